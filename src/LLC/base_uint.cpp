@@ -11,6 +11,7 @@
 
 ____________________________________________________________________________________________*/
 #include <LLC/types/base_uint.h>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 
@@ -26,6 +27,117 @@ namespace
         0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
         0,0xa,0xb,0xc,0xd,0xe,0xf,0,0,0,0,0,0,0,0,0
     };
+
+
+    /* Load 32-bit words into 64-bit limbs, zero padding an odd top word. */
+    inline void load64(const uint32_t* pn, const uint32_t nWidth, uint64_t* pLimbs)
+    {
+        for(uint32_t i = 0; i < nWidth / 2; ++i)
+            pLimbs[i] = pn[2 * i] | (static_cast<uint64_t>(pn[2 * i + 1]) << 32);
+
+        if(nWidth & 1)
+            pLimbs[nWidth / 2] = pn[nWidth - 1];
+    }
+
+
+    /* Store 64-bit limbs into 32-bit words, truncating an odd top word. */
+    inline void store64(const uint64_t* pLimbs, const uint32_t nWidth, uint32_t* pn)
+    {
+        for(uint32_t i = 0; i < nWidth / 2; ++i)
+        {
+            pn[2 * i]     = static_cast<uint32_t>(pLimbs[i]);
+            pn[2 * i + 1] = static_cast<uint32_t>(pLimbs[i] >> 32);
+        }
+
+        if(nWidth & 1)
+            pn[nWidth - 1] = static_cast<uint32_t>(pLimbs[nWidth / 2]);
+    }
+
+
+    /* Get the number of limbs up to the most significant non-zero one. */
+    inline uint32_t used64(const uint64_t* pLimbs, uint32_t nLimbs)
+    {
+        while(nLimbs > 0 && pLimbs[nLimbs - 1] == 0)
+            --nLimbs;
+
+        return nLimbs;
+    }
+
+
+#if defined(__SIZEOF_INT128__)
+    /* Double limb for products and carries. __extension__ keeps -pedantic quiet about the type. */
+    __extension__ typedef unsigned __int128 limb128_t;
+#endif
+
+
+    /* Compute a * b + nAdd + nCarry, which can't overflow 128 bits. Returns the high limb. */
+    inline uint64_t mac64(const uint64_t a, const uint64_t b, const uint64_t nAdd, const uint64_t nCarry, uint64_t &nLow)
+    {
+    #if defined(__SIZEOF_INT128__)
+        /* Compiles to a single mul (or mulx) followed by add/adc pairs. */
+        const limb128_t n = static_cast<limb128_t>(a) * b + nAdd + nCarry;
+
+        nLow = static_cast<uint64_t>(n);
+        return static_cast<uint64_t>(n >> 64);
+    #else
+        /* Build the product from 32-bit halves. */
+        const uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+        const uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+
+        const uint64_t p0 = aLo * bLo, p1 = aLo * bHi, p2 = aHi * bLo, p3 = aHi * bHi;
+        const uint64_t nMid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+
+        uint64_t nHigh = p3 + (p1 >> 32) + (p2 >> 32) + (nMid >> 32);
+        nLow = (nMid << 32) | (p0 & 0xffffffff);
+
+        nLow += nAdd;
+        nHigh += (nLow < nAdd);
+
+        nLow += nCarry;
+        nHigh += (nLow < nCarry);
+
+        return nHigh;
+    #endif
+    }
+
+
+    /* Count the leading zero bits of a non-zero word. */
+    inline uint32_t nlz32(const uint32_t n)
+    {
+    #if defined(__GNUC__)
+        return __builtin_clz(n);
+    #else
+        uint32_t nBits = 0;
+        for(uint32_t nMask = 0x80000000; !(n & nMask); nMask >>= 1)
+            ++nBits;
+
+        return nBits;
+    #endif
+    }
+
+
+    /* Compare two numbers of nWidth words, most significant 64-bit limb first. */
+    inline int32_t compare(const uint32_t* a, const uint32_t* b, uint32_t nWidth)
+    {
+        /* An odd top word is compared on its own. */
+        if(nWidth & 1)
+        {
+            --nWidth;
+            if(a[nWidth] != b[nWidth])
+                return a[nWidth] < b[nWidth] ? -1 : 1;
+        }
+
+        for(; nWidth > 0; nWidth -= 2)
+        {
+            const uint64_t x = a[nWidth - 2] | (static_cast<uint64_t>(a[nWidth - 1]) << 32);
+            const uint64_t y = b[nWidth - 2] | (static_cast<uint64_t>(b[nWidth - 1]) << 32);
+
+            if(x != y)
+                return x < y ? -1 : 1;
+        }
+
+        return 0;
+    }
 }
 
 
@@ -277,14 +389,23 @@ base_uint<BITS>& base_uint<BITS>::operator>>=(uint32_t shift)
 template<uint32_t BITS>
 base_uint<BITS>& base_uint<BITS>::operator+=(const base_uint<BITS>& b)
 {
+    uint64_t a64[LIMBS], b64[LIMBS];
+    load64(pn, WIDTH, a64);
+    load64(b.pn, WIDTH, b64);
+
+    /* Add with carry over 64-bit limbs. */
     uint64_t carry = 0;
-    for(uint8_t i = 0; i < WIDTH; ++i)
+    for(uint32_t i = 0; i < LIMBS; ++i)
     {
-        uint64_t n = carry + pn[i] + b.pn[i];
-        pn[i] = n & 0xffffffff;
-        carry = n >> 32;
+        const uint64_t n = a64[i] + carry;
+        carry = (n < carry);
+
+        a64[i] = n + b64[i];
+        carry += (a64[i] < n);
     }
 
+    store64(a64, WIDTH, pn);
+
     return *this;
 }
 
@@ -305,7 +426,22 @@ base_uint<BITS>& base_uint<BITS>::operator+=(uint64_t b64)
 template<uint32_t BITS>
 base_uint<BITS>& base_uint<BITS>::operator-=(const base_uint<BITS>& b)
 {
-    *this += -b;
+    uint64_t a64[LIMBS], b64[LIMBS];
+    load64(pn, WIDTH, a64);
+    load64(b.pn, WIDTH, b64);
+
+    /* Subtract with borrow over 64-bit limbs, wrapping like the two's complement addition. */
+    uint64_t borrow = 0;
+    for(uint32_t i = 0; i < LIMBS; ++i)
+    {
+        const uint64_t n = a64[i] - b64[i];
+        const uint64_t nBorrow = (a64[i] < b64[i]);
+
+        a64[i] = n - borrow;
+        borrow = nBorrow | (n < borrow);
+    }
+
+    store64(a64, WIDTH, pn);
 
     return *this;
 }
@@ -317,7 +453,7 @@ base_uint<BITS>& base_uint<BITS>::operator-=(uint64_t b64)
 {
     base_uint<BITS> b;
     b = b64;
-    *this += -b;
+    *this -= b;
 
     return *this;
 }
@@ -327,20 +463,28 @@ base_uint<BITS>& base_uint<BITS>::operator-=(uint64_t b64)
 template<uint32_t BITS>
 base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint<BITS>& b)
 {
-    base_uint<BITS> a;
-    a = 0u;
-
-    for(int j = 0; j < WIDTH; j++)
+    uint64_t a64[LIMBS], b64[LIMBS], r64[LIMBS] = { 0 };
+    load64(pn, WIDTH, a64);
+    load64(b.pn, WIDTH, b64);
+
+    /* Schoolbook multiply over 64-bit limbs, skipping the zero limbs of small operands. */
+    const uint32_t nUsedA = used64(a64, LIMBS);
+    const uint32_t nUsedB = used64(b64, LIMBS);
+    for(uint32_t j = 0; j < nUsedA; ++j)
     {
+        if(a64[j] == 0)
+            continue;
+
         uint64_t carry = 0;
-        for(int i = 0; i + j < WIDTH; i++)
-        {
-            uint64_t n = carry + a.pn[i + j] + (uint64_t)pn[j] * b.pn[i];
-            a.pn[i + j] = n & 0xffffffff;
-            carry = n >> 32;
-        }
+        for(uint32_t i = 0; i < nUsedB && i + j < LIMBS; ++i)
+            carry = mac64(a64[j], b64[i], r64[i + j], carry, r64[i + j]);
+
+        /* Carry into the next limb, which is still zero, dropping it past the width. */
+        if(nUsedB + j < LIMBS)
+            r64[nUsedB + j] = carry;
     }
-    *this = a;
+
+    store64(r64, WIDTH, pn);
 
     return *this;
 }
@@ -350,23 +494,15 @@ base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint<BITS>& b)
 template<uint32_t BITS>
 base_uint<BITS>& base_uint<BITS>::operator*=(uint64_t n)
 {
-    base_uint<BITS> a;
-    a = 0u;
+    uint64_t a64[LIMBS];
+    load64(pn, WIDTH, a64);
 
-    base_uint<BITS> b;
-    b = n;
+    /* A single row of limb products. */
+    uint64_t carry = 0;
+    for(uint32_t i = 0; i < LIMBS; ++i)
+        carry = mac64(a64[i], n, 0, carry, a64[i]);
 
-    for(int j = 0; j < WIDTH; j++)
-    {
-        uint64_t carry = 0;
-        for(int i = 0; i + j < WIDTH; i++)
-        {
-            uint64_t n = carry + a.pn[i + j] + (uint64_t)pn[j] * b.pn[i];
-            a.pn[i + j] = n & 0xffffffff;
-            carry = n >> 32;
-        }
-    }
-    *this = a;
+    store64(a64, WIDTH, pn);
 
     return *this;
 }
@@ -377,35 +513,109 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint64_t n)
 template<uint32_t BITS>
 base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint<BITS>& b)
 {
-    base_uint<BITS> div = b;     // make a copy, so we can shift.
-    base_uint<BITS> num = *this; // make a copy, so we can subtract.
-    *this = 0;                   // the quotient.
+    /* Find the significant words of the numerator and divisor. */
+    int32_t m = WIDTH;
+    while(m > 0 && pn[m - 1] == 0)
+        --m;
 
-    int num_bits = num.bits();
-    int div_bits = div.bits();
+    int32_t n = WIDTH;
+    while(n > 0 && b.pn[n - 1] == 0)
+        --n;
 
-    if(div_bits == 0)
+    if(n == 0)
         throw std::domain_error("Division by zero");
 
-    if(div_bits > num_bits) // the result is certainly 0.
+    if(n > m) // the result is certainly 0.
+    {
+        *this = 0;
+        return *this;
+    }
+
+    /* Short division for a single word divisor. */
+    if(n == 1)
+    {
+        const uint64_t nDivisor = b.pn[0];
+
+        uint64_t nRemainder = 0;
+        for(int32_t j = m - 1; j >= 0; --j)
+        {
+            const uint64_t nCurrent = (nRemainder << 32) | pn[j];
+
+            pn[j]      = static_cast<uint32_t>(nCurrent / nDivisor);
+            nRemainder = nCurrent % nDivisor;
+        }
+
         return *this;
+    }
+
+    /* Long division (Knuth algorithm D) on 32-bit digits, normalized so the top bit of the divisor is set. */
+    const uint64_t BASE = 0x100000000ull;
+    const uint32_t s = nlz32(b.pn[n - 1]);
+
+    uint32_t vn[WIDTH];
+    for(int32_t i = n - 1; i > 0; --i)
+        vn[i] = (b.pn[i] << s) | static_cast<uint32_t>(static_cast<uint64_t>(b.pn[i - 1]) >> (32 - s));
+    vn[0] = b.pn[0] << s;
+
+    uint32_t un[WIDTH + 1];
+    un[m] = static_cast<uint32_t>(static_cast<uint64_t>(pn[m - 1]) >> (32 - s));
+    for(int32_t i = m - 1; i > 0; --i)
+        un[i] = (pn[i] << s) | static_cast<uint32_t>(static_cast<uint64_t>(pn[i - 1]) >> (32 - s));
+    un[0] = pn[0] << s;
 
-    int shift = num_bits - div_bits;
+    /* The quotient replaces the numerator. */
+    for(uint32_t i = 0; i < WIDTH; ++i)
+        pn[i] = 0;
 
-    div <<= shift; // shift so that div and num align.
-    while(shift >= 0)
+    for(int32_t j = m - n; j >= 0; --j)
     {
-        if(num >= div)
+        /* Estimate the quotient digit from the top two digits, correcting it at most twice. */
+        const uint64_t nTop = (static_cast<uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+
+        uint64_t qhat = nTop / vn[n - 1];
+        uint64_t rhat = nTop % vn[n - 1];
+        while(qhat >= BASE || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
         {
-            num -= div;
-            pn[shift >> 5] |= (1 << (shift & 31)); // set a bit of the result.
+            --qhat;
+            rhat += vn[n - 1];
+            if(rhat >= BASE)
+                break;
         }
 
-        div >>= 1; // shift back.
-        --shift;
+        /* Multiply and subtract. */
+        int64_t k = 0;
+        int64_t t = 0;
+        for(int32_t i = 0; i < n; ++i)
+        {
+            const uint64_t p = qhat * vn[i];
+
+            t = un[i + j] - k - static_cast<int64_t>(p & 0xffffffff);
+            un[i + j] = static_cast<uint32_t>(t);
+            k = static_cast<int64_t>(p >> 32) - (t >> 32);
+        }
+
+        t = un[j + n] - k;
+        un[j + n] = static_cast<uint32_t>(t);
+
+        /* Add back if we subtracted too much. */
+        pn[j] = static_cast<uint32_t>(qhat);
+        if(t < 0)
+        {
+            --pn[j];
+
+            uint64_t carry = 0;
+            for(int32_t i = 0; i < n; ++i)
+            {
+                const uint64_t nSum = static_cast<uint64_t>(un[i + j]) + vn[i] + carry;
+
+                un[i + j] = static_cast<uint32_t>(nSum);
+                carry = nSum >> 32;
+            }
+
+            un[j + n] += static_cast<uint32_t>(carry);
+        }
     }
 
-    // num now contains the remainder of the division.
     return *this;
 }
 
@@ -476,15 +686,7 @@ const base_uint<BITS> base_uint<BITS>::operator--(int)
 template<uint32_t BITS>
 bool base_uint<BITS>::operator<(const base_uint<BITS>& n) const
 {
-    for(int8_t i = WIDTH-1; i >= 0; --i)
-    {
-        if(this->pn[i] < n.pn[i])
-            return true;
-        else if(this->pn[i] > n.pn[i])
-            return false;
-    }
-
-    return false;
+    return compare(pn, n.pn, WIDTH) < 0;
 }
 
 
@@ -492,15 +694,7 @@ bool base_uint<BITS>::operator<(const base_uint<BITS>& n) const
 template<uint32_t BITS>
 bool base_uint<BITS>::operator<=(const base_uint<BITS>& n) const
 {
-    for(int8_t i = WIDTH-1; i >= 0; --i)
-    {
-        if(this->pn[i] < n.pn[i])
-            return true;
-        else if(this->pn[i] > n.pn[i])
-            return false;
-    }
-
-    return true;
+    return compare(pn, n.pn, WIDTH) <= 0;
 }
 
 
@@ -508,15 +702,7 @@ bool base_uint<BITS>::operator<=(const base_uint<BITS>& n) const
 template<uint32_t BITS>
 bool base_uint<BITS>::operator>(const base_uint<BITS>& n) const
 {
-    for(int8_t i = WIDTH-1; i >= 0; --i)
-    {
-        if(this->pn[i] > n.pn[i])
-            return true;
-        else if(this->pn[i] < n.pn[i])
-            return false;
-    }
-
-    return false;
+    return compare(pn, n.pn, WIDTH) > 0;
 }
 
 
@@ -524,15 +710,7 @@ bool base_uint<BITS>::operator>(const base_uint<BITS>& n) const
 template<uint32_t BITS>
 bool base_uint<BITS>::operator>=(const base_uint<BITS>& n) const
 {
-    for(int8_t i = WIDTH-1; i >= 0; --i)
-    {
-        if(this->pn[i] > n.pn[i])
-            return true;
-        else if(this->pn[i] < n.pn[i])
-            return false;
-    }
-
-    return true;
+    return compare(pn, n.pn, WIDTH) >= 0;
 }
 
 
@@ -540,11 +718,7 @@ bool base_uint<BITS>::operator>=(const base_uint<BITS>& n) const
 template<uint32_t BITS>
 bool base_uint<BITS>::operator==(const base_uint<BITS>& n) const
 {
-    for(uint8_t i = 0; i < WIDTH; ++i)
-        if(this->pn[i] != n.pn[i])
-            return false;
-
-    return true;
+    return std::memcmp(pn, n.pn, sizeof(pn)) == 0;
 }
 
 
@@ -799,14 +973,7 @@ uint32_t base_uint<BITS>::bits() const
     for(int32_t pos = WIDTH - 1; pos >= 0; --pos)
     {
         if(pn[pos])
-        {
-            for(int32_t nbits = 31; nbits > 0; --nbits)
-            {
-                if(pn[pos] & 1U << nbits)
-                    return 32 * pos + nbits + 1;
-            }
-            return 32 * pos + 1;
-        }
+            return 32 * pos + 32 - nlz32(pn[pos]);
     }
 
     return 0;
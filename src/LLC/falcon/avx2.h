@@ -0,0 +1,99 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#ifndef FALCON_AVX2_H__
+#define FALCON_AVX2_H__
+
+/*
+ * Nexus: a second build of the Falcon library with the AVX2 code paths,
+ * picked at runtime by falcon_avx2_supported(). The default build can't
+ * assume AVX2 unless the compiler targets it (see config.h), so the
+ * AVX2 functions are compiled with target attributes and every symbol
+ * gets its own prefix. Keys and signatures are the same as with the
+ * emulated backend, as FMA stays off.
+ *
+ * Nothing is built when the compiler already targets AVX2, or isn't
+ * GCC-compatible on x86-64.
+ */
+#if defined __x86_64__ && defined __GNUC__ && !defined __AVX2__ && !(defined FALCON_AVX2 && FALCON_AVX2)
+#define FALCON_AVX2_DISPATCH   1
+#else
+#define FALCON_AVX2_DISPATCH   0
+#endif
+
+#include "falcon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if FALCON_AVX2_DISPATCH
+
+/*
+ * Returns 1 if the CPU and OS support AVX2, 0 otherwise.
+ */
+int falcon_avx2_supported(void);
+
+/*
+ * AVX2 builds of falcon_keygen_make() and falcon_sign_dyn(), taking the
+ * same arguments. Only call them when falcon_avx2_supported() is 1.
+ */
+int falcon_avx2_keygen_make(
+	shake256_context *rng,
+	unsigned logn,
+	void *privkey, size_t privkey_len,
+	void *pubkey, size_t pubkey_len,
+	void *tmp, size_t tmp_len);
+
+int falcon_avx2_sign_dyn(shake256_context *rng,
+	void *sig, size_t *sig_len,
+	const void *privkey, size_t privkey_len,
+	const void *data, size_t data_len,
+	int ct, void *tmp, size_t tmp_len);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * The sources of the AVX2 build define FALCON_AVX2_BUILD before including
+ * this header, so the library compiles under the second prefix.
+ */
+#if defined FALCON_AVX2_BUILD && FALCON_AVX2_DISPATCH
+#define FALCON_AVX2     1
+#define FALCON_PREFIX   falcon_avx2_inner
+#define falcon_keygen_make            falcon_avx2_keygen_make
+#define falcon_make_public            falcon_avx2_make_public
+#define falcon_get_logn               falcon_avx2_get_logn
+#define falcon_sign_dyn               falcon_avx2_sign_dyn
+#define falcon_expand_privkey         falcon_avx2_expand_privkey
+#define falcon_sign_tree              falcon_avx2_sign_tree
+#define falcon_sign_start             falcon_avx2_sign_start
+#define falcon_sign_dyn_finish        falcon_avx2_sign_dyn_finish
+#define falcon_sign_tree_finish       falcon_avx2_sign_tree_finish
+#define falcon_verify                 falcon_avx2_verify
+#define falcon_verify_start           falcon_avx2_verify_start
+#define falcon_verify_finish          falcon_avx2_verify_finish
+#define falcon_expand_pubkey          falcon_avx2_expand_pubkey
+#define falcon_verify_expanded        falcon_avx2_verify_expanded
+#define shake256_init                  falcon_avx2_shake256_init
+#define shake256_inject                falcon_avx2_shake256_inject
+#define shake256_flip                  falcon_avx2_shake256_flip
+#define shake256_extract               falcon_avx2_shake256_extract
+#define shake256_init_prng_from_seed   falcon_avx2_shake256_init_prng_from_seed
+#define shake256_init_prng_from_system falcon_avx2_shake256_init_prng_from_system
+#endif
+
+#endif
@@ -0,0 +1,41 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+/*
+ * Nexus: part of the AVX2 build of the Falcon library, see avx2.h.
+ */
+#define FALCON_AVX2_BUILD   1
+#include "avx2.h"
+
+#if FALCON_AVX2_DISPATCH
+#include "falcon.c"
+#include "codec.c"
+#include "common.c"
+#include "fft.c"
+#include "fpr.c"
+#include "rng.c"
+#include "shake.c"
+#include "vrfy.c"
+
+/* see avx2.h */
+int
+falcon_avx2_supported(void)
+{
+	/* __builtin_cpu_supports also checks that the OS saves the YMM registers. */
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+}
+#else
+/* ISO C doesn't allow an empty translation unit. */
+typedef int falcon_avx2_unused;
+#endif
@@ -85,7 +85,9 @@
  * FALCON_ASM_CORTEXM4 is defined to 1, in which case the emulated code
  * will be used.
  */
+#if !(defined __AVX2__ || (defined FALCON_AVX2 && FALCON_AVX2))
 #define FALCON_FPEMU   1
+#endif
 
 /*
  * Enable use of assembly for ARM Cortex-M4 CPU. By default, such
@@ -133,6 +135,20 @@
 #define FALCON_FMA   1
  */
 
+/*
+ * Nexus: enable the AVX2 code paths whenever the compiler is already
+ * targeting a CPU that has them (e.g. -march=native or -mavx2), so the
+ * build never emits opcodes the host cannot run. AVX2 needs the native
+ * 'double' backend, which produces the same values as the emulated one
+ * used otherwise (see FALCON_FPEMU above). FMA is left opt-in through
+ * -DFALCON_FMA=1 as it may change keys derived from the same seed.
+ * These paths only affect the FFT code used by key generation and
+ * signing; verification is pure integer NTT.
+ */
+#if defined __AVX2__ && !defined FALCON_AVX2
+#define FALCON_AVX2   1
+#endif
+
 /*
  * Assert that the platform uses little-endian encoding. If enabled,
  * then encoding and decoding of aligned multibyte values will be
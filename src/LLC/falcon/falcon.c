@@ -657,37 +657,24 @@ falcon_verify_start(shake256_context *hash_data,
 	return 0;
 }
 
-/* see falcon.h */
-int
-falcon_verify_finish(const void *sig, size_t sig_len,
-	const void *pubkey, size_t pubkey_len,
-	shake256_context *hash_data,
-	void *tmp, size_t tmp_len)
+/*
+ * Verify a signature against a public key already decoded and converted
+ * to NTT + Montgomery representation (h[], with n = 2^logn elements).
+ * The tmp[] buffer must be 16-bit aligned and hold at least 6*n bytes.
+ */
+static int
+verify_decoded(const void *sig, size_t sig_len,
+	const uint16_t *h, unsigned logn,
+	shake256_context *hash_data, uint8_t *tmp)
 {
-	unsigned logn;
+	const uint8_t *es;
 	uint8_t *atmp;
-	const uint8_t *pk, *es;
 	int ct;
 	size_t u, v, n;
-	uint16_t *h, *hm;
+	uint16_t *hm;
 	int16_t *sv;
 
-	/*
-	 * Get Falcon degree from public key; verify consistency with
-	 * signature value, and check parameters.
-	 */
-	if (sig_len < 41 || pubkey_len == 0) {
-		return FALCON_ERR_FORMAT;
-	}
 	es = sig;
-	pk = pubkey;
-	if ((pk[0] & 0xF0) != 0x00) {
-		return FALCON_ERR_FORMAT;
-	}
-	logn = pk[0] & 0x0F;
-	if (logn < 1 || logn > 10) {
-		return FALCON_ERR_FORMAT;
-	}
 	switch (es[0] & 0xF0) {
 	case 0x30:
 		ct = 0;
@@ -701,28 +688,12 @@ falcon_verify_finish(const void *sig, size_t sig_len,
 	if ((es[0] & 0x0F) != logn) {
 		return FALCON_ERR_BADSIG;
 	}
-	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
-		return FALCON_ERR_FORMAT;
-	}
-	if (tmp_len < FALCON_TMPSIZE_VERIFY(logn)) {
-		return FALCON_ERR_SIZE;
-	}
 
 	n = (size_t)1 << logn;
-	h = (uint16_t *)align_u16(tmp);
-	hm = h + n;
+	hm = (uint16_t *)tmp;
 	sv = (int16_t *)(hm + n);
 	atmp = (uint8_t *)(sv + n);
 
-	/*
-	 * Decode public key.
-	 */
-	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
-		!= pubkey_len - 1)
-	{
-		return FALCON_ERR_FORMAT;
-	}
-
 	/*
 	 * Decode signature value.
 	 */
@@ -752,13 +723,122 @@ falcon_verify_finish(const void *sig, size_t sig_len,
 	/*
 	 * Verify signature.
 	 */
-	Zf(to_ntt_monty)(h, logn);
 	if (!Zf(verify_raw)(hm, sv, h, logn, atmp)) {
 		return FALCON_ERR_BADSIG;
 	}
 	return 0;
 }
 
+/* see falcon.h */
+int
+falcon_verify_finish(const void *sig, size_t sig_len,
+	const void *pubkey, size_t pubkey_len,
+	shake256_context *hash_data,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const uint8_t *pk;
+	size_t n;
+	uint16_t *h;
+
+	/*
+	 * Get Falcon degree from public key; verify consistency with
+	 * signature value, and check parameters.
+	 */
+	if (sig_len < 41 || pubkey_len == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	pk = pubkey;
+	if ((pk[0] & 0xF0) != 0x00) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = pk[0] & 0x0F;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (tmp_len < FALCON_TMPSIZE_VERIFY(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+
+	n = (size_t)1 << logn;
+	h = (uint16_t *)align_u16(tmp);
+
+	/*
+	 * Decode public key.
+	 */
+	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+		!= pubkey_len - 1)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	Zf(to_ntt_monty)(h, logn);
+
+	return verify_decoded(sig, sig_len, h, logn,
+		hash_data, (uint8_t *)(h + n));
+}
+
+/* see falcon.h */
+int
+falcon_expand_pubkey(uint16_t *h, size_t h_len,
+	const void *pubkey, size_t pubkey_len)
+{
+	unsigned logn;
+	const uint8_t *pk;
+
+	if (pubkey_len == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	pk = pubkey;
+	if ((pk[0] & 0xF0) != 0x00) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = pk[0] & 0x0F;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (h_len < FALCON_EXPANDEDPUBKEY_LEN(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+		!= pubkey_len - 1)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	Zf(to_ntt_monty)(h, logn);
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_verify_expanded(const void *sig, size_t sig_len,
+	const uint16_t *h, unsigned logn,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len)
+{
+	shake256_context hd;
+	int r;
+
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_BADARG;
+	}
+	if (tmp_len < FALCON_TMPSIZE_VERIFY(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+	r = falcon_verify_start(&hd, sig, sig_len);
+	if (r < 0) {
+		return r;
+	}
+	shake256_inject(&hd, data, data_len);
+	return verify_decoded(sig, sig_len, h, logn,
+		&hd, (uint8_t *)align_u16(tmp));
+}
+
 /* see falcon.h */
 int
 falcon_verify(const void *sig, size_t sig_len,
@@ -335,6 +335,12 @@ extern "C" {
 #define FALCON_TMPSIZE_VERIFY(logn) \
 	((8u << (logn)) + 1)
 
+/*
+ * Length (in 16-bit elements, not bytes) of an expanded public key.
+ */
+#define FALCON_EXPANDEDPUBKEY_LEN(logn) \
+	((size_t)1 << (logn))
+
 /* ==================================================================== */
 /*
  * SHAKE256.
@@ -725,6 +731,36 @@ int falcon_verify_finish(const void *sig, size_t sig_len,
 	shake256_context *hash_data,
 	void *tmp, size_t tmp_len);
 
+/*
+ * Expand a public key for repeated verification. The public key
+ * pubkey[] (of length pubkey_len bytes) is decoded and converted to the
+ * NTT representation used internally by the verifier, and written into
+ * h[] (of length h_len 16-bit elements, which MUST be at least
+ * FALCON_EXPANDEDPUBKEY_LEN(logn)). The degree logn is the low nibble
+ * of the first public key byte.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_expand_pubkey(uint16_t *h, size_t h_len,
+	const void *pubkey, size_t pubkey_len);
+
+/*
+ * Verify the signature sig[] (of length sig_len bytes) with regards to
+ * the expanded public key h[] (as produced by falcon_expand_pubkey() for
+ * degree logn) and the data[] (of length data_len bytes). This is
+ * equivalent to falcon_verify(), but skips decoding the public key and
+ * converting it to NTT representation.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_VERIFY(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_verify_expanded(const void *sig, size_t sig_len,
+	const uint16_t *h, unsigned logn,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len);
+
 /* ==================================================================== */
 
 #ifdef __cplusplus
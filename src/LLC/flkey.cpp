@@ -18,9 +18,48 @@ ________________________________________________________________________________
 #include <LLC/types/typedef.h>
 
 #include <LLC/include/flkey.h>
+#include <LLC/include/flverifier.h>
+
+#include <LLC/falcon/avx2.h>
 
 namespace LLC
 {
+#if FALCON_AVX2_DISPATCH
+    /* Check once whether the AVX2 build of Falcon can be used on this CPU. */
+    static bool falcon_avx2()
+    {
+        static const bool fSupported = (falcon_avx2_supported() != 0);
+        return fSupported;
+    }
+#endif
+
+
+    /* Generate a Falcon key pair, with the AVX2 build if the CPU supports it. */
+    static int keygen_make(shake256_context* rng, unsigned logn, void* privkey, size_t privkey_len,
+                           void* pubkey, size_t pubkey_len, void* tmp, size_t tmp_len)
+    {
+    #if FALCON_AVX2_DISPATCH
+        if(falcon_avx2())
+            return falcon_avx2_keygen_make(rng, logn, privkey, privkey_len, pubkey, pubkey_len, tmp, tmp_len);
+    #endif
+
+        return falcon_keygen_make(rng, logn, privkey, privkey_len, pubkey, pubkey_len, tmp, tmp_len);
+    }
+
+
+    /* Sign a message, with the AVX2 build if the CPU supports it. */
+    static int sign_dyn(shake256_context* rng, void* sig, size_t* sig_len, const void* privkey, size_t privkey_len,
+                        const void* data, size_t data_len, int ct, void* tmp, size_t tmp_len)
+    {
+    #if FALCON_AVX2_DISPATCH
+        if(falcon_avx2())
+            return falcon_avx2_sign_dyn(rng, sig, sig_len, privkey, privkey_len, data, data_len, ct, tmp, tmp_len);
+    #endif
+
+        return falcon_sign_dyn(rng, sig, sig_len, privkey, privkey_len, data, data_len, ct, tmp, tmp_len);
+    }
+
+
     /* The default constructor. */
     FLKey::FLKey()
     : vchPubKey   ( )
@@ -122,7 +161,7 @@ namespace LLC
         std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_KEYGEN(9), 0);
 
         /* Generate the falcon key. */
-        if(falcon_keygen_make(&ctx, 9,
+        if(keygen_make(&ctx, 9,
             &vchPrivKey[0], vchPrivKey.size(),
             &vchPubKey[0],  vchPubKey.size(),
             &vchTemp[0],     vchTemp.size()))
@@ -150,7 +189,7 @@ namespace LLC
         std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_KEYGEN(9), 0);
 
         /* Generate the falcon key. */
-        if(falcon_keygen_make(&ctx, 9,
+        if(keygen_make(&ctx, 9,
             &vchPrivKey[0], vchPrivKey.size(),
             &vchPubKey[0],  vchPubKey.size(),
             &vchTemp[0],     vchTemp.size()))
@@ -209,7 +248,7 @@ namespace LLC
 
         /* Create the signed message. */
         size_t nSize = vchSig.size();
-        if(falcon_sign_dyn(&ctx, &vchSig[0], &nSize, &vchPrivKey[0], vchPrivKey.size(), &vchData[0], vchData.size(), 1, &vchTemp[0], vchTemp.size()))
+        if(sign_dyn(&ctx, &vchSig[0], &nSize, &vchPrivKey[0], vchPrivKey.size(), &vchData[0], vchData.size(), 1, &vchTemp[0], vchTemp.size()))
             return false;
 
         /* Resize the signature data. */
@@ -226,14 +265,8 @@ namespace LLC
         if(!fSet || vchPubKey.empty())
             return false;
 
-        /* Create temp memory. */
-        std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_VERIFY(9), 0);
-
-        /* Verify the signed message. */
-        if(falcon_verify(&vchSig[0], vchSig.size(), &vchPubKey[0], vchPubKey.size(), &vchData[0], vchData.size(), &vchTemp[0], vchTemp.size()))
-            return false;
-
-        return true;
+        /* Verify the signed message against the cached expanded key. */
+        return flVerifier.Verify(vchPubKey, vchData, vchSig);
     }
 
 
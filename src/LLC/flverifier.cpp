@@ -0,0 +1,73 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/flverifier.h>
+#include <LLC/hash/SK.h>
+
+#include <LLC/falcon/falcon.h>
+
+namespace LLC
+{
+    /* Shared verifier used by FLKey::Verify. */
+    FLVerifier flVerifier(256);
+
+
+    /* Total Elements Constructor */
+    FLVerifier::FLVerifier(const uint32_t nElements)
+    : cacheKeys (nElements)
+    {
+    }
+
+
+    /* Signature Verification Function */
+    bool FLVerifier::Verify(const std::vector<uint8_t>& vchPubKey,
+                            const std::vector<uint8_t>& vchData, const std::vector<uint8_t>& vchSig)
+    {
+        /* Check for empty key or signature. */
+        if(vchPubKey.empty() || vchSig.empty())
+            return false;
+
+        /* Get the falcon degree from the public key header. This is consensus: FLKey::Verify always gave
+         * falcon_verify scratch space for logn 9, which fails for any larger degree, so we must too. */
+        const uint32_t nLogN = (vchPubKey[0] & 0x0f);
+        if(nLogN < 1 || nLogN > MAX_LOGN)
+            return false;
+
+        /* Check the cache for an expanded copy of this key. */
+        const uint256_t hashKey = SK256(vchPubKey);
+
+        std::vector<uint16_t> vExpanded;
+        if(!cacheKeys.Get(hashKey, vExpanded))
+        {
+            /* Decode the key and convert it to NTT form. */
+            vExpanded.resize(FALCON_EXPANDEDPUBKEY_LEN(nLogN));
+            if(falcon_expand_pubkey(&vExpanded[0], vExpanded.size(), &vchPubKey[0], vchPubKey.size()))
+                return false;
+
+            /* Cache the expanded key. */
+            cacheKeys.Put(hashKey, vExpanded);
+        }
+
+        /* Scratch space is kept per thread so verification never allocates once warm. */
+        thread_local std::vector<uint8_t> vchTemp;
+        if(vchTemp.size() < FALCON_TMPSIZE_VERIFY(nLogN))
+            vchTemp.resize(FALCON_TMPSIZE_VERIFY(nLogN));
+
+        /* Verify the signed message. */
+        if(falcon_verify_expanded(&vchSig[0], vchSig.size(), &vExpanded[0], nLogN,
+            vchData.data(), vchData.size(), &vchTemp[0], vchTemp.size()))
+            return false;
+
+        return true;
+    }
+}
@@ -424,6 +424,40 @@ namespace LLC
 
 		return hashKeccak;
 	}
+
+
+	/** SK512Batch
+     *
+     *  512-bit hashing of many messages at once, giving the same hash as SK512(pbegin, pend)
+     *  for each message. Messages are hashed four at a time when the CPU supports AVX2.
+     *  The hash cache is not used.
+     *
+     *  @param[in] vData The begin pointer and size in bytes of each message.
+     *  @param[out] vHashes The hashes, in the same order as the messages.
+     *
+     **/
+	void SK512Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint512_t> &vHashes);
+
+
+	/** SK1024Batch
+     *
+     *  1024-bit hashing of many messages at once, giving the same hash as SK1024(pbegin, pend)
+     *  for each message. Messages are hashed four at a time when the CPU supports AVX2.
+     *  The hash cache is not used.
+     *
+     *  @param[in] vData The begin pointer and size in bytes of each message.
+     *  @param[out] vHashes The hashes, in the same order as the messages.
+     *
+     **/
+	void SK1024Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint1024_t> &vHashes);
+
+
+	/** SKBatchBackend
+     *
+     *  Returns the name of the backend selected for the batch functions on this CPU.
+     *
+     **/
+	std::string SKBatchBackend();
 }
 
 #endif
@@ -184,7 +184,7 @@ void KeccakF1600_StateComplementBit(void *state, uint32_t position)
 
 /* ---------------------------------------------------------------- */
 
-void KeccakF1600_StatePermute(void *argState)
+void KeccakF1600_StatePermute_Compact(void *argState)
 {
     tSmaUtilInt x, y, round;
     tKeccakLane        temp;
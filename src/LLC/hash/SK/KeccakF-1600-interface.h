@@ -72,6 +72,12 @@ void KeccakF1600_StateComplementBit(void *state, uint32_t position);
   */
 void KeccakF1600_StatePermute(void *state);
 
+/** Compact reference implementation of Keccak-f[1600], using loops over the
+  * lanes. KeccakF1600_StatePermute is the unrolled version used for hashing.
+  * @param  state   Pointer to the state.
+  */
+void KeccakF1600_StatePermute_Compact(void *state);
+
 /** Function to retrieve data from the state into bytes.
   * The bits to output are restricted to be consecutive and to be in the same lane.
   * The bit positions that are retrieved by this function are
@@ -0,0 +1,98 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakF1600Round_h_
+#define _KeccakF1600Round_h_
+
+#include <inttypes.h>
+
+/** The round constants of Keccak-f[1600], in round order.
+  */
+static const uint64_t KeccakF1600_RoundConstants[24] =
+{
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/** One fully unrolled round of Keccak-f[1600] on 25 named lanes.
+  * The lanes are the variables A00 to A24 (index x+5*y), with B00 to B24,
+  * C0 to C4 and D0 to D4 as temporaries, prefixed by the macro arguments.
+  * The includer defines ROL(lane, offset) for its lane type, so the same
+  * round works on scalar lanes and on vectors of lanes from several states.
+  * @param  rc  The round constant.
+  */
+#define KeccakF1600_Round(A, B, C, D, rc) \
+    C##0 = A##00 ^ A##05 ^ A##10 ^ A##15 ^ A##20; \
+    C##1 = A##01 ^ A##06 ^ A##11 ^ A##16 ^ A##21; \
+    C##2 = A##02 ^ A##07 ^ A##12 ^ A##17 ^ A##22; \
+    C##3 = A##03 ^ A##08 ^ A##13 ^ A##18 ^ A##23; \
+    C##4 = A##04 ^ A##09 ^ A##14 ^ A##19 ^ A##24; \
+    D##0 = C##4 ^ ROL(C##1, 1); \
+    D##1 = C##0 ^ ROL(C##2, 1); \
+    D##2 = C##1 ^ ROL(C##3, 1); \
+    D##3 = C##2 ^ ROL(C##4, 1); \
+    D##4 = C##3 ^ ROL(C##0, 1); \
+    B##00 = (A##00 ^ D##0); \
+    B##10 = ROL((A##01 ^ D##1), 1); \
+    B##20 = ROL((A##02 ^ D##2), 62); \
+    B##05 = ROL((A##03 ^ D##3), 28); \
+    B##15 = ROL((A##04 ^ D##4), 27); \
+    B##16 = ROL((A##05 ^ D##0), 36); \
+    B##01 = ROL((A##06 ^ D##1), 44); \
+    B##11 = ROL((A##07 ^ D##2), 6); \
+    B##21 = ROL((A##08 ^ D##3), 55); \
+    B##06 = ROL((A##09 ^ D##4), 20); \
+    B##07 = ROL((A##10 ^ D##0), 3); \
+    B##17 = ROL((A##11 ^ D##1), 10); \
+    B##02 = ROL((A##12 ^ D##2), 43); \
+    B##12 = ROL((A##13 ^ D##3), 25); \
+    B##22 = ROL((A##14 ^ D##4), 39); \
+    B##23 = ROL((A##15 ^ D##0), 41); \
+    B##08 = ROL((A##16 ^ D##1), 45); \
+    B##18 = ROL((A##17 ^ D##2), 15); \
+    B##03 = ROL((A##18 ^ D##3), 21); \
+    B##13 = ROL((A##19 ^ D##4), 8); \
+    B##14 = ROL((A##20 ^ D##0), 18); \
+    B##24 = ROL((A##21 ^ D##1), 2); \
+    B##09 = ROL((A##22 ^ D##2), 61); \
+    B##19 = ROL((A##23 ^ D##3), 56); \
+    B##04 = ROL((A##24 ^ D##4), 14); \
+    A##00 = B##00 ^ (~B##01 & B##02); \
+    A##01 = B##01 ^ (~B##02 & B##03); \
+    A##02 = B##02 ^ (~B##03 & B##04); \
+    A##03 = B##03 ^ (~B##04 & B##00); \
+    A##04 = B##04 ^ (~B##00 & B##01); \
+    A##05 = B##05 ^ (~B##06 & B##07); \
+    A##06 = B##06 ^ (~B##07 & B##08); \
+    A##07 = B##07 ^ (~B##08 & B##09); \
+    A##08 = B##08 ^ (~B##09 & B##05); \
+    A##09 = B##09 ^ (~B##05 & B##06); \
+    A##10 = B##10 ^ (~B##11 & B##12); \
+    A##11 = B##11 ^ (~B##12 & B##13); \
+    A##12 = B##12 ^ (~B##13 & B##14); \
+    A##13 = B##13 ^ (~B##14 & B##10); \
+    A##14 = B##14 ^ (~B##10 & B##11); \
+    A##15 = B##15 ^ (~B##16 & B##17); \
+    A##16 = B##16 ^ (~B##17 & B##18); \
+    A##17 = B##17 ^ (~B##18 & B##19); \
+    A##18 = B##18 ^ (~B##19 & B##15); \
+    A##19 = B##19 ^ (~B##15 & B##16); \
+    A##20 = B##20 ^ (~B##21 & B##22); \
+    A##21 = B##21 ^ (~B##22 & B##23); \
+    A##22 = B##22 ^ (~B##23 & B##24); \
+    A##23 = B##23 ^ (~B##24 & B##20); \
+    A##24 = B##24 ^ (~B##20 & B##21); \
+    A##00 ^= (rc);
+
+#endif
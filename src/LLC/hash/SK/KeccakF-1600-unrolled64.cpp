@@ -0,0 +1,56 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include <string.h>
+#include <inttypes.h>
+
+#include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/hash/SK/KeccakF-1600-round.h>
+
+#if defined(_MSC_VER)
+#define ROL(a, offset) _rotl64(a, offset)
+#else
+#define ROL(a, offset) ((((uint64_t)a) << offset) ^ (((uint64_t)a) >> (64-offset)))
+#endif
+
+/* ---------------------------------------------------------------- */
+
+/* Keccak-f[1600] with the rounds unrolled, keeping the state in local lanes. */
+void KeccakF1600_StatePermute(void *argState)
+{
+    uint64_t lanes[25];
+    memcpy(lanes, argState, sizeof(lanes));
+
+    uint64_t A00 = lanes[ 0], A01 = lanes[ 1], A02 = lanes[ 2], A03 = lanes[ 3], A04 = lanes[ 4];
+    uint64_t A05 = lanes[ 5], A06 = lanes[ 6], A07 = lanes[ 7], A08 = lanes[ 8], A09 = lanes[ 9];
+    uint64_t A10 = lanes[10], A11 = lanes[11], A12 = lanes[12], A13 = lanes[13], A14 = lanes[14];
+    uint64_t A15 = lanes[15], A16 = lanes[16], A17 = lanes[17], A18 = lanes[18], A19 = lanes[19];
+    uint64_t A20 = lanes[20], A21 = lanes[21], A22 = lanes[22], A23 = lanes[23], A24 = lanes[24];
+
+    uint64_t B00, B01, B02, B03, B04, B05, B06, B07, B08, B09, B10, B11, B12;
+    uint64_t B13, B14, B15, B16, B17, B18, B19, B20, B21, B22, B23, B24;
+    uint64_t C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;
+
+    for(uint32_t round = 0; round < 24; round += 2)
+    {
+        KeccakF1600_Round(A, B, C, D, KeccakF1600_RoundConstants[round])
+        KeccakF1600_Round(A, B, C, D, KeccakF1600_RoundConstants[round + 1])
+    }
+
+    lanes[ 0] = A00; lanes[ 1] = A01; lanes[ 2] = A02; lanes[ 3] = A03; lanes[ 4] = A04;
+    lanes[ 5] = A05; lanes[ 6] = A06; lanes[ 7] = A07; lanes[ 8] = A08; lanes[ 9] = A09;
+    lanes[10] = A10; lanes[11] = A11; lanes[12] = A12; lanes[13] = A13; lanes[14] = A14;
+    lanes[15] = A15; lanes[16] = A16; lanes[17] = A17; lanes[18] = A18; lanes[19] = A19;
+    lanes[20] = A20; lanes[21] = A21; lanes[22] = A22; lanes[23] = A23; lanes[24] = A24;
+
+    memcpy(argState, lanes, sizeof(lanes));
+}
+
+/* ---------------------------------------------------------------- */
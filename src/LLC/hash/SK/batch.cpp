@@ -0,0 +1,336 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/hash/SK/times4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace LLC
+{
+
+    /* The Keccak rate used by both SK512 and SK1024, in 64-bit lanes. */
+    const uint32_t KECCAK_RATE_LANES = 9;
+
+
+    /* Hash one message with the portable code, as SK512 does without the cache. */
+    uint512_t SK512Scalar(const uint8_t* pData, const uint64_t nSize)
+    {
+        uint512_t hashSkein;
+        Skein_512_Ctxt_t ctxSkein;
+        Skein_512_Init  (&ctxSkein, 512);
+        Skein_512_Update(&ctxSkein, (nSize == 0 ? pblank : pData), nSize);
+        Skein_512_Final (&ctxSkein, (uint8_t *)&hashSkein);
+
+        uint512_t hashKeccak;
+        Keccak_HashInstance ctxKeccak;
+        Keccak_HashInitialize_SHA3_512(&ctxKeccak);
+        Keccak_HashUpdate(&ctxKeccak, (uint8_t *)&hashSkein, 512);
+        Keccak_HashFinal(&ctxKeccak, (uint8_t *)&hashKeccak);
+
+        return hashKeccak;
+    }
+
+
+    /* Hash one message with the portable code, as SK1024 does without the cache. */
+    uint1024_t SK1024Scalar(const uint8_t* pData, const uint64_t nSize)
+    {
+        uint1024_t hashSkein;
+        Skein1024_Ctxt_t ctxSkein;
+        Skein1024_Init  (&ctxSkein, 1024);
+        Skein1024_Update(&ctxSkein, (nSize == 0 ? pblank : pData), nSize);
+        Skein1024_Final (&ctxSkein, (uint8_t *)&hashSkein);
+
+        uint1024_t hashKeccak;
+        Keccak_HashInstance ctxKeccak;
+        Keccak_HashInitialize(&ctxKeccak, 576, 1024, 1024, 0x05);
+        Keccak_HashUpdate(&ctxKeccak, (uint8_t *)&hashSkein, 1024);
+        Keccak_HashFinal(&ctxKeccak, (uint8_t *)&hashKeccak);
+
+        return hashKeccak;
+    }
+
+
+#ifdef SK_TIMES4_AVX2
+
+    /* Run Skein over four messages in parallel lanes, leaving the Skein output words in X.
+     * Lanes past nLanes hash an empty message and are ignored by the caller. */
+    template<uint32_t WORDS>
+    void SkeinTimes4(const std::pair<const uint8_t*, uint64_t>* pData, const uint32_t nLanes,
+                     const u64b_t* pIV, uint64_t* X)
+    {
+        const uint64_t nBlockBytes = WORDS * 8;
+
+        /* Start every lane from the chaining value after the configuration block. */
+        for(uint32_t w = 0; w < WORDS; ++w)
+            for(uint32_t i = 0; i < 4; ++i)
+                X[w * 4 + i] = pIV[w];
+
+        /* Get the number of message blocks in each lane, an empty message still has one. */
+        uint64_t nBlocks[4] = { 1, 1, 1, 1 };
+        uint64_t nMaxBlocks = 1;
+        for(uint32_t i = 0; i < nLanes; ++i)
+        {
+            nBlocks[i] = std::max(uint64_t(1), (pData[i].second + nBlockBytes - 1) / nBlockBytes);
+            nMaxBlocks = std::max(nMaxBlocks, nBlocks[i]);
+        }
+
+        uint64_t w[WORDS * 4];
+        uint64_t T[2 * 4];
+        uint64_t XSave[WORDS * 4];
+        uint8_t  vBlock[WORDS * 8];
+        uint64_t vWords[WORDS];
+
+        /* Process the message blocks, lanes that have finished run on and are restored after. */
+        for(uint64_t b = 0; b < nMaxBlocks; ++b)
+        {
+            bool fFinished = false;
+            for(uint32_t i = 0; i < 4; ++i)
+            {
+                /* Finished lanes get a zero block. */
+                if(b >= nBlocks[i])
+                {
+                    fFinished = true;
+                    for(uint32_t k = 0; k < WORDS; ++k)
+                        w[k * 4 + i] = 0;
+
+                    T[i]     = 0;
+                    T[4 + i] = 0;
+
+                    continue;
+                }
+
+                /* Copy the block, zero padding the final one. */
+                const uint64_t nOffset = b * nBlockBytes;
+                const uint64_t nBytes  = (i < nLanes) ? std::min(nBlockBytes, pData[i].second - nOffset) : 0;
+
+                memset(vBlock, 0, sizeof(vBlock));
+                if(nBytes > 0)
+                    memcpy(vBlock, pData[i].first + nOffset, nBytes);
+
+                Skein_Get64_LSB_First(vWords, vBlock, WORDS);
+                for(uint32_t k = 0; k < WORDS; ++k)
+                    w[k * 4 + i] = vWords[k];
+
+                /* Set the tweak the same way as Skein_Update and Skein_Final. */
+                T[i]     = nOffset + nBytes;
+                T[4 + i] = SKEIN_T1_BLK_TYPE_MSG;
+                if(b == 0)
+                    T[4 + i] |= SKEIN_T1_FLAG_FIRST;
+                if(b == nBlocks[i] - 1)
+                    T[4 + i] |= SKEIN_T1_FLAG_FINAL;
+            }
+
+            if(fFinished)
+                memcpy(XSave, X, sizeof(XSave));
+
+            if(WORDS == SKEIN_512_STATE_WORDS)
+                Skein_512_Process_Block_times4(X, w, T);
+            else
+                Skein1024_Process_Block_times4(X, w, T);
+
+            /* Put back the chaining values of the lanes that had finished. */
+            if(fFinished)
+            {
+                for(uint32_t i = 0; i < 4; ++i)
+                    if(b >= nBlocks[i])
+                        for(uint32_t k = 0; k < WORDS; ++k)
+                            X[k * 4 + i] = XSave[k * 4 + i];
+            }
+        }
+
+        /* Run the output block with counter zero. */
+        memset(w, 0, sizeof(w));
+        for(uint32_t i = 0; i < 4; ++i)
+        {
+            T[i]     = sizeof(u64b_t);
+            T[4 + i] = SKEIN_T1_FLAG_FIRST | SKEIN_T1_BLK_TYPE_OUT_FINAL;
+        }
+
+        if(WORDS == SKEIN_512_STATE_WORDS)
+            Skein_512_Process_Block_times4(X, w, T);
+        else
+            Skein1024_Process_Block_times4(X, w, T);
+    }
+
+
+    /* Run the Keccak sponge over four Skein outputs of WORDS lanes each, writing OUT lanes per instance. */
+    template<uint32_t WORDS, uint32_t OUT>
+    void KeccakTimes4(const uint64_t* X, const uint8_t nSuffix, uint64_t* pOut)
+    {
+        uint64_t states[25 * 4];
+        memset(states, 0, sizeof(states));
+
+        /* Absorb the input, which is always a whole number of lanes. */
+        uint32_t nPosition = 0;
+        for(uint32_t k = 0; k < WORDS; ++k)
+        {
+            for(uint32_t i = 0; i < 4; ++i)
+                states[nPosition * 4 + i] ^= X[k * 4 + i];
+
+            if(++nPosition == KECCAK_RATE_LANES)
+            {
+                KeccakF1600_StatePermute_times4(states);
+                nPosition = 0;
+            }
+        }
+
+        /* Add the domain suffix and the last bit of the padding. */
+        for(uint32_t i = 0; i < 4; ++i)
+        {
+            states[nPosition * 4 + i]                 ^= nSuffix;
+            states[(KECCAK_RATE_LANES - 1) * 4 + i]  ^= uint64_t(0x80) << 56;
+        }
+
+        KeccakF1600_StatePermute_times4(states);
+
+        /* Squeeze the output. */
+        for(uint32_t k = 0; k < OUT; ++k)
+        {
+            if(k > 0 && k % KECCAK_RATE_LANES == 0)
+                KeccakF1600_StatePermute_times4(states);
+
+            for(uint32_t i = 0; i < 4; ++i)
+                pOut[k * 4 + i] = states[(k % KECCAK_RATE_LANES) * 4 + i];
+        }
+    }
+
+
+    /* Hash messages four at a time, with the shortest messages grouped together. */
+    template<uint32_t WORDS, typename HashType>
+    void SKTimes4(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<HashType> &vHashes,
+                  const u64b_t* pIV, const uint8_t nSuffix, HashType (*Scalar)(const uint8_t*, const uint64_t))
+    {
+        const uint32_t OUT = sizeof(HashType) / 8;
+
+        /* Sort by size so lanes in a group finish together. */
+        std::vector<uint32_t> vOrder(vData.size());
+        std::iota(vOrder.begin(), vOrder.end(), 0);
+        std::stable_sort(vOrder.begin(), vOrder.end(),
+            [&vData](const uint32_t a, const uint32_t b){ return vData[a].second < vData[b].second; });
+
+        uint64_t X[WORDS * 4];
+        uint64_t vOut[OUT * 4];
+        for(uint32_t n = 0; n < vOrder.size(); n += 4)
+        {
+            const uint32_t nLanes = std::min(uint32_t(4), uint32_t(vOrder.size() - n));
+
+            /* A lone message is faster on the scalar path. */
+            if(nLanes == 1)
+            {
+                const auto& data = vData[vOrder[n]];
+                vHashes[vOrder[n]] = Scalar(data.first, data.second);
+
+                continue;
+            }
+
+            std::pair<const uint8_t*, uint64_t> vGroup[4];
+            for(uint32_t i = 0; i < nLanes; ++i)
+                vGroup[i] = vData[vOrder[n + i]];
+
+            SkeinTimes4<WORDS>(vGroup, nLanes, pIV, X);
+            KeccakTimes4<WORDS, OUT>(X, nSuffix, vOut);
+
+            /* Write the hashes out as little endian bytes, as Keccak_HashFinal does. */
+            uint64_t vWords[OUT];
+            for(uint32_t i = 0; i < nLanes; ++i)
+            {
+                for(uint32_t k = 0; k < OUT; ++k)
+                    vWords[k] = vOut[k * 4 + i];
+
+                Skein_Put64_LSB_First((uint8_t *)&vHashes[vOrder[n + i]], vWords, sizeof(HashType));
+            }
+        }
+    }
+
+
+    /* Get the Skein-512 chaining value after the configuration block. */
+    const u64b_t* Skein512IV()
+    {
+        struct IV
+        {
+            u64b_t X[SKEIN_512_STATE_WORDS];
+
+            IV()
+            {
+                Skein_512_Ctxt_t ctx;
+                Skein_512_Init(&ctx, 512);
+                std::copy(ctx.X, ctx.X + SKEIN_512_STATE_WORDS, X);
+            }
+        };
+
+        static const IV iv;
+        return iv.X;
+    }
+
+
+    /* Get the Skein-1024 chaining value after the configuration block. */
+    const u64b_t* Skein1024IV()
+    {
+        struct IV
+        {
+            u64b_t X[SKEIN1024_STATE_WORDS];
+
+            IV()
+            {
+                Skein1024_Ctxt_t ctx;
+                Skein1024_Init(&ctx, 1024);
+                std::copy(ctx.X, ctx.X + SKEIN1024_STATE_WORDS, X);
+            }
+        };
+
+        static const IV iv;
+        return iv.X;
+    }
+
+#endif
+
+
+    /* 512-bit hashing of many messages at once. */
+    void SK512Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint512_t> &vHashes)
+    {
+        vHashes.resize(vData.size());
+
+    #ifdef SK_TIMES4_AVX2
+        if(SupportsAVX2())
+            return SKTimes4<SKEIN_512_STATE_WORDS, uint512_t>(vData, vHashes, Skein512IV(), 0x06, SK512Scalar);
+    #endif
+
+        for(uint32_t n = 0; n < vData.size(); ++n)
+            vHashes[n] = SK512Scalar(vData[n].first, vData[n].second);
+    }
+
+
+    /* 1024-bit hashing of many messages at once. */
+    void SK1024Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint1024_t> &vHashes)
+    {
+        vHashes.resize(vData.size());
+
+    #ifdef SK_TIMES4_AVX2
+        if(SupportsAVX2())
+            return SKTimes4<SKEIN1024_STATE_WORDS, uint1024_t>(vData, vHashes, Skein1024IV(), 0x05, SK1024Scalar);
+    #endif
+
+        for(uint32_t n = 0; n < vData.size(); ++n)
+            vHashes[n] = SK1024Scalar(vData[n].first, vData[n].second);
+    }
+
+
+    /* Returns the name of the backend selected for the batch functions on this CPU. */
+    std::string SKBatchBackend()
+    {
+        return SupportsAVX2() ? "avx2-times4" : "scalar";
+    }
+}
@@ -0,0 +1,274 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK/times4.h>
+
+#include <LLC/hash/SK/KeccakF-1600-round.h>
+#include <LLC/hash/SK/skein.h>
+
+#include <cstring>
+
+/* Rotate every 64-bit lane of a vector, or a scalar lane, left by a constant. */
+#define ROL(a, offset) (((a) << (int)(offset)) | ((a) >> (int)(64 - (offset))))
+
+/* Threefish MIX function on a pair of words. */
+#define MIX(a, b, rot) a += b; b = ROL(b, rot); b ^= a;
+
+
+/** Namespace LLC (Lower Level Crypto) **/
+namespace LLC
+{
+
+    /* Returns true if the kernels are built and the CPU and OS support AVX2. */
+    bool SupportsAVX2()
+    {
+    #ifdef SK_TIMES4_AVX2
+        /* __builtin_cpu_supports also checks that the OS saves the YMM registers. */
+        static const bool fSupported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return fSupported;
+    #else
+        return false;
+    #endif
+    }
+
+
+#ifdef SK_TIMES4_AVX2
+
+    /* One 64-bit word from each of four instances. */
+    typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+
+    /* Apply Keccak-f[1600] to four states. */
+    __attribute__((target("avx2")))
+    void KeccakF1600_StatePermute_times4(uint64_t* states)
+    {
+        v4u64 lanes[25];
+        memcpy(lanes, states, sizeof(lanes));
+
+        v4u64 A00 = lanes[ 0], A01 = lanes[ 1], A02 = lanes[ 2], A03 = lanes[ 3], A04 = lanes[ 4];
+        v4u64 A05 = lanes[ 5], A06 = lanes[ 6], A07 = lanes[ 7], A08 = lanes[ 8], A09 = lanes[ 9];
+        v4u64 A10 = lanes[10], A11 = lanes[11], A12 = lanes[12], A13 = lanes[13], A14 = lanes[14];
+        v4u64 A15 = lanes[15], A16 = lanes[16], A17 = lanes[17], A18 = lanes[18], A19 = lanes[19];
+        v4u64 A20 = lanes[20], A21 = lanes[21], A22 = lanes[22], A23 = lanes[23], A24 = lanes[24];
+
+        v4u64 B00, B01, B02, B03, B04, B05, B06, B07, B08, B09, B10, B11, B12;
+        v4u64 B13, B14, B15, B16, B17, B18, B19, B20, B21, B22, B23, B24;
+        v4u64 C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;
+
+        for(uint32_t nRound = 0; nRound < 24; ++nRound)
+        {
+            KeccakF1600_Round(A, B, C, D, KeccakF1600_RoundConstants[nRound])
+        }
+
+        lanes[ 0] = A00; lanes[ 1] = A01; lanes[ 2] = A02; lanes[ 3] = A03; lanes[ 4] = A04;
+        lanes[ 5] = A05; lanes[ 6] = A06; lanes[ 7] = A07; lanes[ 8] = A08; lanes[ 9] = A09;
+        lanes[10] = A10; lanes[11] = A11; lanes[12] = A12; lanes[13] = A13; lanes[14] = A14;
+        lanes[15] = A15; lanes[16] = A16; lanes[17] = A17; lanes[18] = A18; lanes[19] = A19;
+        lanes[20] = A20; lanes[21] = A21; lanes[22] = A22; lanes[23] = A23; lanes[24] = A24;
+
+        memcpy(states, lanes, sizeof(lanes));
+    }
+
+
+    /* Run one UBI block of Skein-512 on four chaining values. */
+    __attribute__((target("avx2")))
+    void Skein_512_Process_Block_times4(uint64_t* X, const uint64_t* w, const uint64_t* T)
+    {
+        /* Key schedule, repeated so that subkey s can be read from ks[s..s+8] without a modulus. */
+        v4u64 ks[9 + 18];
+        v4u64 ts[3 + 18];
+
+        memcpy(ks, X, sizeof(v4u64) * 8);
+        ks[8] = ks[0] ^ ks[1] ^ ks[2] ^ ks[3] ^ ks[4] ^ ks[5] ^ ks[6] ^ ks[7] ^ SKEIN_KS_PARITY;
+        for(uint32_t i = 9; i < 9 + 18; ++i)
+            ks[i] = ks[i - 9];
+
+        memcpy(ts, T, sizeof(v4u64) * 2);
+        ts[2] = ts[0] ^ ts[1];
+        for(uint32_t i = 3; i < 3 + 18; ++i)
+            ts[i] = ts[i - 3];
+
+        /* The message block, kept for the feed forward. */
+        v4u64 m[8];
+        memcpy(m, w, sizeof(m));
+
+        /* The first key injection. */
+        v4u64 X0 = m[0] + ks[0];
+        v4u64 X1 = m[1] + ks[1];
+        v4u64 X2 = m[2] + ks[2];
+        v4u64 X3 = m[3] + ks[3];
+        v4u64 X4 = m[4] + ks[4];
+        v4u64 X5 = m[5] + ks[5] + ts[0];
+        v4u64 X6 = m[6] + ks[6] + ts[1];
+        v4u64 X7 = m[7] + ks[7];
+
+    #define Round512(p0, p1, p2, p3, p4, p5, p6, p7, ROT) \
+        MIX(X##p0, X##p1, ROT##_0)                        \
+        MIX(X##p2, X##p3, ROT##_1)                        \
+        MIX(X##p4, X##p5, ROT##_2)                        \
+        MIX(X##p6, X##p7, ROT##_3)
+
+    #define Inject512(s)                                  \
+        X0 += ks[(s) + 0];                                \
+        X1 += ks[(s) + 1];                                \
+        X2 += ks[(s) + 2];                                \
+        X3 += ks[(s) + 3];                                \
+        X4 += ks[(s) + 4];                                \
+        X5 += ks[(s) + 5] + ts[(s)];                      \
+        X6 += ks[(s) + 6] + ts[(s) + 1];                  \
+        X7 += ks[(s) + 7] + (uint64_t)(s);
+
+        /* 72 rounds, with a key injection every four. */
+        for(uint32_t s = 1; s < 2 * (SKEIN_512_ROUNDS_TOTAL / 8); s += 2)
+        {
+            Round512(0, 1, 2, 3, 4, 5, 6, 7, R_512_0)
+            Round512(2, 1, 4, 7, 6, 5, 0, 3, R_512_1)
+            Round512(4, 1, 6, 3, 0, 5, 2, 7, R_512_2)
+            Round512(6, 1, 0, 7, 2, 5, 4, 3, R_512_3)
+            Inject512(s)
+
+            Round512(0, 1, 2, 3, 4, 5, 6, 7, R_512_4)
+            Round512(2, 1, 4, 7, 6, 5, 0, 3, R_512_5)
+            Round512(4, 1, 6, 3, 0, 5, 2, 7, R_512_6)
+            Round512(6, 1, 0, 7, 2, 5, 4, 3, R_512_7)
+            Inject512(s + 1)
+        }
+
+    #undef Round512
+    #undef Inject512
+
+        /* The feed forward gives the new chaining values. */
+        m[0] ^= X0;
+        m[1] ^= X1;
+        m[2] ^= X2;
+        m[3] ^= X3;
+        m[4] ^= X4;
+        m[5] ^= X5;
+        m[6] ^= X6;
+        m[7] ^= X7;
+
+        memcpy(X, m, sizeof(m));
+    }
+
+
+    /* Run one UBI block of Skein-1024 on four chaining values. */
+    __attribute__((target("avx2")))
+    void Skein1024_Process_Block_times4(uint64_t* X, const uint64_t* w, const uint64_t* T)
+    {
+        /* Key schedule, repeated so that subkey s can be read from ks[s..s+16] without a modulus. */
+        v4u64 ks[17 + 20];
+        v4u64 ts[3 + 20];
+
+        memcpy(ks, X, sizeof(v4u64) * 16);
+        ks[16] = ks[ 0] ^ ks[ 1] ^ ks[ 2] ^ ks[ 3] ^ ks[ 4] ^ ks[ 5] ^ ks[ 6] ^ ks[ 7] ^
+                 ks[ 8] ^ ks[ 9] ^ ks[10] ^ ks[11] ^ ks[12] ^ ks[13] ^ ks[14] ^ ks[15] ^ SKEIN_KS_PARITY;
+        for(uint32_t i = 17; i < 17 + 20; ++i)
+            ks[i] = ks[i - 17];
+
+        memcpy(ts, T, sizeof(v4u64) * 2);
+        ts[2] = ts[0] ^ ts[1];
+        for(uint32_t i = 3; i < 3 + 20; ++i)
+            ts[i] = ts[i - 3];
+
+        /* The message block, kept for the feed forward. */
+        v4u64 m[16];
+        memcpy(m, w, sizeof(m));
+
+        /* The first key injection. */
+        v4u64 X00 = m[ 0] + ks[ 0];
+        v4u64 X01 = m[ 1] + ks[ 1];
+        v4u64 X02 = m[ 2] + ks[ 2];
+        v4u64 X03 = m[ 3] + ks[ 3];
+        v4u64 X04 = m[ 4] + ks[ 4];
+        v4u64 X05 = m[ 5] + ks[ 5];
+        v4u64 X06 = m[ 6] + ks[ 6];
+        v4u64 X07 = m[ 7] + ks[ 7];
+        v4u64 X08 = m[ 8] + ks[ 8];
+        v4u64 X09 = m[ 9] + ks[ 9];
+        v4u64 X10 = m[10] + ks[10];
+        v4u64 X11 = m[11] + ks[11];
+        v4u64 X12 = m[12] + ks[12];
+        v4u64 X13 = m[13] + ks[13] + ts[0];
+        v4u64 X14 = m[14] + ks[14] + ts[1];
+        v4u64 X15 = m[15] + ks[15];
+
+    #define Round1024(p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, pA, pB, pC, pD, pE, pF, ROT) \
+        MIX(X##p0, X##p1, ROT##_0)                                                        \
+        MIX(X##p2, X##p3, ROT##_1)                                                        \
+        MIX(X##p4, X##p5, ROT##_2)                                                        \
+        MIX(X##p6, X##p7, ROT##_3)                                                        \
+        MIX(X##p8, X##p9, ROT##_4)                                                        \
+        MIX(X##pA, X##pB, ROT##_5)                                                        \
+        MIX(X##pC, X##pD, ROT##_6)                                                        \
+        MIX(X##pE, X##pF, ROT##_7)
+
+    #define Inject1024(s)                                 \
+        X00 += ks[(s) +  0];                              \
+        X01 += ks[(s) +  1];                              \
+        X02 += ks[(s) +  2];                              \
+        X03 += ks[(s) +  3];                              \
+        X04 += ks[(s) +  4];                              \
+        X05 += ks[(s) +  5];                              \
+        X06 += ks[(s) +  6];                              \
+        X07 += ks[(s) +  7];                              \
+        X08 += ks[(s) +  8];                              \
+        X09 += ks[(s) +  9];                              \
+        X10 += ks[(s) + 10];                              \
+        X11 += ks[(s) + 11];                              \
+        X12 += ks[(s) + 12];                              \
+        X13 += ks[(s) + 13] + ts[(s)];                    \
+        X14 += ks[(s) + 14] + ts[(s) + 1];                \
+        X15 += ks[(s) + 15] + (uint64_t)(s);
+
+        /* 80 rounds, with a key injection every four. */
+        for(uint32_t s = 1; s < 2 * (SKEIN1024_ROUNDS_TOTAL / 8); s += 2)
+        {
+            Round1024(00, 01, 02, 03, 04, 05, 06, 07, 08, 09, 10, 11, 12, 13, 14, 15, R1024_0)
+            Round1024(00, 09, 02, 13, 06, 11, 04, 15, 10, 07, 12, 03, 14, 05, 08, 01, R1024_1)
+            Round1024(00, 07, 02, 05, 04, 03, 06, 01, 12, 15, 14, 13, 08, 11, 10, 09, R1024_2)
+            Round1024(00, 15, 02, 11, 06, 13, 04, 09, 14, 01, 08, 05, 10, 03, 12, 07, R1024_3)
+            Inject1024(s)
+
+            Round1024(00, 01, 02, 03, 04, 05, 06, 07, 08, 09, 10, 11, 12, 13, 14, 15, R1024_4)
+            Round1024(00, 09, 02, 13, 06, 11, 04, 15, 10, 07, 12, 03, 14, 05, 08, 01, R1024_5)
+            Round1024(00, 07, 02, 05, 04, 03, 06, 01, 12, 15, 14, 13, 08, 11, 10, 09, R1024_6)
+            Round1024(00, 15, 02, 11, 06, 13, 04, 09, 14, 01, 08, 05, 10, 03, 12, 07, R1024_7)
+            Inject1024(s + 1)
+        }
+
+    #undef Round1024
+    #undef Inject1024
+
+        /* The feed forward gives the new chaining values. */
+        m[ 0] ^= X00;
+        m[ 1] ^= X01;
+        m[ 2] ^= X02;
+        m[ 3] ^= X03;
+        m[ 4] ^= X04;
+        m[ 5] ^= X05;
+        m[ 6] ^= X06;
+        m[ 7] ^= X07;
+        m[ 8] ^= X08;
+        m[ 9] ^= X09;
+        m[10] ^= X10;
+        m[11] ^= X11;
+        m[12] ^= X12;
+        m[13] ^= X13;
+        m[14] ^= X14;
+        m[15] ^= X15;
+
+        memcpy(X, m, sizeof(m));
+    }
+
+#endif
+}
@@ -0,0 +1,81 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLC_HASH_SK_TIMES4_H
+#define NEXUS_LLC_HASH_SK_TIMES4_H
+
+#include <cstdint>
+
+/* The multi-buffer kernels need GCC vector extensions and are only built for x86-64. */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SK_TIMES4_AVX2
+#endif
+
+/** Namespace LLC (Lower Level Crypto) **/
+namespace LLC
+{
+
+    /** Multi-buffer kernels
+     *
+     *  These process four independent states at once, one per 64-bit lane of an AVX2 register.
+     *  All arrays are interleaved: word w of instance i is stored at index 4 * w + i.
+     *  They must only be called when SupportsAVX2() returns true.
+     *
+     **/
+
+
+    /** SupportsAVX2
+     *
+     *  Returns true if the kernels are built and the CPU and OS support AVX2.
+     *
+     **/
+    bool SupportsAVX2();
+
+
+    /** KeccakF1600_StatePermute_times4
+     *
+     *  Apply Keccak-f[1600] to four states.
+     *
+     *  @param[in,out] states The 25 lanes of each state, interleaved.
+     *
+     **/
+    void KeccakF1600_StatePermute_times4(uint64_t* states);
+
+
+    /** Skein_512_Process_Block_times4
+     *
+     *  Run one UBI block of Skein-512 on four chaining values.
+     *
+     *  @param[in,out] X The 8 chaining words of each instance, interleaved.
+     *  @param[in] w The 8 message words of each instance, interleaved.
+     *  @param[in] T The 2 tweak words of each instance, interleaved.
+     *
+     **/
+    void Skein_512_Process_Block_times4(uint64_t* X, const uint64_t* w, const uint64_t* T);
+
+
+    /** Skein1024_Process_Block_times4
+     *
+     *  Run one UBI block of Skein-1024 on four chaining values.
+     *
+     *  @param[in,out] X The 16 chaining words of each instance, interleaved.
+     *  @param[in] w The 16 message words of each instance, interleaved.
+     *  @param[in] T The 2 tweak words of each instance, interleaved.
+     *
+     **/
+    void Skein1024_Process_Block_times4(uint64_t* X, const uint64_t* w, const uint64_t* T);
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLC_INCLUDE_FLVERIFIER_H
+#define NEXUS_LLC_INCLUDE_FLVERIFIER_H
+
+#include <vector>
+
+#include <LLC/types/uint1024.h>
+
+#include <LLD/cache/template_lru.h>
+
+namespace LLC
+{
+
+    /** The largest falcon degree accepted for signatures, as accepted by FLKey::Verify before the verifier. **/
+    const uint32_t MAX_LOGN = 9;
+
+
+    /** FLVerifier
+     *
+     *  Verifies FALCON signatures against public keys that have already been
+     *  decoded and converted into NTT form. Sigchains re-use the same key for
+     *  many transactions and producers sign every block, so the expanded keys
+     *  are held in a bounded LRU cache indexed by the SK256 hash of the key.
+     *
+     **/
+    class FLVerifier
+    {
+        /** Expanded public keys indexed by hash of their encoding. **/
+        LLD::TemplateLRU<uint256_t, std::vector<uint16_t>> cacheKeys;
+
+    public:
+
+        /** Default Constructor. **/
+        FLVerifier()                                     = delete;
+
+
+        /** Copy Constructor. **/
+        FLVerifier(const FLVerifier& verifier)           = delete;
+
+
+        /** Move Constructor. **/
+        FLVerifier(FLVerifier&& verifier)                = delete;
+
+
+        /** Copy assignment. **/
+        FLVerifier& operator=(const FLVerifier& verifier) = delete;
+
+
+        /** Move assignment. **/
+        FLVerifier& operator=(FLVerifier&& verifier)      = delete;
+
+
+        /** Total Elements Constructor
+         *
+         *  @param[in] nElements The maximum number of expanded keys to keep.
+         *
+         **/
+        FLVerifier(const uint32_t nElements);
+
+
+        /** Verify
+         *
+         *  Signature Verification Function, equivalent to FLKey::Verify but
+         *  expanding the public key only once for as long as it is cached.
+         *
+         *  @param[in] vchPubKey The encoded public key to verify against.
+         *  @param[in] vchData The input data that was signed in bytes.
+         *  @param[in] vchSig The signature to check.
+         *
+         *  @return True if the Signature was Verified as Valid
+         *
+         **/
+        bool Verify(const std::vector<uint8_t>& vchPubKey,
+                    const std::vector<uint8_t>& vchData, const std::vector<uint8_t>& vchSig);
+
+    };
+
+
+    /* Shared verifier used by FLKey::Verify. */
+    extern FLVerifier flVerifier;
+}
+
+#endif
@@ -10,6 +10,13 @@
             "ad vocem populi" - To the Voice of the People
 
 ____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLC_PRIME_FERMAT_H
+#define NEXUS_LLC_PRIME_FERMAT_H
+
+#include <LLC/types/uint1024.h>
+
 #include <cstdint>
 
 
@@ -65,14 +72,15 @@ inline uint32_t cmp_ge_n(uint32_t *x, uint32_t *y)
 template<uint8_t WORD_MAX>
 inline uint8_t sub_n(uint32_t *z, uint32_t *x, uint32_t *y)
 {
-    uint32_t temp;
+    uint64_t temp;
     uint8_t c = 0;
 
     //#pragma unroll
     for(uint8_t i = 0; i < WORD_MAX; ++i)
     {
-        temp = x[i] - y[i] - c;
-        c = (temp > x[i]);
+        /* Borrow is taken from the wide difference, (temp > x[i]) misses it when y[i] is all ones. */
+        temp = static_cast<uint64_t>(x[i]) - y[i] - c;
+        c = (temp >> 32) & 1;
         z[i] = temp;
     }
     return c;
@@ -99,19 +107,19 @@ inline void sub_ui(uint32_t *z, uint32_t *x, const uint32_t &ui)
 template<uint8_t WORD_MAX>
 inline void add_ui(uint32_t *z, uint32_t *x, const uint64_t &ui)
 {
-    uint32_t temp = x[0] + static_cast<uint32_t>(ui & 0xFFFFFFFF);
-    uint8_t c = temp < x[0];
+    uint64_t temp = static_cast<uint64_t>(x[0]) + (ui & 0xFFFFFFFF);
+    uint8_t c = temp >> 32;
     z[0] = temp;
 
-    temp = x[1] + static_cast<uint32_t>(ui >> 32) + c;
-    c = temp < x[1];
+    temp = static_cast<uint64_t>(x[1]) + (ui >> 32) + c;
+    c = temp >> 32;
     z[1] = temp;
 
     //#pragma unroll
     for(uint8_t i = 2; i < WORD_MAX; ++i)
     {
-        temp = x[i] + c;
-        c = (temp < x[i]);
+        temp = static_cast<uint64_t>(x[i]) + c;
+        c = temp >> 32;
         z[i] = temp;
     }
 }
@@ -138,20 +146,22 @@ inline uint32_t addmul_1(uint32_t *z, uint32_t *x, const uint32_t y)
 
 
 
+/* Montgomery squaring: z = x * x * R^-1 mod n. Scratch t needs (WORD_MAX << 1) + 1 words. */
 template<uint8_t WORD_MAX>
 inline void sqrredc(uint32_t *z, uint32_t *x, uint32_t *n, const uint32_t d, uint32_t *t)
 {
     uint64_t prod;
     uint32_t m;
-    uint32_t c;
+    uint32_t c = 0;
 
     uint8_t i;
     uint8_t j;
 
-    for(i = 0; i < (WORD_MAX<<1); ++i)
+    for(i = 0; i <= (WORD_MAX<<1); ++i)
         t[i] = 0;
 
 
+    /* Cross products x[i] * x[j] for i < j. */
     for(i = 0; i < WORD_MAX; ++i)
     {
         for(j = i + 1; j < WORD_MAX; ++j)
@@ -167,6 +177,7 @@ inline void sqrredc(uint32_t *z, uint32_t *x, uint32_t *n, const uint32_t d, uin
     }
 
 
+    /* Double the cross products. */
     for(i = 0; i < (WORD_MAX<<1); ++i)
     {
         prod = (static_cast<uint64_t>(t[i]) << 1) + c;
@@ -175,28 +186,24 @@ inline void sqrredc(uint32_t *z, uint32_t *x, uint32_t *n, const uint32_t d, uin
     }
 
 
+    /* Add the squares along the diagonal with full carry propagation. */
+    c = 0;
     for(i = 0; i < WORD_MAX; ++i)
     {
         prod = static_cast<uint64_t>(x[i]) * static_cast<uint64_t>(x[i]) +
-               static_cast<uint64_t>(t[i + i]);
+               static_cast<uint64_t>(t[i + i]) + c;
 
         t[i + i] = prod;
         c = prod >> 32;
 
-        for(j = i + 1; j < WORD_MAX; ++j)
-        {
-            prod = static_cast<uint64_t>(t[i + j]) + c;
-            t[i + j] = prod;
-            c = prod >> 32;
-        }
-
-        t[WORD_MAX + i] += c;
-
+        prod = static_cast<uint64_t>(t[i + i + 1]) + c;
+        t[i + i + 1] = prod;
+        c = prod >> 32;
     }
 
 
+    /* Reduce the double width product, carries may spill into t[WORD_MAX << 1]. */
     c = 0;
-
     for(i = 0; i < WORD_MAX; ++i)
     {
         m = t[i] * d;
@@ -220,18 +227,19 @@ inline void sqrredc(uint32_t *z, uint32_t *x, uint32_t *n, const uint32_t d, uin
     }
 
 
-    if(cmp_ge_n<WORD_MAX>(&t[WORD_MAX], n))
+    /* Result is below 2n, so a single subtraction normalizes it (the spill word wraps away). */
+    if(t[WORD_MAX<<1] || cmp_ge_n<WORD_MAX>(&t[WORD_MAX], n))
         sub_n<WORD_MAX>(z, &t[WORD_MAX], n);
     else
         assign<WORD_MAX>(z, &t[WORD_MAX]);
 }
 
 
+/* Montgomery multiplication: z = x * y * R^-1 mod n. Scratch t needs WORD_MAX + 2 words. */
 template<uint8_t WORD_MAX>
 inline void mulredc(uint32_t *z, uint32_t *x, uint32_t *y, uint32_t *n, const uint32_t d, uint32_t *t)
 {
-    //uint32_t m;//, c;
-    //uint64_t temp;
+    uint64_t temp;
 
     assign_zero<WORD_MAX>(t);
     t[WORD_MAX] = 0;
@@ -239,28 +247,23 @@ inline void mulredc(uint32_t *z, uint32_t *x, uint32_t *y, uint32_t *n, const ui
 
     for(uint8_t i = 0; i < WORD_MAX; ++i)
     {
-        //c = addmul_1(t, x, y[i]);
-        t[WORD_MAX] += addmul_1<WORD_MAX>(t, x, y[i]);
-        //temp = static_cast<uint64_t>(t[WORD_MAX]) + c;
-        //t[WORD_MAX] = temp;
-        //t[WORD_MAX] += c;
-        //t[WORD_MAX + 1] = temp >> 32;
-
-        //m = t[0]*d;
+        /* Keep the carry out of the top word, t can reach 2n which needs one extra bit at full width. */
+        temp = static_cast<uint64_t>(t[WORD_MAX]) + addmul_1<WORD_MAX>(t, x, y[i]);
+        t[WORD_MAX]    = temp;
+        t[WORD_MAX+1]  = temp >> 32;
 
-        //c = addmul_1(t, n, m);
-        //t[WORD_MAX] += addmul_1<WORD_MAX>(t, n, m);
-        t[WORD_MAX] += addmul_1<WORD_MAX>(t, n, t[0]*d);
-        //temp = static_cast<uint64_t>(t[WORD_MAX]) + c;
-        //t[WORD_MAX] = temp;
-        //t[WORD_MAX] += c;
-        //t[WORD_MAX + 1] = temp >> 32;
+        temp = static_cast<uint64_t>(t[WORD_MAX]) + addmul_1<WORD_MAX>(t, n, t[0]*d);
+        t[WORD_MAX]    = temp;
+        t[WORD_MAX+1] += temp >> 32;
 
         //#pragma unroll
         for(uint8_t j = 0; j <= WORD_MAX; ++j)
             t[j] = t[j+1];
+
+        t[WORD_MAX+1] = 0;
     }
-    if(cmp_ge_n<WORD_MAX>(t, n))
+
+    if(t[WORD_MAX] || cmp_ge_n<WORD_MAX>(t, n))
         sub_n<WORD_MAX>(t, t, n);
 
     //#pragma unroll
@@ -304,7 +307,7 @@ uint16_t bit_count(uint32_t *x)
     //#pragma unroll
     for(uint16_t i = 0; i < (WORD_MAX << 5); ++i)
     {
-        if(x[i>>5] & (1 << (i & 31)))
+        if(x[i>>5] & (1u << (i & 31)))
             msb = i;
     }
 
@@ -401,8 +404,9 @@ void calcBar(uint32_t *a, uint32_t *b, uint32_t *n, uint32_t *t)
             sub_n<WORD_MAX>(a, a, t);
     }
 
+    uint32_t c = a[WORD_MAX-1] >> 31;
     lshift1<WORD_MAX>(b, a);     //calculate 2R mod N;
-    if(cmp_ge_n<WORD_MAX>(b, n))
+    if(c || cmp_ge_n<WORD_MAX>(b, n))
         sub_n<WORD_MAX>(b, b, n);
 }
 
@@ -430,8 +434,10 @@ template<uint8_t WORD_MAX>
 void calcTable(uint32_t *a, uint32_t *n, uint32_t *t, uint32_t *table)
 {
 
+    /* Doubling can carry out of the top word when n uses the full width. */
+    uint32_t c = a[WORD_MAX-1] >> 31;
     lshift1<WORD_MAX>(t, a);     //calculate 2R mod N;
-    if(cmp_ge_n<WORD_MAX>(t, n))
+    if(c || cmp_ge_n<WORD_MAX>(t, n))
         sub_n<WORD_MAX>(t, t, n);
 
     assign<WORD_MAX>(&table[WORD_MAX], t);
@@ -439,8 +445,9 @@ void calcTable(uint32_t *a, uint32_t *n, uint32_t *t, uint32_t *table)
 
     for(uint16_t i = 2; i < WINDOW_SIZE; ++i) //calculate 2^i R mod N
     {
+        c = t[WORD_MAX-1] >> 31;
         lshift1<WORD_MAX>(t, t);
-        if(cmp_ge_n<WORD_MAX>(t, n))
+        if(c || cmp_ge_n<WORD_MAX>(t, n))
             sub_n<WORD_MAX>(t, t, n);
 
         assign<WORD_MAX>(&table[i * WORD_MAX], t);
@@ -452,7 +459,7 @@ void calcTable(uint32_t *a, uint32_t *n, uint32_t *t, uint32_t *table)
 template<uint8_t WORD_MAX>
 void pow2m(uint32_t *X, uint32_t *Exp, uint32_t *N, uint32_t *table)
 {
-    uint32_t t[WORD_MAX << 1];
+    uint32_t t[(WORD_MAX << 1) + 1];
     uint32_t wval = 0;
     uint32_t d = inv2adic(N[0]);
 
@@ -474,7 +481,7 @@ void pow2m(uint32_t *X, uint32_t *Exp, uint32_t *N, uint32_t *table)
 
         wval <<= 1;
 
-        if(Exp[i>>5] & (1 << (i & 31)))
+        if(Exp[i>>5] & (1u << (i & 31)))
             wval |= 1;
 
         if(((i % WINDOW_BITS) == 0) && wval)
@@ -507,7 +514,7 @@ void pow2m(uint32_t *X, uint32_t *Exp, uint32_t *N)
         //mulredc<WORD_MAX>(X, X, X, N, d, t);
         sqrredc<WORD_MAX>(X, X, N, d, t);
 
-        if(Exp[i>>5] & (1 << (i & 31)))
+        if(Exp[i>>5] & (1u << (i & 31)))
             mulredc<WORD_MAX>(X, X, A, N, d, t);
     }
 
@@ -521,7 +528,7 @@ bool fermat_prime(uint32_t *p)
 {
     uint32_t e[WORD_MAX];
     uint32_t r[WORD_MAX];
-    uint32_t table[WINDOW_SIZE * 32];
+    uint32_t table[WINDOW_SIZE * WORD_MAX];
 
     sub_ui<WORD_MAX>(e, p, 1);
     pow2m<WORD_MAX>(r, e, p, table);
@@ -542,10 +549,286 @@ bool fermat_prime(uint32_t *p)
 }
 
 
-/* Test if number p passes Fermat Primality Test base 2. */
-uint1024_t fermat_prime(const uint1024_t &p)
+#if defined(__SIZEOF_INT128__)
+
+/* 64-bit limb kernel. Base 2 lets every multiply step of the ladder be a modular
+ * doubling, so the only Montgomery operation left is the squaring. */
+
+
+/* Double limb for products and carries. __extension__ keeps -pedantic quiet about the type. */
+__extension__ typedef unsigned __int128 limb128_t;
+
+
+inline uint64_t inv2adic64(uint64_t x)
+{
+    uint64_t a = x;
+
+    /* x * x = 1 mod 8 for odd x, each Newton step doubles the precision. */
+    for(uint8_t i = 0; i < 5; ++i)
+        x *= 2 - a * x;
+
+    return -x;
+}
+
+
+template<uint8_t LIMBS>
+inline bool cmp_ge_n64(const uint64_t *x, const uint64_t *y)
+{
+    for(int8_t i = LIMBS - 1; i >= 0; --i)
+    {
+        if(x[i] > y[i])
+            return true;
+
+        if(x[i] < y[i])
+            return false;
+    }
+    return true;
+}
+
+
+template<uint8_t LIMBS>
+inline void sub_n64(uint64_t *z, const uint64_t *x, const uint64_t *y)
+{
+    limb128_t temp;
+    uint64_t c = 0;
+
+    for(uint8_t i = 0; i < LIMBS; ++i)
+    {
+        temp = static_cast<limb128_t>(x[i]) - y[i] - c;
+        z[i] = static_cast<uint64_t>(temp);
+        c = static_cast<uint64_t>(temp >> 64) & 1;
+    }
+}
+
+
+/* Modular doubling: x = 2x mod n, for x < n. */
+template<uint8_t LIMBS>
+inline void dblmod64(uint64_t *x, const uint64_t *n)
+{
+    uint64_t c = x[LIMBS - 1] >> 63;
+
+    for(uint8_t i = LIMBS - 1; i > 0; --i)
+        x[i] = (x[i] << 1) | (x[i - 1] >> 63);
+
+    x[0] <<= 1;
+
+    if(c || cmp_ge_n64<LIMBS>(x, n))
+        sub_n64<LIMBS>(x, x, n);
+}
+
+
+/* Montgomery squaring: z = x * x * R^-1 mod n, for x < n and any odd n below R. */
+template<uint8_t LIMBS>
+inline void sqrredc64(uint64_t *z, const uint64_t *x, const uint64_t *n, const uint64_t d)
+{
+    uint64_t t[(LIMBS << 1) + 1];
+    limb128_t prod;
+    uint64_t c;
+
+    for(uint8_t i = 0; i <= (LIMBS << 1); ++i)
+        t[i] = 0;
+
+    /* Cross products x[i] * x[j] for i < j. */
+    for(uint8_t i = 0; i < LIMBS; ++i)
+    {
+        c = 0;
+        for(uint8_t j = i + 1; j < LIMBS; ++j)
+        {
+            prod = static_cast<limb128_t>(x[i]) * x[j] + t[i + j] + c;
+            t[i + j] = static_cast<uint64_t>(prod);
+            c = static_cast<uint64_t>(prod >> 64);
+        }
+        t[i + LIMBS] = c;
+    }
+
+    /* Double the cross products. */
+    c = 0;
+    for(uint8_t i = 0; i < (LIMBS << 1); ++i)
+    {
+        uint64_t v = t[i];
+        t[i] = (v << 1) | c;
+        c = v >> 63;
+    }
+
+    /* Add the squares along the diagonal. */
+    c = 0;
+    for(uint8_t i = 0; i < LIMBS; ++i)
+    {
+        prod = static_cast<limb128_t>(x[i]) * x[i] + t[i + i] + c;
+        t[i + i] = static_cast<uint64_t>(prod);
+        c = static_cast<uint64_t>(prod >> 64);
+
+        prod = static_cast<limb128_t>(t[i + i + 1]) + c;
+        t[i + i + 1] = static_cast<uint64_t>(prod);
+        c = static_cast<uint64_t>(prod >> 64);
+    }
+
+    /* Reduce one limb at a time. The carry out of each row is delayed into the next
+     * row's top limb, so there is no carry propagation loop. */
+    uint64_t cc = 0;
+    for(uint8_t i = 0; i < LIMBS; ++i)
+    {
+        uint64_t m = t[i] * d;
+
+        c = 0;
+        for(uint8_t j = 0; j < LIMBS; ++j)
+        {
+            prod = static_cast<limb128_t>(m) * n[j] + t[i + j] + c;
+            t[i + j] = static_cast<uint64_t>(prod);
+            c = static_cast<uint64_t>(prod >> 64);
+        }
+
+        prod = static_cast<limb128_t>(t[i + LIMBS]) + c + cc;
+        t[i + LIMBS] = static_cast<uint64_t>(prod);
+        cc = static_cast<uint64_t>(prod >> 64);
+    }
+    t[LIMBS << 1] = cc;
+
+    /* Result is below 2n, so a single subtraction normalizes it. */
+    if(t[LIMBS << 1] || cmp_ge_n64<LIMBS>(&t[LIMBS], n))
+        sub_n64<LIMBS>(z, &t[LIMBS], n);
+    else
+    {
+        for(uint8_t i = 0; i < LIMBS; ++i)
+            z[i] = t[LIMBS + i];
+    }
+}
+
+
+/* Montgomery reduction out of the residue domain: z = x * R^-1 mod n. */
+template<uint8_t LIMBS>
+inline void redc64(uint64_t *z, const uint64_t *x, const uint64_t *n, const uint64_t d)
+{
+    uint64_t t[LIMBS + 1];
+    limb128_t prod;
+
+    for(uint8_t i = 0; i < LIMBS; ++i)
+        t[i] = x[i];
+
+    t[LIMBS] = 0;
+
+    for(uint8_t i = 0; i < LIMBS; ++i)
+    {
+        uint64_t m = t[0] * d;
+        uint64_t c = 0;
+
+        for(uint8_t j = 0; j < LIMBS; ++j)
+        {
+            prod = static_cast<limb128_t>(m) * n[j] + t[j] + c;
+            t[j] = static_cast<uint64_t>(prod);
+            c = static_cast<uint64_t>(prod >> 64);
+        }
+
+        /* Low limb is now zero, shift down one limb. */
+        prod = static_cast<limb128_t>(t[LIMBS]) + c;
+        for(uint8_t j = 0; j < LIMBS - 1; ++j)
+            t[j] = t[j + 1];
+
+        t[LIMBS - 1] = static_cast<uint64_t>(prod);
+        t[LIMBS]     = static_cast<uint64_t>(prod >> 64);
+    }
+
+    if(t[LIMBS] || cmp_ge_n64<LIMBS>(t, n))
+        sub_n64<LIMBS>(z, t, n);
+    else
+    {
+        for(uint8_t i = 0; i < LIMBS; ++i)
+            z[i] = t[i];
+    }
+}
+
+
+/* Calculate X = 2^(N-1) mod N with a square and double ladder. N must be odd and greater than one. */
+template<uint8_t LIMBS>
+void pow2m64(uint64_t *X, const uint64_t *N)
+{
+    const uint64_t d = inv2adic64(N[0]);
+
+    /* Exponent is N - 1, which only clears the low bit of an odd N. */
+    uint64_t E[LIMBS];
+    for(uint8_t i = 0; i < LIMBS; ++i)
+        E[i] = N[i];
+
+    E[0] &= ~uint64_t(1);
+
+    /* Find the top bit of N. */
+    int16_t nTop = (LIMBS << 6) - 1;
+    while(nTop > 0 && !(N[nTop >> 6] & (uint64_t(1) << (nTop & 63))))
+        --nTop;
+
+    /* X = R mod N by shift and subtract long division (Montgomery form of 1). */
+    uint64_t T[LIMBS];
+    for(uint8_t i = 0; i < LIMBS; ++i)
+        X[i] = 0;
+
+    {
+        uint16_t nShift = ((LIMBS << 6) - 1) - nTop;
+        for(uint8_t i = 0; i < LIMBS; ++i)
+        {
+            uint16_t k = nShift >> 6, s = nShift & 63;
+            T[i] = 0;
+            if(i >= k)
+                T[i] = N[i - k] << s;
+            if(s != 0 && i > k)
+                T[i] |= N[i - k - 1] >> (64 - s);
+        }
+
+        /* X = R - T, then reduce modulo N. */
+        sub_n64<LIMBS>(X, X, T);
+        while(cmp_ge_n64<LIMBS>(X, N))
+        {
+            for(uint8_t i = 0; i < LIMBS - 1; ++i)
+                T[i] = (T[i] >> 1) | (T[i + 1] << 63);
+
+            T[LIMBS - 1] >>= 1;
+
+            if(cmp_ge_n64<LIMBS>(X, T))
+                sub_n64<LIMBS>(X, X, T);
+        }
+    }
+
+    /* Left to right over the exponent bits, the leading bit only doubles. */
+    for(int16_t i = nTop; i >= 0; --i)
+    {
+        if(i != nTop)
+            sqrredc64<LIMBS>(X, X, N, d);
+
+        if(E[i >> 6] & (uint64_t(1) << (i & 63)))
+            dblmod64<LIMBS>(X, N);
+    }
+
+    redc64<LIMBS>(X, X, N, d);
+}
+
+#endif
+
+
+/* Calculate the base 2 Fermat remainder of p, which must be odd. */
+inline uint1024_t fermat_prime(const uint1024_t &p)
 {
     uint1024_t r;
+
+#if defined(__SIZEOF_INT128__)
+
+    /* Pack into 64-bit limbs through get() so the limb order is independent of endianness. */
+    uint64_t pp[16];
+    uint64_t rr[16];
+    for(uint8_t i = 0; i < 16; ++i)
+        pp[i] = (static_cast<uint64_t>(p.get((i << 1) + 1)) << 32) | p.get(i << 1);
+
+    pow2m64<16>(rr, pp);
+
+    std::vector<uint32_t> vWords(32);
+    for(uint8_t i = 0; i < 16; ++i)
+    {
+        vWords[(i << 1)]     = static_cast<uint32_t>(rr[i]);
+        vWords[(i << 1) + 1] = static_cast<uint32_t>(rr[i] >> 32);
+    }
+
+    r.set(vWords);
+
+#else
+
     uint32_t e[32];
     uint32_t table[WINDOW_SIZE * 32];
 
@@ -556,5 +839,9 @@ uint1024_t fermat_prime(const uint1024_t &p)
     pow2m<32>(rr, e, pp, table);
     //pow2m<32>(rr, e, pp);
 
+#endif
+
     return r;
 }
+
+#endif
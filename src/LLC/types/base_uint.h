@@ -44,10 +44,11 @@ class base_uint
 
 protected:
 
-    /* Determine the width in number of words. */
-    enum { WIDTH=BITS/32 };
+    /* Determine the width in number of words, and in 64-bit limbs for arithmetic. */
+    enum { WIDTH=BITS/32, LIMBS=(WIDTH+1)/2 };
 
-    /* The 32-bit integer bignum array. */
+    /* The 32-bit integer bignum array. Arithmetic works on pairs of words as 64-bit limbs,
+     * keeping this layout so serialization and the byte order of the words don't change. */
     uint32_t pn[WIDTH];
 
 
@@ -838,8 +839,12 @@ namespace std
     {
         size_t operator()(const base_uint<BITS>& val) const
         {
-            /* Base the hash function on the string representation, which is the number converted to hex */
-            return hash<std::string>()(val.ToString());
+            /* Fold the words together with an FNV style multiply, instead of hashing the hex string. */
+            uint64_t nHash = 0xcbf29ce484222325ull;
+            for(uint32_t i = 0; i < BITS / 32; ++i)
+                nHash = (nHash ^ val.get(i)) * 0x100000001b3ull;
+
+            return static_cast<size_t>(nHash ^ (nHash >> 32));
         }
     };
 }
@@ -18,6 +18,8 @@ ________________________________________________________________________________
 #include <Util/include/debug.h>
 #include <Util/include/hex.h>
 
+#include <unordered_map>
+
 namespace LLD
 {
     /*  Node to hold the binary data of the double linked list. */
@@ -35,12 +37,16 @@ namespace LLD
         /** The data in the binary node. **/
         std::vector<uint8_t> vData;
 
+        /** The segment the node is linked into. **/
+        uint8_t nSegment;
+
         /** Default constructor **/
-        BinaryNode(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vDataIn)
-        : pprev   (nullptr)
-        , pnext   (nullptr)
-        , hashKey (XXH64(&vKey[0], vKey.size(), 0))
-        , vData   (vDataIn)
+        BinaryNode(const uint64_t hashKeyIn, const std::vector<uint8_t>& vDataIn, const uint8_t nSegmentIn)
+        : pprev    (nullptr)
+        , pnext    (nullptr)
+        , hashKey  (hashKeyIn)
+        , vData    (vDataIn)
+        , nSegment (nSegmentIn)
         {
         }
 
@@ -80,13 +86,17 @@ namespace LLD
     /** Cache Size Constructor **/
     BinaryLRU::BinaryLRU(const uint32_t nCacheSizeIn)
     : MAX_CACHE_SIZE    (nCacheSizeIn)
-    , MAX_CACHE_BUCKETS (nCacheSizeIn / 128)
+    , MAX_CACHE_BUCKETS (std::max(nCacheSizeIn / 128, 1u))
     , nCurrentSize      (MAX_CACHE_BUCKETS * 16)
     , MUTEX             ( )
     , hashmap           (MAX_CACHE_BUCKETS, nullptr)
     , indexes           (MAX_CACHE_BUCKETS, 0)
-    , pfirst            (nullptr)
-    , plast             (nullptr)
+    , pfirst            {nullptr, nullptr}
+    , plast             {nullptr, nullptr}
+    , nWindowSize       (0)
+    , sketch            (MAX_CACHE_BUCKETS)
+    , nHits             (0)
+    , nMisses           (0)
     {
     }
 
@@ -142,15 +152,23 @@ namespace LLD
     {
         LOCK(MUTEX);
 
+        /* Every lookup counts towards the frequency of the key, including misses. */
+        const uint64_t hashKey = XXH64(&vKey[0], vKey.size(), 0);
+        sketch.Increment(hashKey);
+
         /* Check for data. */
         uint64_t& nIndex  = indexes[bucket(vKey)];
         if(nIndex == 0)
+        {
+            ++nMisses;
             return false;
+        }
 
         /* Get the binary node. */
         BinaryNode* pthis = hashmap[slot(nIndex)];
         if(pthis == nullptr)
         {
+            ++nMisses;
             nIndex = 0; //reset by reference
             return false;
         }
@@ -158,18 +176,23 @@ namespace LLD
         /* Check for null state. */
         if(pthis->IsNull())
         {
+            ++nMisses;
             nIndex = 0; //reset by reference
             return false;
         }
 
         /* Check the keys are correct. */
-        if(pthis->hashKey != XXH64(&vKey[0], vKey.size(), 0))
+        if(pthis->hashKey != hashKey)
+        {
+            ++nMisses;
             return false;
+        }
 
         /* Get the data. */
         vData = pthis->vData;
+        ++nHits;
 
-        /* Move to front of double linked list. */
+        /* Move to front of its segment. */
         move_to_front(pthis);
 
         return true;
@@ -181,24 +204,18 @@ namespace LLD
     {
         LOCK(MUTEX);
 
+        /* Writes count towards the frequency of the key as well. */
+        const uint64_t hashKey = XXH64(&vKey[0], vKey.size(), 0);
+        sketch.Increment(hashKey);
+
         /* Get the binary node. */
         uint64_t& nIndex = indexes[bucket(vKey)];
         if(nIndex != 0)
         {
-            /* Get the node from checksum. */
-            uint32_t nSlot    = slot(nIndex);
-            BinaryNode* pthis = hashmap[nSlot];
-
-            /* Check for dereferencing nullptr. */
+            /* Free the old record so a stale copy is never served. */
+            BinaryNode* pthis = hashmap[slot(nIndex)];
             if(pthis != nullptr && !pthis->IsNull())
-            {
-                /* Reduce the current size. */
-                nCurrentSize -= static_cast<uint32_t>(pthis->vData.size());
-
-                /* Free the memory. */
-                remove_node(pthis);
-                pthis->SetNull();
-            }
+                release(pthis);
         }
 
         /* Update index hashmap through reference: NOTE nSectorFile and nSectorStart are 0-based so we add 1 to it to ensure we always have an index */
@@ -208,61 +225,29 @@ namespace LLD
         uint32_t nSlot = slot(nIndex);
         if(hashmap[nSlot] != nullptr)
         {
-            /* Claiming an empty hashmap slot. */
+            /* Erase data on collision. */
             if(!hashmap[nSlot]->IsNull())
-            {
-                /* Erase data on collision. */
-                nCurrentSize -= static_cast<uint32_t>(hashmap[nSlot]->vData.size());
-                hashmap[nSlot]->Erase();
-            }
+                release(hashmap[nSlot]);
 
             /* Set new values. */
-            hashmap[nSlot]->hashKey = XXH64(&vKey[0], vKey.size(), 0);
+            hashmap[nSlot]->hashKey = hashKey;
             hashmap[nSlot]->vData   = vData;
-
-            /* Move to front of list. */
-            move_to_front(hashmap[nSlot]);
         }
         else
         {
             /* Add cache node to objects map. */
-            hashmap[nSlot] = new BinaryNode(vKey, vData);;
-            move_to_front(hashmap[nSlot]);
+            hashmap[nSlot] = new BinaryNode(hashKey, vData, NONE);
 
             /* Account for the node's memory size. */
             nCurrentSize += sizeof(*hashmap[nSlot]);
         }
 
-        /* Remove the last node if cache too large. */
-        while(nCurrentSize > MAX_CACHE_SIZE)
-        {
-            /* Get last pointer. */
-            BinaryNode* pnode = plast;
-            if(!pnode || pnode->IsNull())
-                break;
-
-            /* Set the new links. */
-            plast = plast->pprev;
-            if (plast)
-                plast->pnext = nullptr;
-
-            /* Reset the memory linking. */
-            pnode->pprev = nullptr;
-            pnode->pnext = nullptr;
-
-            /* Reduce memory size. */
-            nCurrentSize -= static_cast<uint32_t>(pnode->vData.size());
-
-            /* Calculate the buckets for the node being deleted */
-            uint32_t  nBucket = pnode->Bucket(MAX_CACHE_BUCKETS);
-            uint64_t& nRemove = indexes[nBucket];
-
-            /* Reset the slot. */
-            hashmap[slot(nRemove)]->SetNull();
-            nRemove                = 0;
-        }
-
+        /* Every new record enters through the window. */
+        push_front(hashmap[nSlot], WINDOW);
         nCurrentSize += static_cast<uint32_t>(vData.size());
+
+        /* Keep within the size limits. */
+        shrink();
     }
 
 
@@ -290,21 +275,125 @@ namespace LLD
             return false;
         }
 
-        /* Remove from the linked list. */
-        BinaryNode* pthis = hashmap[nSlot];
-        remove_node(pthis);
-
-        /* Set to null state. */
-        hashmap[nSlot]->SetNull();
+        /* Free the memory and set to null state. */
+        if(!hashmap[nSlot]->IsNull())
+            release(hashmap[nSlot]);
 
-        /* Free the memory. */
-        nCurrentSize  -= static_cast<uint32_t>(pthis->vData.size() + 48);
-        nIndex         = 0; //reset by reference
+        nIndex = 0; //reset by reference
 
         return true;
     }
 
 
+    /*  Change the maximum size of the cache, evicting records if it shrinks. */
+    void BinaryLRU::SetMaxSize(const uint32_t nCacheSizeIn)
+    {
+        LOCK(MUTEX);
+
+        /* Only rehash once the size is far from what the buckets were made for, so small rebalances stay cheap
+         * while the fixed cost of the buckets can't outgrow the cache. */
+        const uint64_t nBuckets = std::max(nCacheSizeIn / 128, 1u);
+        if(nBuckets > uint64_t(MAX_CACHE_BUCKETS) * 2 || nBuckets * 2 < uint64_t(MAX_CACHE_BUCKETS))
+            rehash(static_cast<uint32_t>(nBuckets));
+
+        MAX_CACHE_SIZE = nCacheSizeIn;
+        shrink();
+    }
+
+
+    /*  Get the maximum size of the cache in bytes. */
+    uint32_t BinaryLRU::MaxSize() const
+    {
+        LOCK(MUTEX);
+
+        return MAX_CACHE_SIZE;
+    }
+
+
+    /*  Get the hits and misses since the last call, and reset them. */
+    void BinaryLRU::Stats(uint64_t &nHitsOut, uint64_t &nMissesOut)
+    {
+        LOCK(MUTEX);
+
+        nHitsOut   = nHits;
+        nMissesOut = nMisses;
+
+        nHits   = 0;
+        nMisses = 0;
+    }
+
+
+    /*  Move the records into a new number of buckets, keeping their order in each segment. */
+    void BinaryLRU::rehash(const uint32_t nBuckets)
+    {
+        /* Find the index of every record that can still be looked up. */
+        std::unordered_map<BinaryNode*, uint64_t> mapIndexes;
+        for(uint32_t nBucket = 0; nBucket < MAX_CACHE_BUCKETS; ++nBucket)
+        {
+            const uint64_t nIndex = indexes[nBucket];
+            if(nIndex == 0)
+                continue;
+
+            BinaryNode* pthis = hashmap[slot(nIndex)];
+            if(pthis != nullptr && !pthis->IsNull() && pthis->Bucket(MAX_CACHE_BUCKETS) == nBucket)
+                mapIndexes[pthis] = nIndex;
+        }
+
+        /* Swap in the new buckets, keeping the old nodes to place or free. */
+        const uint32_t nOldBuckets = MAX_CACHE_BUCKETS;
+        std::vector<BinaryNode*> vOld(nBuckets, nullptr);
+        hashmap.swap(vOld);
+        indexes.assign(nBuckets, 0);
+
+        MAX_CACHE_BUCKETS = nBuckets;
+        nCurrentSize      = MAX_CACHE_BUCKETS * 16;
+        sketch            = FrequencySketch(MAX_CACHE_BUCKETS);
+
+        for(uint8_t nSegment = WINDOW; nSegment <= MAIN; ++nSegment)
+        {
+            /* Place the most recently used records first, so they win any collisions in the new buckets. */
+            std::vector<BinaryNode*> vKept;
+            for(BinaryNode* pthis = pfirst[nSegment]; pthis != nullptr; pthis = pthis->pnext)
+            {
+                auto it = mapIndexes.find(pthis);
+                if(it == mapIndexes.end())
+                    continue;
+
+                uint64_t& nIndex = indexes[pthis->Bucket(MAX_CACHE_BUCKETS)];
+                const uint32_t nSlot = slot(it->second);
+                if(nIndex != 0 || hashmap[nSlot] != nullptr)
+                    continue;
+
+                nIndex          = it->second;
+                hashmap[nSlot]  = pthis;
+
+                vOld[it->second % nOldBuckets] = nullptr;
+
+                vKept.push_back(pthis);
+            }
+
+            /* Relink the kept records in their old order. */
+            pfirst[nSegment] = nullptr;
+            plast[nSegment]  = nullptr;
+            if(nSegment == WINDOW)
+                nWindowSize = 0;
+
+            for(auto it = vKept.rbegin(); it != vKept.rend(); ++it)
+            {
+                push_front(*it, nSegment);
+                nCurrentSize += static_cast<uint32_t>(sizeof(**it) + (*it)->vData.size());
+            }
+        }
+
+        /* Free the nodes that were not placed. */
+        for(BinaryNode* pthis : vOld)
+        {
+            if(pthis != nullptr)
+                delete pthis;
+        }
+    }
+
+
     /*  Find a bucket for checksum key management. */
     uint32_t BinaryLRU::slot(const uint64_t nIndex) const
     {
@@ -315,21 +404,18 @@ namespace LLD
     /*  Remove a node from the double linked list. */
     void BinaryLRU::remove_node(BinaryNode* pthis)
     {
+        /* Nodes not in a segment are already unlinked. */
+        const uint8_t nSegment = pthis->nSegment;
+        if(nSegment == NONE)
+            return;
+
         /* Relink last pointer. */
-        if(pthis == plast)
-        {
-            plast = plast->pprev;
-            if(plast)
-                plast->pnext = nullptr;
-        }
+        if(pthis == plast[nSegment])
+            plast[nSegment] = pthis->pprev;
 
         /* Relink first pointer. */
-        if(pthis == pfirst)
-        {
-            pfirst = pfirst->pnext;
-            if(pfirst)
-                pfirst->pprev = nullptr;
-        }
+        if(pthis == pfirst[nSegment])
+            pfirst[nSegment] = pthis->pnext;
 
         /* Link the next pointer if not null */
         if (pthis->pnext)
@@ -340,8 +426,13 @@ namespace LLD
             pthis->pprev->pnext = pthis->pnext;
 
         /* Unlink next and prev. */
-        pthis->pnext = nullptr;
-        pthis->pprev = nullptr;
+        pthis->pnext    = nullptr;
+        pthis->pprev    = nullptr;
+        pthis->nSegment = NONE;
+
+        /* Track the size of the window. */
+        if(nSegment == WINDOW)
+            nWindowSize -= static_cast<uint32_t>(pthis->vData.size());
     }
 
 
@@ -349,29 +440,88 @@ namespace LLD
     void BinaryLRU::move_to_front(BinaryNode* pthis)
     {
         /* Don't move to front if already in the front. */
-        if(pthis == pfirst)
+        const uint8_t nSegment = pthis->nSegment;
+        if(nSegment == NONE || pthis == pfirst[nSegment])
             return;
 
-        /* Move last pointer if moving from back. */
         remove_node(pthis);
+        push_front(pthis, nSegment);
+    }
 
+
+    /*  Link a node at the front of a segment. */
+    void BinaryLRU::push_front(BinaryNode* pthis, const uint8_t nSegment)
+    {
         /* Link to front. */
-        pthis->pprev = nullptr;
-        pthis->pnext = pfirst;
+        pthis->pprev    = nullptr;
+        pthis->pnext    = pfirst[nSegment];
+        pthis->nSegment = nSegment;
+
+        /* Update the first reference prev, or the last reference of an empty list. */
+        if(pfirst[nSegment])
+            pfirst[nSegment]->pprev = pthis;
+        else
+            plast[nSegment] = pthis;
+
+        pfirst[nSegment] = pthis;
+
+        /* Track the size of the window. */
+        if(nSegment == WINDOW)
+            nWindowSize += static_cast<uint32_t>(pthis->vData.size());
+    }
+
+
+    /*  Unlink a node and free its data, leaving its slot for reuse. */
+    void BinaryLRU::release(BinaryNode* pthis)
+    {
+        remove_node(pthis);
+
+        /* Reduce memory size. */
+        nCurrentSize -= static_cast<uint32_t>(pthis->vData.size());
+        pthis->SetNull();
+    }
+
 
-        /* Update the first reference prev */
-        if(pfirst)
+    /*  Release a node and clear the index that points to it. */
+    void BinaryLRU::evict(BinaryNode* pthis)
+    {
+        /* Calculate the bucket for the node being deleted, only clearing it if it still points here. */
+        uint64_t& nRemove = indexes[pthis->Bucket(MAX_CACHE_BUCKETS)];
+        if(nRemove != 0 && hashmap[slot(nRemove)] == pthis)
+            nRemove = 0;
+
+        release(pthis);
+    }
+
+
+    /*  Move the overflow of the window into the main segment if admitted, then evict until we fit. */
+    void BinaryLRU::shrink()
+    {
+        /* Records leaving the window must be used more often than the main victim they would replace.
+         * The newest record always stays, so it can gather hits even if it is larger than the window. */
+        const uint32_t nWindowMax = static_cast<uint32_t>(uint64_t(MAX_CACHE_SIZE) * CACHE_WINDOW_PERCENT / 100);
+        while(nWindowSize > nWindowMax && plast[WINDOW] != pfirst[WINDOW])
         {
-            /* Set last for second iteration. */
-            pfirst->pprev = pthis;
-            if(!plast)
-            {
-                plast = pfirst;
-                plast->pnext = nullptr;
-            }
+            BinaryNode* pcandidate = plast[WINDOW];
+            remove_node(pcandidate);
+
+            /* Admit freely while there is room. */
+            BinaryNode* pvictim = plast[MAIN];
+            if(nCurrentSize > MAX_CACHE_SIZE && pvictim
+            && sketch.Frequency(pcandidate->hashKey) <= sketch.Frequency(pvictim->hashKey))
+                evict(pcandidate);
+            else
+                push_front(pcandidate, MAIN);
         }
 
-        /* Update the first reference. */
-        pfirst        = pthis;
+        /* Remove the least recently used records of the main segment, then the window, if cache too large. */
+        while(nCurrentSize > MAX_CACHE_SIZE)
+        {
+            BinaryNode* pnode = (plast[MAIN] ? plast[MAIN] : plast[WINDOW]);
+            if(!pnode)
+                break;
+
+            evict(pnode);
+        }
     }
 }
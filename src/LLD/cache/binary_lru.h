@@ -14,6 +14,8 @@ ________________________________________________________________________________
 #ifndef NEXUS_LLD_CACHE_BINARY_LRU_H
 #define NEXUS_LLD_CACHE_BINARY_LRU_H
 
+#include <LLD/cache/frequency_sketch.h>
+
 #include <mutex>
 #include <cstdint>
 #include <vector>
@@ -33,15 +35,32 @@ namespace LLD
     struct BinaryNode;
 
 
+    /** The percentage of the cache that every new record enters through. **/
+    const uint32_t CACHE_WINDOW_PERCENT = 1;
+
+
     /** BinaryLRU
     *
     *   LRU - Least Recently Used.
     *   This class is responsible for holding data that is partially processed.
     *   This class has no types, all objects are in binary forms.
     *
+    *   New records enter a small LRU window. Records that fall out of the window are only
+    *   admitted to the main LRU if they were used more often than its least recently used
+    *   record, so a one-off scan can't evict the working set (W-TinyLFU).
+    *
     **/
     class BinaryLRU
     {
+        /* The segments of the cache. */
+        enum
+        {
+            WINDOW = 0,
+            MAIN   = 1,
+            NONE   = 2,
+        };
+
+
         /* The Maximum Size of the Cache. */
         uint32_t MAX_CACHE_SIZE;
 
@@ -66,12 +85,25 @@ namespace LLD
         std::vector<uint64_t> indexes;
 
 
-        /* Keep track of the first object in linked list. */
-        BinaryNode* pfirst;
+        /* Keep track of the first object in the linked list of each segment. */
+        BinaryNode* pfirst[2];
+
+
+        /* Keep track of the last object in the linked list of each segment. */
+        BinaryNode* plast[2];
 
 
-        /* Keep track of the last object in linked list. */
-        BinaryNode* plast;
+        /* The data size of the records in the window. */
+        uint32_t nWindowSize;
+
+
+        /* The recent access frequency of keys, for admission to the main segment. */
+        FrequencySketch sketch;
+
+
+        /* The hits and misses since the last call to Stats. */
+        uint64_t nHits;
+        uint64_t nMisses;
 
 
     public:
@@ -169,6 +201,37 @@ namespace LLD
         bool Remove(const std::vector<uint8_t>& vKey);
 
 
+        /** SetMaxSize
+         *
+         *  Change the maximum size of the cache, evicting records if it shrinks. The buckets
+         *  are rehashed once the size is more than double or less than half of what they
+         *  were made for.
+         *
+         *  @param[in] nCacheSizeIn The new maximum size in bytes.
+         *
+         **/
+        void SetMaxSize(const uint32_t nCacheSizeIn);
+
+
+        /** MaxSize
+         *
+         *  Get the maximum size of the cache in bytes.
+         *
+         **/
+        uint32_t MaxSize() const;
+
+
+        /** Stats
+         *
+         *  Get the hits and misses since the last call, and reset them.
+         *
+         *  @param[out] nHitsOut The number of lookups that found a record.
+         *  @param[out] nMissesOut The number of lookups that didn't.
+         *
+         **/
+        void Stats(uint64_t &nHitsOut, uint64_t &nMissesOut);
+
+
     private:
 
         /** RemoveNode
@@ -191,6 +254,57 @@ namespace LLD
         void move_to_front(BinaryNode* pthis);
 
 
+        /** PushFront
+         *
+         *  Link a node at the front of a segment.
+         *
+         *  @param[in] pthis The node to link.
+         *  @param[in] nSegment The segment to link it into.
+         *
+         **/
+        void push_front(BinaryNode* pthis, const uint8_t nSegment);
+
+
+        /** Release
+         *
+         *  Unlink a node and free its data, leaving its slot for reuse.
+         *
+         *  @param[in] pthis The node to release.
+         *
+         **/
+        void release(BinaryNode* pthis);
+
+
+        /** Evict
+         *
+         *  Release a node and clear the index that points to it.
+         *
+         *  @param[in] pthis The node to evict.
+         *
+         **/
+        void evict(BinaryNode* pthis);
+
+
+        /** Shrink
+         *
+         *  Move the overflow of the window into the main segment if admitted, then evict until
+         *  the cache is within its maximum size.
+         *
+         **/
+        void shrink();
+
+
+        /** Rehash
+         *
+         *  Move the records into a new number of buckets, keeping their order in each segment.
+         *  Records that collide in the new buckets are freed, and the frequencies start over.
+         *
+         *  @param[in] nBuckets The new number of buckets.
+         *
+         **/
+        void rehash(const uint32_t nBuckets);
+
+
         /** Bucket
          *
          *  Find a bucket for cache key management.
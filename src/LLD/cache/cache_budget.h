@@ -0,0 +1,137 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_CACHE_CACHE_BUDGET_H
+#define NEXUS_LLD_CACHE_CACHE_BUDGET_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LLD
+{
+    class BinaryLRU;
+
+
+    /** The smallest size a cache is shrunk to when rebalancing. **/
+    const uint32_t MIN_CACHE_SIZE = 256 * 1024;
+
+
+    /** CacheBudget
+     *
+     *  Shares one memory budget across the caches of several databases. The caches are
+     *  periodically resized in proportion to their misses, so memory moves to the database
+     *  whose working set doesn't fit, away from ones that are already hitting.
+     *
+     **/
+    class CacheBudget
+    {
+        /* Mutex for thread concurrency. */
+        std::mutex MUTEX;
+
+
+        /* The condition to wake the rebalance thread on shutdown. */
+        std::condition_variable CONDITION;
+
+
+        /* The caches sharing the budget, with their names for logging. */
+        std::vector<std::pair<std::string, BinaryLRU*>> vCaches;
+
+
+        /* The total size of all the caches in bytes. */
+        uint64_t nBudget;
+
+
+        /* The seconds between rebalances. */
+        uint32_t nInterval;
+
+
+        /* Flag to stop the rebalance thread. */
+        bool fShutdown;
+
+
+        /* The rebalance thread. */
+        std::thread REBALANCE_THREAD;
+
+
+    public:
+
+
+        /** Budget Constructor
+         *
+         *  @param[in] nBudgetIn The total size of all the caches in bytes.
+         *  @param[in] nIntervalIn The seconds between rebalances, 0 to only rebalance manually.
+         *
+         **/
+        CacheBudget(const uint64_t nBudgetIn, const uint32_t nIntervalIn);
+
+
+        /** Default Destructor. Stops the rebalance thread. **/
+        ~CacheBudget();
+
+
+        /** Add
+         *
+         *  Add a cache to the budget. The caches must outlive the budget or the call to Stop.
+         *
+         *  @param[in] strName The name of the cache for logging.
+         *  @param[in] pCache The cache to manage.
+         *
+         **/
+        void Add(const std::string& strName, BinaryLRU* pCache);
+
+
+        /** Start
+         *
+         *  Start the rebalance thread.
+         *
+         **/
+        void Start();
+
+
+        /** Stop
+         *
+         *  Stop the rebalance thread.
+         *
+         **/
+        void Stop();
+
+
+        /** Rebalance
+         *
+         *  Resize the caches from the hits and misses since the last rebalance. A quarter of
+         *  the budget is split evenly so no cache starves, the rest goes by share of misses,
+         *  and each cache moves halfway towards its target to damp oscillation. Caches held at
+         *  MIN_CACHE_SIZE come out of the budget first, so the total stays within it unless
+         *  the budget is smaller than the minimum of every cache.
+         *
+         **/
+        void Rebalance();
+
+
+    private:
+
+
+        /** Thread
+         *
+         *  Rebalance the caches every interval until stopped.
+         *
+         **/
+        void Thread();
+    };
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_CACHE_FREQUENCY_SKETCH_H
+#define NEXUS_LLD_CACHE_FREQUENCY_SKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace LLD
+{
+
+    /** FrequencySketch
+     *
+     *  Count-min sketch of 4-bit counters, used by the caches to estimate how often a key was
+     *  accessed recently (TinyLFU). All counters are halved after a sample period so that old
+     *  popularity fades out. This class is not thread safe, the cache locks around it.
+     *
+     **/
+    class FrequencySketch
+    {
+        /* The table of counters, 16 per word. */
+        std::vector<uint64_t> vTable;
+
+
+        /* Mask to index into the table. */
+        uint64_t nMask;
+
+
+        /* The number of increments since the last reset. */
+        uint32_t nSamples;
+
+
+        /* The number of increments that triggers a reset. */
+        uint32_t nSampleSize;
+
+    public:
+
+        /** Default Constructor. **/
+        FrequencySketch() = delete;
+
+
+        /** Capacity Constructor
+         *
+         *  @param[in] nEntries The expected number of entries in the cache.
+         *
+         **/
+        FrequencySketch(const uint32_t nEntries);
+
+
+        /** Increment
+         *
+         *  Record an access to a key.
+         *
+         *  @param[in] hashKey The 64-bit hash of the key.
+         *
+         **/
+        void Increment(const uint64_t hashKey);
+
+
+        /** Frequency
+         *
+         *  Estimate the recent access count of a key.
+         *
+         *  @param[in] hashKey The 64-bit hash of the key.
+         *
+         *  @return The estimate between 0 and 15.
+         *
+         **/
+        uint32_t Frequency(const uint64_t hashKey) const;
+
+
+        /** Reset
+         *
+         *  Halve all counters to age the sketch.
+         *
+         **/
+        void Reset();
+
+    private:
+
+        /** index
+         *
+         *  Get the table word for one of the four hash functions.
+         *
+         **/
+        uint64_t index(const uint64_t hashKey, const uint32_t nDepth) const;
+
+
+        /** offset
+         *
+         *  Get the bit offset of the counter within its word for one of the four hash functions.
+         *
+         **/
+        uint32_t offset(const uint64_t hashKey, const uint32_t nDepth) const
+        {
+            return static_cast<uint32_t>((hashKey >> (nDepth << 2)) & 15) << 2;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#include <LLD/cache/cache_budget.h>
+#include <LLD/cache/binary_lru.h>
+
+#include <Util/include/debug.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+namespace LLD
+{
+    /* Budget Constructor */
+    CacheBudget::CacheBudget(const uint64_t nBudgetIn, const uint32_t nIntervalIn)
+    : MUTEX            ( )
+    , CONDITION        ( )
+    , vCaches          ( )
+    , nBudget          (nBudgetIn)
+    , nInterval        (nIntervalIn)
+    , fShutdown        (false)
+    , REBALANCE_THREAD ( )
+    {
+    }
+
+
+    /* Default Destructor. */
+    CacheBudget::~CacheBudget()
+    {
+        Stop();
+    }
+
+
+    /* Add a cache to the budget. */
+    void CacheBudget::Add(const std::string& strName, BinaryLRU* pCache)
+    {
+        LOCK(MUTEX);
+
+        vCaches.push_back(std::make_pair(strName, pCache));
+    }
+
+
+    /* Start the rebalance thread. */
+    void CacheBudget::Start()
+    {
+        if(nInterval == 0 || REBALANCE_THREAD.joinable())
+            return;
+
+        {
+            LOCK(MUTEX);
+            fShutdown = false;
+        }
+
+        REBALANCE_THREAD = std::thread(std::bind(&CacheBudget::Thread, this));
+    }
+
+
+    /* Stop the rebalance thread. */
+    void CacheBudget::Stop()
+    {
+        {
+            LOCK(MUTEX);
+            fShutdown = true;
+        }
+        CONDITION.notify_all();
+
+        if(REBALANCE_THREAD.joinable())
+            REBALANCE_THREAD.join();
+    }
+
+
+    /* Resize the caches from the hits and misses since the last rebalance. */
+    void CacheBudget::Rebalance()
+    {
+        LOCK(MUTEX);
+
+        if(vCaches.empty())
+            return;
+
+        /* Collect the misses of every cache. */
+        const uint32_t nCaches = static_cast<uint32_t>(vCaches.size());
+        std::vector<uint64_t> vMisses(nCaches, 0);
+
+        uint64_t nTotalMisses = 0;
+        for(uint32_t n = 0; n < nCaches; ++n)
+        {
+            uint64_t nHits = 0;
+            vCaches[n].second->Stats(nHits, vMisses[n]);
+
+            nTotalMisses += vMisses[n];
+        }
+
+        /* Nothing to learn from an idle period. */
+        if(nTotalMisses == 0)
+            return;
+
+        /* Find the damped target of every cache. */
+        const uint64_t nShared = nBudget / 4;
+        const uint64_t nEven   = nShared / nCaches;
+
+        std::vector<uint64_t> vTargets(nCaches, 0);
+
+        uint64_t nTotal = 0;
+        for(uint32_t n = 0; n < nCaches; ++n)
+        {
+            const uint64_t nTarget = nEven + static_cast<uint64_t>(
+                static_cast<double>(nBudget - nShared) * vMisses[n] / nTotalMisses);
+
+            vTargets[n] = (vCaches[n].second->MaxSize() + nTarget) / 2;
+            nTotal     += vTargets[n];
+        }
+
+        /* Hold caches that would scale below the minimum at it, taking them out of the budget first. */
+        std::vector<bool> vMinimum(nCaches, false);
+
+        uint64_t nScaled = nBudget;
+        for(bool fChanged = true; fChanged; )
+        {
+            fChanged = false;
+            for(uint32_t n = 0; n < nCaches; ++n)
+            {
+                if(vMinimum[n] || static_cast<double>(vTargets[n]) * nScaled / std::max(nTotal, uint64_t(1)) >= MIN_CACHE_SIZE)
+                    continue;
+
+                vMinimum[n] = true;
+                nScaled    -= std::min(nScaled, uint64_t(MIN_CACHE_SIZE));
+                nTotal     -= vTargets[n];
+                fChanged    = true;
+            }
+        }
+
+        /* Scale the rest back to the budget, since damping doesn't preserve the total. */
+        for(uint32_t n = 0; n < nCaches; ++n)
+        {
+            const uint64_t nSize = vMinimum[n] ? uint64_t(MIN_CACHE_SIZE) :
+                static_cast<uint64_t>(static_cast<double>(vTargets[n]) * nScaled / std::max(nTotal, uint64_t(1)));
+
+            const uint32_t nCacheSize = static_cast<uint32_t>(std::min(nSize, uint64_t(UINT32_MAX)));
+            debug::log(3, FUNCTION, vCaches[n].first, " misses ", vMisses[n], " resized to ", nCacheSize / 1024, " KB");
+
+            vCaches[n].second->SetMaxSize(nCacheSize);
+        }
+    }
+
+
+    /* Rebalance the caches every interval until stopped. */
+    void CacheBudget::Thread()
+    {
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(MUTEX);
+                CONDITION.wait_for(lock, std::chrono::seconds(nInterval), [this]{ return fShutdown; });
+
+                if(fShutdown)
+                    return;
+            }
+
+            Rebalance();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/compress.h>
+#include <LLD/compress/lz4.h>
+
+namespace LLD
+{
+
+    /* The size of the compressed record header. */
+    const uint32_t COMPRESSED_HEADER_SIZE = 5;
+
+
+    /* The largest raw record accepted when decompressing, the same as a sector file. */
+    const uint32_t MAX_RECORD_SIZE = 1024 * 1024 * 512;
+
+
+    /*  Compress a record with LZ4 for writing to a sector file. */
+    bool CompressRecord(const std::vector<uint8_t>& vData, std::vector<uint8_t> &vRecord)
+    {
+        /* Small records don't compress well enough to pay for the header. */
+        if(vData.size() < MIN_COMPRESS_SIZE || vData.size() > MAX_RECORD_SIZE)
+            return false;
+
+        /* Only keep the compressed record if it saves space. */
+        const int nRaw   = static_cast<int>(vData.size());
+        const int nLimit = nRaw - static_cast<int>(COMPRESSED_HEADER_SIZE) - 1;
+
+        vRecord.resize(COMPRESSED_HEADER_SIZE + LZ4_compressBound(nRaw));
+
+        const int nSize = LZ4_compress_default((const char*)&vData[0], (char*)&vRecord[COMPRESSED_HEADER_SIZE], nRaw, nLimit);
+        if(nSize <= 0)
+            return false;
+
+        /* Write the header. */
+        vRecord[0] = COMPRESSED_RECORD;
+        vRecord[1] = static_cast<uint8_t>(nRaw);
+        vRecord[2] = static_cast<uint8_t>(nRaw >> 8);
+        vRecord[3] = static_cast<uint8_t>(nRaw >> 16);
+        vRecord[4] = static_cast<uint8_t>(nRaw >> 24);
+
+        vRecord.resize(COMPRESSED_HEADER_SIZE + nSize);
+
+        return true;
+    }
+
+
+    /*  Decompress a record written by CompressRecord. */
+    bool DecompressRecord(const std::vector<uint8_t>& vRecord, std::vector<uint8_t> &vData)
+    {
+        if(!IsCompressed(vRecord) || vRecord.size() <= COMPRESSED_HEADER_SIZE)
+            return false;
+
+        /* Read the header. */
+        const uint32_t nRaw = static_cast<uint32_t>(vRecord[1])
+                           | (static_cast<uint32_t>(vRecord[2]) << 8)
+                           | (static_cast<uint32_t>(vRecord[3]) << 16)
+                           | (static_cast<uint32_t>(vRecord[4]) << 24);
+
+        if(nRaw == 0 || nRaw > MAX_RECORD_SIZE)
+            return false;
+
+        /* The decoder never writes past the raw size. */
+        vData.resize(nRaw);
+
+        const int nSize = LZ4_decompress_safe((const char*)&vRecord[COMPRESSED_HEADER_SIZE], (char*)&vData[0],
+            static_cast<int>(vRecord.size() - COMPRESSED_HEADER_SIZE), static_cast<int>(nRaw));
+
+        return nSize == static_cast<int>(nRaw);
+    }
+
+}
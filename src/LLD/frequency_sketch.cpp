@@ -0,0 +1,98 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#include <LLD/cache/frequency_sketch.h>
+
+#include <algorithm>
+
+namespace LLD
+{
+    /* Seeds for the four hash functions. */
+    static const uint64_t SEEDS[4] =
+    {
+        0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull, 0x9ae16a3b2f90404full, 0xcbf29ce484222325ull
+    };
+
+
+    /* Capacity Constructor */
+    FrequencySketch::FrequencySketch(const uint32_t nEntries)
+    : vTable      ( )
+    , nMask       (0)
+    , nSamples    (0)
+    , nSampleSize (std::max(10u * nEntries, 160u))
+    {
+        /* Use a power of two words, with 8 counters for every entry. */
+        uint64_t nWords = 8;
+        while(nWords < nEntries / 2)
+            nWords <<= 1;
+
+        vTable.resize(nWords, 0);
+        nMask = nWords - 1;
+    }
+
+
+    /* Record an access to a key. */
+    void FrequencySketch::Increment(const uint64_t hashKey)
+    {
+        bool fAdded = false;
+        for(uint32_t nDepth = 0; nDepth < 4; ++nDepth)
+        {
+            uint64_t& nWord = vTable[index(hashKey, nDepth)];
+
+            /* Saturate at the 4-bit maximum. */
+            const uint32_t nOffset = offset(hashKey, nDepth);
+            if(((nWord >> nOffset) & 15) < 15)
+            {
+                nWord += (uint64_t(1) << nOffset);
+                fAdded = true;
+            }
+        }
+
+        /* Age the sketch once the sample period is over. */
+        if(fAdded && ++nSamples >= nSampleSize)
+            Reset();
+    }
+
+
+    /* Estimate the recent access count of a key. */
+    uint32_t FrequencySketch::Frequency(const uint64_t hashKey) const
+    {
+        uint32_t nFrequency = 15;
+        for(uint32_t nDepth = 0; nDepth < 4; ++nDepth)
+        {
+            const uint32_t nCount = static_cast<uint32_t>((vTable[index(hashKey, nDepth)] >> offset(hashKey, nDepth)) & 15);
+            nFrequency = std::min(nFrequency, nCount);
+        }
+
+        return nFrequency;
+    }
+
+
+    /* Halve all counters to age the sketch. */
+    void FrequencySketch::Reset()
+    {
+        for(auto& nWord : vTable)
+            nWord = (nWord >> 1) & 0x7777777777777777ull;
+
+        nSamples /= 2;
+    }
+
+
+    /* Get the table word for one of the four hash functions. */
+    uint64_t FrequencySketch::index(const uint64_t hashKey, const uint32_t nDepth) const
+    {
+        uint64_t nHash = (hashKey + SEEDS[nDepth]) * SEEDS[nDepth];
+        nHash += (nHash >> 32);
+
+        return nHash & nMask;
+    }
+}
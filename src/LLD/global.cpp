@@ -12,9 +12,15 @@
 ____________________________________________________________________________________________*/
 
 #include <LLD/include/global.h>
+#include <LLD/cache/cache_budget.h>
 
 #include <TAO/Ledger/include/enum.h> //for internal flags
 
+#include <Util/include/filesystem.h>
+#include <Util/include/trace.h>
+
+#include <fstream>
+
 namespace LLD
 {
     /* The LLD global instance pointers. */
@@ -29,6 +35,10 @@ namespace LLD
     LegacyDB*     Legacy;
 
 
+    /* The memory budget shared by the ledger, register and legacy caches. */
+    static CacheBudget* pBudget = nullptr;
+
+
     /*  Initialize the global LLD instances. */
     void Initialize()
     {
@@ -38,29 +48,52 @@ namespace LLD
         Contract = new ContractDB(
                         FLAGS::CREATE | FLAGS::FORCE);
 
+        /* Use larger caches by default when importing a block archive. */
+        const bool fImport = !config::GetArg(std::string("-importblocks"), "").empty();
+
         /* Create the contract database instance. */
-        uint32_t nRegisterCacheSize = config::GetArg("-registercache", 2);
+        uint32_t nRegisterCacheSize = config::GetArg("-registercache", fImport ? 64 : 2);
         Register = new RegisterDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | (config::GetBoolArg("-compressregister") ? FLAGS::COMPRESS : 0),
                         77773,
                         nRegisterCacheSize * 1024 * 1024);
 
         /* Create the ledger database instance. */
-        uint32_t nLedgerCacheSize = config::GetArg("-ledgercache", 2);
+        uint32_t nLedgerCacheSize = config::GetArg("-ledgercache", fImport ? 256 : 2);
         Ledger    = new LedgerDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | (config::GetBoolArg("-compressledger") ? FLAGS::COMPRESS : 0),
                         config::fClient.load() ? 77773 : (256 * 256 * 64),
                         nLedgerCacheSize * 1024 * 1024);
 
 
         /* Create the legacy database instance. */
-        uint32_t nLegacyCacheSize = config::GetArg("-legacycache", 1);
+        uint32_t nLegacyCacheSize = config::GetArg("-legacycache", fImport ? 64 : 1);
         Legacy = new LegacyDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | (config::GetBoolArg("-compresslegacy") ? FLAGS::COMPRESS : 0),
                         config::fClient.load() ? 77773 : 256 * 256 * 64,
                         nLegacyCacheSize * 1024 * 1024);
 
 
+        /* Share one budget across the large caches, starting from the ratio of their configured sizes. */
+        const uint64_t nBudget = config::GetArg("-cachebudget", 0);
+        if(nBudget > 0)
+        {
+            pBudget = new CacheBudget(nBudget * 1024 * 1024, config::GetArg("-cacherebalance", 60));
+
+            const uint64_t nConfigured = std::max(uint64_t(1), uint64_t(nRegisterCacheSize) + nLedgerCacheSize + nLegacyCacheSize);
+            Register->Cache()->SetMaxSize(static_cast<uint32_t>(nBudget * 1024 * 1024 * nRegisterCacheSize / nConfigured));
+            Ledger->Cache()->SetMaxSize(static_cast<uint32_t>(nBudget * 1024 * 1024 * nLedgerCacheSize / nConfigured));
+            Legacy->Cache()->SetMaxSize(static_cast<uint32_t>(nBudget * 1024 * 1024 * nLegacyCacheSize / nConfigured));
+
+            pBudget->Add("register", Register->Cache());
+            pBudget->Add("ledger", Ledger->Cache());
+            pBudget->Add("legacy", Legacy->Cache());
+            pBudget->Start();
+
+            debug::log(0, FUNCTION, "Sharing ", nBudget, " MB across caches");
+        }
+
+
         /* Create the trust database instance. */
         Trust  = new TrustDB(
                         FLAGS::CREATE | FLAGS::FORCE);
@@ -79,6 +112,9 @@ namespace LLD
                             77773);
         }
 
+        /* Finish or roll back a bulk load cut short by a shutdown. */
+        BulkRecovery();
+
         /* Handle database recovery mode. */
         TxnRecovery();
     }
@@ -89,6 +125,13 @@ namespace LLD
     {
         debug::log(0, FUNCTION, "Shutting down LLD");
 
+        /* Stop rebalancing before the caches are deleted. */
+        if(pBudget)
+        {
+            delete pBudget;
+            pBudget = nullptr;
+        }
+
         /* Cleanup the contract database. */
         if(Contract)
         {
@@ -319,6 +362,8 @@ namespace LLD
     /* Global handler for all LLD instances. */
     void TxnCommit(const uint8_t nFlags)
     {
+        trace::Span span("LLD::TxnCommit", "lld");
+
         /* Commit the contract DB transaction. */
         if(Contract)
             Contract->MemoryCommit();
@@ -421,4 +466,255 @@ namespace LLD
         if(Legacy)
             Legacy->TxnRelease();
     }
+
+
+    /* The file marking that the chain databases are in bulk load mode. */
+    static std::string bulk_active()
+    {
+        return config::GetDataDir() + "bulk.active";
+    }
+
+
+    /* The file marking that every bulk load spool is written and can be built. */
+    static std::string bulk_commit()
+    {
+        return config::GetDataDir() + "bulk.commit";
+    }
+
+
+    /* Create an empty marker file. */
+    static bool write_marker(const std::string& strPath)
+    {
+        std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!stream.is_open())
+            return false;
+
+        stream.close();
+        return !stream.fail();
+    }
+
+
+    /* Only one flush at a time. */
+    static std::mutex BULK_FLUSH_MUTEX;
+
+
+    /* Global handler for all LLD instances. */
+    void BulkBegin()
+    {
+        /* Mark the bulk load so a shutdown before the next flush is rolled back on start. */
+        if(!write_marker(bulk_active()))
+            debug::error(FUNCTION, "failed to write bulk load marker");
+
+        /* Start bulk load on the contract DB. */
+        if(Contract)
+            Contract->BulkBegin();
+
+        /* Start bulk load on the register DB. */
+        if(Register)
+            Register->BulkBegin();
+
+        /* Start bulk load on the ledger DB. */
+        if(Ledger)
+            Ledger->BulkBegin();
+
+        /* Start bulk load on the trust DB. */
+        if(Trust)
+            Trust->BulkBegin();
+
+        /* Start bulk load on the legacy DB. */
+        if(Legacy)
+            Legacy->BulkBegin();
+    }
+
+
+    /* Global handler for all LLD instances. */
+    bool BulkFlush()
+    {
+        LOCK(BULK_FLUSH_MUTEX);
+
+        /* Spool the held keys of every database before any of them touch a keychain. */
+        if((Contract && !Contract->BulkPrepare())
+        || (Register && !Register->BulkPrepare())
+        || (Ledger   && !Ledger->BulkPrepare())
+        || (Trust    && !Trust->BulkPrepare())
+        || (Legacy   && !Legacy->BulkPrepare()))
+        {
+            /* Nothing is committed yet, the keys are still held. */
+            if(Contract)
+                Contract->BulkDiscard();
+
+            if(Register)
+                Register->BulkDiscard();
+
+            if(Ledger)
+                Ledger->BulkDiscard();
+
+            if(Trust)
+                Trust->BulkDiscard();
+
+            if(Legacy)
+                Legacy->BulkDiscard();
+
+            return debug::error(FUNCTION, "failed to spool bulk load keys");
+        }
+
+        /* Once the marker is written the spools are built on start if the build is cut short. */
+        if(!write_marker(bulk_commit()))
+            return debug::error(FUNCTION, "failed to write bulk load commit marker");
+
+        bool fSuccess = true;
+
+        /* Build the contract DB keys. */
+        if(Contract && !Contract->BulkBuild())
+            fSuccess = false;
+
+        /* Build the register DB keys. */
+        if(Register && !Register->BulkBuild())
+            fSuccess = false;
+
+        /* Build the ledger DB keys. */
+        if(Ledger && !Ledger->BulkBuild())
+            fSuccess = false;
+
+        /* Build the trust DB keys. */
+        if(Trust && !Trust->BulkBuild())
+            fSuccess = false;
+
+        /* Build the legacy DB keys. */
+        if(Legacy && !Legacy->BulkBuild())
+            fSuccess = false;
+
+        /* Keep the marker of a failed build so it's retried on start. */
+        if(!fSuccess)
+            return debug::error(FUNCTION, "failed to build bulk load keys");
+
+        filesystem::remove(bulk_commit());
+
+        return true;
+    }
+
+
+    /* Global handler for all LLD instances. */
+    bool BulkCheckpoint()
+    {
+        /* Flush every database together once any of them holds enough keys. */
+        if((Contract && Contract->BulkFull())
+        || (Register && Register->BulkFull())
+        || (Ledger   && Ledger->BulkFull())
+        || (Trust    && Trust->BulkFull())
+        || (Legacy   && Legacy->BulkFull()))
+            return BulkFlush();
+
+        return true;
+    }
+
+
+    /* Global handler for all LLD instances. */
+    bool BulkCommit()
+    {
+        /* New keys go straight to the keychains from here. */
+        if(Contract)
+            Contract->BulkEnd();
+
+        if(Register)
+            Register->BulkEnd();
+
+        if(Ledger)
+            Ledger->BulkEnd();
+
+        if(Trust)
+            Trust->BulkEnd();
+
+        if(Legacy)
+            Legacy->BulkEnd();
+
+        /* Build the keys held since the last flush. */
+        if(!BulkFlush())
+            return false;
+
+        filesystem::remove(bulk_active());
+
+        return true;
+    }
+
+
+    /* Global handler for all LLD instances. */
+    void BulkAbort()
+    {
+        /* Drop the keys held since the last flush. */
+        if(Contract)
+            Contract->BulkAbort();
+
+        if(Register)
+            Register->BulkAbort();
+
+        if(Ledger)
+            Ledger->BulkAbort();
+
+        if(Trust)
+            Trust->BulkAbort();
+
+        if(Legacy)
+            Legacy->BulkAbort();
+
+        filesystem::remove(bulk_active());
+    }
+
+
+    /* Global handler for all LLD instances. */
+    void BulkRecovery()
+    {
+        /* Finish a flush that was committed but cut short. */
+        if(filesystem::exists(bulk_commit()))
+        {
+            debug::log(0, FUNCTION, "finishing interrupted bulk load build");
+
+            bool fSuccess = true;
+            if(Contract && !Contract->BulkBuild())
+                fSuccess = false;
+
+            if(Register && !Register->BulkBuild())
+                fSuccess = false;
+
+            if(Ledger && !Ledger->BulkBuild())
+                fSuccess = false;
+
+            if(Trust && !Trust->BulkBuild())
+                fSuccess = false;
+
+            if(Legacy && !Legacy->BulkBuild())
+                fSuccess = false;
+
+            if(fSuccess)
+                filesystem::remove(bulk_commit());
+            else
+                debug::error(FUNCTION, "failed to finish bulk load build");
+        }
+
+        /* Spools that were never committed are from a flush that didn't finish preparing. */
+        if(Contract)
+            Contract->BulkDiscard();
+
+        if(Register)
+            Register->BulkDiscard();
+
+        if(Ledger)
+            Ledger->BulkDiscard();
+
+        if(Trust)
+            Trust->BulkDiscard();
+
+        if(Legacy)
+            Legacy->BulkDiscard();
+
+        /* Roll back to the last flush. Records since then are in the sector files without keys,
+         * and a journal from a block after the flush would write keys on top of the ones lost. */
+        if(filesystem::exists(bulk_active()))
+        {
+            debug::log(0, FUNCTION, "rolling back interrupted bulk load to the last flush");
+
+            TxnAbort();
+            filesystem::remove(bulk_active());
+        }
+    }
 }
@@ -0,0 +1,73 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_INCLUDE_COMPRESS_H
+#define NEXUS_LLD_INCLUDE_COMPRESS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace LLD
+{
+
+    /** The first byte of a compressed record. Raw records start with the compact size of their type string, which is never 0xff. **/
+    const uint8_t COMPRESSED_RECORD = 0xff;
+
+
+    /** Records smaller than this are always stored raw. **/
+    const uint32_t MIN_COMPRESS_SIZE = 64;
+
+
+    /** IsCompressed
+     *
+     *  Determines if a record read from a sector file is compressed.
+     *
+     *  @param[in] vRecord The record bytes without the length prefix.
+     *
+     **/
+    inline bool IsCompressed(const std::vector<uint8_t>& vRecord)
+    {
+        return !vRecord.empty() && vRecord[0] == COMPRESSED_RECORD;
+    }
+
+
+    /** CompressRecord
+     *
+     *  Compress a record with LZ4 for writing to a sector file. The compressed record is the
+     *  marker byte, the raw size as 4 bytes little endian, then the LZ4 block.
+     *
+     *  @param[in] vData The raw record to compress.
+     *  @param[out] vRecord The compressed record.
+     *
+     *  @return True if the record was compressed, false if it is too small or doesn't get smaller.
+     *
+     **/
+    bool CompressRecord(const std::vector<uint8_t>& vData, std::vector<uint8_t> &vRecord);
+
+
+    /** DecompressRecord
+     *
+     *  Decompress a record written by CompressRecord.
+     *
+     *  @param[in] vRecord The compressed record.
+     *  @param[out] vData The raw record.
+     *
+     *  @return True if the record was decompressed to its full size.
+     *
+     **/
+    bool DecompressRecord(const std::vector<uint8_t>& vRecord, std::vector<uint8_t> &vData);
+
+}
+
+#endif
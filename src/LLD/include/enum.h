@@ -29,7 +29,8 @@ namespace LLD
         READONLY      = (1 << 2),
         CREATE        = (1 << 3),
         WRITE         = (1 << 4),
-        FORCE         = (1 << 5)
+        FORCE         = (1 << 5),
+        COMPRESS      = (1 << 6)
     };
 
 
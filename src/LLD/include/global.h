@@ -83,6 +83,57 @@ namespace LLD
      *
      */
     void TxnCommit(const uint8_t nFlags = 0);
+
+
+    /** Bulk Begin
+     *
+     *  Put the chain databases in bulk load mode, deferring keychain writes and erases.
+     *
+     */
+    void BulkBegin();
+
+
+    /** Bulk Flush
+     *
+     *  Build the deferred keys of every chain database into the keychains as one commit.
+     *  All the spools are written before a commit marker, so a shutdown during the build is
+     *  finished on the next start and a shutdown before it is rolled back to the last flush.
+     *
+     */
+    bool BulkFlush();
+
+
+    /** Bulk Checkpoint
+     *
+     *  Flush once any chain database holds enough deferred keys. Only call this where the
+     *  databases agree with each other, such as between blocks.
+     *
+     */
+    bool BulkCheckpoint();
+
+
+    /** Bulk Commit
+     *
+     *  Build the deferred keys into the keychains and leave bulk load mode.
+     *
+     */
+    bool BulkCommit();
+
+
+    /** Bulk Abort
+     *
+     *  Drop the keys deferred since the last flush and leave bulk load mode.
+     *
+     */
+    void BulkAbort();
+
+
+    /** Bulk Recovery
+     *
+     *  Finish a committed flush or roll back a bulk load left by a shutdown.
+     *
+     */
+    void BulkRecovery();
 }
 
 #endif
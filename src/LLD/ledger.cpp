@@ -110,6 +110,20 @@ namespace LLD
     }
 
 
+    /* Writes the block a register snapshot was loaded at. */
+    bool LedgerDB::WriteSnapshot(const uint1024_t& hashBlock)
+    {
+        return Write(std::string("snapshot"), hashBlock);
+    }
+
+
+    /* Reads the block a register snapshot was loaded at. */
+    bool LedgerDB::ReadSnapshot(uint1024_t &hashBlock)
+    {
+        return Read(std::string("snapshot"), hashBlock);
+    }
+
+
     /* Reads a contract from the ledger DB. */
     const TAO::Operation::Contract LedgerDB::ReadContract(const uint512_t& hashTx, const uint32_t nContract, const uint8_t nFlags)
     {
@@ -722,6 +736,125 @@ namespace LLD
     }
 
 
+    /* Appends a contract to the history index of a register. */
+    bool LedgerDB::WriteHistory(const uint256_t& hashRegister, const uint512_t& hashTx, const uint32_t nContract)
+    {
+        /* Get the current sequence number. */
+        uint32_t nSequence = 0;
+        if(!ReadHistorySize(hashRegister, nSequence))
+            nSequence = 0; //reset value just in case
+
+        /* Write the new sequence number iterated by one. */
+        if(!Write(std::make_pair(std::string("history.sequence"), hashRegister), nSequence + 1))
+            return false;
+
+        return Write(std::make_tuple(std::string("history"), hashRegister, nSequence), std::make_pair(hashTx, nContract));
+    }
+
+
+    /* Erases the newest contract from the history index of a register if it belongs to the given transaction. */
+    bool LedgerDB::EraseHistory(const uint256_t& hashRegister, const uint512_t& hashTx)
+    {
+        /* Get the current sequence number. */
+        uint32_t nSequence = 0;
+        if(!ReadHistorySize(hashRegister, nSequence) || nSequence == 0)
+            return true;
+
+        /* Blocks connected before the index existed have nothing to erase. */
+        std::pair<uint512_t, uint32_t> pairContract;
+        if(!Read(std::make_tuple(std::string("history"), hashRegister, nSequence - 1), pairContract) || pairContract.first != hashTx)
+            return true;
+
+        /* Write the new sequence number decremented by one. */
+        if(!Write(std::make_pair(std::string("history.sequence"), hashRegister), nSequence - 1))
+            return false;
+
+        return Erase(std::make_tuple(std::string("history"), hashRegister, nSequence - 1));
+    }
+
+
+    /* Reads the contracts of the transaction before a position in the history index of a register. */
+    bool LedgerDB::ReadHistory(const uint256_t& hashRegister, uint32_t &nSequence, uint512_t &hashTx, std::vector<uint32_t> &vContracts)
+    {
+        vContracts.clear();
+
+        /* Read back while the contracts belong to the same transaction. */
+        while(nSequence > 0)
+        {
+            std::pair<uint512_t, uint32_t> pairContract;
+            if(!Read(std::make_tuple(std::string("history"), hashRegister, nSequence - 1), pairContract))
+                return debug::error(FUNCTION, "missing history ", nSequence - 1, " for ", hashRegister.SubString());
+
+            /* Stop at the next transaction. */
+            if(!vContracts.empty() && pairContract.first != hashTx)
+                break;
+
+            hashTx = pairContract.first;
+            vContracts.push_back(pairContract.second);
+
+            --nSequence;
+        }
+
+        return !vContracts.empty();
+    }
+
+
+    /* Reads the number of contracts in the history index of a register. */
+    bool LedgerDB::ReadHistorySize(const uint256_t& hashRegister, uint32_t &nSequence)
+    {
+        return Read(std::make_pair(std::string("history.sequence"), hashRegister), nSequence);
+    }
+
+
+    /* Writes the height the register history index was started at. */
+    bool LedgerDB::WriteHistoryHeight(const uint32_t nHeight)
+    {
+        return Write(std::string("history.height"), nHeight);
+    }
+
+
+    /* Reads the height the register history index was started at. */
+    bool LedgerDB::ReadHistoryHeight(uint32_t &nHeight)
+    {
+        return Read(std::string("history.height"), nHeight);
+    }
+
+
+    /* Writes the vote tally of an account. */
+    bool LedgerDB::WriteTally(const uint256_t& hashAccount, const std::pair<uint64_t, uint64_t>& pairTally)
+    {
+        return Write(std::make_pair(std::string("tally"), hashAccount), pairTally);
+    }
+
+
+    /* Reads the vote tally of an account. */
+    bool LedgerDB::ReadTally(const uint256_t& hashAccount, std::pair<uint64_t, uint64_t> &pairTally)
+    {
+        return Read(std::make_pair(std::string("tally"), hashAccount), pairTally);
+    }
+
+
+    /* Writes a sigchain's vote in the tally of an account. */
+    bool LedgerDB::WriteVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis, const std::pair<uint64_t, uint32_t>& pairVoter)
+    {
+        return Write(std::make_tuple(std::string("voter"), hashAccount, hashGenesis), pairVoter);
+    }
+
+
+    /* Reads a sigchain's vote in the tally of an account. */
+    bool LedgerDB::ReadVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis, std::pair<uint64_t, uint32_t> &pairVoter)
+    {
+        return Read(std::make_tuple(std::string("voter"), hashAccount, hashGenesis), pairVoter);
+    }
+
+
+    /* Erases a sigchain's vote from the tally of an account. */
+    bool LedgerDB::EraseVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis)
+    {
+        return Erase(std::make_tuple(std::string("voter"), hashAccount, hashGenesis));
+    }
+
+
     /* Writes a proof to disk. Proofs are used to keep track of spent temporal proofs. */
     bool LedgerDB::WriteProof(const uint256_t& hashProof, const uint512_t& hashTx,
                               const uint32_t nContract, const uint8_t nFlags)
@@ -12,6 +12,7 @@
 ____________________________________________________________________________________________*/
 
 #include <LLD/templates/sector.h>
+#include <LLD/include/compress.h>
 
 #include <LLD/cache/binary_lfu.h>
 #include <LLD/cache/binary_lru.h>
@@ -24,6 +25,8 @@ ________________________________________________________________________________
 #include <Util/include/filesystem.h>
 #include <Util/include/hex.h>
 
+#include <algorithm>
+#include <fstream>
 #include <functional>
 
 namespace LLD
@@ -55,9 +58,19 @@ namespace LLD
     , nBytesRead(0)
     , nBytesWrote(0)
     , nRecordsFlushed(0)
+    , CACHE_HITS(metrics::GetCounter("nexus_lld_cache_hits_total", metrics::Label("database", strNameIn)))
+    , CACHE_MISSES(metrics::GetCounter("nexus_lld_cache_misses_total", metrics::Label("database", strNameIn)))
+    , BYTES_READ(metrics::GetCounter("nexus_lld_read_bytes_total", metrics::Label("database", strNameIn)))
+    , BYTES_WRITTEN(metrics::GetCounter("nexus_lld_written_bytes_total", metrics::Label("database", strNameIn)))
+    , FLUSH_LATENCY(metrics::GetHistogram("nexus_lld_flush_seconds", metrics::Label("database", strNameIn)))
     , fDestruct(false)
     , fInitialized(false)
     , nFlags(nFlagsIn)
+    , fBulk(false)
+    , BULK_MUTEX()
+    , mapBulk()
+    , vBulkRun()
+    , nBulkKeys(std::max(1u, static_cast<uint32_t>(config::GetArg("-bulkkeys", 256 * 1024))))
     {
         /* Set readonly flag if write or append are not specified. */
         if(!(nFlags & FLAGS::FORCE) && !(nFlags & FLAGS::WRITE) && !(nFlags & FLAGS::APPEND))
@@ -145,24 +158,298 @@ namespace LLD
         }
 
         pTransaction = nullptr;
+
         fInitialized = true;
     }
 
 
+    /*  Enter bulk load mode. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::BulkBegin()
+    {
+        debug::log(2, FUNCTION, strName, " entering bulk load mode");
+
+        fBulk = true;
+    }
+
+
+    /*  Leave bulk load mode. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::BulkEnd()
+    {
+        /* New keys go straight to the keychain from here. */
+        fBulk = false;
+
+        debug::log(2, FUNCTION, strName, " left bulk load mode");
+    }
+
+
+    /*  Leave bulk load mode and drop the held keys. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::BulkAbort()
+    {
+        fBulk = false;
+
+        LOCK(BULK_MUTEX);
+
+        /* The cache must not serve records whose keys are dropped. */
+        for(const auto& entry : mapBulk)
+            cachePool->Remove(entry.first);
+
+        debug::log(0, FUNCTION, strName, " dropped ", mapBulk.size(), " bulk load keys");
+
+        mapBulk.clear();
+        vBulkRun.clear();
+    }
+
+
+    /*  Check if enough keys are held to flush. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::BulkFull()
+    {
+        LOCK(BULK_MUTEX);
+
+        return mapBulk.size() >= nBulkKeys;
+    }
+
+
+    /*  Get a sector key from the bulk load index or the keychain. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::GetKey(const std::vector<uint8_t>& vKey, SectorKey &cKey)
+    {
+        {
+            LOCK(BULK_MUTEX);
+
+            /* Keys held for bulk load are newer than the keychain. */
+            if(!mapBulk.empty())
+            {
+                auto it = mapBulk.find(vKey);
+                if(it != mapBulk.end())
+                {
+                    /* An empty key was erased in bulk mode. */
+                    if(it->second.nState == STATE::EMPTY)
+                        return false;
+
+                    cKey = it->second;
+                    return true;
+                }
+            }
+        }
+
+        return pSectorKeys->Get(vKey, cKey);
+    }
+
+
+    /*  Write a sector key to the bulk load index in bulk mode, or to the keychain. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::PutKey(const SectorKey& cKey)
+    {
+        {
+            LOCK(BULK_MUTEX);
+
+            /* Hold the key until the next flush. */
+            if(fBulk.load())
+            {
+                mapBulk[cKey.vKey] = cKey;
+                return true;
+            }
+
+            /* Drop an older bulk load key so reads don't find it first. */
+            if(!mapBulk.empty())
+                mapBulk.erase(cKey.vKey);
+        }
+
+        return pSectorKeys->Put(cKey);
+    }
+
+
+    /*  Erase a sector key from the keychain, or hold it as erased in bulk mode. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::EraseKey(const std::vector<uint8_t>& vKey)
+    {
+        /* Hold an empty key so the keychain entry is erased by the next flush, not before. */
+        if(fBulk.load())
+        {
+            SectorKey cKey;
+            const bool fExists = GetKey(vKey, cKey);
+
+            LOCK(BULK_MUTEX);
+            mapBulk[vKey] = SectorKey(STATE::EMPTY, vKey, 0, 0, 0);
+
+            return fExists;
+        }
+
+        bool fErased = false;
+        {
+            LOCK(BULK_MUTEX);
+
+            if(!mapBulk.empty())
+                fErased = (mapBulk.erase(vKey) > 0);
+        }
+
+        /* The key may be in both if it was written again in bulk mode. */
+        return pSectorKeys->Erase(vKey) || fErased;
+    }
+
+
+    /*  Spool the held keys sorted by keychain bucket. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::BulkPrepare()
+    {
+        /* Copy the held keys, they stay readable from the index until they are in the keychain. */
+        std::vector< std::pair<uint32_t, SectorKey> > vKeys;
+        {
+            LOCK(BULK_MUTEX);
+
+            vKeys.reserve(mapBulk.size());
+            for(const auto& entry : mapBulk)
+                vKeys.push_back(std::make_pair(pSectorKeys->GetBucket(entry.first), entry.second));
+        }
+
+        /* Sort by bucket so the keychain files are written front to back. */
+        std::stable_sort(vKeys.begin(), vKeys.end(),
+            [](const std::pair<uint32_t, SectorKey>& a, const std::pair<uint32_t, SectorKey>& b)
+            {
+                return a.first < b.first;
+            });
+
+        /* Spool the run so an interrupted build can be finished on the next start. */
+        DataStream ssRun(SER_LLD, DATABASE_VERSION);
+        ssRun << static_cast<uint32_t>(vKeys.size());
+        for(const auto& entry : vKeys)
+            ssRun << entry.second << entry.second.vKey;
+
+        {
+            std::ofstream stream(debug::safe_printstr(config::GetDataDir(), strName, "/bulk.dat"), std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "failed to open bulk load spool");
+
+            stream.write((char*)&ssRun.Bytes()[0], ssRun.size());
+            stream.close();
+
+            if(!stream)
+                return debug::error(FUNCTION, "failed to write bulk load spool");
+        }
+
+        /* Remember the run to drop it from the index once built. */
+        LOCK(BULK_MUTEX);
+
+        vBulkRun.clear();
+        vBulkRun.reserve(vKeys.size());
+        for(const auto& entry : vKeys)
+            vBulkRun.push_back(entry.second);
+
+        return true;
+    }
+
+
+    /*  Build the spooled bulk load keys into the keychain and clear the spool. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::BulkBuild()
+    {
+        const std::string strSpool = debug::safe_printstr(config::GetDataDir(), strName, "/bulk.dat");
+
+        /* Read the spooled run. */
+        std::vector<uint8_t> vSpool;
+        {
+            std::ifstream stream(strSpool, std::ios::in | std::ios::binary | std::ios::ate);
+            if(!stream.is_open())
+                return true;
+
+            vSpool.resize(static_cast<uint64_t>(stream.tellg()));
+            if(vSpool.empty())
+                return true;
+
+            stream.seekg(0, std::ios::beg);
+            stream.read((char*)&vSpool[0], vSpool.size());
+        }
+
+        /* Write the keys in the spooled order, empty keys were erased. */
+        try
+        {
+            DataStream ssRun(vSpool, SER_LLD, DATABASE_VERSION);
+
+            uint32_t nKeys = 0;
+            ssRun >> nKeys;
+
+            for(uint32_t n = 0; n < nKeys; ++n)
+            {
+                SectorKey cKey;
+                std::vector<uint8_t> vKey;
+                ssRun >> cKey >> vKey;
+
+                cKey.SetKey(vKey);
+                if(cKey.nState == STATE::EMPTY)
+                    pSectorKeys->Erase(vKey);
+                else if(!pSectorKeys->Put(cKey))
+                    return debug::error(FUNCTION, strName, " failed to build bulk load key");
+            }
+        }
+        catch(const std::exception& e)
+        {
+            /* The spool is written before the commit marker, so a committed spool is never short. */
+            return debug::error(FUNCTION, strName, " corrupt bulk load spool: ", e.what());
+        }
+
+        /* Drop the built keys unless they were written again since the spool was prepared. */
+        {
+            LOCK(BULK_MUTEX);
+
+            for(const auto& cKey : vBulkRun)
+            {
+                auto it = mapBulk.find(cKey.vKey);
+                if(it != mapBulk.end()
+                && it->second.nState       == cKey.nState
+                && it->second.nSectorFile  == cKey.nSectorFile
+                && it->second.nSectorStart == cKey.nSectorStart
+                && it->second.nSectorSize  == cKey.nSectorSize)
+                    mapBulk.erase(it);
+            }
+
+            debug::log(3, FUNCTION, strName, " built ", vBulkRun.size(), " bulk load keys");
+            vBulkRun.clear();
+        }
+
+        BulkDiscard();
+
+        return true;
+    }
+
+
+    /*  Clear a spool that was never committed. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::BulkDiscard()
+    {
+        const std::string strSpool = debug::safe_printstr(config::GetDataDir(), strName, "/bulk.dat");
+        if(!filesystem::exists(strSpool))
+            return;
+
+        std::ofstream stream(strSpool, std::ios::out | std::ios::trunc);
+        stream.close();
+    }
+
+
     /*  Get a record from cache or from disk */
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Get(const std::vector<uint8_t>& vKey, std::vector<uint8_t>& vData)
     {
+        trace::Span span("SectorDatabase::Get", "lld");
+
         /* Iterate if meters are enabled. */
         nBytesRead += static_cast<uint32_t>(vKey.size() + vData.size());
 
         /* Check the cache pool for key first. */
         if(cachePool->Get(vKey, vData))
+        {
+            CACHE_HITS.Add();
             return true;
+        }
+
+        CACHE_MISSES.Add();
 
         /* Get the key from the keychain. */
         SectorKey cKey;
-        if(pSectorKeys->Get(vKey, cKey))
+        if(GetKey(vKey, cKey))
         {
             {
                 LOCK(SECTOR_MUTEX);
@@ -196,6 +483,17 @@ namespace LLD
                 if(!pstream->read((char*) &vData[0], vData.size()))
                     return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes read");
 
+                BYTES_READ.Add(vData.size());
+            }
+
+            /* Decompress the record, files can mix compressed and raw records. */
+            if(IsCompressed(vData))
+            {
+                std::vector<uint8_t> vRecord;
+                vRecord.swap(vData);
+
+                if(!DecompressRecord(vRecord, vData))
+                    return debug::error(FUNCTION, "failed to decompress record in file ", cKey.nSectorFile, " at ", cKey.nSectorStart);
             }
 
             /* Add to cache */
@@ -218,6 +516,8 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Get(const SectorKey& cKey, std::vector<uint8_t>& vData)
     {
+        trace::Span span("SectorDatabase::Get", "lld");
+
         {
             LOCK(SECTOR_MUTEX);
 
@@ -225,7 +525,12 @@ namespace LLD
 
             /* Check the cache pool for key first. */
             if(cachePool->Get(cKey.vKey, vData))
+            {
+                CACHE_HITS.Add();
                 return true;
+            }
+
+            CACHE_MISSES.Add();
 
             /* Find the file stream for LRU cache. */
             std::fstream *pstream;
@@ -256,6 +561,18 @@ namespace LLD
             if(!pstream->read((char*) &vData[0], vData.size()))
                 return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes read");
 
+            BYTES_READ.Add(vData.size());
+
+            /* Decompress the record, files can mix compressed and raw records. */
+            if(IsCompressed(vData))
+            {
+                std::vector<uint8_t> vRecord;
+                vRecord.swap(vData);
+
+                if(!DecompressRecord(vRecord, vData))
+                    return debug::error(FUNCTION, "failed to decompress record in file ", cKey.nSectorFile, " at ", cKey.nSectorStart);
+            }
+
             /* Verboe output. */
             if(config::nVerbose >= 5)
                 debug::log(5, FUNCTION, "Current File: ", cKey.nSectorFile,
@@ -268,15 +585,16 @@ namespace LLD
 
     /*  Update a record on disk. */
     template<class KeychainType, class CacheType>
-    bool SectorDatabase<KeychainType, CacheType>::Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
+    bool SectorDatabase<KeychainType, CacheType>::Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData,
+                                                         const std::vector<uint8_t>& vRecord)
     {
         /* Check the keychain for key. */
         SectorKey key;
-        if(!pSectorKeys->Get(vKey, key))
+        if(!GetKey(vKey, key))
             return false;
 
         /* Get current size */
-        uint64_t nSize = vData.size() + GetSizeOfCompactSize(vData.size());
+        uint64_t nSize = vRecord.size() + GetSizeOfCompactSize(vRecord.size());
 
         /* Check data size constraints. */
         if(nSize != key.nSectorSize)
@@ -308,17 +626,18 @@ namespace LLD
             pstream->seekp(key.nSectorStart, std::ios::beg);
 
             /* Write the size of record. */
-            WriteCompactSize(*pstream, vData.size());
+            WriteCompactSize(*pstream, vRecord.size());
 
             /* Write the data record. */
-            if(!pstream->write((char*) &vData[0], vData.size()))
-                return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes written");
+            if(!pstream->write((char*) &vRecord[0], vRecord.size()))
+                return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vRecord.size(), " bytes written");
 
             pstream->flush();
 
             /* Records flushed indicator. */
             ++nRecordsFlushed;
-            nBytesWrote += static_cast<uint32_t>(vData.size());
+            nBytesWrote += static_cast<uint32_t>(vRecord.size());
+            BYTES_WRITTEN.Add(vRecord.size());
 
             /* Verbose output. */
             if(config::nVerbose >= 5)
@@ -334,7 +653,16 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Force(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
     {
-        if(nFlags & FLAGS::APPEND || !Update(vKey, vData))
+        trace::Span span("SectorDatabase::Force", "lld");
+
+        /* Compress the record if enabled, records that don't get smaller are written raw. */
+        std::vector<uint8_t> vCompressed;
+        const bool fCompressed = (nFlags & FLAGS::COMPRESS) && CompressRecord(vData, vCompressed);
+
+        /* Get the bytes to write to disk. */
+        const std::vector<uint8_t>& vRecord = fCompressed ? vCompressed : vData;
+
+        if(nFlags & FLAGS::APPEND || fBulk.load() || !Update(vKey, vData, vRecord))
         {
 
             {
@@ -376,17 +704,17 @@ namespace LLD
                 pstream->seekp(nCurrentFileSize, std::ios::beg);
 
                 /* Write the size of record. */
-                WriteCompactSize(*pstream, vData.size());
+                WriteCompactSize(*pstream, vRecord.size());
 
                 /* Write the data record. */
-                if(!pstream->write((char*) &vData[0], vData.size()))
-                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes written");
+                if(!pstream->write((char*) &vRecord[0], vRecord.size()))
+                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vRecord.size(), " bytes written");
 
                 pstream->flush();
             }
 
             /* Get current size */
-            uint64_t nSize = vData.size() + GetSizeOfCompactSize(vData.size());
+            uint64_t nSize = vRecord.size() + GetSizeOfCompactSize(vRecord.size());
 
             /* Create a new Sector Key. */
             SectorKey key(STATE::READY, vKey, static_cast<uint16_t>(nCurrentFile),
@@ -398,9 +726,10 @@ namespace LLD
             /* Records flushed indicator. */
             ++nRecordsFlushed;
             nBytesWrote += static_cast<uint32_t>(nSize);
+            BYTES_WRITTEN.Add(nSize);
 
             /* Assign the Key to Keychain. */
-            if(!pSectorKeys->Put(key))
+            if(!PutKey(key))
                 return debug::error(FUNCTION, "failed to write key to keychain");
 
             /* Write the data into the memory cache. */
@@ -420,6 +749,8 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Put(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
     {
+        trace::Span span("SectorDatabase::Put", "lld");
+
         /* Handle force write mode. */
         if(nFlags & FLAGS::FORCE)
             return Force(vKey, vData);
@@ -452,11 +783,11 @@ namespace LLD
     {
         /* Check the keychain for key. */
         SectorKey key;
-        if(!pSectorKeys->Get(vKey, key))
+        if(!GetKey(vKey, key))
             return false;
 
         /* Return the Key existance in the Keychain Database. */
-        if(!pSectorKeys->Erase(vKey))
+        if(!EraseKey(vKey))
             return false;
 
         /* Check that this key isn't a keychain only entry. */
@@ -546,6 +877,9 @@ namespace LLD
                 nBufferBytes = 0;
             }
 
+            /* Time the whole flush of this buffer. */
+            metrics::Timer timer(FLUSH_LATENCY);
+
             /* Create a new file if the sector file size is over file size limits. */
             if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
             {
@@ -699,7 +1033,7 @@ namespace LLD
 
         /* Erase data set to be removed. */
         for(const auto& item : pTransaction->setErasedData)
-            if(!pSectorKeys->Erase(item))
+            if(!EraseKey(item))
                 return debug::error(FUNCTION, "failed to erase from keychain");
 
         /* Commit the sector data. */
@@ -711,7 +1045,7 @@ namespace LLD
         for(const auto& item : pTransaction->setKeychain)
         {
             SectorKey cKey(STATE::READY, item, 0, 0, 0);
-            if(!pSectorKeys->Put(cKey))
+            if(!PutKey(cKey))
                 return debug::error(FUNCTION, "failed to commit to keychain");
         }
 
@@ -725,7 +1059,7 @@ namespace LLD
                 cKey = mapIndex[item.second];
             else
             {
-                if(!pSectorKeys->Get(item.second, cKey))
+                if(!GetKey(item.second, cKey))
                     return debug::error(FUNCTION, "failed to read indexing entry");
 
                 mapIndex[item.second] = cKey;
@@ -733,7 +1067,7 @@ namespace LLD
 
             /* Write the new sector key. */
             cKey.SetKey(item.first);
-            if(!pSectorKeys->Put(cKey))
+            if(!PutKey(cKey))
                 return debug::error(FUNCTION, "failed to write indexing entry");
         }
 
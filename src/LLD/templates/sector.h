@@ -16,6 +16,7 @@ ________________________________________________________________________________
 #define NEXUS_LLD_TEMPLATES_SECTOR_H
 
 
+#include <LLD/include/compress.h>
 #include <LLD/include/enum.h>
 #include <LLD/include/version.h>
 #include <LLD/templates/key.h>
@@ -26,6 +27,8 @@ ________________________________________________________________________________
 #include <Util/templates/datastream.h>
 #include <Util/include/runtime.h>
 #include <Util/include/debug.h>
+#include <Util/include/metrics.h>
+#include <Util/include/trace.h>
 
 #include <string>
 #include <cstdint>
@@ -33,6 +36,7 @@ ________________________________________________________________________________
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <map>
 
 namespace LLD
 {
@@ -146,6 +150,13 @@ namespace LLD
         std::atomic<uint32_t> nBytesWrote;
         std::atomic<uint32_t> nRecordsFlushed;
 
+        /* Runtime metrics for this database. */
+        metrics::Counter&   CACHE_HITS;
+        metrics::Counter&   CACHE_MISSES;
+        metrics::Counter&   BYTES_READ;
+        metrics::Counter&   BYTES_WRITTEN;
+        metrics::Histogram& FLUSH_LATENCY;
+
         /* Destructor Flag. */
         std::atomic<bool> fDestruct;
 
@@ -158,6 +169,26 @@ namespace LLD
         uint8_t nFlags;
 
 
+        /** Bulk load flag, new keys are held in memory until built into the keychain. **/
+        std::atomic<bool> fBulk;
+
+
+        /** Mutex for the bulk load key index. **/
+        std::mutex BULK_MUTEX;
+
+
+        /** The keys written or erased in bulk load mode that aren't in the keychain yet. **/
+        std::map<std::vector<uint8_t>, SectorKey> mapBulk;
+
+
+        /** The keys spooled by BulkPrepare, dropped from the index once built. **/
+        std::vector<SectorKey> vBulkRun;
+
+
+        /** The number of bulk load keys to hold before building them into the keychain. **/
+        uint32_t nBulkKeys;
+
+
     public:
 
 
@@ -178,6 +209,82 @@ namespace LLD
         void Initialize();
 
 
+        /** Cache
+         *
+         *  Get the cache pool of this database, used to share a memory budget across databases.
+         *
+         **/
+        CacheType* Cache() const
+        {
+            return cachePool;
+        }
+
+
+        /** BulkBegin
+         *
+         *  Enter bulk load mode. Records are appended to the sector files and their keys are
+         *  held in memory, where reads find them, instead of being written to the keychain one
+         *  by one. Erased keys are held as empty keys so a build can't bring them back. The
+         *  held keys only reach the keychain through BulkPrepare and BulkBuild, which the
+         *  global LLD::BulkFlush runs across all the databases behind one commit marker.
+         *
+         **/
+        void BulkBegin();
+
+
+        /** BulkEnd
+         *
+         *  Leave bulk load mode. Keys still held are built by the next flush.
+         *
+         **/
+        void BulkEnd();
+
+
+        /** BulkAbort
+         *
+         *  Leave bulk load mode and drop the held keys, leaving the keychain as of the last flush.
+         *
+         **/
+        void BulkAbort();
+
+
+        /** BulkFull
+         *
+         *  Check if nBulkKeys keys are held and should be flushed.
+         *
+         **/
+        bool BulkFull();
+
+
+        /** BulkPrepare
+         *
+         *  Spool the held keys sorted by keychain bucket, ready for BulkBuild.
+         *
+         *  @return True if the spool was written.
+         *
+         **/
+        bool BulkPrepare();
+
+
+        /** BulkBuild
+         *
+         *  Build the spooled keys into the keychain in one sequential pass, drop them from the
+         *  held keys and clear the spool. Also finishes a build interrupted by a shutdown.
+         *
+         *  @return True if the spool was empty or fully built.
+         *
+         **/
+        bool BulkBuild();
+
+
+        /** BulkDiscard
+         *
+         *  Clear a spool that was never committed.
+         *
+         **/
+        void BulkDiscard();
+
+
         /** Exists
          *
          *  Determine if the entry identified by the given key exists.
@@ -227,7 +334,7 @@ namespace LLD
 
             /* Return the Key existance in the Keychain Database. */
             SectorKey cKey;
-            return pSectorKeys->Get(vKey, cKey);
+            return GetKey(vKey, cKey);
         }
 
 
@@ -268,7 +375,7 @@ namespace LLD
                 }
             }
 
-            return pSectorKeys->Erase(ssKey.Bytes());//Delete(ssKey.Bytes());
+            return EraseKey(ssKey.Bytes());//Delete(ssKey.Bytes());
         }
 
 
@@ -314,7 +421,7 @@ namespace LLD
 
             /* Get the key. */
             SectorKey cKey;
-            if(!pSectorKeys->Get(ssKey.Bytes(), cKey))
+            if(!GetKey(ssKey.Bytes(), cKey))
                 return false;
 
             /* The current file being read. */
@@ -395,6 +502,39 @@ namespace LLD
                             if(nSize == 0) //reached end of current file
                                 break;
 
+                            /* Decompress compressed records to read them. */
+                            if(ssData.GetPos() < ssData.size() && ssData.Bytes()[ssData.GetPos()] == COMPRESSED_RECORD)
+                            {
+                                std::vector<uint8_t> vRecord(nSize);
+                                ssData.read((char*)&vRecord[0], nSize);
+
+                                /* Read the type and value from the raw record. */
+                                std::vector<uint8_t> vRaw;
+                                if(DecompressRecord(vRecord, vRaw))
+                                {
+                                    DataStream ssRecord(vRaw, SER_LLD, DATABASE_VERSION);
+
+                                    std::string strThis;
+                                    ssRecord >> strThis;
+
+                                    if(strType == strThis)
+                                    {
+                                        Type value;
+                                        ssRecord >> value;
+
+                                        vValues.push_back(value);
+
+                                        if(nLimit != -1 && --nLimit == 0)
+                                            return (vValues.size() > 0);
+                                    }
+                                }
+
+                                /* Iterate to next position. */
+                                nStart += nSize + GetSizeOfCompactSize(nSize);
+
+                                continue;
+                            }
+
                             /* Deserialize the String. */
                             std::string strThis;
                             ssData >> strThis;
@@ -560,7 +700,7 @@ namespace LLD
 
             /* Get the key. */
             SectorKey cKey;
-            if(!pSectorKeys->Get(vIndex, cKey))
+            if(!GetKey(vIndex, cKey))
                 return false;
 
             /* Remove the item from the cache pool. */
@@ -569,7 +709,7 @@ namespace LLD
 
             /* Write the new sector key. */
             cKey.SetKey(vKey);
-            return pSectorKeys->Put(cKey);
+            return PutKey(cKey);
         }
 
 
@@ -616,7 +756,7 @@ namespace LLD
 
             /* Return the Key existance in the Keychain Database. */
             SectorKey cKey(STATE::READY, vKey, 0, 0, 0);
-            return pSectorKeys->Put(cKey);
+            return PutKey(cKey);
         }
 
 
@@ -672,6 +812,43 @@ namespace LLD
         }
 
 
+        /** GetKey
+         *
+         *  Get a sector key from the bulk load index or the keychain.
+         *
+         *  @param[in] vKey The binary data of the key.
+         *  @param[out] cKey The sector key.
+         *
+         *  @return True if the key was found.
+         *
+         **/
+        bool GetKey(const std::vector<uint8_t>& vKey, SectorKey &cKey);
+
+
+        /** PutKey
+         *
+         *  Write a sector key to the bulk load index in bulk mode, or to the keychain.
+         *
+         *  @param[in] cKey The sector key to write.
+         *
+         *  @return True if the key was written.
+         *
+         **/
+        bool PutKey(const SectorKey& cKey);
+
+
+        /** EraseKey
+         *
+         *  Erase a sector key from the keychain, or hold it as erased in bulk mode.
+         *
+         *  @param[in] vKey The binary data of the key.
+         *
+         *  @return True if the key was erased.
+         *
+         **/
+        bool EraseKey(const std::vector<uint8_t>& vKey);
+
+
         /** Get
          *
          *  Get a record from cache or from disk
@@ -705,11 +882,13 @@ namespace LLD
          *
          *  @param[in] vKey The binary data of the key to flush
          *  @param[in] vData The binary data of the record to flush
+         *  @param[in] vRecord The record as written to disk, compressed or the same as vData
          *
          *  @return True if the flush was successful.
          *
          **/
-        bool Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
+        bool Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData,
+                    const std::vector<uint8_t>& vRecord);
 
 
         /** Force
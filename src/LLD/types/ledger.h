@@ -139,6 +139,30 @@ namespace LLD
         bool ReadBestChain(memory::atomic<uint1024_t> &atomicBest);
 
 
+        /** WriteSnapshot
+         *
+         *  Writes the block a register snapshot was loaded at. Blocks before it aren't in the ledger.
+         *
+         *  @param[in] hashBlock The block hash of the snapshot checkpoint.
+         *
+         *  @return True if the write was successful, false otherwise.
+         *
+         **/
+        bool WriteSnapshot(const uint1024_t& hashBlock);
+
+
+        /** ReadSnapshot
+         *
+         *  Reads the block a register snapshot was loaded at.
+         *
+         *  @param[out] hashBlock The block hash of the snapshot checkpoint.
+         *
+         *  @return True if the ledger was loaded from a snapshot, false otherwise.
+         *
+         **/
+        bool ReadSnapshot(uint1024_t &hashBlock);
+
+
         /** ReadContract
          *
          *  Reads a contract from the ledger DB.
@@ -560,6 +584,154 @@ namespace LLD
         bool ReadStake(const uint256_t& hashGenesis, uint512_t& hashLast, const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK);
 
 
+        /** WriteHistory
+         *
+         *  Appends a contract to the history index of a register.
+         *
+         *  @param[in] hashRegister The register address the contract operates on.
+         *  @param[in] hashTx The txid of the contract.
+         *  @param[in] nContract The contract-id in the transaction.
+         *
+         *  @return True if the write was successful.
+         *
+         **/
+        bool WriteHistory(const uint256_t& hashRegister, const uint512_t& hashTx, const uint32_t nContract);
+
+
+        /** EraseHistory
+         *
+         *  Erases the newest contract from the history index of a register if it belongs to the given transaction.
+         *
+         *  @param[in] hashRegister The register address the contract operates on.
+         *  @param[in] hashTx The txid being disconnected.
+         *
+         *  @return True if the erase was successful or there was nothing to erase.
+         *
+         **/
+        bool EraseHistory(const uint256_t& hashRegister, const uint512_t& hashTx);
+
+
+        /** ReadHistory
+         *
+         *  Reads the contracts of the transaction before a position in the history index of a register,
+         *  moving the position back past them.
+         *
+         *  @param[in] hashRegister The register address to read history for.
+         *  @param[in,out] nSequence The position to read before, start with the value from ReadHistorySize.
+         *  @param[out] hashTx The txid of the contracts.
+         *  @param[out] vContracts The contract-ids in the transaction, newest first.
+         *
+         *  @return True if there was a transaction before the position.
+         *
+         **/
+        bool ReadHistory(const uint256_t& hashRegister, uint32_t &nSequence, uint512_t &hashTx, std::vector<uint32_t> &vContracts);
+
+
+        /** ReadHistorySize
+         *
+         *  Reads the number of contracts in the history index of a register.
+         *
+         *  @param[in] hashRegister The register address to read history for.
+         *  @param[out] nSequence The number of contracts indexed.
+         *
+         *  @return True if the register has any history indexed.
+         *
+         **/
+        bool ReadHistorySize(const uint256_t& hashRegister, uint32_t &nSequence);
+
+
+        /** WriteHistoryHeight
+         *
+         *  Writes the height the register history index was started at.
+         *
+         *  @param[in] nHeight The first block height covered by the index.
+         *
+         *  @return True if the write was successful.
+         *
+         **/
+        bool WriteHistoryHeight(const uint32_t nHeight);
+
+
+        /** ReadHistoryHeight
+         *
+         *  Reads the height the register history index was started at. The index is
+         *  only complete for every register if it was started at height zero.
+         *
+         *  @param[out] nHeight The first block height covered by the index.
+         *
+         *  @return True if the height was found.
+         *
+         **/
+        bool ReadHistoryHeight(uint32_t &nHeight);
+
+
+        /** WriteTally
+         *
+         *  Writes the vote tally of an account.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[in] pairTally The number of voters and the total vote weight.
+         *
+         *  @return True if the write was successful.
+         *
+         **/
+        bool WriteTally(const uint256_t& hashAccount, const std::pair<uint64_t, uint64_t>& pairTally);
+
+
+        /** ReadTally
+         *
+         *  Reads the vote tally of an account.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[out] pairTally The number of voters and the total vote weight.
+         *
+         *  @return True if the account has a vote tally.
+         *
+         **/
+        bool ReadTally(const uint256_t& hashAccount, std::pair<uint64_t, uint64_t> &pairTally);
+
+
+        /** WriteVoter
+         *
+         *  Writes a sigchain's vote in the tally of an account.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[in] hashGenesis The genesis of the voting sigchain.
+         *  @param[in] pairVoter The weight of the vote and the number of credits made.
+         *
+         *  @return True if the write was successful.
+         *
+         **/
+        bool WriteVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis, const std::pair<uint64_t, uint32_t>& pairVoter);
+
+
+        /** ReadVoter
+         *
+         *  Reads a sigchain's vote in the tally of an account.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[in] hashGenesis The genesis of the voting sigchain.
+         *  @param[out] pairVoter The weight of the vote and the number of credits made.
+         *
+         *  @return True if the sigchain's vote is counted.
+         *
+         **/
+        bool ReadVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis, std::pair<uint64_t, uint32_t> &pairVoter);
+
+
+        /** EraseVoter
+         *
+         *  Erases a sigchain's vote from the tally of an account.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[in] hashGenesis The genesis of the voting sigchain.
+         *
+         *  @return True if the erase was successful.
+         *
+         **/
+        bool EraseVoter(const uint256_t& hashAccount, const uint256_t& hashGenesis);
+
+
         /** WriteProof
          *
          *  Writes a proof to disk. Proofs are used to keep track of spent temporal proofs.
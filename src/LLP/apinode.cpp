@@ -21,6 +21,7 @@ ________________________________________________________________________________
 #include <Util/include/string.h>
 #include <Util/include/urlencode.h>
 #include <Util/include/config.h>
+#include <Util/include/metrics.h>
 #include <Util/include/base64.h>
 
 namespace LLP
@@ -90,6 +91,23 @@ namespace LLP
             return false;
         }
 
+        /* Serve the runtime metrics in the Prometheus text format. */
+        if(INCOMING.strType == "GET" && INCOMING.strRequest == "/metrics")
+        {
+            HTTPPacket RESPONSE(200);
+            RESPONSE.mapHeaders["Content-Type"] = "text/plain; version=0.0.4";
+            RESPONSE.mapHeaders["Connection"]   = "keep-alive";
+            RESPONSE.strContent = metrics::Prometheus();
+
+            /* Scrapes can be large, so compress them as well. */
+            if(INCOMING.mapHeaders.count("accept-encoding"))
+                RESPONSE.Compress(INCOMING.mapHeaders["accept-encoding"]);
+
+            this->WritePacket(RESPONSE);
+
+            return true;
+        }
+
         /* Parse the packet request. */
         std::string::size_type npos = INCOMING.strRequest.find('/', 1);
 
@@ -102,6 +120,12 @@ namespace LLP
         /* The JSON response */
         json::json ret;
 
+        /* The response content when the method streams its result directly. */
+        std::string strContent;
+
+        /* Flag indicating that the response was streamed into strContent. */
+        bool fStreamed = false;
+
         /* The HTTP response status code, default to 200 unless an error is encountered */
         uint16_t nStatus = 200;
 
@@ -208,35 +232,54 @@ namespace LLP
                 return true;
             }
 
-            /* Execute the api and methods. */
+            /* Find the api to execute the method on. */
+            TAO::API::Base* pAPI = nullptr;
             if(strAPI == "supply")
-                ret = { {"result", TAO::API::supply->Execute(METHOD, params) } };
+                pAPI = TAO::API::supply;
             else if(strAPI == "users")
-                ret = { {"result", TAO::API::users->Execute(METHOD, params) } };
+                pAPI = TAO::API::users;
             else if(strAPI == "assets")
-                ret = { {"result", TAO::API::assets->Execute(METHOD, params) } };
+                pAPI = TAO::API::assets;
             else if(strAPI == "ledger")
-                ret = { {"result", TAO::API::ledger->Execute(METHOD, params) } };
+                pAPI = TAO::API::ledger;
             else if(strAPI == "tokens")
-                ret = { {"result", TAO::API::tokens->Execute(METHOD, params) } };
+                pAPI = TAO::API::tokens;
             else if(strAPI == "system")
-                ret = { {"result", TAO::API::system->Execute(METHOD, params) } };
+                pAPI = TAO::API::system;
             else if(strAPI == "finance")
-                ret = { {"result", TAO::API::finance->Execute(METHOD, params) } };
+                pAPI = TAO::API::finance;
             else if(strAPI == "names")
-                ret = { {"result", TAO::API::names->Execute(METHOD, params) } };
+                pAPI = TAO::API::names;
             else if(strAPI == "dex")
-                ret = { {"result", TAO::API::dex->Execute(METHOD, params) } };
+                pAPI = TAO::API::dex;
             else if(strAPI == "voting")
-                ret = { {"result", TAO::API::voting->Execute(METHOD, params) } };
+                pAPI = TAO::API::voting;
             else if(strAPI == "invoices")
-                ret = { {"result", TAO::API::invoices->Execute(METHOD, params) } };
+                pAPI = TAO::API::invoices;
             else if(strAPI == "crypto")
-                ret = { {"result", TAO::API::crypto->Execute(METHOD, params) } };
+                pAPI = TAO::API::crypto;
             else if(strAPI == "p2p")
-                ret = { {"result", TAO::API::p2p->Execute(METHOD, params) } };
+                pAPI = TAO::API::p2p;
             else
                 throw TAO::API::APIException(-4, debug::safe_printstr("API not found: ", strAPI));
+
+            /* Stream the result directly into the response content if the method supports it. */
+            json::writer writer(strContent);
+            writer.BeginObject();
+            writer.Key("result");
+
+            if(pAPI->Stream(METHOD, params, writer))
+            {
+                writer.EndObject();
+                fStreamed = true;
+            }
+
+            /* Otherwise execute the method and build the response tree. */
+            else
+            {
+                strContent.clear();
+                ret = { {"result", pAPI->Execute(METHOD, params) } };
+            }
         }
 
         /* Handle for custom API exceptions. */
@@ -273,8 +316,10 @@ namespace LLP
                     break;
             }
 
-            /* Populate the return JSON to the error */
+            /* Populate the return JSON to the error, discarding any partially streamed result. */
             ret = { { "error", jsonError } };
+            strContent.clear();
+            fStreamed = false;
 
         }
 
@@ -299,8 +344,15 @@ namespace LLP
         }
 
         /* Add content. */
-        RESPONSE.strContent = ret.dump();
-            
+        if(fStreamed)
+            RESPONSE.strContent = std::move(strContent);
+        else
+            RESPONSE.strContent = ret.dump();
+
+        /* Compress the content here rather than on the flush thread. */
+        if(INCOMING.mapHeaders.count("accept-encoding"))
+            RESPONSE.Compress(INCOMING.mapHeaders["accept-encoding"]);
+
         /* Write the response */
         this->WritePacket(RESPONSE);
 
@@ -34,17 +34,21 @@ namespace LLP
     DataThread<ProtocolType>::DataThread(uint32_t nID, bool ffDDOSIn,
                                          uint32_t rScore, uint32_t cScore,
                                          uint32_t nTimeout, bool fMeter)
-    : SLOT_MUTEX      ( )
-    , fDDOS           (ffDDOSIn)
+    : fDDOS           (ffDDOSIn)
     , fMETER          (fMeter)
     , fDestruct       (false)
     , nIncoming       (0)
     , nOutbound       (0)
+    , PACKETS         (metrics::GetCounter("nexus_llp_packets_total", metrics::Label("server", ProtocolType::Name())))
+    , BYTES_READ      (metrics::GetCounter("nexus_llp_read_bytes_total", metrics::Label("server", ProtocolType::Name())))
+    , BYTES_WRITTEN   (metrics::GetCounter("nexus_llp_written_bytes_total", metrics::Label("server", ProtocolType::Name())))
+    , INCOMING        (metrics::GetGauge("nexus_llp_connections", metrics::Label("server", ProtocolType::Name()) + ",direction=\"incoming\""))
+    , OUTBOUND        (metrics::GetGauge("nexus_llp_connections", metrics::Label("server", ProtocolType::Name()) + ",direction=\"outbound\""))
     , ID              (nID)
     , TIMEOUT         (nTimeout)
     , DDOS_rSCORE     (rScore)
     , DDOS_cSCORE     (cScore)
-    , CONNECTIONS     (memory::atomic_ptr< std::vector<memory::atomic_ptr<ProtocolType>> >(new std::vector<memory::atomic_ptr<ProtocolType>>()))
+    , CONNECTIONS     ( )
     , RELAY           (memory::atomic_ptr< std::queue<std::pair<typename ProtocolType::message_t, DataStream>> >(new std::queue<std::pair<typename ProtocolType::message_t, DataStream>>()))
     , CONDITION       ( )
     , DATA_THREAD     (std::bind(&DataThread::Thread, this))
@@ -67,7 +71,6 @@ namespace LLP
         if(FLUSH_THREAD.joinable())
             FLUSH_THREAD.join();
 
-        CONNECTIONS.free();
         RELAY.free();
     }
 
@@ -80,11 +83,12 @@ namespace LLP
         /* Iterate through connections to remove. When call on destruct, simply remove the connection. Otherwise,
          * force a disconnect event. This will inform address manager so it knows to attempt new connections.
          */
-        for(uint32_t nIndex = 0; nIndex < CONNECTIONS->size(); ++nIndex)
+        uint32_t nSize = CONNECTIONS.size();
+        for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
         {
             if(!fDestruct.load())
                 disconnect_remove_event(nIndex, DISCONNECT::FORCE);
-            else
+            else if(CONNECTIONS.Claim(nIndex))
                 remove(nIndex);
         }
     }
@@ -133,7 +137,7 @@ namespace LLP
                 return;
 
             /* Wrapped mutex lock. */
-            uint32_t nSize = static_cast<uint32_t>(CONNECTIONS->size());
+            uint32_t nSize = static_cast<uint32_t>(CONNECTIONS.size());
 
             /* Check the pollfd's size. */
             if(POLLFDS.size() != nSize)
@@ -151,7 +155,7 @@ namespace LLP
                     POLLFDS.at(nIndex).revents = 0; //reset return events
 
                     /* Set to invalid socket if connection is inactive. */
-                    if(!CONNECTIONS->at(nIndex))
+                    if(!CONNECTIONS.at(nIndex))
                     {
                         POLLFDS.at(nIndex).fd = INVALID_SOCKET;
 
@@ -159,7 +163,7 @@ namespace LLP
                     }
 
                     /* Set the correct file descriptor. */
-                    POLLFDS.at(nIndex).fd = CONNECTIONS->at(nIndex)->fd;
+                    POLLFDS.at(nIndex).fd = CONNECTIONS.at(nIndex)->fd;
                 }
                 catch(const std::exception& e)
                 {
@@ -188,7 +192,7 @@ namespace LLP
                 try
                 {
                     /* Load the atomic pointer raw data. */
-                    ProtocolType* CONNECTION = CONNECTIONS->at(nIndex).load();
+                    ProtocolType* CONNECTION = CONNECTIONS.at(nIndex).load();
 
                     /* Skip over Inactive Connections. */
                     if(!CONNECTION || !CONNECTION->Connected())
@@ -268,8 +272,8 @@ namespace LLP
                     /* Work on Reading a Packet. **/
                     CONNECTION->ReadPacket();
 
-                    /* If a Packet was received successfully, increment request count [and DDOS count if enabled]. */
-                    if(CONNECTION->PacketComplete())
+                    /* Process every complete packet, including requests pipelined behind the first one where the protocol allows. */
+                    for(uint32_t nPacket = 0; nPacket < ProtocolType::MaxPipeline() && CONNECTION->PacketComplete(); ++nPacket)
                     {
                         /* Debug dump of message type. */
                         if(config::nVerbose.load() >= 4)
@@ -283,20 +287,32 @@ namespace LLP
                         if(fMETER)
                             ++ProtocolType::REQUESTS;
 
+                        PACKETS.Add();
+
                         /* Increment rScore. */
                         if(fDDOS && CONNECTION->DDOS)
                             CONNECTION->DDOS->rSCORE += 1;
 
                         /* Packet Process return value of False will flag Data Thread to Disconnect. */
-                        if(!CONNECTION->ProcessPacket())
+                        bool fProcessed = false;
+                        {
+                            trace::Span span("LLP::ProcessPacket", "llp");
+                            fProcessed = CONNECTION->ProcessPacket();
+                        }
+
+                        if(!fProcessed)
                         {
                             disconnect_remove_event(nIndex, DISCONNECT::FORCE);
-                            continue;
+                            break;
                         }
 
                         /* Run procssed event for connection triggers. */
                         CONNECTION->Event(EVENTS::PROCESSED);
                         CONNECTION->ResetPacket();
+
+                        /* Parse the next packet out of any data already buffered. */
+                        if(nPacket + 1 < ProtocolType::MaxPipeline())
+                            CONNECTION->ReadPacket();
                     }
                 }
                 catch(const std::exception& e)
@@ -338,12 +354,18 @@ namespace LLP
                         return true;
 
                     /* Check for buffered connection. */
-                    for(uint32_t nIndex = 0; nIndex < CONNECTIONS->size(); ++nIndex)
+                    uint32_t nSize = CONNECTIONS.size();
+                    for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
                     {
                         try
                         {
+                            /* Skip over empty slots. */
+                            memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS.at(nIndex);
+                            if(!CONNECTION)
+                                continue;
+
                             /* Check for buffered connection. */
-                            if(CONNECTIONS->at(nIndex)->Buffered())
+                            if(CONNECTION->Buffered())
                                 return true;
                         }
                         catch(const std::exception& e) { }
@@ -369,7 +391,7 @@ namespace LLP
             }
 
             /* Check all connections for data and packets. */
-            uint32_t nSize = CONNECTIONS->size();
+            uint32_t nSize = CONNECTIONS.size();
             for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
                 try
@@ -378,7 +400,9 @@ namespace LLP
                     qRelay.second.Reset();
 
                     /* Get atomic pointer to reduce locking around CONNECTIONS scope. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nIndex);
+                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS.at(nIndex);
+                    if(!CONNECTION)
+                        continue;
 
                     /* Relay if there are active subscriptions. */
                     const DataStream ssRelay = CONNECTION->RelayFilter(qRelay.first, qRelay.second);
@@ -407,10 +431,18 @@ namespace LLP
     void DataThread<ProtocolType>::NotifyEvent()
     {
         /* Loop through each connection. */
-        uint32_t nSize = static_cast<uint32_t>(CONNECTIONS->size());
+        uint32_t nSize = static_cast<uint32_t>(CONNECTIONS.size());
         for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
         {
-            try { CONNECTIONS->at(nIndex)->NotifyEvent(); }
+            try
+            {
+                /* Skip over empty slots. */
+                memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS.at(nIndex);
+                if(!CONNECTION)
+                    continue;
+
+                CONNECTION->NotifyEvent();
+            }
             catch(const std::exception& e) { }
         }
     }
@@ -437,7 +469,11 @@ namespace LLP
     template <class ProtocolType>
     void DataThread<ProtocolType>::disconnect_remove_event(uint32_t nIndex, uint8_t nReason)
     {
-        ProtocolType* raw = CONNECTIONS->at(nIndex).load(); //we use raw pointer here because event could contain switch node that will cause deadlocks
+        /* Claim the slot so that only one thread fires the event and frees the connection. */
+        if(!CONNECTIONS.Claim(nIndex))
+            return;
+
+        ProtocolType* raw = CONNECTIONS.at(nIndex).load(); //we use raw pointer here because event could contain switch node that will cause deadlocks
         raw->Event(EVENTS::DISCONNECT, nReason);
 
         remove(nIndex);
@@ -448,33 +484,63 @@ namespace LLP
     template <class ProtocolType>
     void DataThread<ProtocolType>::remove(uint32_t nIndex)
     {
-        LOCK(SLOT_MUTEX);
-
         /* Check for inbound socket. */
-        if(CONNECTIONS->at(nIndex)->Incoming())
+        if(CONNECTIONS.at(nIndex)->Incoming())
+        {
             --nIncoming;
+            INCOMING.Add(-1);
+        }
         else
+        {
             --nOutbound;
+            OUTBOUND.Add(-1);
+        }
 
-        /* Free the memory. */
-        CONNECTIONS->at(nIndex).free();
+        /* Free the memory and put the slot on the free list. */
+        CONNECTIONS.Release(nIndex);
         CONDITION.notify_all();
     }
 
 
-    /* Returns the index of a component of the CONNECTIONS vector that has been flagged Disconnected */
+    /* Adds a connected node to a free slot and fires the connect event. */
     template <class ProtocolType>
-    uint32_t DataThread<ProtocolType>::find_slot()
+    bool DataThread<ProtocolType>::insert(ProtocolType* pnode)
     {
-        /* Loop through each connection. */
-        uint32_t nSize = static_cast<uint32_t>(CONNECTIONS->size());
-        for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
+        /* Find an available slot. */
+        uint32_t nSlot = 0;
+        if(!CONNECTIONS.Reserve(nSlot))
         {
-            if(!CONNECTIONS->at(nIndex))
-                return nIndex;
+            delete pnode;
+            return debug::error(FUNCTION, "no free connection slots on data thread ", ID);
         }
 
-        return nSize;
+        /* Update the indexes. */
+        pnode->nDataThread     = ID;
+        pnode->nDataIndex      = nSlot;
+        pnode->FLUSH_CONDITION = &FLUSH_CONDITION;
+
+        /* Count the socket traffic under this server. */
+        pnode->pBytesRead    = &BYTES_READ;
+        pnode->pBytesWritten = &BYTES_WRITTEN;
+
+        /* Fire the connected event before the connection is visible to other threads. */
+        pnode->Event(EVENTS::CONNECT);
+
+        /* Count the connection before it is visible, so a fast disconnect can't underflow the counters. */
+        if(pnode->Incoming())
+        {
+            ++nIncoming;
+            INCOMING.Add(1);
+        }
+        else
+        {
+            ++nOutbound;
+            OUTBOUND.Add(1);
+        }
+
+        CONNECTIONS.Store(nSlot, pnode);
+
+        return true;
     }
 
 
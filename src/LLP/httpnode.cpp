@@ -17,6 +17,9 @@ ________________________________________________________________________________
 #include <Util/include/string.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 namespace LLP
 {
@@ -24,6 +27,11 @@ namespace LLP
     /** Default Constructor **/
     HTTPNode::HTTPNode()
     : BaseConnection<HTTPPacket> ( )
+    , vchRead                    ( )
+    , nBufferPos                 (0)
+    , nScanPos                   (0)
+    , nChunkSize                 (0)
+    , nChunkState                (CHUNK::SIZE)
     , vchBuffer                  ( )
     {
     }
@@ -32,6 +40,11 @@ namespace LLP
     /** Constructor **/
     HTTPNode::HTTPNode(const Socket &SOCKET_IN, DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : BaseConnection<HTTPPacket> (SOCKET_IN, DDOS_IN, fDDOSIn)
+    , vchRead                    ( )
+    , nBufferPos                 (0)
+    , nScanPos                   (0)
+    , nChunkSize                 (0)
+    , nChunkState                (CHUNK::SIZE)
     , vchBuffer                  ( )
     {
     }
@@ -40,6 +53,11 @@ namespace LLP
     /** Constructor **/
     HTTPNode::HTTPNode(DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : BaseConnection<HTTPPacket> (DDOS_IN, fDDOSIn)
+    , vchRead                    ( )
+    , nBufferPos                 (0)
+    , nScanPos                   (0)
+    , nChunkSize                 (0)
+    , nChunkState                (CHUNK::SIZE)
     , vchBuffer                  ( )
     {
     }
@@ -69,94 +87,327 @@ namespace LLP
             /* Handle Reading Data into Buffer. */
             uint32_t nAvailable = Available();
             if(nAvailable > 0)
-            {                
-                std::vector<int8_t> vchData(nAvailable);
-                int nRead = Read(vchData, nAvailable);
+            {
+                /* Grow the scratch buffer only when a larger read comes in. */
+                if(vchRead.size() < nAvailable)
+                    vchRead.resize(nAvailable);
+
+                int nRead = Read(vchRead, nAvailable);
                 if(nRead > 0)
-                    vchBuffer.insert(vchBuffer.end(), vchData.begin(), vchData.begin() + nRead);
+                    vchBuffer.insert(vchBuffer.end(), vchRead.begin(), vchRead.begin() + nRead);
+            }
+
+            /* Continue parsing from where the last read left off. */
+            if(!Parse())
+            {
+                DoS(20, false);
+                throw debug::exception(FUNCTION, "malformed HTTP request from ", addr.ToStringIP());
             }
+        }
+    }
+
 
-            /* If waiting for buffer data, don't try to parse. */
-            if(vchBuffer.size() == 0)
-                return;
+    /* Incremental parser that continues building the incoming packet from the read buffer. */
+    bool HTTPNode::Parse()
+    {
+        /* Check once per call if headers should be dumped. */
+        const bool fDump = config::GetBoolArg("-httpheader");
 
-            /* Allow up to 10 iterations to parse the header. */
-            for(int i = 0; i < 10; ++i)
+        /* Keep going until the packet is built or we run out of data. */
+        while(!INCOMING.Complete() && nBufferPos < vchBuffer.size())
+        {
+            /* Read the request line and headers line by line. */
+            if(!INCOMING.fHeader)
             {
-                /* Read content if there is some. */
-                if(INCOMING.fHeader)
+                uint32_t nBegin = 0, nLength = 0;
+                if(!ReadLine(nBegin, nLength))
                 {
-                    INCOMING.strContent += std::string(vchBuffer.begin(), vchBuffer.end());
-                    vchBuffer.clear();
-                    return;
-                }
+                    /* Don't let a line grow without bounds. */
+                    if(vchBuffer.size() - nBufferPos > MAX_HTTP_LINE)
+                        return debug::error(FUNCTION, "header line exceeds ", MAX_HTTP_LINE, " bytes");
 
-                /* Break out the lines by the input buffer. */
-                auto it = std::find(vchBuffer.begin(), vchBuffer.end(), '\n');
+                    break;
+                }
 
-                /* Return if a full line hasn't been read yet. */
-                if(it == vchBuffer.end())
-                    return;
+                /* Dump the header if requested on read. */
+                if(fDump)
+                    debug::log(0, std::string(&vchBuffer[nBegin], &vchBuffer[nBegin] + nLength));
 
-                /* Check for the end of header with double CLRF. */
-                if(vchBuffer.begin() == (it - 1))
+                /* Check for the end of header with double CRLF. */
+                if(nLength == 0)
                 {
-                    INCOMING.fHeader = true;
+                    /* Skip empty lines between pipelined requests. */
+                    if(INCOMING.strType.empty())
+                        continue;
+
+                    /* Reserve the whole content up front for the fast path. */
+                    if(!INCOMING.fChunked)
+                        INCOMING.strContent.reserve(INCOMING.nContentLength);
 
-                    vchBuffer.erase(vchBuffer.begin(), it + 1); //erase the CLRF
-                    //this->Event()
-                    //TODO: assess the events code and calling virutal method from lower class in the inheritance heirarchy
+                    INCOMING.fHeader = true;
+                    continue;
                 }
 
-                /* Read all the headers. */
-                else if(!INCOMING.fHeader)
+                /* Handle the request line. */
+                if(INCOMING.strType.empty())
                 {
-                    /* Extract the line from the buffer. */
-                    std::string strLine = std::string(vchBuffer.begin(), it - 1);
+                    if(!ParseRequest(nBegin, nLength))
+                        return false;
+                }
 
-                    /* Dump the header if requested on read. */
-                    if(config::GetBoolArg("-httpheader"))
-                        debug::log(0, strLine);
+                /* Handle normal headers. */
+                else if(!ParseHeader(nBegin, nLength))
+                    return false;
+            }
 
-                    /* Find the delimiter to split. */
-                    std::string::size_type pos = strLine.find(':', 0);
+            /* Handle the chunked transfer encoding. */
+            else if(INCOMING.fChunked)
+            {
+                if(!ParseChunked())
+                    return false;
 
-                    /* Handle the request types. */
-                    if(INCOMING.strType == "")
-                    {
-                        /* Find the end of request type. */
-                        std::string::size_type npos = strLine.find(' ', 0);
-                        INCOMING.strType = strLine.substr(0, npos);
+                break;
+            }
 
-                        /* Find the start of version. */
-                        std::string::size_type npos2 = strLine.find(' ', npos + 1);
-                        INCOMING.strVersion = strLine.substr(npos2 + 1);
+            /* Content-Length fast path, copy as much of the content as we have in one go. */
+            else
+            {
+                const uint32_t nCopy = std::min(INCOMING.nContentLength - static_cast<uint32_t>(INCOMING.strContent.size()),
+                                                static_cast<uint32_t>(vchBuffer.size() - nBufferPos));
 
-                        /* Parse request from between the two. */
-                        INCOMING.strRequest = strLine.substr(npos + 1, npos2 - INCOMING.strType.length() - 1);
+                INCOMING.strContent.append(reinterpret_cast<const char*>(&vchBuffer[nBufferPos]), nCopy);
+                nBufferPos += nCopy;
+            }
+        }
 
-                    }
+        /* Drop the parsed bytes, keeping the start of any pipelined request. */
+        if(nBufferPos == vchBuffer.size())
+        {
+            vchBuffer.clear();
+            nBufferPos = 0;
+            nScanPos   = 0;
+        }
+        else if(INCOMING.Complete() || INCOMING.fHeader)
+        {
+            vchBuffer.erase(vchBuffer.begin(), vchBuffer.begin() + nBufferPos);
+            nScanPos   = (nScanPos > nBufferPos) ? nScanPos - nBufferPos : 0;
+            nBufferPos = 0;
+        }
 
-                    /* Handle normal headers. */
-                    else if(pos != std::string::npos)
-                    {
-                        /* Set the field value to lowercase. */
-                        std::string strField = ToLower(strLine.substr(0, pos));
+        return true;
+    }
+
+
+    /* Find the next full line in the buffer starting at the parse offset. */
+    bool HTTPNode::ReadLine(uint32_t &nBegin, uint32_t &nLength)
+    {
+        /* Resume the search where the last one for this line stopped. */
+        if(nScanPos < nBufferPos)
+            nScanPos = nBufferPos;
+
+        /* Search only the bytes not looked at yet. */
+        const int8_t* pBegin = &vchBuffer[nBufferPos];
+        const int8_t* pEnd   = static_cast<const int8_t*>(std::memchr(&vchBuffer[nScanPos], '\n', vchBuffer.size() - nScanPos));
+        if(!pEnd)
+        {
+            nScanPos = static_cast<uint32_t>(vchBuffer.size());
+            return false;
+        }
+
+        /* Set the view of the line, without the CRLF. */
+        nBegin  = nBufferPos;
+        nLength = static_cast<uint32_t>(pEnd - pBegin);
+        if(nLength > 0 && vchBuffer[nBegin + nLength - 1] == '\r')
+            --nLength;
+
+        /* Move past the line. */
+        nBufferPos += static_cast<uint32_t>(pEnd - pBegin) + 1;
+        nScanPos    = nBufferPos;
+
+        return true;
+    }
+
+
+    /* Parse the request line or status line of a packet. */
+    bool HTTPNode::ParseRequest(const uint32_t nBegin, const uint32_t nLength)
+    {
+        const char* pLine = reinterpret_cast<const char*>(&vchBuffer[nBegin]);
+        const char* pEnd  = pLine + nLength;
+
+        /* Find the end of request type. */
+        const char* pType = std::find(pLine, pEnd, ' ');
+        if(pType == pEnd)
+            return debug::error(FUNCTION, "malformed request line");
+
+        /* Find the start of version. */
+        const char* pRequest = std::find(pType + 1, pEnd, ' ');
+        if(pRequest == pEnd)
+            return debug::error(FUNCTION, "malformed request line");
+
+        /* Parse request from between the two. */
+        INCOMING.strType.assign(pLine, pType);
+        INCOMING.strRequest.assign(pType + 1, pRequest);
+        INCOMING.strVersion.assign(pRequest + 1, pEnd);
+
+        return true;
+    }
 
-                        /* Parse out the content length field. */
-                        if(strField == "content-length")
-                            INCOMING.nContentLength = std::stoul(strLine.substr(pos + 2));
 
-                        /* Add line to the headers map. */
-                        INCOMING.mapHeaders[strField] = strLine.substr(pos + 2);
+    /* Parse one header field line into the packet headers. */
+    bool HTTPNode::ParseHeader(const uint32_t nBegin, const uint32_t nLength)
+    {
+        const char* pLine = reinterpret_cast<const char*>(&vchBuffer[nBegin]);
+        const char* pEnd  = pLine + nLength;
+
+        /* Find the delimiter to split. */
+        const char* pColon = std::find(pLine, pEnd, ':');
+        if(pColon == pEnd || pColon == pLine)
+            return debug::error(FUNCTION, "malformed header field");
+
+        /* Check the header count. */
+        if(INCOMING.mapHeaders.size() >= MAX_HTTP_HEADERS)
+            return debug::error(FUNCTION, "too many header fields");
+
+        /* Trim the whitespace around the value. */
+        const char* pValue = pColon + 1;
+        while(pValue < pEnd && (*pValue == ' ' || *pValue == '\t'))
+            ++pValue;
+
+        const char* pValueEnd = pEnd;
+        while(pValueEnd > pValue && (*(pValueEnd - 1) == ' ' || *(pValueEnd - 1) == '\t'))
+            --pValueEnd;
+
+        /* Set the field value to lowercase. */
+        std::string strField(pLine, pColon);
+        for(auto& ch : strField)
+            ch = std::tolower(ch);
+
+        /* Parse out the content length field. */
+        if(strField == "content-length")
+        {
+            char* pParsed = nullptr;
+            const std::string strLength(pValue, pValueEnd);
+
+            const uint64_t nContentLength = std::strtoull(strLength.c_str(), &pParsed, 10);
+            if(strLength.empty() || *pParsed != '\0')
+                return debug::error(FUNCTION, "malformed content-length ", strLength);
+
+            /* Check against our maximum. */
+            if(nContentLength > MAX_HTTP_CONTENT)
+                return debug::error(FUNCTION, "content-length ", nContentLength, " exceeds maximum ", MAX_HTTP_CONTENT);
+
+            /* Chunked encoding takes precedence over the length. */
+            if(!INCOMING.fChunked)
+                INCOMING.nContentLength = static_cast<uint32_t>(nContentLength);
+        }
+
+        /* Check for chunked transfer encoding. */
+        else if(strField == "transfer-encoding")
+        {
+            std::string strEncoding(pValue, pValueEnd);
+            for(auto& ch : strEncoding)
+                ch = std::tolower(ch);
+
+            if(strEncoding.find("chunked") != std::string::npos)
+            {
+                INCOMING.fChunked       = true;
+                INCOMING.nContentLength = 0;
+
+                nChunkSize  = 0;
+                nChunkState = CHUNK::SIZE;
+            }
+        }
+
+        /* Add line to the headers map. */
+        INCOMING.mapHeaders[std::move(strField)].assign(pValue, pValueEnd);
+
+        return true;
+    }
+
+
+    /* Decode as much chunked content from the buffer as is available. */
+    bool HTTPNode::ParseChunked()
+    {
+        while(INCOMING.fChunked && nBufferPos < vchBuffer.size())
+        {
+            /* Copy the data of the current chunk. */
+            if(nChunkState == CHUNK::DATA)
+            {
+                const uint32_t nCopy = std::min(nChunkSize, static_cast<uint32_t>(vchBuffer.size() - nBufferPos));
 
+                INCOMING.strContent.append(reinterpret_cast<const char*>(&vchBuffer[nBufferPos]), nCopy);
+                nBufferPos += nCopy;
+                nChunkSize -= nCopy;
+
+                /* Expect the CRLF after the chunk data. */
+                if(nChunkSize == 0)
+                    nChunkState = CHUNK::END;
+
+                continue;
+            }
+
+            /* All other states work on full lines. */
+            uint32_t nBegin = 0, nLength = 0;
+            if(!ReadLine(nBegin, nLength))
+            {
+                /* Don't let a line grow without bounds. */
+                if(vchBuffer.size() - nBufferPos > MAX_HTTP_LINE)
+                    return debug::error(FUNCTION, "chunk line exceeds ", MAX_HTTP_LINE, " bytes");
+
+                break;
+            }
+
+            switch(nChunkState)
+            {
+                /* Parse the hex chunk size, ignoring any chunk extensions. */
+                case CHUNK::SIZE:
+                {
+                    const std::string strSize(&vchBuffer[nBegin], &vchBuffer[nBegin] + nLength);
+
+                    char* pParsed = nullptr;
+                    const uint64_t nSize = std::strtoull(strSize.c_str(), &pParsed, 16);
+                    if(pParsed == strSize.c_str() || (*pParsed != '\0' && *pParsed != ';' && *pParsed != ' '))
+                        return debug::error(FUNCTION, "malformed chunk size ", strSize);
+
+                    /* Check against our maximum. */
+                    if(nSize > MAX_HTTP_CONTENT - INCOMING.strContent.size())
+                        return debug::error(FUNCTION, "chunked content exceeds maximum ", MAX_HTTP_CONTENT);
+
+                    /* The last chunk is followed by the trailer. */
+                    nChunkSize  = static_cast<uint32_t>(nSize);
+                    nChunkState = (nChunkSize == 0 ? CHUNK::TRAILER : CHUNK::DATA);
+
+                    break;
+                }
+
+                /* The CRLF after the chunk data. */
+                case CHUNK::END:
+                {
+                    if(nLength != 0)
+                        return debug::error(FUNCTION, "missing CRLF after chunk data");
+
+                    nChunkState = CHUNK::SIZE;
+
+                    break;
+                }
+
+                /* Skip trailer fields until the empty line that ends the content. */
+                case CHUNK::TRAILER:
+                {
+                    if(nLength == 0)
+                    {
+                        INCOMING.nContentLength = static_cast<uint32_t>(INCOMING.strContent.size());
+                        INCOMING.fChunked       = false;
+
+                        nChunkState = CHUNK::SIZE;
                     }
 
-                    /* Erase line read from the read buffer. */
-                    vchBuffer.erase(vchBuffer.begin(), it + 1);
+                    break;
                 }
             }
         }
+
+        return true;
     }
 
 
@@ -169,6 +420,10 @@ namespace LLP
             HTTPPacket RESPONSE(nMsg);
             RESPONSE.strContent = strContent;
 
+            /* Compress the content if the client accepts it. */
+            if(INCOMING.mapHeaders.count("accept-encoding"))
+                RESPONSE.Compress(INCOMING.mapHeaders["accept-encoding"]);
+
             this->WritePacket(RESPONSE);
         }
         catch(...)
@@ -16,10 +16,13 @@ ________________________________________________________________________________
 #define NEXUS_LLP_INCLUDE_MANAGER_H
 
 #include <LLP/include/trust_address.h>
+
+#include <Util/templates/ranked_set.h>
 #include <map>
 #include <vector>
 #include <cstdint>
 #include <mutex>
+#include <tuple>
 
 /* forward declarations */
 namespace LLD
@@ -363,6 +366,40 @@ namespace LLP
         void update_state(TrustAddress *pAddr, uint8_t nState);
 
 
+        /** select_key
+         *
+         *  Gets the key of an address in the selection index, best addresses first.
+         *
+         *  @param[in] hash The hash of the address.
+         *  @param[in] addr The trust address.
+         *
+         **/
+        static std::tuple<double, uint32_t, uint64_t> select_key(const uint64_t hash, const TrustAddress &addr);
+
+
+        /** index_address
+         *
+         *  Adds an address to the selection index if it can be selected.
+         *
+         *  @param[in] hash The hash of the address.
+         *  @param[in] addr The trust address.
+         *
+         **/
+        void index_address(const uint64_t hash, const TrustAddress &addr);
+
+
+        /** unindex_address
+         *
+         *  Removes an address from the selection index. Must be called before
+         *  anything that changes the address score or state.
+         *
+         *  @param[in] hash The hash of the address.
+         *  @param[in] addr The trust address.
+         *
+         **/
+        void unindex_address(const uint64_t hash, const TrustAddress &addr);
+
+
     private:
 
         /* The map of trust addresses to track. */
@@ -374,6 +411,9 @@ namespace LLP
         /* The map of DNS related addresses. */
         std::map<uint64_t, std::string> mapDNS;
 
+        /* The addresses that can be selected, ordered by score. */
+        ranked_set< std::tuple<double, uint32_t, uint64_t> > setSelect;
+
         /* The mutex used for thread locking. */
         mutable std::mutex MUTEX;
 
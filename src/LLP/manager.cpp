@@ -31,11 +31,18 @@ ________________________________________________________________________________
 
 namespace LLP
 {
+    /* The states of addresses that can be selected for a new connection. */
+    const uint8_t SELECT_FLAGS = ConnectState::NEW     |
+                                 ConnectState::FAILED  |
+                                 ConnectState::DROPPED ;
+
+
     /* Default constructor */
     AddressManager::AddressManager(uint16_t nPortIn)
     : mapTrustAddress()
     , mapBanned()
     , mapDNS()
+    , setSelect()
     , MUTEX()
     , pDatabase(nullptr)
     , nPort(nPortIn)
@@ -124,16 +131,20 @@ namespace LLP
             return;
 
         /* Add address to map if not already added. */
-        if(mapTrustAddress.find(hash) == mapTrustAddress.end())
-            mapTrustAddress[hash] = addr;
+        auto it = mapTrustAddress.find(hash);
+        if(it == mapTrustAddress.end())
+            it = mapTrustAddress.insert(std::make_pair(hash, TrustAddress(addr))).first;
+        else
+            unindex_address(hash, it->second);
 
         /* Set the port number to match this server */
-        TrustAddress& trust_addr = mapTrustAddress[hash];
+        TrustAddress& trust_addr = it->second;
         trust_addr.SetPort(nPort);
         trust_addr.nSession = nSession;
 
         /* Update the stats for this address based on the nState. */
         update_state(&trust_addr, nState);
+        index_address(hash, trust_addr);
 
         /* Update the LLD Address database for this entry */
         pDatabase->WriteTrustAddress(hash, trust_addr);
@@ -240,7 +251,10 @@ namespace LLP
         auto it = mapTrustAddress.find(hash);
         if(it != mapTrustAddress.end())
         {
+            /* Latency is part of the score, so re-index the address. */
+            unindex_address(hash, it->second);
             it->second.nLatency = lat;
+            index_address(hash, it->second);
 
             /* Update the LLD Address database for this entry */
             pDatabase->WriteTrustAddress(hash, it->second);
@@ -269,43 +283,30 @@ namespace LLP
     /*  Select a good address to connect to that isn't already connected. */
     bool AddressManager::StochasticSelect(BaseAddress &addr)
     {
-        std::vector<TrustAddress> vAddresses;
-        uint64_t nSelect = 0;
         uint64_t nTimestamp = runtime::unifiedtimestamp();
         uint64_t nRand = LLC::GetRand(nTimestamp);
         uint32_t nHash = LLC::SK32(BEGIN(nRand), END(nRand));
 
+        /* Select a rank with a random weighted bias toward the best scores. */
+        uint64_t nWeighted = (std::numeric_limits<uint64_t>::max() /
+            std::max((uint64_t)std::pow(nHash, 1.95) + 1, (uint64_t)1)) - 3;
 
-        /* Put unconnected address info scores into a vector and sort them. */
-        uint8_t nFlags = ConnectState::NEW     |
-                         ConnectState::FAILED  |
-                         ConnectState::DROPPED ;
-
-        /* Critical section: Get address info for the selected nFlags. */
-        {
-            LOCK(MUTEX);
-            get_addresses(vAddresses, nFlags);
-        }
-
-        uint64_t nSize = vAddresses.size();
+        /* Critical section: Get the address at the selected rank of the score index. */
+        LOCK(MUTEX);
 
+        uint64_t nSize = setSelect.size();
         if(nSize == 0)
             return false;
 
-        /* Select an index with a random weighted bias toward the front of the list. */
-        nSelect = ((std::numeric_limits<uint64_t>::max() /
-            std::max((uint64_t)std::pow(nHash, 1.95) + 1, (uint64_t)1)) - 3) % nSize;
-
-        if(nSelect >= nSize)
-          return debug::error(FUNCTION, "index out of bounds");
+        uint64_t nSelect = nWeighted % nSize;
 
-        /* sort info vector and assign the selected address */
-        std::sort(vAddresses.begin(), vAddresses.end());
-        std::reverse(vAddresses.begin(), vAddresses.end());
+        /* Find the address for the selected index entry. */
+        auto it = mapTrustAddress.find(std::get<2>(setSelect.at(nSelect)));
+        if(it == mapTrustAddress.end())
+            return debug::error(FUNCTION, "selection index out of sync");
 
-
-        addr.SetIP(vAddresses[nSelect]);
-        addr.SetPort(vAddresses[nSelect].GetPort());
+        addr.SetIP(it->second);
+        addr.SetPort(it->second.GetPort());
 
         return true;
     }
@@ -383,6 +384,7 @@ namespace LLP
             /* Make sure the map is empty. */
             mapTrustAddress.clear();
             mapBanned.clear();
+            setSelect.clear();
 
             /* Make sure the database exists. */
             if(!pDatabase)
@@ -404,7 +406,14 @@ namespace LLP
                     {
                         /* Get the hash and load it into the map. */
                         uint64_t hash = addr.GetHash();
+
+                        /* Replace any entry loaded with the same hash. */
+                        auto it = mapTrustAddress.find(hash);
+                        if(it != mapTrustAddress.end())
+                            unindex_address(hash, it->second);
+
                         mapTrustAddress[hash] = addr;
+                        index_address(hash, mapTrustAddress[hash]);
 
                         hashLast = hash;
                     }
@@ -491,7 +500,10 @@ namespace LLP
 
         /* Erase from the map if the address was found. */
         if(it != mapTrustAddress.end())
-            mapTrustAddress.erase(hash);
+        {
+            unindex_address(hash, it->second);
+            mapTrustAddress.erase(it);
+        }
     }
 
 
@@ -598,4 +610,27 @@ namespace LLP
               break;
         }
     }
+
+
+    /*  Gets the key of an address in the selection index, best addresses first. */
+    std::tuple<double, uint32_t, uint64_t> AddressManager::select_key(const uint64_t hash, const TrustAddress &addr)
+    {
+        /* Highest score first, lowest latency breaks ties, then the hash to keep keys unique. */
+        return std::make_tuple(-addr.Score(), addr.nLatency, hash);
+    }
+
+
+    /*  Adds an address to the selection index if it can be selected. */
+    void AddressManager::index_address(const uint64_t hash, const TrustAddress &addr)
+    {
+        if((addr.nState & SELECT_FLAGS) && !is_banned(hash))
+            setSelect.insert(select_key(hash, addr));
+    }
+
+
+    /*  Removes an address from the selection index. */
+    void AddressManager::unindex_address(const uint64_t hash, const TrustAddress &addr)
+    {
+        setSelect.erase(select_key(hash, addr));
+    }
 }
@@ -18,6 +18,11 @@ ________________________________________________________________________________
 
 #include <Util/include/runtime.h>
 #include <Util/include/debug.h>
+#include <Util/include/args.h>
+#include <Util/include/deflate.h>
+#include <Util/templates/datastream.h>
+#include <cctype>
+#include <cstdlib>
 #include <vector>
 #include <map>
 
@@ -65,6 +70,10 @@ namespace LLP
         bool fHeader;
 
 
+        /* Flag for chunked transfer encoding, cleared once the last chunk is read. */
+        bool fChunked;
+
+
         /** Default Constructor **/
         HTTPPacket()
         : strType        ("")
@@ -74,6 +83,7 @@ namespace LLP
         , nContentLength (0)
         , strContent     ("")
         , fHeader        (false)
+        , fChunked       (false)
         {
         }
 
@@ -87,6 +97,7 @@ namespace LLP
         , nContentLength (packet.nContentLength)
         , strContent     (packet.strContent)
         , fHeader        (packet.fHeader)
+        , fChunked       (packet.fChunked)
         {
         }
 
@@ -100,6 +111,7 @@ namespace LLP
         , nContentLength (std::move(packet.nContentLength))
         , strContent     (std::move(packet.strContent))
         , fHeader        (std::move(packet.fHeader))
+        , fChunked       (std::move(packet.fChunked))
         {
         }
 
@@ -114,6 +126,7 @@ namespace LLP
             nContentLength = packet.nContentLength;
             strContent     = packet.strContent;
             fHeader        = packet.fHeader;
+            fChunked       = packet.fChunked;
 
             return *this;
         }
@@ -129,6 +142,7 @@ namespace LLP
             nContentLength = std::move(packet.nContentLength);
             strContent     = std::move(packet.strContent);
             fHeader        = std::move(packet.fHeader);
+            fChunked       = std::move(packet.fChunked);
 
             return *this;
         }
@@ -149,6 +163,7 @@ namespace LLP
         , nContentLength (0)
         , strContent     ("")
         , fHeader        (false)
+        , fChunked       (false)
         {
             SetStatus(nStatus);
         }
@@ -169,7 +184,8 @@ namespace LLP
             strContent = "";
             nContentLength = 0;
 
-            fHeader = false;
+            fHeader  = false;
+            fChunked = false;
         }
 
 
@@ -191,10 +207,7 @@ namespace LLP
          **/
         bool Complete() const
         {
-            if(strType == "GET" && fHeader)
-                return true;
-
-            return fHeader && (nContentLength == 0 || (nContentLength > 0 && nContentLength == strContent.size()));
+            return fHeader && !fChunked && strContent.size() == nContentLength;
         }
 
 
@@ -256,6 +269,85 @@ namespace LLP
         }
 
 
+        /** Compress
+         *
+         *  Compress the content with the best encoding accepted by the client, when the
+         *  content is large enough to be worth it. Prefers gzip over deflate and honors q=0,
+         *  with an encoding refused by name staying refused under a wildcard.
+         *
+         *  @param[in] strAccept The Accept-Encoding header of the request.
+         *
+         *  @return True if the content was compressed.
+         *
+         **/
+        bool Compress(const std::string& strAccept)
+        {
+            /* Check the size threshold first. */
+            if(!config::GetBoolArg("-httpcompress", true)
+            || strContent.size() < static_cast<uint64_t>(config::GetArg("-httpcompressmin", 1024)))
+                return false;
+
+            /* Check each of the encodings listed: 1 if accepted, -1 if refused with q=0, 0 if not listed. */
+            int32_t nGzip = 0, nDeflate = 0, nAny = 0;
+
+            std::string::size_type nBegin = 0;
+            while(nBegin < strAccept.size())
+            {
+                std::string::size_type nEnd = strAccept.find(',', nBegin);
+                if(nEnd == std::string::npos)
+                    nEnd = strAccept.size();
+
+                /* Split off the parameters. */
+                const std::string strToken = strAccept.substr(nBegin, nEnd - nBegin);
+                nBegin = nEnd + 1;
+
+                std::string::size_type nParams = strToken.find(';');
+                std::string strName = strToken.substr(0, nParams);
+
+                /* Trim and lowercase the encoding name. */
+                strName.erase(0, strName.find_first_not_of(" \t"));
+                strName.erase(strName.find_last_not_of(" \t") + 1);
+                for(auto& ch : strName)
+                    ch = std::tolower(ch);
+
+                /* A quality of zero means not acceptable. */
+                int32_t nAccept = 1;
+                if(nParams != std::string::npos)
+                {
+                    std::string::size_type nQuality = strToken.find("q=", nParams);
+                    if(nQuality != std::string::npos && std::strtod(strToken.c_str() + nQuality + 2, nullptr) <= 0)
+                        nAccept = -1;
+                }
+
+                if(strName == "gzip" || strName == "x-gzip")
+                    nGzip = (nGzip < 0 ? nGzip : nAccept);
+                else if(strName == "deflate")
+                    nDeflate = (nDeflate < 0 ? nDeflate : nAccept);
+                else if(strName == "*")
+                    nAny = (nAny < 0 ? nAny : nAccept);
+            }
+
+            /* An encoding listed by name takes precedence over the wildcard. */
+            const bool fGzip    = (nGzip > 0 || (nGzip == 0 && nAny > 0));
+            const bool fDeflate = (nDeflate > 0 || (nDeflate == 0 && nAny > 0));
+
+            if(!fGzip && !fDeflate)
+                return false;
+
+            /* Only use the compressed content if it is smaller. */
+            std::string strCompressed;
+            if(!encoding::Deflate(strContent, strCompressed, fGzip, config::GetArg("-httpcompresslevel", -1))
+            || strCompressed.size() >= strContent.size())
+                return false;
+
+            strContent = std::move(strCompressed);
+            mapHeaders["Content-Encoding"] = (fGzip ? "gzip" : "deflate");
+            mapHeaders["Vary"]             = "Accept-Encoding";
+
+            return true;
+        }
+
+
         /** GetBytes
          *
          *  Serializes class into a byte buffer. Used to write Packet to
@@ -277,11 +369,11 @@ namespace LLP
             /* Check for content. */
             if(strContent.size() > 0)
             {
-                strReply += debug::safe_printstr
-                (
-                    "Content-Length: ", strContent.size(), "\r\n",
-                    "Content-Type: application/json\r\n"
-                );
+                strReply += debug::safe_printstr("Content-Length: ", strContent.size(), "\r\n");
+
+                /* Default to json unless a custom content type was set. */
+                if(!mapHeaders.count("Content-Type"))
+                    strReply += "Content-Type: application/json\r\n";
             }
 
             /* Add custom header fields. */
@@ -247,11 +247,11 @@ namespace LLP
         for(uint16_t nThread = 0; nThread < DATA_THREADS.size(); ++nThread)
         {
             /* Loop through connections in data thread. */
-            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS->size());
+            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS.size());
             for(uint16_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
                 /* Get the current atomic_ptr. */
-                memory::atomic_ptr<ProtocolType>& pConnection = DATA_THREADS[nThread]->CONNECTIONS->at(nIndex);
+                memory::atomic_ptr<ProtocolType>& pConnection = DATA_THREADS[nThread]->CONNECTIONS.at(nIndex);
                 
                 /* Check to see if it is null */
                 if(!pConnection)
@@ -290,13 +290,13 @@ namespace LLP
         for(uint16_t nThread = 0; nThread < MAX_THREADS; ++nThread)
         {
             /* Loop through connections in data thread. */
-            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS->size());
+            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS.size());
             for(uint16_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
                 try
                 {
                     /* Get the current atomic_ptr. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS->at(nIndex);
+                    memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS.at(nIndex);
                     if(!CONNECTION)
                         continue;
 
@@ -321,7 +321,7 @@ namespace LLP
         if(nRetThread == -1 || nRetIndex == -1)
             return pNULL;
 
-        return DATA_THREADS[nRetThread]->CONNECTIONS->at(nRetIndex);
+        return DATA_THREADS[nRetThread]->CONNECTIONS.at(nRetIndex);
     }
 
 
@@ -337,7 +337,7 @@ namespace LLP
         for(uint16_t nThread = 0; nThread < MAX_THREADS; ++nThread)
         {
             /* Loop through connections in data thread. */
-            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS->size());
+            uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS.size());
             for(uint16_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
                 try
@@ -347,7 +347,7 @@ namespace LLP
                         continue;
 
                     /* Get the current atomic_ptr. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS->at(nIndex);
+                    memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS.at(nIndex);
                     if(!CONNECTION)
                         continue;
 
@@ -372,7 +372,7 @@ namespace LLP
         if(nRetThread == -1 || nRetIndex == -1)
             return pNULL;
 
-        return DATA_THREADS[nRetThread]->CONNECTIONS->at(nRetIndex);
+        return DATA_THREADS[nRetThread]->CONNECTIONS.at(nRetIndex);
     }
 
 
@@ -380,7 +380,7 @@ namespace LLP
     template<class ProtocolType>
     memory::atomic_ptr<ProtocolType>& Server<ProtocolType>::GetConnection(const uint32_t nDataThread, const uint32_t nDataIndex)
     {
-        return DATA_THREADS[nDataThread]->CONNECTIONS->at(nDataIndex);
+        return DATA_THREADS[nDataThread]->CONNECTIONS.at(nDataIndex);
     }
 
 
@@ -396,7 +396,7 @@ namespace LLP
             DataThread<ProtocolType> *dt = DATA_THREADS[nThread];
 
             /* Lock the data thread. */
-            uint16_t nSize = static_cast<uint16_t>(dt->CONNECTIONS->size());
+            uint16_t nSize = static_cast<uint16_t>(dt->CONNECTIONS.size());
 
             /* Loop through connections in data thread. */
             for(uint16_t nIndex = 0; nIndex < nSize; ++nIndex)
@@ -404,12 +404,12 @@ namespace LLP
                 try
                 {
                     /* Skip over inactive connections. */
-                    if(!dt->CONNECTIONS->at(nIndex))
+                    if(!dt->CONNECTIONS.at(nIndex))
                         continue;
 
                     /* Push the active connection. */
-                    if(dt->CONNECTIONS->at(nIndex)->Connected())
-                        vAddr.emplace_back(dt->CONNECTIONS->at(nIndex)->addr);
+                    if(dt->CONNECTIONS.at(nIndex)->Connected())
+                        vAddr.emplace_back(dt->CONNECTIONS.at(nIndex)->addr);
                 }
                 catch(const std::runtime_error& e)
                 {
@@ -45,6 +45,8 @@ namespace LLP
     , vBuffer            ( )
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
+    , pBytesRead         (nullptr)
+    , pBytesWritten      (nullptr)
     , addr               ( )
     {
         fd = INVALID_SOCKET;
@@ -67,6 +69,8 @@ namespace LLP
     , vBuffer            (socket.vBuffer)
     , fBufferFull        (socket.fBufferFull.load())
     , nConsecutiveErrors (socket.nConsecutiveErrors.load())
+    , pBytesRead         (socket.pBytesRead)
+    , pBytesWritten      (socket.pBytesWritten)
     , addr               (socket.addr)
     {
         if(socket.pSSL)
@@ -101,6 +105,8 @@ namespace LLP
     , vBuffer            ( )
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
+    , pBytesRead         (nullptr)
+    , pBytesWritten      (nullptr)
     , addr               (addrIn)
     {
         fd = nSocketIn;
@@ -218,6 +224,8 @@ namespace LLP
     , vBuffer            ( )
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
+    , pBytesRead         (nullptr)
+    , pBytesWritten      (nullptr)
     , addr               ( )
     {
         fd = INVALID_SOCKET;
@@ -651,8 +659,13 @@ namespace LLP
             }
         }
         else if(nRead > 0)
+        {
             nLastRecv = runtime::timestamp(true);
 
+            if(pBytesRead)
+                pBytesRead->Add(nRead);
+        }
+
         return nRead;
     }
 
@@ -740,8 +753,13 @@ namespace LLP
             }
         }
         else if(nRead > 0)
+        {
             nLastRecv = runtime::timestamp(true);
 
+            if(pBytesRead)
+                pBytesRead->Add(nRead);
+        }
+
         return nRead;
     }
 
@@ -800,6 +818,10 @@ namespace LLP
         else //don't update last sent unless all the data was written to the buffer
             nLastSend = runtime::timestamp(true);
 
+        /* Count the bytes that made it to the socket. */
+        if(nSent > 0 && pBytesWritten)
+            pBytesWritten->Add(nSent);
+
         return nSent;
     }
 
@@ -869,6 +891,9 @@ namespace LLP
 
             /* Reset that buffers are full. */
             fBufferFull.store(false);
+
+            if(pBytesWritten)
+                pBytesWritten->Add(nSent);
         }
 
         return nSent;
@@ -169,6 +169,15 @@ namespace LLP
         static std::string Name() { return "Base"; }
 
 
+        /** MaxPipeline
+         *
+         *  Returns the number of complete packets the data thread processes per pass. Protocols
+         *  that parse packets out of buffered data, such as HTTPNode, hide this with a larger limit.
+         *
+         **/
+        static uint32_t MaxPipeline() { return 1; }
+
+
         /** Notifications
          *
          *  Filter out relay requests with notifications node is subscribed to.
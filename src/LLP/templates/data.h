@@ -20,9 +20,12 @@ ________________________________________________________________________________
 
 #include <LLP/templates/ddos.h>
 #include <LLP/templates/events.h>
+#include <LLP/templates/slots.h>
 
 #include <Util/include/mutex.h>
 #include <Util/include/memory.h>
+#include <Util/include/metrics.h>
+#include <Util/include/trace.h>
 
 #include <Util/templates/datastream.h>
 
@@ -63,11 +66,6 @@ namespace LLP
     template <class ProtocolType>
     class DataThread
     {
-        
-        /** Lock access to find slot to ensure no race conditions happend between threads. **/
-        std::mutex SLOT_MUTEX;
-
-
     public:
 
         /* Variables to track Connection / Request Count. */
@@ -79,14 +77,21 @@ namespace LLP
         std::atomic<uint32_t> nIncoming;
         std::atomic<uint32_t> nOutbound;
 
+        /* Runtime metrics shared by all data threads of this server. */
+        metrics::Counter& PACKETS;
+        metrics::Counter& BYTES_READ;
+        metrics::Counter& BYTES_WRITTEN;
+        metrics::Gauge&   INCOMING;
+        metrics::Gauge&   OUTBOUND;
+
         uint32_t ID;
         uint32_t TIMEOUT;
         uint32_t DDOS_rSCORE;
         uint32_t DDOS_cSCORE;
 
 
-        /* Vector to store Connections. */
-        memory::atomic_ptr< std::vector< memory::atomic_ptr<ProtocolType>> > CONNECTIONS;
+        /* Slot table to store Connections. */
+        SlotTable<ProtocolType> CONNECTIONS;
 
 
         /** Queu to process outbound relay messages. **/
@@ -140,37 +145,13 @@ namespace LLP
                 ProtocolType* pnode = new ProtocolType(SOCKET, DDOS, fDDOS, std::forward<Args>(args)...);
                 pnode->fCONNECTED.store(true);
 
-                {
-                    LOCK(SLOT_MUTEX);
-
-                    /* Find an available slot. */
-                    uint32_t nSlot = find_slot();
-
-                    /* Update the indexes. */
-                    pnode->nDataThread     = ID;
-                    pnode->nDataIndex      = nSlot;
-                    pnode->FLUSH_CONDITION = &FLUSH_CONDITION;
-
-                    /* Find a slot that is empty. */
-                    if(nSlot == CONNECTIONS->size())
-                        CONNECTIONS->push_back(memory::atomic_ptr<ProtocolType>(pnode));
-                    else
-                        CONNECTIONS->at(nSlot).store(pnode);
-
-                    /* Fire the connected event. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nSlot);
-                    CONNECTION->Event(EVENTS::CONNECT);
-
-                    /* Iterate the DDOS cScore (Connection score). */
-                    if(DDOS)
-                        DDOS -> cSCORE += 1;
-
-                    /* Check for inbound socket. */
-                    if(CONNECTION->Incoming())
-                        ++nIncoming;
-                    else
-                        ++nOutbound;
-                }
+                /* Add the connection to a free slot. */
+                if(!insert(pnode))
+                    return;
+
+                /* Iterate the DDOS cScore (Connection score). */
+                if(DDOS)
+                    DDOS -> cSCORE += 1;
 
                 /* Notify data thread to wake up. */
                 CONDITION.notify_all();
@@ -212,37 +193,12 @@ namespace LLP
                     return false;
                 }
 
-                {
-                    LOCK(SLOT_MUTEX);
-
-                    /* Find an available slot. */
-                    uint32_t nSlot = find_slot();
-
-                    /* Update the indexes. */
-                    pnode->nDataThread     = ID;
-                    pnode->nDataIndex      = nSlot;
-                    pnode->FLUSH_CONDITION = &FLUSH_CONDITION;
-
-                    /* Find a slot that is empty. */
-                    if(nSlot == CONNECTIONS->size())
-                        CONNECTIONS->push_back(memory::atomic_ptr<ProtocolType>(pnode));
-                    else
-                        CONNECTIONS->at(nSlot).store(pnode);
-
-                    /* Fire the connected event. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nSlot);
-                    CONNECTION->Event(EVENTS::CONNECT);
-
-                    /* Check for inbound socket. */
-                    if(CONNECTION->Incoming())
-                        ++nIncoming;
-                    else
-                        ++nOutbound;
-                }
+                /* Add the connection to a free slot. */
+                if(!insert(pnode))
+                    return false;
 
                 /* Notify data thread to wake up. */
                 CONDITION.notify_all();
-
             }
             catch(const std::runtime_error& e)
             {
@@ -352,6 +308,7 @@ namespace LLP
          *
          *  Removes given connection from current Data Thread.
          *  This happens with a timeout/error, graceful close, or disconnect command.
+         *  The slot must already be claimed by the caller.
          *
          *  @param[in] The index of the connection to remove.
          *
@@ -359,13 +316,17 @@ namespace LLP
         void remove(uint32_t nIndex);
 
 
-        /** find_slot
+        /** insert
+         *
+         *  Adds a connected node to a free slot and fires the connect event.
+         *  The node is deleted if there are no free slots.
+         *
+         *  @param[in] pnode The node to add, owned by the data thread afterwards.
          *
-         *  Returns the index of a component of the CONNECTIONS vector that
-         *  has been flagged Disconnected
+         *  @return True if the node was added.
          *
          **/
-        uint32_t find_slot();
+        bool insert(ProtocolType* pnode);
 
     };
 }
@@ -324,13 +324,13 @@ namespace LLP
             for(uint16_t nThread = 0; nThread < MAX_THREADS; ++nThread)
             {
                 /* Loop through connections in data thread. */
-                uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS->size());
+                uint16_t nSize = static_cast<uint16_t>(DATA_THREADS[nThread]->CONNECTIONS.size());
                 for(uint16_t nIndex = 0; nIndex < nSize; ++nIndex)
                 {
                     try
                     {
                         /* Get the current atomic_ptr. */
-                        memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS->at(nIndex);
+                        memory::atomic_ptr<ProtocolType>& CONNECTION = DATA_THREADS[nThread]->CONNECTIONS.at(nIndex);
                         if(!CONNECTION)
                             continue;
 
@@ -362,7 +362,7 @@ namespace LLP
             if(nRetThread == -1 || nRetIndex == -1)
                 return pNULL;
 
-            return DATA_THREADS[nRetThread]->CONNECTIONS->at(nRetIndex);
+            return DATA_THREADS[nRetThread]->CONNECTIONS.at(nRetIndex);
         }
 
 
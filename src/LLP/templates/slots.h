@@ -0,0 +1,330 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLP_TEMPLATES_SLOTS_H
+#define NEXUS_LLP_TEMPLATES_SLOTS_H
+
+#include <Util/include/debug.h>
+#include <Util/include/memory.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace LLP
+{
+
+    /* States of a slot in the slot table. */
+    namespace SLOT
+    {
+        enum
+        {
+            FREE     = 0,
+            RESERVED = 1,
+            USED     = 2,
+            CLOSING  = 3,
+        };
+    }
+
+
+    /** SlotTable
+     *
+     *  Fixed index table of connection pointers for a data thread.
+     *
+     *  Slots live in chunks that are never moved or freed while the table exists, so an
+     *  index stays valid for the life of the table and readers never take a table lock.
+     *  Released slots go onto a lock-free free list whose head carries a generation tag,
+     *  so a slot can be reserved in constant time without scanning the table.
+     *
+     **/
+    template<class TypeName>
+    class SlotTable
+    {
+    public:
+
+        /** The number of slots in one chunk. **/
+        static const uint32_t CHUNK_SIZE = 256;
+
+
+        /** The maximum number of chunks in the table. **/
+        static const uint32_t MAX_CHUNKS = 256;
+
+    private:
+
+        /** Slot
+         *
+         *  A single connection pointer with its state and free list link.
+         *
+         **/
+        struct Slot
+        {
+            /** The connection pointer. **/
+            memory::atomic_ptr<TypeName> pointer;
+
+            /** The state of this slot. **/
+            std::atomic<uint8_t> nState;
+
+            /** The next free slot plus one, or zero for the end of the free list. **/
+            std::atomic<uint32_t> nNext;
+
+            Slot()
+            : pointer ( )
+            , nState  (SLOT::FREE)
+            , nNext   (0)
+            {
+            }
+        };
+
+
+        /** The chunks of slots, allocated as the table grows. **/
+        std::atomic<Slot*> CHUNKS[MAX_CHUNKS];
+
+
+        /** The number of slots ever handed out, readers iterate up to here. **/
+        std::atomic<uint32_t> nSize;
+
+
+        /** The free list head, generation in the high 32 bits and index plus one in the low 32 bits. **/
+        std::atomic<uint64_t> nFreeHead;
+
+
+        /** slot
+         *
+         *  Get the slot for an index below the high water mark.
+         *
+         **/
+        Slot& slot(const uint32_t nIndex) const
+        {
+            return CHUNKS[nIndex / CHUNK_SIZE].load(std::memory_order_acquire)[nIndex % CHUNK_SIZE];
+        }
+
+
+        /** push_free
+         *
+         *  Push a slot onto the free list.
+         *
+         **/
+        void push_free(const uint32_t nIndex)
+        {
+            uint64_t nHead = nFreeHead.load(std::memory_order_acquire);
+            while(true)
+            {
+                slot(nIndex).nNext.store(static_cast<uint32_t>(nHead), std::memory_order_relaxed);
+
+                const uint64_t nNew = (((nHead >> 32) + 1) << 32) | (nIndex + 1);
+                if(nFreeHead.compare_exchange_weak(nHead, nNew, std::memory_order_acq_rel, std::memory_order_acquire))
+                    return;
+            }
+        }
+
+
+        /** pop_free
+         *
+         *  Pop a slot off the free list.
+         *
+         *  @param[out] nIndex The index of the slot.
+         *
+         *  @return True if the free list wasn't empty.
+         *
+         **/
+        bool pop_free(uint32_t &nIndex)
+        {
+            uint64_t nHead = nFreeHead.load(std::memory_order_acquire);
+            while(static_cast<uint32_t>(nHead) != 0)
+            {
+                /* Slots are never freed, so reading the link of a slot popped by another thread is safe.
+                 * The generation tag makes the exchange fail if the head was popped and pushed again. */
+                const uint32_t nHeadIndex = static_cast<uint32_t>(nHead) - 1;
+                const uint64_t nNew = (((nHead >> 32) + 1) << 32) | slot(nHeadIndex).nNext.load(std::memory_order_relaxed);
+                if(nFreeHead.compare_exchange_weak(nHead, nNew, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    nIndex = nHeadIndex;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+
+        /** grow
+         *
+         *  Take a new slot from the end of the table.
+         *
+         *  @param[out] nIndex The index of the slot.
+         *
+         *  @return False if the table is full.
+         *
+         **/
+        bool grow(uint32_t &nIndex)
+        {
+            uint32_t nCurrent = nSize.load(std::memory_order_acquire);
+            while(true)
+            {
+                if(nCurrent >= CHUNK_SIZE * MAX_CHUNKS)
+                    return false;
+
+                /* Make sure the chunk exists before the index is visible to readers. */
+                std::atomic<Slot*>& CHUNK = CHUNKS[nCurrent / CHUNK_SIZE];
+                if(!CHUNK.load(std::memory_order_acquire))
+                {
+                    Slot* pExpected = nullptr;
+                    Slot* pChunk    = new Slot[CHUNK_SIZE];
+                    if(!CHUNK.compare_exchange_strong(pExpected, pChunk, std::memory_order_acq_rel))
+                        delete[] pChunk;
+                }
+
+                if(nSize.compare_exchange_weak(nCurrent, nCurrent + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    nIndex = nCurrent;
+                    return true;
+                }
+            }
+        }
+
+    public:
+
+        /** Default Constructor. **/
+        SlotTable()
+        : nSize     (0)
+        , nFreeHead (0)
+        {
+            for(uint32_t nChunk = 0; nChunk < MAX_CHUNKS; ++nChunk)
+                CHUNKS[nChunk].store(nullptr);
+        }
+
+
+        /** Copy Constructor. **/
+        SlotTable(const SlotTable<TypeName>& table) = delete;
+
+
+        /** Assignment operator. **/
+        SlotTable& operator=(const SlotTable<TypeName>& table) = delete;
+
+
+        /** Default Destructor.
+         *
+         *  Frees the slots but not the pointers they hold.
+         *
+         **/
+        ~SlotTable()
+        {
+            for(uint32_t nChunk = 0; nChunk < MAX_CHUNKS; ++nChunk)
+                delete[] CHUNKS[nChunk].load();
+        }
+
+
+        /** size
+         *
+         *  Returns the number of slots ever used. Slots below this may be empty.
+         *
+         **/
+        uint32_t size() const
+        {
+            return nSize.load(std::memory_order_acquire);
+        }
+
+
+        /** at
+         *
+         *  Get the pointer in a slot without locking the table.
+         *
+         *  @param[in] nIndex The index of the slot, must be below size().
+         *
+         **/
+        memory::atomic_ptr<TypeName>& at(const uint32_t nIndex)
+        {
+            if(nIndex >= size())
+                throw std::runtime_error(debug::safe_printstr(FUNCTION, "slot ", nIndex, " out of range ", size()));
+
+            return slot(nIndex).pointer;
+        }
+
+
+        /** Reserve
+         *
+         *  Reserve an empty slot, reusing released slots before growing the table.
+         *
+         *  @param[out] nIndex The index of the reserved slot.
+         *
+         *  @return False if the table is full.
+         *
+         **/
+        bool Reserve(uint32_t &nIndex)
+        {
+            if(!pop_free(nIndex) && !grow(nIndex))
+                return false;
+
+            slot(nIndex).nState.store(SLOT::RESERVED, std::memory_order_release);
+
+            return true;
+        }
+
+
+        /** Store
+         *
+         *  Store a pointer into a reserved slot and mark it used.
+         *
+         *  @param[in] nIndex The index of the reserved slot.
+         *  @param[in] pData The pointer to store, owned by the table until Release.
+         *
+         **/
+        void Store(const uint32_t nIndex, TypeName* pData)
+        {
+            Slot& entry = slot(nIndex);
+
+            entry.pointer.store(pData);
+            entry.nState.store(SLOT::USED, std::memory_order_release);
+        }
+
+
+        /** Claim
+         *
+         *  Claim a used slot for removal. Only one caller can claim a slot.
+         *
+         *  @param[in] nIndex The index of the slot.
+         *
+         *  @return True if this caller claimed the slot and must Release it.
+         *
+         **/
+        bool Claim(const uint32_t nIndex)
+        {
+            if(nIndex >= size())
+                return false;
+
+            uint8_t nExpected = SLOT::USED;
+            return slot(nIndex).nState.compare_exchange_strong(nExpected, SLOT::CLOSING, std::memory_order_acq_rel);
+        }
+
+
+        /** Release
+         *
+         *  Free the pointer in a claimed slot and put the slot on the free list.
+         *
+         *  @param[in] nIndex The index of the claimed slot.
+         *
+         **/
+        void Release(const uint32_t nIndex)
+        {
+            Slot& entry = slot(nIndex);
+
+            entry.pointer.free();
+            entry.nState.store(SLOT::FREE, std::memory_order_release);
+
+            push_free(nIndex);
+        }
+    };
+}
+
+#endif
@@ -18,6 +18,8 @@ ________________________________________________________________________________
 
 #include <LLP/include/base_address.h>
 
+#include <Util/include/metrics.h>
+
 #include <vector>
 #include <cstdint>
 #include <mutex>
@@ -83,6 +85,11 @@ namespace LLP
         std::atomic<uint32_t> nConsecutiveErrors;
 
 
+        /** Byte counters of the server this socket belongs to, set by the data thread. **/
+        metrics::Counter* pBytesRead;
+        metrics::Counter* pBytesWritten;
+
+
         /** Timeout flags. **/
         enum
         {
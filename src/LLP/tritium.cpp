@@ -34,6 +34,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/enum.h>
 #include <TAO/Ledger/include/process.h>
+#include <TAO/Ledger/include/pipeline.h>
 
 #include <TAO/Ledger/types/client.h>
 #include <TAO/Ledger/types/locator.h>
@@ -345,6 +346,15 @@ namespace LLP
                 }
 
 
+                /* Count the sync blocks the pipeline committed since our last block, so the end of a sync is reported. */
+                std::vector<uint8_t> vStatus;
+                if(nCurrentSession != 0 && TAO::Ledger::SyncPipeline::GetInstance().Status(nCurrentSession, vStatus))
+                {
+                    for(const auto& nBlockStatus : vStatus)
+                        count_status(nBlockStatus);
+                }
+
+
                 /* Unreliabilitiy re-requesting (max time since getblocks) */
                 if(TAO::Ledger::ChainState::Synchronizing()
                 && nCurrentSession == TAO::Ledger::nSyncSession.load()
@@ -438,7 +448,12 @@ namespace LLP
                         /* Make sure that we aren't freeing our session if handling duplicate connections. */
                         const std::pair<uint32_t, uint32_t>& pair = mapSessions[nCurrentSession];
                         if(pair.first == nDataThread && pair.second == nDataIndex)
+                        {
                             mapSessions.erase(nCurrentSession);
+
+                            /* Nobody is left to collect the session's sync block statuses. */
+                            TAO::Ledger::SyncPipeline::GetInstance().Remove(nCurrentSession);
+                        }
                     }
                 }
 
@@ -2691,6 +2706,21 @@ namespace LLP
                         TAO::Ledger::SyncBlock block;
                         ssPacket >> block;
 
+                        /* Hand off to the sync pipeline if enabled and not full, which reports status of earlier blocks. */
+                        std::vector<uint8_t> vStatus;
+                        if(TAO::Ledger::SyncPipeline::GetInstance().Push(block, nCurrentSession, vStatus))
+                        {
+                            /* Count each committed block on its own, as if it had been processed here, stopping at a limit. */
+                            for(const auto& nBlockStatus : vStatus)
+                            {
+                                count_status(nBlockStatus);
+                                if(nConsecutiveOrphans >= 1000 || nConsecutiveFails >= 1000)
+                                    break;
+                            }
+
+                            break;
+                        }
+
                         /* Check version switch. */
                         if(block.nVersion >= 7)
                         {
@@ -2760,24 +2790,7 @@ namespace LLP
                 }
 
                 /* Check for specific status messages. */
-                if(nStatus & TAO::Ledger::PROCESS::ACCEPTED)
-                {
-                    /* Reset the fails and orphans. */
-                    nConsecutiveOrphans = 0;
-                    nConsecutiveFails   = 0;
-
-                    /* Reset last time received. */
-                    if(nCurrentSession == TAO::Ledger::nSyncSession.load())
-                        nLastTimeReceived.store(runtime::timestamp());
-                }
-
-                /* Check for failure status messages. */
-                if(nStatus & TAO::Ledger::PROCESS::REJECTED)
-                    ++nConsecutiveFails;
-
-                /* Check for orphan status messages. */
-                if(nStatus & TAO::Ledger::PROCESS::ORPHAN)
-                    ++nConsecutiveOrphans;
+                count_status(nStatus);
 
                 /* Detect large orphan chains and ask for new blocks from origin again. */
                 if(nConsecutiveOrphans >= 1000)
@@ -3424,6 +3437,30 @@ namespace LLP
     }
 
 
+    /* Update the consecutive orphan and failure counters from a processed block's status. */
+    void TritiumNode::count_status(const uint8_t nStatus)
+    {
+        if(nStatus & TAO::Ledger::PROCESS::ACCEPTED)
+        {
+            /* Reset the fails and orphans. */
+            nConsecutiveOrphans = 0;
+            nConsecutiveFails   = 0;
+
+            /* Reset last time received. */
+            if(nCurrentSession == TAO::Ledger::nSyncSession.load())
+                nLastTimeReceived.store(runtime::timestamp());
+        }
+
+        /* Check for failure status messages. */
+        if(nStatus & TAO::Ledger::PROCESS::REJECTED)
+            ++nConsecutiveFails;
+
+        /* Check for orphan status messages. */
+        if(nStatus & TAO::Ledger::PROCESS::ORPHAN)
+            ++nConsecutiveOrphans;
+    }
+
+
     /*  Non-Blocking Packet reader to build a packet from TCP Connection.
      *  This keeps thread from spending too much time for each Connection. */
     void TritiumNode::ReadPacket()
@@ -3711,7 +3748,7 @@ namespace LLP
             TAO::API::Session& session = TAO::API::GetSessionManager().Get(0, false);
 
             /* The genesis of the currently logged in user */
-            uint256_t hashSigchain = session.GetAccount()->Genesis();
+            uint256_t hashSigchain = session.Genesis();
 
             uint64_t nTimestamp = runtime::unifiedtimestamp();
 
@@ -28,6 +28,35 @@ ________________________________________________________________________________
 namespace LLP
 {
 
+    /** The maximum length of a request line, header line or chunk size line. **/
+    const uint32_t MAX_HTTP_LINE = 8 * 1024;
+
+
+    /** The maximum number of header fields in a request. **/
+    const uint32_t MAX_HTTP_HEADERS = 128;
+
+
+    /** The maximum size of the content of a request. **/
+    const uint32_t MAX_HTTP_CONTENT = 32 * 1024 * 1024;
+
+
+    /** The maximum number of pipelined requests already in a connection's buffer processed per pass. **/
+    const uint32_t MAX_HTTP_PIPELINE = 16;
+
+
+    /** States of the chunked transfer decoder. **/
+    namespace CHUNK
+    {
+        enum
+        {
+            SIZE    = 0,
+            DATA    = 1,
+            END     = 2,
+            TRAILER = 3
+        };
+    }
+
+
     /** HTTPNode
      *
      *  A node that can speak over HTTP protocols.
@@ -49,9 +78,92 @@ namespace LLP
      **/
     class HTTPNode : public BaseConnection<HTTPPacket>
     {
+        /* Scratch buffer for socket reads. */
+        std::vector<int8_t> vchRead;
+
+
+        /* The offset of the first byte in the buffer not parsed yet. */
+        uint32_t nBufferPos;
+
+
+        /* The offset in the buffer a search for the next line resumes from. */
+        uint32_t nScanPos;
+
+
+        /* The bytes left to read in the current chunk. */
+        uint32_t nChunkSize;
+
+
+        /* The current state of the chunked transfer decoder. */
+        uint8_t nChunkState;
+
+
+        /** ReadLine
+         *
+         *  Find the next full line in the buffer starting at the parse offset, and move the
+         *  offset past it. Bytes already searched for a partial line are not searched again. The line is returned as a view into the buffer without the CRLF.
+         *
+         *  @param[out] nBegin The offset of the first byte of the line.
+         *  @param[out] nLength The length of the line.
+         *
+         *  @return True if a full line was in the buffer.
+         *
+         **/
+        bool ReadLine(uint32_t &nBegin, uint32_t &nLength);
+
+
+        /** ParseRequest
+         *
+         *  Parse the request line or status line of a packet.
+         *
+         *  @param[in] nBegin The offset of the line in the buffer.
+         *  @param[in] nLength The length of the line.
+         *
+         *  @return True if the line was well formed.
+         *
+         **/
+        bool ParseRequest(const uint32_t nBegin, const uint32_t nLength);
+
+
+        /** ParseHeader
+         *
+         *  Parse one header field line into the packet headers.
+         *
+         *  @param[in] nBegin The offset of the line in the buffer.
+         *  @param[in] nLength The length of the line.
+         *
+         *  @return True if the line was well formed.
+         *
+         **/
+        bool ParseHeader(const uint32_t nBegin, const uint32_t nLength);
+
+
+        /** ParseChunked
+         *
+         *  Decode as much chunked content from the buffer as is available.
+         *
+         *  @return True if no errors, false if the chunk encoding was malformed.
+         *
+         **/
+        bool ParseChunked();
+
+    protected:
+
         /* Internal Read Buffer. */
         std::vector<int8_t> vchBuffer;
 
+
+        /** Parse
+         *
+         *  Incremental parser that continues building the incoming packet from the read
+         *  buffer where the last call left off. Bytes after the end of a complete packet are
+         *  kept in the buffer for the next pipelined request.
+         *
+         *  @return True if no errors, false if the request was malformed.
+         *
+         **/
+        bool Parse();
+
     public:
 
         /** Default Constructor **/
@@ -70,6 +182,15 @@ namespace LLP
         virtual ~HTTPNode();
 
 
+        /** MaxPipeline
+         *
+         *  HTTP clients may pipeline keep-alive requests, so the data thread processes every
+         *  complete request already buffered, up to MAX_HTTP_PIPELINE per pass.
+         *
+         **/
+        static uint32_t MaxPipeline() { return MAX_HTTP_PIPELINE; }
+
+
         /** Event
          *
          *  Virtual Functions to Determine Behavior of Message LLP.
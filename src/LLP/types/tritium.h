@@ -509,6 +509,18 @@ namespace LLP
 
         }
 
+
+    private:
+
+        /** count_status
+         *
+         *  Update the consecutive orphan and failure counters from a processed block's status.
+         *
+         *  @param[in] nStatus The status flags of the processed block.
+         *
+         **/
+        void count_status(const uint8_t nStatus);
+
     };
 } // end namespace LLP
 
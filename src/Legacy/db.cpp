@@ -39,6 +39,7 @@ namespace Legacy
     , pdb(nullptr)
     , strDbFile(strFileIn)
     , vTxn()
+    , nTxnThread()
     {
         /* Passing an empty string is invalid */
         if(strFileIn.empty())
@@ -267,7 +268,7 @@ namespace Legacy
     /*  Retrieves the most recently started database transaction. */
     DbTxn* BerkeleyDB::GetTxn()
     {
-        if(!vTxn.empty())
+        if(!vTxn.empty() && nTxnThread == std::this_thread::get_id())
             return vTxn.back();
         else
             return nullptr;
@@ -374,6 +375,10 @@ namespace Legacy
         if(pdb == nullptr)
             OpenHandle();
 
+        /* Transactions only nest on the thread that began the first one. */
+        if(!vTxn.empty() && nTxnThread != std::this_thread::get_id())
+            return false;
+
         /* Start a new database transaction. Need to use raw pointer with Berkeley API */
         DbTxn* pTxn = nullptr;
 
@@ -385,6 +390,7 @@ namespace Legacy
 
         /* Add new transaction to the end of vTxn */
         vTxn.push_back(pTxn);
+        nTxnThread = std::this_thread::get_id();
 
         return true;
     }
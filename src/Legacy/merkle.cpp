@@ -16,6 +16,7 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/merklecache.h>
 #include <TAO/Ledger/types/state.h>
 #include <TAO/Ledger/types/transaction.h>
 
@@ -171,22 +172,12 @@ namespace Legacy
         /* Cache this txid. */
         uint512_t hash = GetHash();
 
-        /* Find the index of this transaction. */
-        for(nIndex = 0; nIndex < state.vtx.size(); ++nIndex)
-            if(state.vtx[nIndex].second == hash)
-                break;
+        /* Build the merkle branch from the cached tree of this block. */
+        uint32_t nPosition = 0;
+        if(!TAO::Ledger::GetMerkleBranch(state, hash, vMerkleBranch, nPosition))
+            return false;
 
-        /* Check for valid index. */
-        if(nIndex == state.vtx.size())
-            return debug::error(FUNCTION, "transaction not found");
-
-        /* Build merkle branch. */
-        vMerkleBranch = state.GetMerkleBranch(state.vtx, nIndex);
-
-        /* NOTE: extra expensive check for testing, consider removing in production */
-        uint512_t hashCheck = TAO::Ledger::Block::CheckMerkleBranch(hash, vMerkleBranch, nIndex);
-        if(state.hashMerkleRoot != hashCheck)
-            return debug::error(FUNCTION, "merkle root mismatch ", hashCheck.SubString());
+        nIndex = static_cast<int32_t>(nPosition);
 
         return true;
     }
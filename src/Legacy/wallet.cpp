@@ -47,6 +47,9 @@ ________________________________________________________________________________
 #include <openssl/rand.h>   // For RAND_bytes
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <thread>
 #include <utility>
 
@@ -1193,6 +1196,133 @@ namespace Legacy
     }
 
 
+    /** ScanWorkers
+     *
+     *  Worker threads kept for the length of a rescan, so each batch doesn't start and join its own.
+     *  Run hands every worker the same job with its slot number and returns once all of them are done.
+     *
+     **/
+    class ScanWorkers
+    {
+    public:
+
+        /* Start the workers, the calling thread takes slot zero. */
+        explicit ScanWorkers(const uint32_t nThreadsIn)
+        : nThreads(std::max(1u, nThreadsIn))
+        , MUTEX()
+        , CONDITION()
+        , fnJob()
+        , nGeneration(0)
+        , nPending(0)
+        , fStop(false)
+        , vWorkers()
+        {
+            for(uint32_t nThread = 1; nThread < nThreads; ++nThread)
+                vWorkers.push_back(std::thread(std::bind(&ScanWorkers::worker, this, nThread)));
+        }
+
+
+        /* Stop and join the workers. */
+        ~ScanWorkers()
+        {
+            {
+                std::unique_lock<std::mutex> lock(MUTEX);
+                fStop = true;
+            }
+            CONDITION.notify_all();
+
+            for(auto& thread : vWorkers)
+                thread.join();
+        }
+
+
+        /* The number of slots, including the calling thread. */
+        uint32_t Size() const
+        {
+            return nThreads;
+        }
+
+
+        /* Run a job on every slot and wait for it to finish. */
+        void Run(const std::function<void(const uint32_t)>& fnRun)
+        {
+            {
+                std::unique_lock<std::mutex> lock(MUTEX);
+                fnJob    = fnRun;
+                nPending = static_cast<uint32_t>(vWorkers.size());
+                ++nGeneration;
+            }
+            CONDITION.notify_all();
+
+            /* This thread takes its share too. */
+            fnRun(0);
+
+            std::unique_lock<std::mutex> lock(MUTEX);
+            CONDITION.wait(lock, [this]{ return nPending == 0; });
+        }
+
+
+    private:
+
+        /* Wait for each new job and run its slot. */
+        void worker(const uint32_t nThread)
+        {
+            uint64_t nLast = 0;
+            while(true)
+            {
+                std::function<void(const uint32_t)> fnRun;
+                {
+                    std::unique_lock<std::mutex> lock(MUTEX);
+                    CONDITION.wait(lock, [this, &nLast]{ return fStop || nGeneration != nLast; });
+
+                    if(fStop)
+                        return;
+
+                    nLast = nGeneration;
+                    fnRun = fnJob;
+                }
+
+                fnRun(nThread);
+
+                {
+                    std::unique_lock<std::mutex> lock(MUTEX);
+                    --nPending;
+                }
+                CONDITION.notify_all();
+            }
+        }
+
+
+        const uint32_t nThreads;
+
+        std::mutex MUTEX;
+        std::condition_variable CONDITION;
+
+        std::function<void(const uint32_t)> fnJob;
+        uint64_t nGeneration;
+        uint32_t nPending;
+        bool fStop;
+
+        std::vector<std::thread> vWorkers;
+    };
+
+
+    /* Checks a batch of transactions for outputs belonging to this wallet on worker threads. */
+    template<typename TxType>
+    void Wallet::scan_mine(const std::vector<TxType>& vtx, ScanWorkers &workers, std::vector<uint8_t> &vMine)
+    {
+        vMine.assign(vtx.size(), 0);
+
+        /* Each slot takes every nThreads'th transaction. */
+        const uint32_t nThreads = workers.Size();
+        workers.Run([&](const uint32_t nThread)
+        {
+            for(uint32_t nIndex = nThread; nIndex < vtx.size(); nIndex += nThreads)
+                vMine[nIndex] = IsMine(vtx[nIndex]) ? 1 : 0;
+        });
+    }
+
+
     /* Scan the block chain for transactions from or to keys in this wallet.
      * Add/update the current wallet transactions for any found.
      */
@@ -1214,6 +1344,10 @@ namespace Legacy
         TAO::Ledger::BlockState stateStart = stateBegin;
         bool fFirst = true;
 
+        /* The threads checking outputs, started once for the whole rescan. */
+        ScanWorkers workers(static_cast<uint32_t>(
+            config::GetArg("-scanthreads", std::max(1u, std::thread::hardware_concurrency()))));
+
         /* Check for genesis. */
         if(stateStart.nHeight == 0)
         {
@@ -1259,12 +1393,21 @@ namespace Legacy
                 if(!LLD::Legacy->BatchRead(std::make_pair(std::string("tx"), hashLast), "tx", vtx, 1000, !fFirst))
                     break;
 
+                /* Check the outputs of the whole batch on the worker threads. */
+                std::vector<uint8_t> vMine;
+                scan_mine(vtx, workers, vMine);
+
+                /* Write the wallet updates for this batch in one database transaction. */
+                WalletBatch batch;
+
                 /* Loop through found transactions. */
                 TAO::Ledger::BlockState state;
-                for(const auto& tx : vtx)
+                for(uint32_t nIndex = 0; nIndex < vtx.size(); ++nIndex)
                 {
-                    /* Add to the wallet */
-                    if(AddToWalletIfInvolvingMe(tx, state, fUpdate, true, true))
+                    const Transaction& tx = vtx[nIndex];
+
+                    /* Spends depend on the wallet as it is updated, so they are checked here. */
+                    if((vMine[nIndex] || IsFromMe(tx)) && AddToWalletIfInvolvingMe(tx, state, fUpdate, true, true))
                     {
                         /* Get txid. */
                         uint512_t hash = tx.GetHash();
@@ -1347,12 +1490,21 @@ namespace Legacy
                 if(!LLD::Ledger->BatchRead(hashLast, "tx", vtx, 1000, !fFirst))
                     break;
 
+                /* Check the outputs of the whole batch on the worker threads. */
+                std::vector<uint8_t> vMine;
+                scan_mine(vtx, workers, vMine);
+
+                /* Write the wallet updates for this batch in one database transaction. */
+                WalletBatch batch;
+
                 /* Loop through found transactions. */
                 TAO::Ledger::BlockState state;
-                for(const auto& tx : vtx)
+                for(uint32_t nIndex = 0; nIndex < vtx.size(); ++nIndex)
                 {
+                    const TAO::Ledger::Transaction& tx = vtx[nIndex];
+
                     /* Add to the wallet */
-                    if(AddToWalletIfInvolvingMe(tx, state, fUpdate, true, true))
+                    if(vMine[nIndex] && AddToWalletIfInvolvingMe(tx, state, fUpdate, true, true))
                     {
                         /* Get txid. */
                         uint512_t hash = tx.GetHash();
@@ -25,6 +25,7 @@ ________________________________________________________________________________
 #include <map>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 
@@ -86,6 +87,10 @@ namespace Legacy
         std::vector<DbTxn*> vTxn;
 
 
+        /** The thread that began the open transactions. Other threads write outside of them. **/
+        std::thread::id nTxnThread;
+
+
         /** Constructor
          *
          *  Initializes database access for a given file name.
@@ -133,7 +138,8 @@ namespace Legacy
 
         /** GetTxn
          *
-         *  Retrieves the most recently started database transaction.
+         *  Retrieves the most recently started database transaction, if it was started by the
+         *  calling thread. Writes from other threads are committed on their own.
          *
          *  This method does not lock the cs_db mutex and should be called within lock scope.
          *
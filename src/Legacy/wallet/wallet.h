@@ -64,6 +64,7 @@ namespace Legacy
 
     class Output;
     class ReserveKey;
+    class ScanWorkers;
 
 
     /** Nexus: Setting to unlock wallet for block minting only **/
@@ -1078,6 +1079,21 @@ namespace Legacy
 
 
     private:
+
+        /** scan_mine
+         *
+         *  Checks a batch of transactions for outputs belonging to this wallet on
+         *  worker threads. Used by the rescan, which then adds the matches serially.
+         *
+         *  @param[in] vtx The transactions to check
+         *  @param[in] workers The worker threads started for this rescan
+         *  @param[out] vMine Set to 1 for each transaction with outputs belonging to this wallet
+         *
+         **/
+        template<typename TxType>
+        void scan_mine(const std::vector<TxType>& vtx, ScanWorkers &workers, std::vector<uint8_t> &vMine);
+
+
     /*----------------------------------------------------------------------------------------*/
     /*  Load Wallet operations - require WalletDB declared friend                            */
     /*----------------------------------------------------------------------------------------*/
@@ -19,6 +19,7 @@ ________________________________________________________________________________
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
@@ -614,6 +615,10 @@ namespace Legacy
 
 
     private:
+        /** Batches hold the in progress flag while their database transaction is open. **/
+        friend class WalletBatch;
+
+
         /**  Thread to perform wallet flush. Used to execute WalletDB::ThreadFlushWalletDB **/
         static std::thread flushThread;
 
@@ -633,6 +638,132 @@ namespace Legacy
 
     };
 
+
+    /** @class WalletBatch
+     *
+     *  Groups the wallet transaction writes made by the current thread into
+     *  Berkeley database transactions of up to nMaxWrites records each.
+     *
+     *  Writes are queued in memory and written in one database transaction when
+     *  the batch commits, on going out of scope or when it is full. The flush
+     *  thread is only held off while that transaction is written, and nothing is
+     *  waited on while the records are queued, so a batch can be opened and
+     *  written to under any wallet lock. A batch opened while another is active
+     *  on the same thread does nothing, the outer batch keeps the writes. Writes
+     *  from other threads are not part of the batch and commit on their own.
+     *
+     **/
+    class WalletBatch
+    {
+    public:
+
+        /** The default number of records written per database transaction. **/
+        static const uint32_t DEFAULT_MAX_WRITES = 1000;
+
+
+        /** Constructor
+         *
+         *  Make this the active batch for the current thread.
+         *
+         *  @param[in] nMaxWritesIn The number of records to queue before committing.
+         *
+         **/
+        explicit WalletBatch(const uint32_t nMaxWritesIn = DEFAULT_MAX_WRITES);
+
+
+        /** Copy Constructor. **/
+        WalletBatch(const WalletBatch& batch)            = delete;
+
+
+        /** Copy Assignment. **/
+        WalletBatch& operator=(const WalletBatch& batch) = delete;
+
+
+        /** Destructor
+         *
+         *  Commits any queued records.
+         *
+         **/
+        ~WalletBatch();
+
+
+        /** Commit
+         *
+         *  Write the queued records in one database transaction. Records that can't be
+         *  written as a transaction are written on their own.
+         *
+         *  @return true if there was nothing to commit or every record was written.
+         *
+         **/
+        bool Commit();
+
+
+        /** Size
+         *
+         *  Returns the number of records queued and not yet committed.
+         *
+         **/
+        uint32_t Size() const;
+
+
+        /** Write
+         *
+         *  Queue a wallet transaction write on the active batch of the current thread.
+         *
+         *  @param[in] hash The transaction hash.
+         *  @param[in] wtx The wallet transaction to write.
+         *
+         *  @return true if queued, false if there is no active batch and the caller should write directly.
+         *
+         **/
+        static bool Write(const uint512_t& hash, const WalletTx& wtx);
+
+
+        /** Erase
+         *
+         *  Queue a wallet transaction erase on the active batch of the current thread.
+         *
+         *  @param[in] hash The transaction hash.
+         *
+         *  @return true if queued, false if there is no active batch and the caller should erase directly.
+         *
+         **/
+        static bool Erase(const uint512_t& hash);
+
+
+        /** Read
+         *
+         *  Read a wallet transaction queued on the active batch of the current thread.
+         *
+         *  @param[in] hash The transaction hash.
+         *  @param[out] wtx The queued wallet transaction.
+         *  @param[out] fErased Set if the queued record is an erase.
+         *
+         *  @return true if the batch holds a write for hash.
+         *
+         **/
+        static bool Read(const uint512_t& hash, WalletTx& wtx, bool &fErased);
+
+
+    private:
+
+        /** The active batch of the current thread. **/
+        static thread_local WalletBatch* pActive;
+
+
+        /** The number of records to queue before committing. **/
+        const uint32_t nMaxWrites;
+
+
+        /** Flag indicating this batch is nested in another on the same thread. **/
+        bool fNested;
+
+
+        /** The queued records by hash, null for an erase. **/
+        std::map<uint512_t, std::unique_ptr<WalletTx>> mapPending;
+
+    };
+
 }
 
 #endif
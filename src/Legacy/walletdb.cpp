@@ -35,6 +35,7 @@ ________________________________________________________________________________
 #include <Util/include/filesystem.h>
 #include <Util/include/runtime.h>
 
+#include <algorithm>
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -243,6 +244,14 @@ namespace Legacy
     /* Reads the wallet transaction for a given transaction hash. */
     bool WalletDB::ReadTx(const uint512_t& hash, WalletTx& wtx)
     {
+        /* Records queued on this thread's batch are newer than the database. */
+        bool fErased = false;
+        if(WalletBatch::Read(hash, wtx, fErased))
+            return true;
+
+        if(fErased)
+            return false;
+
         return BerkeleyDB::GetInstance().Read(std::make_pair(std::string("tx"), hash), wtx);
     }
 
@@ -250,6 +259,10 @@ namespace Legacy
     /* Stores a wallet transaction using its transaction hash. */
     bool WalletDB::WriteTx(const uint512_t& hash, const WalletTx& wtx)
     {
+        /* Queue on this thread's batch, which counts the update when it commits. */
+        if(WalletBatch::Write(hash, wtx))
+            return true;
+
         ++WalletDB::nWalletDBUpdated;
         return BerkeleyDB::GetInstance().Write(std::make_pair(std::string("tx"), hash), wtx);
     }
@@ -258,6 +271,10 @@ namespace Legacy
     /* Removes the wallet transaction associated with a transaction hash. */
     bool WalletDB::EraseTx(const uint512_t& hash)
     {
+        /* Queue on this thread's batch, which counts the update when it commits. */
+        if(WalletBatch::Erase(hash))
+            return true;
+
         ++WalletDB::nWalletDBUpdated;
         return BerkeleyDB::GetInstance().Erase(std::make_pair(std::string("tx"), hash));
     }
@@ -983,4 +1000,164 @@ namespace Legacy
         return fBackupSuccessful;
     }
 
+
+    /* The active batch of the current thread. */
+    thread_local WalletBatch* WalletBatch::pActive = nullptr;
+
+
+    /* Make this the active batch for the current thread. */
+    WalletBatch::WalletBatch(const uint32_t nMaxWritesIn)
+    : nMaxWrites (std::max(nMaxWritesIn, 1u))
+    , fNested    (pActive != nullptr)
+    , mapPending ( )
+    {
+        if(!fNested)
+            pActive = this;
+    }
+
+
+    /* Commits any queued records. */
+    WalletBatch::~WalletBatch()
+    {
+        if(fNested)
+            return;
+
+        Commit();
+        pActive = nullptr;
+    }
+
+
+    /* Write the queued records in one database transaction. */
+    bool WalletBatch::Commit()
+    {
+        if(mapPending.empty())
+            return true;
+
+        /* Take the records so that writes made while committing start a new batch. */
+        std::map<uint512_t, std::unique_ptr<WalletTx>> mapCommit;
+        mapCommit.swap(mapPending);
+
+        /* Hold off the flush thread while the transaction is open. The other holders of this flag
+         * (flush, backup, encryption) only do database work while they hold it and never wait on us,
+         * so waiting here is safe even when the caller holds cs_wallet. */
+        bool fExpectedValue = false;
+        while(!WalletDB::fDbInProgress.compare_exchange_weak(fExpectedValue, true))
+        {
+            runtime::sleep(1);
+            fExpectedValue = false;
+        }
+
+        BerkeleyDB& db = BerkeleyDB::GetInstance();
+
+        /* Write every record in one transaction. */
+        bool fCommitted = db.TxnBegin();
+        if(fCommitted)
+        {
+            for(const auto& record : mapCommit)
+            {
+                const std::pair<std::string, uint512_t> key = std::make_pair(std::string("tx"), record.first);
+                if(record.second)
+                    fCommitted = db.Write(key, *record.second);
+                else
+                    fCommitted = db.Erase(key);
+
+                if(!fCommitted)
+                    break;
+            }
+
+            if(fCommitted)
+                fCommitted = db.TxnCommit();
+            else
+                db.TxnAbort();
+        }
+
+        /* Fall back to writing the records on their own, as they would be without a batch. */
+        bool fWritten = true;
+        if(!fCommitted)
+        {
+            debug::error(FUNCTION, "failed to commit wallet batch, writing ", mapCommit.size(), " records on their own");
+
+            for(const auto& record : mapCommit)
+            {
+                const std::pair<std::string, uint512_t> key = std::make_pair(std::string("tx"), record.first);
+                if(record.second)
+                    fWritten = db.Write(key, *record.second) && fWritten;
+                else
+                    fWritten = db.Erase(key) && fWritten;
+            }
+        }
+
+        WalletDB::fDbInProgress.store(false);
+        WalletDB::nWalletDBUpdated += mapCommit.size();
+
+        if(!fWritten)
+            return debug::error(FUNCTION, "failed to write wallet batch");
+
+        return true;
+    }
+
+
+    /* Returns the number of records queued and not yet committed. */
+    uint32_t WalletBatch::Size() const
+    {
+        return static_cast<uint32_t>(mapPending.size());
+    }
+
+
+    /* Queue a wallet transaction write on the active batch of the current thread. */
+    bool WalletBatch::Write(const uint512_t& hash, const WalletTx& wtx)
+    {
+        WalletBatch* pBatch = pActive;
+        if(!pBatch)
+            return false;
+
+        pBatch->mapPending[hash].reset(new WalletTx(wtx));
+
+        /* Commit a full batch. */
+        if(pBatch->mapPending.size() >= pBatch->nMaxWrites)
+            pBatch->Commit();
+
+        return true;
+    }
+
+
+    /* Queue a wallet transaction erase on the active batch of the current thread. */
+    bool WalletBatch::Erase(const uint512_t& hash)
+    {
+        WalletBatch* pBatch = pActive;
+        if(!pBatch)
+            return false;
+
+        pBatch->mapPending[hash].reset();
+
+        /* Commit a full batch. */
+        if(pBatch->mapPending.size() >= pBatch->nMaxWrites)
+            pBatch->Commit();
+
+        return true;
+    }
+
+
+    /* Read a wallet transaction queued on the active batch of the current thread. */
+    bool WalletBatch::Read(const uint512_t& hash, WalletTx& wtx, bool &fErased)
+    {
+        fErased = false;
+
+        WalletBatch* pBatch = pActive;
+        if(!pBatch)
+            return false;
+
+        auto it = pBatch->mapPending.find(hash);
+        if(it == pBatch->mapPending.end())
+            return false;
+
+        if(!it->second)
+        {
+            fErased = true;
+            return false;
+        }
+
+        wtx = *it->second;
+        return true;
+    }
 }
@@ -15,6 +15,7 @@ ________________________________________________________________________________
 
 #include <LLC/types/uint1024.h>
 #include <Util/include/json.h>
+#include <Util/include/json_writer.h>
 
 namespace Legacy { class Transaction; }
 
@@ -50,6 +51,18 @@ namespace TAO
         json::json BlockToJSON(const TAO::Ledger::BlockState& block, uint32_t nVerbosity);
 
 
+        /** BlockToJSON
+         *
+         *  Writes the block as formatted JSON directly into a streaming writer.
+         *
+         *  @param[in] block The block to convert
+         *  @param[in] nVerbosity determines the amount of transaction data to include in the response
+         *  @param[out] writer The writer to serialize into.
+         *
+         **/
+        void BlockToJSON(const TAO::Ledger::BlockState& block, uint32_t nVerbosity, json::writer& writer);
+
+
         /** TransactionToJSON
          *
          *  Converts the transaction to formatted JSON
@@ -68,6 +81,23 @@ namespace TAO
                                      const uint256_t& hashCoinbase = 0 );
 
 
+        /** TransactionToJSON
+         *
+         *  Writes the transaction as formatted JSON directly into a streaming writer.
+         *
+         *  @param[in] hashCaller Genesis hash of the callers sig chain (0 if not logged in)
+         *  @param[in] tx The transaction to convert to JSON
+         *  @param[in] block The block that the transaction exists in.
+         *  @param[in] nVerbosity determines the amount of transaction data to include in the response
+         *  @param[out] writer The writer to serialize into.
+         *  @param[in] hashCoinbase Used to filter out coinbase transactions to only those belonging to hashCoinbase
+         *
+         **/
+        void TransactionToJSON(const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
+                               const TAO::Ledger::BlockState& block, uint32_t nVerbosity,
+                               json::writer& writer, const uint256_t& hashCoinbase = 0);
+
+
         /** TransactionToJSON
          *
          *  Converts the transaction to formatted JSON
@@ -98,6 +128,21 @@ namespace TAO
                                    uint32_t nVerbosity = 0, const uint256_t& hashCoinbase = 0);
 
 
+        /** ContractsToJSON
+         *
+         *  Writes the list of contracts bound to the transaction directly into a streaming writer.
+         *
+         *  @param[in] hashCaller Genesis hash of the callers sig chain (0 if not logged in)
+         *  @param[in] tx The transaction with contracts to convert to JSON
+         *  @param[in] nVerbosity The verbose output level.
+         *  @param[out] writer The writer to serialize into.
+         *  @param[in] hashCoinbase Used to filter out coinbase transactions to only those belonging to hashCoinbase
+         *
+         **/
+        void ContractsToJSON(const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
+                             uint32_t nVerbosity, json::writer& writer, const uint256_t& hashCoinbase = 0);
+
+
         /** ContractToJSON
          *
          *  Converts a serialized contract stream to formattted JSON
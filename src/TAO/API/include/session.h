@@ -197,6 +197,24 @@ namespace TAO
                 bool CanProcessNotifications() const;
 
 
+                /** SetPregenerateKeys
+                 *
+                 *  Opts this session in or out of background key pregeneration after each transaction.
+                 *
+                 *  @param[in] fPregenerate Flag to enable pregeneration.
+                 *
+                 **/
+                void SetPregenerateKeys(const bool fPregenerate);
+
+
+                /** CanPregenerateKeys
+                 *
+                 *  Checks if this session has opted in to background key pregeneration.
+                 *
+                 **/
+                bool CanPregenerateKeys() const;
+
+
                 /** GetAccount
                  *
                  *  Returns the sigchain the account logged in.
@@ -209,6 +227,16 @@ namespace TAO
                 const memory::encrypted_ptr<TAO::Ledger::SignatureChain>& GetAccount() const;
 
 
+                /** Genesis
+                 *
+                 *  Returns the genesis of the sigchain logged in, without decrypting the sigchain.
+                 *
+                 *  @return the genesis hash, or 0 if the session isn't initialized.
+                 *
+                 **/
+                uint256_t Genesis() const;
+
+
                 /** GetNetworkKey
                 *
                 *  Returns the private key for the network public key for a logged in session
@@ -321,8 +349,16 @@ namespace TAO
 
                 /** Number of incorrect authentication attempts recorded for this session **/
                 uint8_t nAuthAttempts;
+
+
+                /** Flag to pregenerate the next sequence keys after each transaction **/
+                bool fPregenerateKeys;
                 
 
+                /** Genesis of the signature chain, which is public so is kept out of encrypted memory. **/
+                uint256_t hashGenesis;
+
+
                 /** Encrypted pointer of signature chain **/
                 memory::encrypted_ptr<TAO::Ledger::SignatureChain> pSigChain;
 
@@ -55,39 +55,118 @@ namespace TAO
     namespace API
     {
 
-        /* Converts the block to formatted JSON */
-        json::json BlockToJSON(const TAO::Ledger::BlockState& block, uint32_t nVerbosity)
+        /* Determines if a coinbase contract should be filtered out because it is not meant for hashCoinbase. */
+        static bool filter_coinbase(const TAO::Operation::Contract& contract, const uint256_t& hashCoinbase)
         {
-            /* Decalre the response object*/
-            json::json result;
+            /* No filtering unless the caller asked for it. */
+            if(hashCoinbase == 0)
+                return false;
+
+            /* Only coinbase contracts are filtered. */
+            if(!TAO::Register::Unpack(contract, TAO::Operation::OP::COINBASE))
+                return false;
+
+            /* The proof (owner) of the coinbase */
+            uint256_t hashProof = 0;
+
+            /* Unpack the owner from the contract */
+            TAO::Register::Unpack(contract, hashProof);
+
+            /* Skip this contract if the proof is not the hashCoinbase */
+            return hashProof != hashCoinbase;
+        }
+
+
+        /* Adapter that lets the shared field emitters below fill a json tree the same way they fill a writer. */
+        struct tree_fields
+        {
+            json::json& object;
+
+            template<typename Type>
+            void Field(const std::string& strKey, const Type& value)
+            {
+                object[strKey] = value;
+            }
+        };
+
 
+        /* Emits the block header fields. Shared by the tree and streaming BlockToJSON so the two can't drift. */
+        template<typename Fields>
+        static void block_fields(const TAO::Ledger::BlockState& block, Fields& fields)
+        {
             /* Main block hash. */
-            result["hash"] = block.GetHash().GetHex();
+            fields.Field("hash", block.GetHash().GetHex());
 
             /* The hash that was relevant for Proof of Stake or Proof of Work (depending on block version) */
-            result["proofhash"]  =
+            fields.Field("proofhash",
                                     block.nVersion < 5 ? block.GetHash().GetHex() :
-                                    ((block.nChannel == 0) ? block.StakeHash().GetHex() : block.ProofHash().GetHex());
+                                    ((block.nChannel == 0) ? block.StakeHash().GetHex() : block.ProofHash().GetHex()));
 
             /* Body of the block with relevant data. */
-            result["size"]       = (uint32_t)::GetSerializeSize(block, SER_NETWORK, LLP::PROTOCOL_VERSION);
-            result["height"]     = (uint32_t)block.nHeight;
-            result["channel"]    = (uint32_t)block.nChannel;
-            result["version"]    = (uint32_t)block.nVersion;
-            result["merkleroot"] = block.hashMerkleRoot.GetHex();
-            result["time"]       = convert::DateTimeStrFormat(block.GetBlockTime());
-            result["nonce"]      = (uint64_t)block.nNonce;
-            result["bits"]       = HexBits(block.nBits);
-            result["difficulty"] = TAO::Ledger::GetDifficulty(block.nBits, block.nChannel);
-            result["mint"]       = Legacy::SatoshisToAmount(block.nMint);
+            fields.Field("size",       (uint32_t)::GetSerializeSize(block, SER_NETWORK, LLP::PROTOCOL_VERSION));
+            fields.Field("height",     (uint32_t)block.nHeight);
+            fields.Field("channel",    (uint32_t)block.nChannel);
+            fields.Field("version",    (uint32_t)block.nVersion);
+            fields.Field("merkleroot", block.hashMerkleRoot.GetHex());
+            fields.Field("time",       convert::DateTimeStrFormat(block.GetBlockTime()));
+            fields.Field("nonce",      (uint64_t)block.nNonce);
+            fields.Field("bits",       HexBits(block.nBits));
+            fields.Field("difficulty", TAO::Ledger::GetDifficulty(block.nBits, block.nChannel));
+            fields.Field("mint",       Legacy::SatoshisToAmount(block.nMint));
 
             /* Add previous block if not null. */
             if(block.hashPrevBlock != 0)
-                result["previousblockhash"] = block.hashPrevBlock.GetHex();
+                fields.Field("previousblockhash", block.hashPrevBlock.GetHex());
 
             /* Add next hash if not null. */
             if(block.hashNextBlock != 0)
-                result["nextblockhash"] = block.hashNextBlock.GetHex();
+                fields.Field("nextblockhash", block.hashNextBlock.GetHex());
+        }
+
+
+        /* Emits the tritium transaction fields up to the contracts. Shared by the tree and streaming TransactionToJSON. */
+        template<typename Fields>
+        static void transaction_fields(const TAO::Ledger::Transaction& tx, const TAO::Ledger::BlockState& block,
+                                       uint32_t nVerbosity, Fields& fields)
+        {
+            /* Always add the transaction hash */
+            fields.Field("txid", tx.GetHash().GetHex());
+
+            /* Basic TX info for level 2 and up */
+            if(nVerbosity >= 2)
+            {
+                /* Build base transaction data. */
+                fields.Field("type",      tx.TypeString());
+                fields.Field("version",   tx.nVersion);
+                fields.Field("sequence",  tx.nSequence);
+                fields.Field("timestamp", tx.nTimestamp);
+                fields.Field("blockhash", block.IsNull() ? "" : block.GetHash().GetHex());
+                fields.Field("confirmations", block.IsNull() ? 0 : TAO::Ledger::ChainState::nBestHeight.load() - block.nHeight + 1);
+
+                /* Genesis and hashes are verbose 3 and up. */
+                if(nVerbosity >= 3)
+                {
+                    /* More sigchain level details. */
+                    fields.Field("genesis",   tx.hashGenesis.ToString());
+                    fields.Field("nexthash",  tx.hashNext.ToString());
+                    fields.Field("prevhash",  tx.hashPrevTx.ToString());
+
+                    /* The cryptographic data. */
+                    fields.Field("pubkey",    HexStr(tx.vchPubKey.begin(), tx.vchPubKey.end()));
+                    fields.Field("signature", HexStr(tx.vchSig.begin(),    tx.vchSig.end()));
+                }
+            }
+        }
+
+
+        /* Converts the block to formatted JSON */
+        json::json BlockToJSON(const TAO::Ledger::BlockState& block, uint32_t nVerbosity)
+        {
+            /* Decalre the response object*/
+            json::json result;
+
+            tree_fields fields = { result };
+            block_fields(block, fields);
 
             /* Add the transaction data if the caller has requested it*/
             if(nVerbosity > 0)
@@ -129,6 +208,45 @@ namespace TAO
             return result;
         }
 
+        /* Writes the block as formatted JSON directly into a streaming writer. */
+        void BlockToJSON(const TAO::Ledger::BlockState& block, uint32_t nVerbosity, json::writer& writer)
+        {
+            writer.BeginObject();
+
+            block_fields(block, writer);
+
+            /* Add the transaction data if the caller has requested it*/
+            if(nVerbosity > 0)
+            {
+                writer.Key("tx");
+                writer.BeginArray();
+
+                /* Iterate through each transaction hash in the block vtx*/
+                for(const auto& vtx : block.vtx)
+                {
+                    if(vtx.first == TAO::Ledger::TRANSACTION::TRITIUM)
+                    {
+                        /* Get the tritium transaction from the database*/
+                        TAO::Ledger::Transaction tx;
+                        if(LLD::Ledger->ReadTx(vtx.second, tx))
+                            TransactionToJSON(0, tx, block, nVerbosity, writer);
+                    }
+                    else if(vtx.first == TAO::Ledger::TRANSACTION::LEGACY)
+                    {
+                        /* Get the legacy transaction from the database. Legacy transactions are small enough to build as a tree. */
+                        Legacy::Transaction tx;
+                        if(LLD::Legacy->ReadTx(vtx.second, tx))
+                            writer.Value(TransactionToJSON(tx, block, nVerbosity));
+                    }
+                }
+
+                writer.EndArray();
+            }
+
+            writer.EndObject();
+        }
+
+
         /* Converts the transaction to formatted JSON */
         json::json TransactionToJSON(const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
                                      const TAO::Ledger::BlockState& block, uint32_t nVerbosity, const uint256_t& hashCoinbase)
@@ -136,41 +254,36 @@ namespace TAO
             /* Declare JSON object to return */
             json::json ret;
 
-            /* Always add the transaction hash */
-            ret["txid"] = tx.GetHash().GetHex();
+            tree_fields fields = { ret };
+            transaction_fields(tx, block, nVerbosity, fields);
 
-            /* Basic TX info for level 2 and up */
+            /* Always add the contracts if level 2 and up */
             if(nVerbosity >= 2)
-            {
-                /* Build base transaction data. */
-                ret["type"]      = tx.TypeString();
-                ret["version"]   = tx.nVersion;
-                ret["sequence"]  = tx.nSequence;
-                ret["timestamp"] = tx.nTimestamp;
-                ret["blockhash"] = block.IsNull() ? "" : block.GetHash().GetHex();
-                ret["confirmations"] = block.IsNull() ? 0 : TAO::Ledger::ChainState::nBestHeight.load() - block.nHeight + 1;
+                ret["contracts"] = ContractsToJSON(hashCaller, tx, nVerbosity, hashCoinbase);
 
-                /* Genesis and hashes are verbose 3 and up. */
-                if(nVerbosity >= 3)
-                {
-                    /* More sigchain level details. */
-                    ret["genesis"]   = tx.hashGenesis.ToString();
-                    ret["nexthash"]  = tx.hashNext.ToString();
-                    ret["prevhash"]  = tx.hashPrevTx.ToString();
+            return ret;
+        }
 
-                    /* The cryptographic data. */
-                    ret["pubkey"]    = HexStr(tx.vchPubKey.begin(), tx.vchPubKey.end());
-                    ret["signature"] = HexStr(tx.vchSig.begin(),    tx.vchSig.end());
-                }
-            }
+        /* Writes the transaction as formatted JSON directly into a streaming writer. */
+        void TransactionToJSON(const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
+                               const TAO::Ledger::BlockState& block, uint32_t nVerbosity,
+                               json::writer& writer, const uint256_t& hashCoinbase)
+        {
+            writer.BeginObject();
+
+            transaction_fields(tx, block, nVerbosity, writer);
 
             /* Always add the contracts if level 2 and up */
             if(nVerbosity >= 2)
-                ret["contracts"] = ContractsToJSON(hashCaller, tx, nVerbosity, hashCoinbase);
+            {
+                writer.Key("contracts");
+                ContractsToJSON(hashCaller, tx, nVerbosity, writer, hashCoinbase);
+            }
 
-            return ret;
+            writer.EndObject();
         }
 
+
         /* Converts the transaction to formatted JSON */
         json::json TransactionToJSON(const Legacy::Transaction& tx, const TAO::Ledger::BlockState& block, uint32_t nVerbosity)
         {
@@ -302,22 +415,10 @@ namespace TAO
             for(uint32_t nContract = 0; nContract < nContracts; ++nContract)
             {
                 const TAO::Operation::Contract& contract = tx[nContract];
-                /* If the caller has requested to filter the coinbases then we only include those where the coinbase is meant for hashCoinbase  */
-                if(hashCoinbase != 0)
-                {
-                    if(TAO::Register::Unpack(contract, TAO::Operation::OP::COINBASE))
-                    {
-                        /* The proof (owner) of the coinbase */
-                        uint256_t hashProof = 0;
-
-                        /* Unpack the owner from the contract */
-                        TAO::Register::Unpack(contract, hashProof);
 
-                        /* Skip this contract if the proof is not the hashCoinbase */
-                        if(hashProof != hashCoinbase)
-                            continue;
-                    }
-                }
+                /* If the caller has requested to filter the coinbases then we only include those where the coinbase is meant for hashCoinbase  */
+                if(filter_coinbase(contract, hashCoinbase))
+                    continue;
 
                 /* JSONify the contract */
                 json::json contractJSON = ContractToJSON(hashCaller, contract, nContract, nVerbosity);
@@ -330,6 +431,30 @@ namespace TAO
         }
 
 
+        /* Writes the list of contracts bound to the transaction directly into a streaming writer. */
+        void ContractsToJSON(const uint256_t& hashCaller, const TAO::Ledger::Transaction &tx, uint32_t nVerbosity,
+                             json::writer& writer, const uint256_t& hashCoinbase)
+        {
+            writer.BeginArray();
+
+            /* Add a contract to the list of contracts. */
+            uint32_t nContracts = tx.Size();
+            for(uint32_t nContract = 0; nContract < nContracts; ++nContract)
+            {
+                const TAO::Operation::Contract& contract = tx[nContract];
+
+                /* If the caller has requested to filter the coinbases then we only include those where the coinbase is meant for hashCoinbase  */
+                if(filter_coinbase(contract, hashCoinbase))
+                    continue;
+
+                /* Each contract is only a handful of fields, so it is built as a tree and written straight out. */
+                writer.Value(ContractToJSON(hashCaller, contract, nContract, nVerbosity));
+            }
+
+            writer.EndArray();
+        }
+
+
         /* Converts a serialized operation stream to formattted JSON */
         json::json ContractToJSON(const uint256_t& hashCaller, const TAO::Operation::Contract& contract, uint32_t nContract, uint32_t nVerbosity)
         {
@@ -33,6 +33,8 @@ namespace TAO
         , nStarted              (0)
         , nLastActive           (0)
         , nAuthAttempts          (0)
+        , fPregenerateKeys      (false)
+        , hashGenesis           (0)
         , pSigChain             ()
         , pActivePIN            ()
         , nNetworkKey           (0)
@@ -48,6 +50,8 @@ namespace TAO
         , nStarted              (std::move(session.nStarted))
         , nLastActive           (std::move(session.nLastActive))
         , nAuthAttempts          (std::move(session.nAuthAttempts))
+        , fPregenerateKeys      (std::move(session.fPregenerateKeys))
+        , hashGenesis           (std::move(session.hashGenesis))
         , pSigChain             (std::move(session.pSigChain))
         , pActivePIN            (std::move(session.pActivePIN))
         , nNetworkKey           (std::move(session.nNetworkKey))
@@ -64,6 +68,8 @@ namespace TAO
             nStarted =          (std::move(session.nStarted));
             nLastActive =       (std::move(session.nLastActive));
             nAuthAttempts =      (std::move(session.nAuthAttempts));
+            fPregenerateKeys =  (std::move(session.fPregenerateKeys));
+            hashGenesis =       (std::move(session.hashGenesis));
             pSigChain =         (std::move(session.pSigChain));
             pActivePIN =        (std::move(session.pActivePIN));
             nNetworkKey =       (std::move(session.nNetworkKey));
@@ -104,6 +110,9 @@ namespace TAO
             /* Instantiate the sig chain */
             pSigChain = new TAO::Ledger::SignatureChain(strUsername, strPassword);
 
+            /* Cache the genesis, which stays the same when the password is updated. */
+            hashGenesis = pSigChain->Genesis();
+
             /* Generate and cache the network private key */
             nNetworkKey = new memory::encrypted_type<uint512_t>(pSigChain->Generate("network", 0, strPin));
         }
@@ -247,6 +256,24 @@ namespace TAO
         }
 
 
+        /* Opts this session in or out of background key pregeneration after each transaction. */
+        void Session::SetPregenerateKeys(const bool fPregenerate)
+        {
+            LOCK(MUTEX);
+
+            fPregenerateKeys = fPregenerate;
+        }
+
+
+        /* Checks if this session has opted in to background key pregeneration. */
+        bool Session::CanPregenerateKeys() const
+        {
+            LOCK(MUTEX);
+
+            return fPregenerateKeys;
+        }
+
+
         /*  Returns the sigchain the account logged in. */
         const memory::encrypted_ptr<TAO::Ledger::SignatureChain>& Session::GetAccount() const
         {
@@ -254,6 +281,13 @@ namespace TAO
         }
 
 
+        /* Returns the genesis of the sigchain logged in. */
+        uint256_t Session::Genesis() const
+        {
+            return hashGenesis;
+        }
+
+
         /* Adds a new P2P Request. */
         void Session::AddP2PRequest(const LLP::P2P::ConnectionRequest& request, bool fIncoming)
         {
@@ -18,6 +18,7 @@ ________________________________________________________________________________
 #include <TAO/API/types/function.h>
 #include <TAO/API/types/exception.h>
 #include <Util/include/debug.h>
+#include <Util/include/metrics.h>
 
 /* Global TAO namespace. */
 namespace TAO
@@ -99,12 +100,64 @@ namespace TAO
                     strMethodToCall = RewriteURL(strMethod, jsonParamsUpdated);
 
                 if(mapFunctions.find(strMethodToCall) != mapFunctions.end())
+                {
+                    metrics::Timer timer(Latency(strMethodToCall));
                     return mapFunctions[strMethodToCall].Execute(SanitizeParams(strMethodToCall, jsonParamsUpdated), fHelp);
+                }
                 else
                     throw APIException(-2, debug::safe_printstr("Method not found: ", strMethodToCall));
             }
 
 
+            /** Stream
+             *
+             *  Handles the processing of the requested method by writing the response directly into a
+             *  streaming writer, avoiding the intermediate json::json tree for large responses.
+             *
+             *  @param[in] strMethod The requested API method.
+             *  @param[in] jsonParameters The parameters that the caller has passed to the API request.
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             *  @return True if the method supports streaming and was executed, false to fall back to Execute.
+             *
+             **/
+            bool Stream(const std::string& strMethod, const json::json& jsonParams, json::writer& writer)
+            {
+                json::json jsonParamsUpdated = jsonParams;
+                std::string strMethodToCall = strMethod;
+
+                /* Give derived API's the opportunity to rewrite the URL in the same way as Execute. */
+                if(mapFunctions.find(strMethodToCall) == mapFunctions.end())
+                    strMethodToCall = RewriteURL(strMethod, jsonParamsUpdated);
+
+                /* Only methods that registered a stream function can be streamed. */
+                auto it = mapFunctions.find(strMethodToCall);
+                if(it == mapFunctions.end() || !it->second.Streaming())
+                    return false;
+
+                metrics::Timer timer(Latency(strMethodToCall));
+                it->second.Stream(SanitizeParams(strMethodToCall, jsonParamsUpdated), writer);
+
+                return true;
+            }
+
+
+            /** Latency
+             *
+             *  Get the latency histogram of a method of this API.
+             *
+             *  @param[in] strMethod The method name, after any URL rewriting.
+             *
+             *  @return The histogram to record the method latency into.
+             *
+             **/
+            metrics::Histogram& Latency(const std::string& strMethod) const
+            {
+                return metrics::GetHistogram("nexus_api_request_seconds",
+                    metrics::Label("api", GetName()) + "," + metrics::Label("method", strMethod));
+            }
+
+
             /** RewriteURL
              *
              *  Allows derived API's to handle custom/dynamic URL's where the strMethod does not
@@ -107,27 +107,32 @@ namespace TAO
             /* Set the new key scheme */
             tx.nNextType = nScheme;
 
-            /* Regenerate the next hashed public key based on the new scheme */
-            tx.NextHash(user->Generate(tx.nSequence + 1, strPIN), tx.nNextType);
-
             /* Declare operation stream to serialize all of the field updates*/
             TAO::Operation::Stream ssOperationStream;
 
-            /* Regenerate any keys in the crypto object register */
-            if(crypto.get<uint256_t>("auth") != 0)
-                ssOperationStream << std::string("auth") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("auth", 0, strPIN, tx.nNextType);
-            
-            if(crypto.get<uint256_t>("lisp") != 0)
-                ssOperationStream << std::string("lisp") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("lisp", 0, strPIN, tx.nNextType);
+            /* Hold the sigchain decrypted while the next hash and the register keys are regenerated. */
+            {
+                memory::decrypted_view<TAO::Ledger::SignatureChain> unlocked(user);
+
+                /* Regenerate the next hashed public key based on the new scheme */
+                tx.NextHash(unlocked->Generate(tx.nSequence + 1, strPIN), tx.nNextType);
+
+                /* Regenerate any keys in the crypto object register */
+                if(crypto.get<uint256_t>("auth") != 0)
+                    ssOperationStream << std::string("auth") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("auth", 0, strPIN, tx.nNextType);
+
+                if(crypto.get<uint256_t>("lisp") != 0)
+                    ssOperationStream << std::string("lisp") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("lisp", 0, strPIN, tx.nNextType);
 
-            if(crypto.get<uint256_t>("network") != 0)
-                ssOperationStream << std::string("network") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("network", 0, strPIN, tx.nNextType);
+                if(crypto.get<uint256_t>("network") != 0)
+                    ssOperationStream << std::string("network") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("network", 0, strPIN, tx.nNextType);
 
-            if(crypto.get<uint256_t>("sign") != 0)
-                ssOperationStream << std::string("sign") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("sign", 0, strPIN, tx.nNextType);
+                if(crypto.get<uint256_t>("sign") != 0)
+                    ssOperationStream << std::string("sign") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("sign", 0, strPIN, tx.nNextType);
 
-            if(crypto.get<uint256_t>("verify") != 0)
-                ssOperationStream << std::string("verify") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("verify", 0, strPIN, tx.nNextType);
+                if(crypto.get<uint256_t>("verify") != 0)
+                    ssOperationStream << std::string("verify") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("verify", 0, strPIN, tx.nNextType);
+            }
 
             /* Add the crypto update contract. */
             tx[tx.Size()] << uint8_t(TAO::Operation::OP::WRITE) << hashCrypto << ssOperationStream.Bytes();
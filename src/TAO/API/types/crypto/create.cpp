@@ -72,7 +72,7 @@ namespace TAO
                 throw APIException(-291, "The cert key cannot be used to create a key pair as it is reserved for a TLS certificate.  Please use the create/certificate API method instead.");
 
             /* The logged in sig chain genesis hash */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* The address of the crypto object register, which is deterministic based on the genesis */
             TAO::Register::Address hashCrypto = TAO::Register::Address(std::string("crypto"), hashGenesis, TAO::Register::Address::CRYPTO);
@@ -190,7 +190,7 @@ namespace TAO
             Session& session = users->GetSession(params);
 
             /* The logged in sig chain genesis hash */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* The address of the crypto object register, which is deterministic based on the genesis */
             TAO::Register::Address hashCrypto = TAO::Register::Address(std::string("crypto"), hashGenesis, TAO::Register::Address::CRYPTO);
@@ -62,7 +62,7 @@ namespace TAO
             
             /* use logged in session. */
             else 
-                hashGenesis = users->GetSession(params).GetAccount()->Genesis();
+                hashGenesis = users->GetSession(params).Genesis();
            
             /* Prevent foreign data lookup in client mode */
             if(config::fClient.load() && hashGenesis != users->GetCallersGenesis(params))
@@ -152,7 +152,7 @@ namespace TAO
             std::string strName = params["name"].get<std::string>();
 
             /* The logged in sig chain genesis hash */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* The scheme to use to generate the key. */
             uint8_t nKeyType = get_scheme(params);
@@ -336,7 +336,7 @@ namespace TAO
             Session& session = users->GetSession(params);
 
             /* The logged in sig chain genesis hash */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* The address of the crypto object register, which is deterministic based on the genesis */
             TAO::Register::Address hashCrypto = TAO::Register::Address(std::string("crypto"), hashGenesis, TAO::Register::Address::CRYPTO);
@@ -170,6 +170,17 @@ namespace TAO
             json::json List(const json::json& params, bool fHelp);
 
 
+            /** ListStream
+             *
+             *  List all NXS accounts directly into a streaming writer.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             **/
+            void ListStream(const json::json& params, json::writer& writer);
+
+
             /** ListTransactions
              *
              *  Lists all transactions for a given account
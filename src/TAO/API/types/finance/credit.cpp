@@ -62,7 +62,7 @@ namespace TAO
             Session& session = users->GetSession(params);
 
             /* Genesis hash of the user */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* Check for txid parameter. */
             if(params.find("txid") == params.end())
@@ -287,7 +287,7 @@ namespace TAO
 
                     /* Add expiration condition unless sending to self */
                     if(!fSendToSelf)
-                        AddExpires( jsonRecipient, session.GetAccount()->Genesis(), tx[nContract], fTokenizedDebit);
+                        AddExpires( jsonRecipient, session.Genesis(), tx[nContract], fTokenizedDebit);
 
                     /* Increment the contract ID */
                     nContract++;
@@ -51,14 +51,17 @@ namespace TAO
             if(!user)
                 throw APIException(-10, "Invalid session ID");
 
+            /* Get the genesis once, rather than decrypting the sigchain for every lookup. */
+            const uint256_t hashGenesis = user->Genesis();
+
             /* Retrieve the trust register address, which is based on the users genesis */
-            TAO::Register::Address hashRegister = TAO::Register::Address(std::string("trust"), user->Genesis(), TAO::Register::Address::TRUST);
+            TAO::Register::Address hashRegister = TAO::Register::Address(std::string("trust"), hashGenesis, TAO::Register::Address::TRUST);
 
             /* Get trust account. Any trust account that has completed Genesis will be indexed. */
             TAO::Register::Object trust;
 
             /* Check for trust index. */
-            if(!LLD::Register->ReadTrust(user->Genesis(), trust)
+            if(!LLD::Register->ReadTrust(hashGenesis, trust)
             && !LLD::Register->ReadState(hashRegister, trust, TAO::Ledger::FLAGS::MEMPOOL))
                 throw APIException(-70, "Trust account not found");
 
@@ -89,17 +92,17 @@ namespace TAO
             TAO::Ledger::StakeMinter& stakeMinter = TAO::Ledger::StakeMinter::GetInstance();
 
             /* Indexed trust account has genesis */
-            bool fTrustIndexed = LLD::Register->HasTrust(user->Genesis());
+            bool fTrustIndexed = LLD::Register->HasTrust(hashGenesis);
 
             ret["new"] = (bool)(!fTrustIndexed);
 
             /* Return whether stake minter is started and actively running. */
-            ret["staking"] = (bool)(stakeMinter.IsStarted() && trust.hashOwner == user->Genesis());
+            ret["staking"] = (bool)(stakeMinter.IsStarted() && trust.hashOwner == hashGenesis);
 
             /* Need the stake minter running for accessing current staking metrics.
              * Verifying current user ownership of trust account is a sanity check.
              */
-            if(stakeMinter.IsStarted() && trust.hashOwner == user->Genesis())
+            if(stakeMinter.IsStarted() && trust.hashOwner == hashGenesis)
             {
                 /* The trust account is on hold when it does not have genesis, and is waiting to reach minimum age to stake */
                 bool fOnHold = (!fTrustIndexed && stakeMinter.IsWaitPeriod());
@@ -131,7 +134,7 @@ namespace TAO
             }
 
             TAO::Ledger::StakeChange stakeChange;
-            if(LLD::Local->ReadStakeChange(user->Genesis(), stakeChange) && !stakeChange.fProcessed
+            if(LLD::Local->ReadStakeChange(hashGenesis, stakeChange) && !stakeChange.fProcessed
             && (stakeChange.nExpires == 0 || stakeChange.nExpires > runtime::unifiedtimestamp()))
             {
                 ret["change"] = true;
@@ -26,6 +26,8 @@ ________________________________________________________________________________
 
 #include <Util/include/debug.h>
 
+#include <functional>
+
 
 /* Global TAO namespace. */
 namespace TAO
@@ -35,12 +37,10 @@ namespace TAO
     namespace API
     {
 
-        /* Get a list of accounts owned by a signature chain. */
-        json::json Finance::List(const json::json& params, bool fHelp)
+        /* Iterates the requested page of NXS accounts owned by a signature chain, passing each one to the callback. */
+        static void list_accounts(const json::json& params,
+            const std::function<void(const TAO::Register::Object&, const TAO::Register::Address&)>& fnAccount)
         {
-            /* JSON return value. */
-            json::json ret;// = json::json::array();
-
             /* Get the session to be used for this API call */
             Session& session = users->GetSession(params);
 
@@ -111,13 +111,50 @@ namespace TAO
                 if(nTotal - (nPage * nLimit) > nLimit)
                     break;
 
-                /* Convert the object to JSON */
-                ret.push_back(TAO::API::ObjectToJSON(params, object, state.first));
+                /* Hand the account to the caller. */
+                fnAccount(object, state.first);
             }
+        }
+
+
+        /* Get a list of accounts owned by a signature chain. */
+        json::json Finance::List(const json::json& params, bool fHelp)
+        {
+            /* JSON return value. */
+            json::json ret;// = json::json::array();
+
+            /* Convert each object to JSON */
+            list_accounts(params, [&](const TAO::Register::Object& object, const TAO::Register::Address& hashRegister)
+            {
+                ret.push_back(TAO::API::ObjectToJSON(params, object, hashRegister));
+            });
 
             return ret;
         }
 
+
+        /* List all NXS accounts directly into a streaming writer. */
+        void Finance::ListStream(const json::json& params, json::writer& writer)
+        {
+            /* The array is only opened once there is an account, matching the null result of List when there are none. */
+            bool fEmpty = true;
+            list_accounts(params, [&](const TAO::Register::Object& object, const TAO::Register::Address& hashRegister)
+            {
+                if(fEmpty)
+                {
+                    writer.BeginArray();
+                    fEmpty = false;
+                }
+
+                writer.Value(TAO::API::ObjectToJSON(params, object, hashRegister));
+            });
+
+            if(fEmpty)
+                writer.Null();
+            else
+                writer.EndArray();
+        }
+
         /* Lists all transactions for a given account. */
         json::json Finance::ListTransactions(const json::json& params, bool fHelp)
         {
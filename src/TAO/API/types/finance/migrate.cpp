@@ -171,7 +171,7 @@ namespace TAO
                 if(!hashAccount.IsValid())
                 {
                     std::vector<TAO::Register::Address> vAccounts;
-                    if(ListAccounts(session.GetAccount()->Genesis(), vAccounts, false, false))
+                    if(ListAccounts(session.Genesis(), vAccounts, false, false))
                     {
                         for(const auto& hashRegister : vAccounts)
                         {
@@ -240,7 +240,7 @@ namespace TAO
 
                     /* If user has not explicitly indicated not to create a name then create a Name Object register for it. */
                     if(fCreateName)
-                        tx[nContracts++] = Names::CreateName(session.GetAccount()->Genesis(), strAccount, "", hashAccount);
+                        tx[nContracts++] = Names::CreateName(session.Genesis(), strAccount, "", hashAccount);
                 }
 
                 /* Add this to the map */
@@ -16,6 +16,8 @@ ________________________________________________________________________________
 #define NEXUS_TAO_API_TYPES_FUNCTION_H
 
 #include <Util/include/json.h>
+#include <Util/include/json_writer.h>
+
 #include <functional>
 #include <memory>
 
@@ -39,6 +41,10 @@ namespace TAO
             std::function<json::json(const json::json&, bool)> function;
 
 
+            /** The optional function pointer to stream the response directly into a writer. */
+            std::function<void(const json::json&, json::writer&)> stream;
+
+
             /** The state being enabled or not. **/
             bool fEnabled;
 
@@ -49,6 +55,7 @@ namespace TAO
             /** Default Constructor. **/
             Function()
             : function()
+            , stream()
             , fEnabled(true)
             {
             }
@@ -57,6 +64,17 @@ namespace TAO
             /** Function input **/
             Function(std::function<json::json(const json::json&, bool)> functionIn)
             : function(functionIn)
+            , stream()
+            , fEnabled(true)
+            {
+            }
+
+
+            /** Function input with streaming support **/
+            Function(std::function<json::json(const json::json&, bool)> functionIn,
+                     std::function<void(const json::json&, json::writer&)> streamIn)
+            : function(functionIn)
+            , stream(streamIn)
             , fEnabled(true)
             {
             }
@@ -81,6 +99,33 @@ namespace TAO
             }
 
 
+            /** Streaming
+             *
+             *  Determines if this function can stream its response.
+             *
+             *  @return True if enabled and a stream function pointer is set.
+             *
+             **/
+            bool Streaming() const
+            {
+                return fEnabled && stream;
+            }
+
+
+            /** Stream
+             *
+             *  Executes the stream function pointer, writing the response directly.
+             *
+             *  @param[in] params The json formatted parameters
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             **/
+            void Stream(const json::json& jsonParams, json::writer& writer)
+            {
+                stream(jsonParams, writer);
+            }
+
+
             /** Disable
              *
              *  Disables the method from executing.
@@ -142,7 +142,7 @@ namespace TAO
             }
 
             /* Check that the recipient isn't the sender */
-            if(hashRecipient == session.GetAccount()->Genesis())
+            if(hashRecipient == session.Genesis())
                 throw APIException(-244, "Cannot send invoice to self");
 
             /* Add the mandatroy invoice fields to the invoice JSON */
@@ -292,7 +292,7 @@ namespace TAO
 
             /* Check for name parameter. If one is supplied then we need to create a Name Object register for it. */
             if(params.find("name") != params.end())
-                tx[nContract++] = Names::CreateName(session.GetAccount()->Genesis(), params["name"].get<std::string>(), "", hashRegister);
+                tx[nContract++] = Names::CreateName(session.Genesis(), params["name"].get<std::string>(), "", hashRegister);
 
             /* Add the transfer contract */
             tx[nContract] << uint8_t(TAO::Operation::OP::CONDITION) << (uint8_t)TAO::Operation::OP::TRANSFER << hashRegister << hashRecipient << uint8_t(TAO::Operation::TRANSFER::CLAIM);
@@ -100,7 +100,7 @@ namespace TAO
             hashRecipient.SetHex(invoice["recipient"].get<std::string>());
 
             /* Ensure the caller is the recipient */
-            if(hashRecipient != session.GetAccount()->Genesis())
+            if(hashRecipient != session.Genesis())
                 throw APIException(-250, "Invoice is not yours to pay");
 
             /* Get the invoice status so that we can validate that we are allowed to cancel it */
@@ -0,0 +1,140 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+
+#include <LLC/types/uint1024.h>
+
+#include <Util/include/allocators.h>
+#include <Util/include/mutex.h>
+
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <tuple>
+
+
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* API Layer namespace. */
+    namespace API
+    {
+        /** KeyPipeline Class
+         *
+         *  Pregenerates the sigchain keys for the next transaction in the background, so that a
+         *  following create call does not have to wait on the argon2 and key pair derivations.
+         *  Only sessions that have opted in with Session::SetPregenerateKeys are processed.
+         *
+         **/
+        class KeyPipeline
+        {
+
+        public:
+
+            /** Default Constructor. **/
+            KeyPipeline();
+
+
+            /** Destructor. **/
+            ~KeyPipeline();
+
+
+            /** Queue
+             *
+             *  Queue key pregeneration for the transaction following the given sequence. The job is only queued
+             *  for sessions that opted in, and the pipeline thread is started by the first queued job. The job
+             *  waits on the session's CREATE_MUTEX and is dropped unless that sequence is the last in the sigchain.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain that created the transaction.
+             *  @param[in] strPIN The pin used to create the transaction.
+             *  @param[in] nSequence The sequence of the transaction that was created.
+             *
+             **/
+            void Queue(const uint256_t& hashGenesis, const SecureString& strPIN, const uint32_t nSequence);
+
+
+            /** Remove
+             *
+             *  Drop the queued jobs for a sigchain and wait for its running job to finish. Must be called with
+             *  the session's CREATE_MUTEX held before the session is removed, so the job never outlives it.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain that is logging out.
+             *
+             **/
+            void Remove(const uint256_t& hashGenesis);
+
+
+          private:
+
+            /** the shutdown flag for gracefully shutting down pipeline thread. **/
+            std::atomic<bool> fShutdown;
+
+
+            /** The genesis of the job being processed, or zero if idle. **/
+            uint256_t hashActive;
+
+
+            /** Flag set by Remove to abandon the job being processed. **/
+            bool fCancel;
+
+
+            /** The mutex for the jobs queue and the active job. **/
+            std::mutex MUTEX;
+
+
+            /** The condition variable to awaken sleeping pipeline thread. **/
+            std::condition_variable CONDITION;
+
+
+            /** Queue of genesis, pin and sequence to pregenerate keys for. **/
+            std::deque<std::tuple<uint256_t, SecureString, uint32_t>> queueJobs;
+
+
+            /** The key pregeneration thread. **/
+            std::thread PIPELINE_THREAD;
+
+
+            /** Thread
+             *
+             *  Background thread to process the pregeneration jobs.
+             *
+             **/
+            void Thread();
+
+
+            /** cancelled
+             *
+             *  Check whether the running job has been abandoned by Remove or shutdown.
+             *
+             **/
+            bool cancelled();
+
+
+            /** pregenerate
+             *
+             *  Pregenerate the keys for the transaction following nSequence.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *  @param[in] strPIN The pin to generate keys with.
+             *  @param[in] nSequence The sequence of the transaction that was created.
+             *
+             **/
+            void pregenerate(const uint256_t& hashGenesis, const SecureString& strPIN, const uint32_t nSequence);
+
+        };
+    }
+}
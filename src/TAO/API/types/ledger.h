@@ -119,6 +119,17 @@ namespace TAO
             json::json Block(const json::json& params, bool fHelp);
 
 
+            /** BlockStream
+             *
+             *  Writes the block data for a given hash or height directly into a streaming writer.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             **/
+            void BlockStream(const json::json& params, json::writer& writer);
+
+
             /** Blocks
              *
              *  Retrieves the block data for a sequential range of blocks
@@ -133,6 +144,18 @@ namespace TAO
             json::json Blocks(const json::json& params, bool fHelp);
 
 
+            /** BlocksStream
+             *
+             *  Writes the block data for a sequential range of blocks starting at a
+             *  given hash or height directly into a streaming writer.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             **/
+            void BlocksStream(const json::json& params, json::writer& writer);
+
+
             /** Transaction
              *
              *  Retrieves the transaction data for a given hash.
@@ -27,6 +27,8 @@ ________________________________________________________________________________
 #include <Util/include/hex.h>
 #include <Util/include/string.h>
 
+#include <functional>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -78,19 +80,13 @@ namespace TAO
         }
 
 
-        /* Retrieves the block data for a given hash or height. */
-        json::json Ledger::Block(const json::json& params, bool fHelp)
+        /* Reads the block state for the hash or height given in the parameters. */
+        static void read_block(const json::json& params, TAO::Ledger::BlockState& blockState)
         {
-            if(config::fClient.load())
-                throw APIException(-300, "API can only be used to lookup data for the currently logged in signature chain when running in client mode");
-
             /* Check for the block height parameter. */
             if(params.find("hash") == params.end() && params.find("height") == params.end())
                 throw APIException(-84, "Missing hash or height");
 
-            /* Declare the BlockState to load from the DB */
-            TAO::Ledger::BlockState blockState;
-
             /* look up by height*/
             if(params.find("height") != params.end())
             {
@@ -125,7 +121,12 @@ namespace TAO
                 if(!LLD::Ledger->ReadBlock(blockHash, blockState))
                     throw APIException(-83, "Block not found");
             }
+        }
 
+
+        /* Gets the transaction verbosity level from the request. */
+        static uint32_t get_verbosity(const json::json& params)
+        {
             std::string strVerbose = "default";
             if(params.find("verbose") != params.end())
                 strVerbose = params["verbose"].get<std::string>();
@@ -141,21 +142,16 @@ namespace TAO
             else if(strVerbose == "detail")
                 nVerbose = 3;
 
-            json::json ret = TAO::API::BlockToJSON(blockState, nVerbose);
-
-            return ret;
+            return nVerbose;
         }
 
 
-        /* Retrieves the block data for a sequential range of blocks starting at a given hash or height. */
-        json::json Ledger::Blocks(const json::json& params, bool fHelp)
+        /* Iterates the requested page of blocks starting at a given hash or height, passing each one to the callback. */
+        static void list_blocks(const json::json& params, const std::function<void(const TAO::Ledger::BlockState&)>& fnBlock)
         {
-            /* Check for the block height parameter. */
-            if(params.find("hash") == params.end() && params.find("height") == params.end())
-                throw APIException(-84, "Missing hash or height");
-
             /* Declare the BlockState to load from the DB */
             TAO::Ledger::BlockState blockState;
+            read_block(params, blockState);
 
             /* Check for page parameter. */
             uint32_t nPage = 0;
@@ -167,60 +163,6 @@ namespace TAO
             if(params.find("limit") != params.end())
                 nLimit = std::stoul(params["limit"].get<std::string>());
 
-            /* look up by height*/
-            if(params.find("height") != params.end())
-            {
-                /* Check that the node is configured to index blocks by height */
-                if(!config::GetBoolArg("-indexheight"))
-                    throw APIException(-85, "getblock by height requires the daemon to be started with the -indexheight flag.");
-
-                /* Check that the height parameter is numeric*/
-                std::string strHeight = params["height"].get<std::string>();
-
-                if(!IsAllDigit(strHeight))
-                    throw APIException(-81, "Invalid height parameter");
-
-                /* Convert the incoming height string to an int*/
-                uint32_t nHeight = std::stoul(strHeight);
-
-                /* Check that the requested height is within our chain range*/
-                if(nHeight > TAO::Ledger::ChainState::nBestHeight.load())
-                    throw APIException(-82, "Block number out of range.");
-
-                /* Read the block state from the the ledger DB using the height index */
-                if(!LLD::Ledger->ReadBlock(nHeight, blockState))
-                    throw APIException(-83, "Block not found");
-            }
-            else if(params.find("hash") != params.end())
-            {
-                uint1024_t blockHash;
-                /* Load the hash from the params*/
-                blockHash.SetHex(params["hash"].get<std::string>());
-
-                /* Read the block state from the the ledger DB using the hash index */
-                if(!LLD::Ledger->ReadBlock(blockHash, blockState))
-                    throw APIException(-83, "Block not found");
-            }
-
-            /* Get the transaction verbosity level from the request*/
-            std::string strVerbose = "default";
-            if(params.find("verbose") != params.end())
-                strVerbose = params["verbose"].get<std::string>();
-
-            /* Default to verbosity 1 which includes only the hash */
-            uint32_t nVerbose = 1;
-            if(strVerbose == "none")
-                nVerbose = 0;
-            else if(strVerbose == "default")
-                nVerbose = 1;
-            else if(strVerbose == "summary")
-                nVerbose = 2;
-            else if(strVerbose == "detail")
-                nVerbose = 3;
-
-            /* Declare the JSON array to return */
-            json::json ret = json::json::array();
-
             /* Iterate through blocks until we hit the limit or no more blocks*/
             uint32_t nTotal = 0;
             while(!blockState.IsNull())
@@ -246,15 +188,75 @@ namespace TAO
                 if(nTotal - (nPage * nLimit) > nLimit)
                     break;
 
+                /* Hand the block to the caller. */
+                fnBlock(blockToAdd);
+            }
+        }
+
+
+        /* Retrieves the block data for a given hash or height. */
+        json::json Ledger::Block(const json::json& params, bool fHelp)
+        {
+            if(config::fClient.load())
+                throw APIException(-300, "API can only be used to lookup data for the currently logged in signature chain when running in client mode");
 
-                /* convert the block to JSON data and add it to the return JSON array*/
-                ret.push_back(TAO::API::BlockToJSON(blockToAdd, nVerbose));
+            /* Declare the BlockState to load from the DB */
+            TAO::Ledger::BlockState blockState;
+            read_block(params, blockState);
 
-                ;
+            json::json ret = TAO::API::BlockToJSON(blockState, get_verbosity(params));
+
+            return ret;
+        }
+
+
+        /* Writes the block data for a given hash or height directly into a streaming writer. */
+        void Ledger::BlockStream(const json::json& params, json::writer& writer)
+        {
+            if(config::fClient.load())
+                throw APIException(-300, "API can only be used to lookup data for the currently logged in signature chain when running in client mode");
+
+            /* Declare the BlockState to load from the DB */
+            TAO::Ledger::BlockState blockState;
+            read_block(params, blockState);
+
+            TAO::API::BlockToJSON(blockState, get_verbosity(params), writer);
+        }
+
+
+        /* Retrieves the block data for a sequential range of blocks starting at a given hash or height. */
+        json::json Ledger::Blocks(const json::json& params, bool fHelp)
+        {
+            /* Get the transaction verbosity level from the request*/
+            uint32_t nVerbose = get_verbosity(params);
+
+            /* Declare the JSON array to return */
+            json::json ret = json::json::array();
+
+            /* convert each block to JSON data and add it to the return JSON array*/
+            list_blocks(params, [&](const TAO::Ledger::BlockState& block)
+            {
+                ret.push_back(TAO::API::BlockToJSON(block, nVerbose));
+            });
 
-            }
             return ret;
         }
+
+
+        /* Writes the block data for a sequential range of blocks directly into a streaming writer. */
+        void Ledger::BlocksStream(const json::json& params, json::writer& writer)
+        {
+            /* Get the transaction verbosity level from the request*/
+            uint32_t nVerbose = get_verbosity(params);
+
+            /* Write each block straight into the response array. */
+            writer.BeginArray();
+            list_blocks(params, [&](const TAO::Ledger::BlockState& block)
+            {
+                TAO::API::BlockToJSON(block, nVerbose, writer);
+            });
+            writer.EndArray();
+        }
     }
 
 }
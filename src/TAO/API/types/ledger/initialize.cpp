@@ -28,8 +28,10 @@ namespace TAO
         {
             mapFunctions["create"] = Function(std::bind(&Ledger::Create, this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["get/blockhash"] = Function(std::bind(&Ledger::BlockHash, this, std::placeholders::_1, std::placeholders::_2));
-            mapFunctions["get/block"] = Function(std::bind(&Ledger::Block, this, std::placeholders::_1, std::placeholders::_2));
-            mapFunctions["list/blocks"] = Function(std::bind(&Ledger::Blocks, this, std::placeholders::_1, std::placeholders::_2));
+            mapFunctions["get/block"] = Function(std::bind(&Ledger::Block, this, std::placeholders::_1, std::placeholders::_2),
+                                                 std::bind(&Ledger::BlockStream, this, std::placeholders::_1, std::placeholders::_2));
+            mapFunctions["list/blocks"] = Function(std::bind(&Ledger::Blocks, this, std::placeholders::_1, std::placeholders::_2),
+                                                   std::bind(&Ledger::BlocksStream, this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["get/transaction"] = Function(std::bind(&Ledger::Transaction, this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["submit/transaction"] = Function(std::bind(&Ledger::Submit, this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["void/transaction"] = Function(std::bind(&Ledger::VoidTransaction, this, std::placeholders::_1, std::placeholders::_2));
@@ -120,7 +120,7 @@ namespace TAO
 
 
             /* Create the Name object contract */
-            tx[0] = Names::CreateName(session.GetAccount()->Genesis(), strName, strNamespace, hashRegister);
+            tx[0] = Names::CreateName(session.Genesis(), strName, strNamespace, hashRegister);
 
             /* Add the fee */
             AddFee(tx);
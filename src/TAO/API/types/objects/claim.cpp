@@ -147,11 +147,11 @@ namespace TAO
 
                     /* If the caller has passed in a name then create a name record using the new name */
                     if(!strName.empty())
-                        nameContract = Names::CreateName(session.GetAccount()->Genesis(), strName, "", hashAddress);
+                        nameContract = Names::CreateName(session.Genesis(), strName, "", hashAddress);
 
                     /* Otherwise create a new name from the previous owners name */
                     else
-                        nameContract = Names::CreateName(session.GetAccount()->Genesis(), hashTx);
+                        nameContract = Names::CreateName(session.Genesis(), hashTx);
 
                     /* If the Name contract operation was created then add it to the transaction */
                     if(!nameContract.Empty())
@@ -97,19 +97,57 @@ namespace TAO
             if(!LLD::Ledger->ReadLast(hashOwner, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
                 throw APIException(-107, "No history found");
 
+            /* The register history index only has every confirmed contract if it was started at genesis. */
+            uint32_t nHistoryHeight = 0;
+            const bool fIndex = !config::fClient.load() && LLD::Ledger->ReadHistoryHeight(nHistoryHeight) && nHistoryHeight == 0;
+
+            /* Walk the sigchain until the last confirmed transaction, then read the rest from the index. */
+            uint512_t hashConfirmed = 0;
+            uint32_t nSequence = 0;
+            if(fIndex)
+            {
+                LLD::Ledger->ReadLast(hashOwner, hashConfirmed);
+                LLD::Ledger->ReadHistorySize(hashRegister, nSequence);
+            }
+
+            bool fIndexed = false;
+            std::vector<uint32_t> vIndexed;
+
             /* Iterate through sigchain for register updates. */
             while(hashLast != 0)
             {
+                /* Switch to the register history index once the unconfirmed transactions are done. */
+                if(fIndex && !fIndexed && hashLast == hashConfirmed)
+                {
+                    fIndexed = true;
+                    if(!LLD::Ledger->ReadHistory(hashRegister, nSequence, hashLast, vIndexed))
+                        break;
+                }
+
                 /* Get the transaction from disk. */
                 TAO::Ledger::Transaction tx;
                 if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
                     throw APIException(-108, "Failed to read transaction");
 
-                /* Set the next last. */
-                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+                /* Get the contracts to check newest first, and set the next last. */
+                std::vector<uint32_t> vCheck;
+                if(fIndexed)
+                {
+                    vCheck = vIndexed;
+
+                    if(!LLD::Ledger->ReadHistory(hashRegister, nSequence, hashLast, vIndexed))
+                        hashLast = 0;
+                }
+                else
+                {
+                    for(int32_t nContract = tx.Size() - 1; nContract >= 0; --nContract)
+                        vCheck.push_back(nContract);
+
+                    hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+                }
 
                 /* Check through all the contracts. */
-                for(int32_t nContract = tx.Size() - 1; nContract >= 0; --nContract)
+                for(const uint32_t nContract : vCheck)
                 {
                     /* Get the contract. */
                     const TAO::Operation::Contract& contract = tx[nContract];
@@ -371,8 +409,9 @@ namespace TAO
                             /* Push to return array. */
                             ret.push_back(obj);
 
-                            /* Get the previous txid. */
-                            hashLast = hashTx;
+                            /* Get the previous txid, the index already has the previous owner's contracts. */
+                            if(!fIndexed)
+                                hashLast = hashTx;
 
                             break;
                         }
@@ -51,7 +51,7 @@ namespace TAO
                 hashGenesis = TAO::Ledger::SignatureChain::Genesis(params["username"].get<std::string>().c_str());
             else
                 /* If no specific genesis or username have been provided then fall back to the active sig chain */
-                hashGenesis = users->GetSession(params).GetAccount()->Genesis();
+                hashGenesis = users->GetSession(params).Genesis();
             
             /* The genesis hash of the API caller, if logged in */
             uint256_t hashCaller = users->GetCallersGenesis(params);
@@ -115,10 +115,34 @@ namespace TAO
             if(!LLD::Ledger->ReadLast(hashGenesis, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
                 throw APIException(-144, "No transactions found");
 
+            /* The register history index only has every confirmed transaction if it was started at genesis. */
+            uint32_t nHistoryHeight = 0;
+            const bool fIndex = !config::fClient.load() && LLD::Ledger->ReadHistoryHeight(nHistoryHeight) && nHistoryHeight == 0;
+
+            /* Walk the sigchain until the last confirmed transaction, then read the rest from the index. */
+            uint512_t hashConfirmed = 0;
+            uint32_t nSequence = 0;
+            if(fIndex)
+            {
+                LLD::Ledger->ReadLast(hashGenesis, hashConfirmed);
+                LLD::Ledger->ReadHistorySize(hashRegister, nSequence);
+            }
+
+            bool fIndexed = false;
+            std::vector<uint32_t> vIndexed;
+
             /* Loop until genesis. */
             uint32_t nTotal = 0;
             while(hashLast != 0)
             {
+                /* Switch to the register history index once the unconfirmed transactions are done. */
+                if(fIndex && !fIndexed && hashLast == hashConfirmed)
+                {
+                    fIndexed = true;
+                    if(!LLD::Ledger->ReadHistory(hashRegister, nSequence, hashLast, vIndexed))
+                        break;
+                }
+
                 /* Get the current page. */
                 uint32_t nCurrentPage = nTotal / nLimit;
 
@@ -220,10 +244,16 @@ namespace TAO
                 }
 
                 /* Set the next last. */
-                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+                if(fIndexed)
+                {
+                    if(!LLD::Ledger->ReadHistory(hashRegister, nSequence, hashLast, vIndexed))
+                        hashLast = 0;
+                }
+                else
+                    hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
 
-                /* skip this transaction if none of its contracts relate to the register */
-                if(vContracts.size() == 0)
+                /* skip this transaction if none of its contracts relate to the register, the index also has other sigchains */
+                if(vContracts.size() == 0 || tx.hashGenesis != hashGenesis)
                     continue;
 
                 ++nTotal;
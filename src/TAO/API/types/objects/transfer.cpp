@@ -125,7 +125,7 @@ namespace TAO
             tx[0] << (uint8_t)TAO::Operation::OP::TRANSFER << hashRegister << hashTo << uint8_t(TAO::Operation::TRANSFER::CLAIM);
 
             /* Add expiration condition. */
-            AddExpires(params, session.GetAccount()->Genesis(), tx[0], false);
+            AddExpires(params, session.Genesis(), tx[0], false);
 
             /* Add the fee */
             AddFee(tx);
@@ -44,7 +44,7 @@ namespace TAO
             Session& session = users->GetSession(params);
 
             /* Get the Genesis ID. */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* The App ID to search for */
             std::string strAppID = "";
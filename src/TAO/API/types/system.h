@@ -139,6 +139,19 @@ namespace TAO
             json::json Metrics(const json::json& params, bool fHelp);
 
 
+            /** DumpTrace
+             *
+             *  Writes the spans recorded with -trace to a Chrome trace_event file in the data directory.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[in] fHelp Trigger for help data.
+             *
+             *  @return The return object in JSON.
+             *
+             **/
+            json::json DumpTrace(const json::json& params, bool fHelp);
+
+
 
         private:
 
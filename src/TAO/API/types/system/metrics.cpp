@@ -23,6 +23,8 @@ ________________________________________________________________________________
 
 #include <TAO/API/types/system.h>
 
+#include <Util/include/metrics.h>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -211,7 +213,30 @@ namespace TAO
             jsonReserves["hash"] = fHasHash ? double(lastHashBlockState.nReleasedReserve[0]) / TAO::Ledger::NXS_COIN : 0;
             jsonReserves["prime"] = fHasPrime ? double(lastPrimeBlockState.nReleasedReserve[0]) / TAO::Ledger::NXS_COIN : 0;
             jsonRet["reserves"] = jsonReserves;
-            
+
+            /* Add the runtime metrics, grouped by name and then by labels. */
+            json::json jsonRuntime = json::json::object();
+            for(const auto& pMetric : metrics::List())
+            {
+                json::json jsonValue;
+                if(pMetric->nType == metrics::TYPE::HISTOGRAM)
+                {
+                    const metrics::Histogram& histogram = pMetric->histogram;
+
+                    jsonValue["count"]   = histogram.Count();
+                    jsonValue["seconds"] = double(histogram.Sum()) / 1000000;
+                    jsonValue["p50"]     = double(histogram.Quantile(0.50)) / 1000000;
+                    jsonValue["p99"]     = double(histogram.Quantile(0.99)) / 1000000;
+                }
+                else
+                    jsonValue = pMetric->Value();
+
+                if(pMetric->strLabels.empty())
+                    jsonRuntime[pMetric->strName] = jsonValue;
+                else
+                    jsonRuntime[pMetric->strName][pMetric->strLabels] = jsonValue;
+            }
+            jsonRet["runtime"] = jsonRuntime;
 
             return jsonRet;
         }
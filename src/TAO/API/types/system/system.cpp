@@ -51,6 +51,7 @@ namespace TAO
             mapFunctions["list/peers"]       = Function(std::bind(&System::ListPeers,    this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["list/lisp-eids"]   = Function(std::bind(&System::LispEIDs, this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["validate/address"] = Function(std::bind(&System::Validate,    this, std::placeholders::_1, std::placeholders::_2));
+            mapFunctions["dump/trace"]       = Function(std::bind(&System::DumpTrace,   this, std::placeholders::_1, std::placeholders::_2));
         }
 
 
@@ -0,0 +1,48 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/API/types/system.h>
+
+#include <Util/include/runtime.h>
+#include <Util/include/trace.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* API Layer namespace. */
+    namespace API
+    {
+        /* Writes the recorded spans to a Chrome trace file in the data directory. */
+        json::json System::DumpTrace(const json::json& params, bool fHelp)
+        {
+            /* Spans are only recorded with -trace. */
+            if(!trace::fEnabled.load())
+                throw APIException(-297, "Tracing is disabled, start with -trace");
+
+            /* Write to a new file each time so earlier dumps are kept. */
+            const std::string strPath = debug::safe_printstr(config::GetDataDir(), "trace-", runtime::timestamp(true), ".json");
+
+            uint64_t nEvents = 0;
+            if(!trace::Write(strPath, nEvents))
+                throw APIException(-298, "Failed to write trace file");
+
+            /* Build json response. */
+            json::json jsonRet;
+            jsonRet["file"]   = strPath;
+            jsonRet["events"] = nEvents;
+
+            return jsonRet;
+        }
+    }
+}
@@ -159,7 +159,7 @@ namespace TAO
                 if(objectTo.Base() == TAO::Register::OBJECTS::ACCOUNT || objectTo.Base() == TAO::Register::OBJECTS::TOKEN)
                 {
                     /* Check that the debit was made to an account that we own */
-                    if(objectTo.hashOwner == session.GetAccount()->Genesis())
+                    if(objectTo.hashOwner == session.Genesis())
                     {
                         /* If the user requested a particular object type then check it is that type */
                         std::string strType = params.find("type") != params.end() ? params["type"].get<std::string>() : "";
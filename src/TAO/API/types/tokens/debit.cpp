@@ -215,7 +215,7 @@ namespace TAO
 
                 /* Add expiration condition unless sending to self */
                 if(recipient.hashOwner != object.hashOwner)
-                    AddExpires( jsonRecipient, session.GetAccount()->Genesis(), tx[nContract], false);
+                    AddExpires( jsonRecipient, session.Genesis(), tx[nContract], false);
 
                 /* Increment the contract ID */
                 nContract++;
@@ -15,6 +15,7 @@ ________________________________________________________________________________
 
 #include <TAO/API/types/base.h>
 #include <TAO/API/types/notifications_processor.h>
+#include <TAO/API/types/key_pipeline.h>
 #include <TAO/API/include/session.h>
 
 #include <TAO/Operation/types/contract.h>
@@ -75,6 +76,10 @@ namespace TAO
             NotificationsProcessor* NOTIFICATIONS_PROCESSOR;
 
 
+            /** Background key pregeneration for sessions that opt in **/
+            KeyPipeline* KEY_PIPELINE;
+
+
             /** Initialize.
              *
              *  Sets the function pointers for this API.
@@ -321,6 +326,17 @@ namespace TAO
             json::json Transactions(const json::json& params, bool fHelp);
 
 
+            /** TransactionsStream
+             *
+             *  Writes transactions for an account directly into a streaming writer.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[out] writer The writer to serialize the response into.
+             *
+             **/
+            void TransactionsStream(const json::json& params, json::writer& writer);
+
+
             /** Notifications
              *
              *  Get notifications for an account
@@ -131,7 +131,7 @@ namespace TAO
             TAO::Register::Address hashRegister = TAO::Register::Address(std::string("trust"), hashGenesis, TAO::Register::Address::TRUST);
 
             /* Add a Name record for the trust account */
-            tx[0] = Names::CreateName(user->Genesis(), "trust", "", hashRegister);
+            tx[0] = Names::CreateName(hashGenesis, "trust", "", hashRegister);
 
             /* Set up tx operation to create the trust account register at the same time as sig chain genesis. */
             tx[1] << uint8_t(TAO::Operation::OP::CREATE)      << hashRegister
@@ -141,7 +141,7 @@ namespace TAO
             hashRegister = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
 
             /* Add a Name record for the default account */
-            tx[2] = Names::CreateName(user->Genesis(), "default", "", hashRegister);
+            tx[2] = Names::CreateName(hashGenesis, "default", "", hashRegister);
 
             /* Add the default account register operation to the transaction */
             tx[3] << uint8_t(TAO::Operation::OP::CREATE)      << hashRegister
@@ -56,7 +56,7 @@ namespace TAO
                in the parameters in multiuser mode, or that a user is logged in for single user mode. Otherwise the GetSession 
                method will throw an appropriate error. */
             else
-                hashGenesis = users->GetSession(params).GetAccount()->Genesis();
+                hashGenesis = users->GetSession(params).Genesis();
 
             if(config::fClient.load() && hashGenesis != users->GetCallersGenesis(params))
                 throw APIException(-300, "API can only be used to lookup data for the currently logged in signature chain when running in client mode");
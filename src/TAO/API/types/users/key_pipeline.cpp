@@ -0,0 +1,225 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/API/types/key_pipeline.h>
+
+#include <TAO/API/include/global.h>
+#include <TAO/API/include/session.h>
+#include <TAO/API/types/users.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/keycache.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/debug.h>
+
+#include <chrono>
+#include <functional>
+
+namespace TAO
+{
+    namespace API
+    {
+        /* Default Constructor. */
+        KeyPipeline::KeyPipeline()
+        : fShutdown(false)
+        , hashActive(0)
+        , fCancel(false)
+        , MUTEX()
+        , CONDITION()
+        , queueJobs()
+        , PIPELINE_THREAD()
+        {
+        }
+
+
+        /* Destructor. */
+        KeyPipeline::~KeyPipeline()
+        {
+            /* Set the shutdown flag and join pipeline thread. */
+            {
+                LOCK(MUTEX);
+                fShutdown = true;
+            }
+            CONDITION.notify_all();
+
+            if(PIPELINE_THREAD.joinable())
+                PIPELINE_THREAD.join();
+
+            /* Don't leave derived private keys in memory after the pipeline is gone. */
+            TAO::Ledger::PurgeKeys();
+        }
+
+
+        /* Queue key pregeneration for the transaction following the given sequence. */
+        void KeyPipeline::Queue(const uint256_t& hashGenesis, const SecureString& strPIN, const uint32_t nSequence)
+        {
+            /* Only queue for sessions that opted in. The caller holds CREATE_MUTEX so the session is still live. */
+            if(!users->LoggedIn(hashGenesis) || !users->GetSession(hashGenesis, false).CanPregenerateKeys())
+                return;
+
+            {
+                LOCK(MUTEX);
+                if(fShutdown.load())
+                    return;
+
+                /* Start the pipeline thread on the first job, so nodes without pregeneration don't run it. */
+                if(!PIPELINE_THREAD.joinable())
+                    PIPELINE_THREAD = std::thread(std::bind(&KeyPipeline::Thread, this));
+
+                queueJobs.push_back(std::make_tuple(hashGenesis, strPIN, nSequence));
+            }
+
+            CONDITION.notify_all();
+        }
+
+
+        /* Drop the queued jobs for a sigchain and wait for its running job to finish. */
+        void KeyPipeline::Remove(const uint256_t& hashGenesis)
+        {
+            std::unique_lock<std::mutex> lock(MUTEX);
+
+            /* Drop any jobs that have not started yet. */
+            for(auto it = queueJobs.begin(); it != queueJobs.end(); )
+            {
+                if(std::get<0>(*it) == hashGenesis)
+                    it = queueJobs.erase(it);
+                else
+                    ++it;
+            }
+
+            /* Abandon the running job and wait for it to release the session. */
+            if(hashActive == hashGenesis)
+            {
+                fCancel = true;
+                CONDITION.notify_all();
+
+                CONDITION.wait(lock, [this, &hashGenesis]{ return hashActive != hashGenesis; });
+            }
+
+            /* Nothing can derive keys for this sigchain now, so drop the ones already derived. */
+            TAO::Ledger::PurgeKeys(hashGenesis);
+        }
+
+
+        /* Background thread to process the pregeneration jobs. */
+        void KeyPipeline::Thread()
+        {
+            /* Loop the pipeline thread until shutdown. */
+            while(!fShutdown.load())
+            {
+                /* Wait for a job or shutdown. */
+                std::unique_lock<std::mutex> lock(MUTEX);
+                CONDITION.wait(lock, [this]{ return fShutdown.load() || !queueJobs.empty(); });
+
+                /* Check for a shutdown event. */
+                if(fShutdown.load())
+                    return;
+
+                /* Take the next job off the queue and mark its sigchain as active. */
+                std::tuple<uint256_t, SecureString, uint32_t> job = queueJobs.front();
+                queueJobs.pop_front();
+
+                hashActive = std::get<0>(job);
+                fCancel    = false;
+
+                lock.unlock();
+
+                try
+                {
+                    pregenerate(std::get<0>(job), std::get<1>(job), std::get<2>(job));
+                }
+                catch(const std::exception& e)
+                {
+                    /* Log the error and attempt to continue processing */
+                    debug::error(FUNCTION, e.what());
+                }
+
+                /* Release the session to any waiting Remove. */
+                lock.lock();
+                hashActive = 0;
+                lock.unlock();
+
+                CONDITION.notify_all();
+            }
+        }
+
+
+        /* Check whether the running job has been abandoned by Remove or shutdown. */
+        bool KeyPipeline::cancelled()
+        {
+            LOCK(MUTEX);
+            return fCancel || fShutdown.load();
+        }
+
+
+        /* Pregenerate the keys for the transaction following nSequence. */
+        void KeyPipeline::pregenerate(const uint256_t& hashGenesis, const SecureString& strPIN, const uint32_t nSequence)
+        {
+            /* The session may have logged out since the job was queued. */
+            if(!users->LoggedIn(hashGenesis))
+                return;
+
+            /* The session stays live until hashActive is cleared, as logout waits for us in Remove. */
+            Session& session = users->GetSession(hashGenesis, false);
+
+            /* The next transaction signs with the key at nSequence + 1 and commits to the key at nSequence + 2. */
+            uint8_t nNextType = 0;
+            {
+                /* Wait for the transaction that queued this job to be accepted or abandoned. Poll rather than block,
+                 * since logout holds CREATE_MUTEX while it waits in Remove for this job to finish. */
+                std::unique_lock<std::mutex> lockCreate(session.CREATE_MUTEX, std::defer_lock);
+                while(!lockCreate.try_lock())
+                {
+                    std::unique_lock<std::mutex> lock(MUTEX);
+                    if(CONDITION.wait_for(lock, std::chrono::milliseconds(1), [this]{ return fCancel || fShutdown.load(); }))
+                        return;
+                }
+
+                /* Only process sessions that opted in. */
+                if(!session.CanPregenerateKeys())
+                    return;
+
+                /* Get the last transaction, which must be the one that queued this job. */
+                uint512_t hashLast = 0;
+                if(!LLD::Ledger->ReadLast(hashGenesis, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
+                    return;
+
+                TAO::Ledger::Transaction txPrev;
+                if(!LLD::Ledger->ReadTx(hashLast, txPrev, TAO::Ledger::FLAGS::MEMPOOL))
+                    return;
+
+                /* Nothing to do if the transaction failed or another one has been created since. */
+                if(txPrev.nSequence != nSequence)
+                    return;
+
+                nNextType = txPrev.nNextType;
+            }
+
+            /* Derive the keys without CREATE_MUTEX, so the next create isn't held up behind them. */
+            const memory::encrypted_ptr<TAO::Ledger::SignatureChain>& user = session.GetAccount();
+            for(uint32_t nKeyID = nSequence + 1; nKeyID <= nSequence + 2; ++nKeyID)
+            {
+                if(cancelled())
+                    return;
+
+                if(!TAO::Ledger::PregenerateKey(hashGenesis, user->Generate(nKeyID, strPIN), nNextType))
+                    return;
+            }
+
+            debug::log(2, FUNCTION, "Pregenerated keys for ", hashGenesis.SubString(), " sequence ", nSequence + 1);
+        }
+    }
+}
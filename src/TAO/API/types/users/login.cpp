@@ -98,7 +98,7 @@ namespace TAO
             if(config::fClient.load())
             {
                 /* If not using multiuser then check to see whether another user is already logged in */
-                if(GetSessionManager().Has(0) && GetSessionManager().Get(0).GetAccount()->Genesis() != hashGenesis)
+                if(GetSessionManager().Has(0) && GetSessionManager().Get(0).Genesis() != hashGenesis)
                 {
                     throw APIException(-140, "CLIENT MODE: Already logged in with a different username.");
                 }
@@ -194,7 +194,7 @@ namespace TAO
                 auto session = GetSessionManager().mapSessions.begin();
                 while(session != GetSessionManager().mapSessions.end())
                 {
-                    if(session->second.GetAccount()->Genesis() == hashGenesis)
+                    if(session->second.Genesis() == hashGenesis)
                     {
                         ret["genesis"] = hashGenesis.ToString();
                         if(config::fMultiuser.load())
@@ -211,7 +211,7 @@ namespace TAO
             }
 
             /* If not using multiuser then check to see whether another user is already logged in */
-            if(!config::fMultiuser.load() && GetSessionManager().Has(0) && GetSessionManager().Get(0).GetAccount()->Genesis() != hashGenesis)
+            if(!config::fMultiuser.load() && GetSessionManager().Has(0) && GetSessionManager().Get(0).Genesis() != hashGenesis)
             {
                 throw APIException(-140, "Already logged in with a different username.");
             }
@@ -223,6 +223,15 @@ namespace TAO
             if(NOTIFICATIONS_PROCESSOR)
                 NOTIFICATIONS_PROCESSOR->Add(session.ID());
 
+            /* Check if this session opts in to key pregeneration, which defaults to -pregeneratekeys. */
+            bool fPregenerate = config::GetBoolArg("-pregeneratekeys", false);
+            if(params.find("pregenerate") != params.end())
+            {
+                std::string strPregenerate = params["pregenerate"].get<std::string>();
+                fPregenerate = (strPregenerate == "1" || strPregenerate == "true");
+            }
+            session.SetPregenerateKeys(fPregenerate);
+
             ret["genesis"] = hashGenesis.ToString();
 
             if(config::fMultiuser.load())
@@ -268,7 +277,7 @@ namespace TAO
                     Session& session = GetSessionManager().Add(strUsername, strPassword, strPin);
 
                     /* Get the genesis ID. */
-                    uint256_t hashGenesis = session.GetAccount()->Genesis();
+                    uint256_t hashGenesis = session.Genesis();
 
                     /* Check for -client mode. */
                     if(config::fClient.load())
@@ -391,6 +400,9 @@ namespace TAO
                     if(NOTIFICATIONS_PROCESSOR)
                         NOTIFICATIONS_PROCESSOR->Add(session.ID());
 
+                    /* Opt in to key pregeneration, so the stake minter does not wait on key derivation. */
+                    session.SetPregenerateKeys(config::GetBoolArg("-pregeneratekeys", false));
+
                     /* Start the stake minter if successful login. */
                     TAO::Ledger::TritiumMinter::GetInstance().Start();
                 }
@@ -953,7 +953,7 @@ namespace TAO
                in the parameters in multiuser mode, or that a user is logged in for single user mode. Otherwise the GetSession 
                method will throw an appropriate error. */
             else
-                hashGenesis = users->GetSession(params).GetAccount()->Genesis();
+                hashGenesis = users->GetSession(params).Genesis();
 
             /* The genesis hash of the API caller, if logged in */
             uint256_t hashCaller = users->GetCallersGenesis(params);
@@ -1440,7 +1440,7 @@ namespace TAO
                         if(!hashFrom.IsName() && !hashFrom.IsNamespace())
                         {
                             /* Create a new name from the previous owners name */
-                            TAO::Operation::Contract nameContract = Names::CreateName(user->Genesis(), hashTx);
+                            TAO::Operation::Contract nameContract = Names::CreateName(hashGenesis, hashTx);
 
                             /* If the Name contract operation was created then add it to the transaction */
                             if(!nameContract.Empty())
@@ -1505,7 +1505,7 @@ namespace TAO
                     throw APIException(-41, "Failed to parse object from debit transaction");
 
                 /* Check for the owner to make sure this was a send to the current users account */
-                if(debit.hashOwner == user->Genesis())
+                if(debit.hashOwner == hashGenesis)
                 {
                     /* Identify trust migration to create OP::MIGRATE instead of OP::CREDIT */
 
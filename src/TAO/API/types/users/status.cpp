@@ -41,7 +41,7 @@ namespace TAO
             Session& session = users->GetSession(params, true, false);
 
             /* The callers genesis */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* Flag indicating whether to include the username in the response. If this is in multiuser mode then we 
                will only return the username if they have provided a valid pin */
@@ -25,6 +25,8 @@ ________________________________________________________________________________
 
 #include <Util/include/hex.h>
 
+#include <functional>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -33,12 +35,11 @@ namespace TAO
     namespace API
     {
 
-        /* Get a user's account. */
-        json::json Users::Transactions(const json::json& params, bool fHelp)
+        /* Iterates the requested page of a signature chain's transactions, passing each one to the callback. */
+        static void list_transactions(const json::json& params,
+            const std::function<void(const uint256_t&, const TAO::Ledger::Transaction&,
+                                     const TAO::Ledger::BlockState&, uint32_t, const uint256_t&)>& fnTransaction)
         {
-            /* JSON return value. */
-            json::json ret = json::json::array();
-
             /* Get the Genesis ID. */
             uint256_t hashGenesis = 0;
 
@@ -54,7 +55,7 @@ namespace TAO
                in the parameters in multiuser mode, or that a user is logged in for single user mode. Otherwise the GetSession 
                method will throw an appropriate error. */
             else
-                hashGenesis = users->GetSession(params).GetAccount()->Genesis();
+                hashGenesis = users->GetSession(params).Genesis();
 
             /* The genesis hash of the API caller, if logged in */
             uint256_t hashCaller = users->GetCallersGenesis(params);
@@ -117,7 +118,7 @@ namespace TAO
 
             uint32_t nTotal = 0;
 
-            for(auto tx : vtx)
+            for(const auto& tx : vtx)
             {
                 /* Get the current page. */
                 uint32_t nCurrentPage = nTotal / nLimit;
@@ -138,13 +139,42 @@ namespace TAO
                 TAO::Ledger::BlockState blockState;
                 LLD::Ledger->ReadBlock(tx.GetHash(), blockState);
 
-                /* Get the transaction JSON. */
-                json::json obj = TAO::API::TransactionToJSON(hashCaller, tx, blockState, nVerbose, hashGenesis);
-
-                ret.push_back(obj);
+                /* Hand the transaction to the caller. */
+                fnTransaction(hashCaller, tx, blockState, nVerbose, hashGenesis);
             }
+        }
+
+
+        /* Get a user's account. */
+        json::json Users::Transactions(const json::json& params, bool fHelp)
+        {
+            /* JSON return value. */
+            json::json ret = json::json::array();
+
+            /* Get the transaction JSON. */
+            list_transactions(params, [&](const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
+                                          const TAO::Ledger::BlockState& blockState, uint32_t nVerbose, const uint256_t& hashGenesis)
+            {
+                ret.push_back(TAO::API::TransactionToJSON(hashCaller, tx, blockState, nVerbose, hashGenesis));
+            });
 
             return ret;
         }
+
+
+        /* Writes a user's transactions directly into a streaming writer. */
+        void Users::TransactionsStream(const json::json& params, json::writer& writer)
+        {
+            writer.BeginArray();
+
+            /* Write each transaction straight into the response array. */
+            list_transactions(params, [&](const uint256_t& hashCaller, const TAO::Ledger::Transaction& tx,
+                                          const TAO::Ledger::BlockState& blockState, uint32_t nVerbose, const uint256_t& hashGenesis)
+            {
+                TAO::API::TransactionToJSON(hashCaller, tx, blockState, nVerbose, writer, hashGenesis);
+            });
+
+            writer.EndArray();
+        }
     }
 }
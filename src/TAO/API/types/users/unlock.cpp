@@ -141,7 +141,7 @@ namespace TAO
 
 
             /* Get the genesis ID. */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* Check for duplicates in ledger db. */
             TAO::Ledger::Transaction txPrev;
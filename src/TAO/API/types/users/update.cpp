@@ -101,7 +101,7 @@ namespace TAO
 
             /* Validate the existing credentials again */
             /* Get the genesis ID. */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* Check for duplicates in ledger db. */
             TAO::Ledger::Transaction txPrev;
@@ -308,21 +308,25 @@ namespace TAO
             /* Declare operation stream to serialize all of the field updates*/
             TAO::Operation::Stream ssOperationStream;
 
-            /* Update the keys */
-            if(crypto.get<uint256_t>("auth") != 0)
-                ssOperationStream << std::string("auth") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("auth", 0, strPin, tx.nKeyType);
-            
-            if(crypto.get<uint256_t>("lisp") != 0)
-                ssOperationStream << std::string("lisp") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("lisp", 0, strPin, tx.nKeyType);
+            /* Update the keys, decrypting the sigchain once for all of them. */
+            {
+                memory::decrypted_view<TAO::Ledger::SignatureChain> unlocked(user);
+
+                if(crypto.get<uint256_t>("auth") != 0)
+                    ssOperationStream << std::string("auth") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("auth", 0, strPin, tx.nKeyType);
 
-            if(crypto.get<uint256_t>("network") != 0)
-                ssOperationStream << std::string("network") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("network", 0, strPin, tx.nKeyType);
+                if(crypto.get<uint256_t>("lisp") != 0)
+                    ssOperationStream << std::string("lisp") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("lisp", 0, strPin, tx.nKeyType);
 
-            if(crypto.get<uint256_t>("sign") != 0)
-                ssOperationStream << std::string("sign") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("sign", 0, strPin, tx.nKeyType);
+                if(crypto.get<uint256_t>("network") != 0)
+                    ssOperationStream << std::string("network") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("network", 0, strPin, tx.nKeyType);
 
-            if(crypto.get<uint256_t>("verify") != 0)
-                ssOperationStream << std::string("verify") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << user->KeyHash("verify", 0, strPin, tx.nKeyType);
+                if(crypto.get<uint256_t>("sign") != 0)
+                    ssOperationStream << std::string("sign") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("sign", 0, strPin, tx.nKeyType);
+
+                if(crypto.get<uint256_t>("verify") != 0)
+                    ssOperationStream << std::string("verify") << uint8_t(TAO::Operation::OP::TYPES::UINT256_T) << unlocked->KeyHash("verify", 0, strPin, tx.nKeyType);
+            }
 
             /* Add the crypto update contract. */
             tx[tx.Size()] << uint8_t(TAO::Operation::OP::WRITE) << hashCrypto << ssOperationStream.Bytes();
@@ -46,6 +46,7 @@ namespace TAO
         , fShutdown(false)
         , LOGIN_THREAD()
         , NOTIFICATIONS_PROCESSOR(nullptr)
+        , KEY_PIPELINE(new KeyPipeline())
         {
             Initialize();
 
@@ -72,6 +73,10 @@ namespace TAO
             if(NOTIFICATIONS_PROCESSOR)
                 delete NOTIFICATIONS_PROCESSOR;
 
+            /* Destroy the key pipeline */
+            if(KEY_PIPELINE)
+                delete KEY_PIPELINE;
+
             /* Clear all sessions */
             GetSessionManager().Clear();
 
@@ -149,7 +154,7 @@ namespace TAO
                 }
             }
 
-            return GetSessionManager().Get(nSessionToUse, false).GetAccount()->Genesis(); //TODO: Assess the security of being able to generate genesis. Most likely this should be a localDB thing.
+            return GetSessionManager().Get(nSessionToUse, false).Genesis(); //TODO: Assess the security of being able to generate genesis. Most likely this should be a localDB thing.
         }
 
 
@@ -223,7 +228,7 @@ namespace TAO
         {
             if(!config::fMultiuser.load())
             {
-                if(GetSessionManager().mapSessions.count(0) > 0 && GetSessionManager().mapSessions[0].GetAccount()->Genesis() == hashGenesis)
+                if(GetSessionManager().mapSessions.count(0) > 0 && GetSessionManager().mapSessions[0].Genesis() == hashGenesis)
                     return GetSessionManager().Get(0, fLogActivity);
             }
             else
@@ -231,7 +236,7 @@ namespace TAO
                 auto session = GetSessionManager().mapSessions.begin();
                 while(session != GetSessionManager().mapSessions.end())
                 {
-                    if(session->second.GetAccount()->Genesis() == hashGenesis)
+                    if(session->second.Genesis() == hashGenesis)
                         return GetSessionManager().Get(session->first, fLogActivity);
                     
                     /* increment iterator */
@@ -254,14 +259,14 @@ namespace TAO
         {
             if(!config::fMultiuser.load())
             {
-                return GetSessionManager().Has(0) > 0 && GetSessionManager().Get(0, false).GetAccount()->Genesis() == hashGenesis;
+                return GetSessionManager().Has(0) > 0 && GetSessionManager().Get(0, false).Genesis() == hashGenesis;
             }
             else
             {
                 auto session = GetSessionManager().mapSessions.begin();
                 while(session != GetSessionManager().mapSessions.end())
                 {
-                    if(session->second.GetAccount()->Genesis() == hashGenesis)
+                    if(session->second.Genesis() == hashGenesis)
                         return true;
                     /* increment iterator */
                     ++session;
@@ -336,8 +341,15 @@ namespace TAO
                 CheckMature(user->Genesis());
             }
 
-            /* Create the transaction and return */
-            return TAO::Ledger::CreateTransaction(user, pin, tx);
+            /* Create the transaction. */
+            if(!TAO::Ledger::CreateTransaction(user, pin, tx))
+                return false;
+
+            /* Pregenerate the keys for the following transaction once this one is accepted. */
+            if(users->KEY_PIPELINE)
+                users->KEY_PIPELINE->Queue(tx.hashGenesis, pin, tx.nSequence);
+
+            return true;
         }
 
         /* Checks that the session/password/pin parameters have been provided (where necessary) and then verifies that the 
@@ -356,7 +368,7 @@ namespace TAO
                 throw APIException(-10, "Invalid session ID");
 
             /* The logged in sig chain genesis hash */
-            uint256_t hashGenesis = session.GetAccount()->Genesis();
+            uint256_t hashGenesis = session.Genesis();
 
             /* Get the last transaction. */
             uint512_t hashLast;
@@ -406,7 +418,7 @@ namespace TAO
                 throw APIException(-141, "Already logged out");
 
             /* The genesis of the user logging out */
-            uint256_t hashGenesis = GetSessionManager().Get(nSession).GetAccount()->Genesis();
+            uint256_t hashGenesis = GetSessionManager().Get(nSession).Genesis();
 
             /* If P2P server is running, terminate any connections for this user */
             if(LLP::P2P_SERVER)
@@ -459,6 +471,10 @@ namespace TAO
                 /* Lock the signature chain in case another process attempts to create a transaction . */
                 LOCK(GetSessionManager().Get(nSession).CREATE_MUTEX);
 
+                /* Stop any key pregeneration that is still using the session. */
+                if(KEY_PIPELINE)
+                    KEY_PIPELINE->Remove(hashGenesis);
+
                 /* Finally remove the session from the session manager */
                 GetSessionManager().Remove(nSession);
             }
@@ -63,6 +63,12 @@ namespace TAO
              *
              *  Counts the number of votes (transactions) made to a given account.
              *
+             *  The weighting field of the result says how the weighted total was reached. An account
+             *  with a tally returns "counted": each vote keeps the weight its sender had when it was
+             *  counted, either by rebuild/votes or as its block was connected. Any other account is
+             *  counted by walking its sigchain and returns "current", with every vote weighted by
+             *  its sender's trust now. The two can differ for the same votes.
+             *
              *  @param[in] params The parameters from the API call.
              *  @param[in] fHelp Trigger for help data.
              *
@@ -83,6 +89,20 @@ namespace TAO
              *
              **/
             json::json List(const json::json& params, bool fHelp);
+
+
+            /** Rebuild
+             *
+             *  Recounts the votes made to an account and keeps its tally up to date from then on,
+             *  so that count/votes no longer has to walk the account's sigchain.
+             *
+             *  @param[in] params The parameters from the API call.
+             *  @param[in] fHelp Trigger for help data.
+             *
+             *  @return The return object in JSON.
+             *
+             **/
+            json::json Rebuild(const json::json& params, bool fHelp);
         };
     }
 }
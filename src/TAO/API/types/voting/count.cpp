@@ -21,6 +21,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/sigchain.h>
 #include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/tally.h>
 
 #include <TAO/Operation/include/enum.h>
 
@@ -68,6 +69,17 @@ namespace TAO
             if(account.Base() != TAO::Register::OBJECTS::ACCOUNT)
                 throw APIException(-65, "Object is not an account");
 
+            /* Use the tally if the account has one, it is kept up to date as blocks are connected.
+             * Each vote in a tally keeps the weight its sender had when the vote was counted. */
+            std::pair<uint64_t, uint64_t> pairTally;
+            if(!config::fClient.load() && LLD::Ledger->ReadTally(hashAccount, pairTally))
+            {
+                ret["count"]     = pairTally.first;
+                ret["weighted"]  = (double) pairTally.second / TAO::Ledger::NXS_COIN;
+                ret["weighting"] = "counted";
+
+                return ret;
+            }
 
             /* Get the last transaction. */
             uint512_t hashLast = 0;
@@ -142,44 +154,11 @@ namespace TAO
                     if(vVotes.find(hashSender) != vVotes.end())
                         continue;
 
-                    /* The weighted vote amount for this contract */
-                    uint64_t nVote = TAO::Ledger::NXS_COIN;
-
-                    /* Get the trust account for the sender */
-                    TAO::Register::Address hashTrust = TAO::Register::Address(std::string("trust"), hashSender, TAO::Register::Address::TRUST);
-
-                    /* Get trust account. Any trust account that has completed Genesis will be indexed. */
-                    TAO::Register::Object trust;
-
-                    /* Check for trust index. */
-                    if(!LLD::Register->ReadTrust(hashSender, trust)
-                    && !LLD::Register->ReadState(hashTrust, trust))
+                    /* The weighted vote amount for this contract, sig chains without a trust account can't vote. */
+                    uint64_t nVote = 0;
+                    if(!TAO::Ledger::VoteWeight(hashSender, nVote))
                         continue;
 
-                    /* Parse the object. */
-                    if(!trust.Parse())
-                        throw APIException(-71, "Unable to parse trust account.");
-
-                    /* The amount staked */
-                    uint64_t nStake = trust.get<uint64_t>("stake") ;
-
-                    /* The sender's trust score as a %*/
-                    double dTrustScore = (double)trust.get<uint64_t>("trust") / 10000000.0;
-
-                    /* Only apply the trust weighting if they are staking */
-                    if(nStake > 0 && dTrustScore > 0.5)
-                    {
-                        /* Cap the amount of NXS used in the vote to 10k NXS so that large accounts cannot dominate */
-                        uint64_t nStakeCapped = std::min(nStake, 10000 * TAO::Ledger::NXS_COIN);
-
-                        nVote = TAO::Ledger::NXS_COIN + ((nStakeCapped / 10000) * dTrustScore);  
-
-                        // 1,000 NXS    @ 0.6%      = 1.06 votes
-                        // 10,000 NXS   @ 0.6%      = 1.6 votes
-                        // 10,000 NXS   @ 1%        = 2 votes
-                        // 10,000 NXS   @ 3%        = 4 votes
-                    }
-
                     /* record the vote so that we don't get dupes */
                     vVotes[hashSender] = nVote;
 
@@ -195,9 +174,10 @@ namespace TAO
 
             }
 
-            /* Build response JSON */
+            /* Build response JSON, the walk weights every vote by its sender's current trust. */
             ret["count"] = nVotes;
             ret["weighted"] = dWeightedVotes;
+            ret["weighting"] = "current";
 
             return ret;
         }
@@ -28,6 +28,7 @@ namespace TAO
         {
             mapFunctions["count/votes"]       = Function(std::bind(&Voting::Count,  this, std::placeholders::_1, std::placeholders::_2));
             mapFunctions["list/votes"]        = Function(std::bind(&Voting::List,   this, std::placeholders::_1, std::placeholders::_2));
+            mapFunctions["rebuild/votes"]     = Function(std::bind(&Voting::Rebuild, this, std::placeholders::_1, std::placeholders::_2));
         }
     }
 }
@@ -0,0 +1,80 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/API/include/global.h>
+#include <TAO/API/include/utils.h>
+
+#include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/tally.h>
+
+#include <TAO/Register/types/object.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* API Layer namespace. */
+    namespace API
+    {
+
+        /* Recounts the votes made to an account and keeps its tally up to date. */
+        json::json Voting::Rebuild(const json::json& params, bool fHelp)
+        {
+            /* JSON return value. */
+            json::json ret;
+
+            /* Tallies are kept by the ledger, which client mode doesn't have. */
+            if(config::fClient.load())
+                throw APIException(-300, "API not available in client mode");
+
+            /* The register address of the account to tally. */
+            TAO::Register::Address hashAccount ;
+
+            /* If name is provided then use this to deduce the register address,
+             * otherwise try to find the raw hex encoded address. */
+            if(params.find("name") != params.end() && !params["name"].get<std::string>().empty())
+                hashAccount = Names::ResolveAddress(params, params["name"].get<std::string>());
+            else if(params.find("address") != params.end())
+                hashAccount.SetBase58(params["address"].get<std::string>());
+            else
+                throw APIException(-33, "Missing name or address");
+
+            /* Get the account . */
+            TAO::Register::Object account;
+            if(!LLD::Register->ReadState(hashAccount, account))
+                throw APIException(-13, "Account not found");
+
+            /* Parse the object register. */
+            if(!account.Parse())
+                throw APIException(-14, "Object failed to parse");
+
+            /* Check that the object is an account. */
+            if(account.Base() != TAO::Register::OBJECTS::ACCOUNT)
+                throw APIException(-65, "Object is not an account");
+
+            /* Count the votes and write the tally. */
+            uint64_t nVotes = 0;
+            uint64_t nWeight = 0;
+            if(!TAO::Ledger::RebuildTally(hashAccount, nVotes, nWeight))
+                throw APIException(-144, "No transactions found");
+
+            /* Build response JSON */
+            ret["count"]    = nVotes;
+            ret["weighted"] = (double) nWeight / TAO::Ledger::NXS_COIN;
+
+            return ret;
+        }
+    }
+}
@@ -0,0 +1,242 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <LLP/include/version.h>
+
+#include <TAO/Ledger/include/archive.h>
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/process.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/syncblock.h>
+#include <TAO/Ledger/types/tritium.h>
+
+#include <Legacy/types/legacy.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <algorithm>
+#include <fstream>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Magic bytes at the start of every block archive. */
+        const char ARCHIVE_MAGIC[4] = { 'N', 'X', 'S', 'A' };
+
+
+        /* The maximum size of a single archive record. */
+        const uint32_t MAX_RECORD_SIZE = 64 * 1024 * 1024;
+
+
+        /* The number of blocks between progress messages. */
+        const uint32_t PROGRESS_INTERVAL = 10000;
+
+
+        /* Write the best chain after genesis to a flat block archive. */
+        bool ExportBlocks(const std::string& strPath, uint32_t &nBlocks)
+        {
+            nBlocks = 0;
+
+            /* Open the archive file. */
+            std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "failed to open ", strPath);
+
+            /* Write the archive header. */
+            DataStream ssHeader(SER_DISK, LLP::PROTOCOL_VERSION);
+            ssHeader << ARCHIVE_VERSION << ChainState::Genesis();
+
+            stream.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+            stream.write((char*)ssHeader.Bytes().data(), ssHeader.size());
+
+            /* Walk the best chain forward from genesis. */
+            runtime::timer timer;
+            timer.Start();
+
+            const uint32_t nBestHeight = ChainState::nBestHeight.load();
+            BlockState state = ChainState::stateGenesis;
+            while(!config::fShutdown.load() && state.hashNextBlock != 0 && state.nHeight < nBestHeight)
+            {
+                /* Read the next block in the chain. */
+                const uint1024_t hashNext = state.hashNextBlock;
+                if(!LLD::Ledger->ReadBlock(hashNext, state))
+                    return debug::error(FUNCTION, "failed to read block ", hashNext.SubString());
+
+                /* Serialize the block with its transactions. */
+                DataStream ssRecord(SER_NETWORK, LLP::PROTOCOL_VERSION);
+                ssRecord << SyncBlock(state);
+
+                /* Write the length prefix and record. */
+                DataStream ssSize(SER_DISK, LLP::PROTOCOL_VERSION);
+                ssSize << static_cast<uint32_t>(ssRecord.size());
+
+                stream.write((char*)ssSize.Bytes().data(), ssSize.size());
+                stream.write((char*)ssRecord.Bytes().data(), ssRecord.size());
+                if(!stream.good())
+                    return debug::error(FUNCTION, "failed to write block ", state.nHeight, " to ", strPath);
+
+                /* Log the progress. */
+                if(++nBlocks % PROGRESS_INTERVAL == 0)
+                    debug::log(0, FUNCTION, "Exported ", nBlocks, " blocks height=", state.nHeight,
+                        " [", nBlocks / (timer.Elapsed() + 1), " blocks/s]");
+            }
+
+            stream.close();
+
+            debug::log(0, FUNCTION, "Exported ", nBlocks, " blocks to ", strPath, " in ", timer.Elapsed(), " seconds");
+
+            return !config::fShutdown.load();
+        }
+
+
+        /* Read a block archive and pass each record to a callback in chain order. */
+        bool ReadArchive(const std::string& strPath, const std::function<bool(const SyncBlock&)>& fnBlock)
+        {
+            /* Open the archive file. */
+            std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "failed to open ", strPath);
+
+            /* Check the magic bytes. */
+            char vchMagic[sizeof(ARCHIVE_MAGIC)];
+            if(!stream.read(vchMagic, sizeof(vchMagic)) || !std::equal(vchMagic, vchMagic + sizeof(vchMagic), ARCHIVE_MAGIC))
+                return debug::error(FUNCTION, strPath, " is not a block archive");
+
+            /* Read the archive header. */
+            std::vector<uint8_t> vHeader(4 + 128);
+            if(!stream.read((char*)&vHeader[0], vHeader.size()))
+                return debug::error(FUNCTION, "failed to read archive header");
+
+            uint32_t nVersion = 0;
+            uint1024_t hashGenesis = 0;
+
+            DataStream ssHeader(vHeader, SER_DISK, LLP::PROTOCOL_VERSION);
+            ssHeader >> nVersion >> hashGenesis;
+
+            /* Check the header against this node. */
+            if(nVersion != ARCHIVE_VERSION)
+                return debug::error(FUNCTION, "unsupported archive version ", nVersion);
+
+            if(hashGenesis != ChainState::Genesis())
+                return debug::error(FUNCTION, "archive is for a different network, genesis ", hashGenesis.SubString());
+
+            /* Read the records in chain order. */
+            uint32_t nRecords = 0;
+            std::vector<uint8_t> vSize(4);
+            std::vector<uint8_t> vRecord;
+            while(!config::fShutdown.load())
+            {
+                /* A clean end of file can only fall on a record boundary. */
+                if(!stream.read((char*)&vSize[0], vSize.size()))
+                {
+                    if(stream.gcount() != 0)
+                        return debug::error(FUNCTION, "archive truncated after ", nRecords, " blocks");
+
+                    break;
+                }
+
+                /* Get the length of the record. */
+                uint32_t nSize = 0;
+                DataStream ssSize(vSize, SER_DISK, LLP::PROTOCOL_VERSION);
+                ssSize >> nSize;
+
+                if(nSize == 0 || nSize > MAX_RECORD_SIZE)
+                    return debug::error(FUNCTION, "invalid record size ", nSize, " after ", nRecords, " blocks");
+
+                /* Read the record. */
+                vRecord.resize(nSize);
+                if(!stream.read((char*)&vRecord[0], nSize))
+                    return debug::error(FUNCTION, "archive truncated after ", nRecords, " blocks");
+
+                /* Deserialize the block, which must use up the whole record. */
+                SyncBlock block;
+                try
+                {
+                    DataStream ssRecord(vRecord, SER_NETWORK, LLP::PROTOCOL_VERSION);
+                    ssRecord >> block;
+
+                    if(!ssRecord.End())
+                        return debug::error(FUNCTION, "trailing data in record after ", nRecords, " blocks");
+                }
+                catch(const std::exception& e)
+                {
+                    return debug::error(FUNCTION, "corrupt record after ", nRecords, " blocks: ", e.what());
+                }
+
+                if(!fnBlock(block))
+                    return false;
+
+                ++nRecords;
+            }
+
+            return !config::fShutdown.load();
+        }
+
+
+        /* Read a block archive and feed each block through Process. */
+        bool ImportBlocks(const std::string& strPath, uint32_t &nBlocks)
+        {
+            nBlocks = 0;
+
+            runtime::timer timer;
+            timer.Start();
+
+            uint32_t nSkipped = 0;
+            const bool fRead = ReadArchive(strPath, [&](const SyncBlock& block)
+            {
+                /* Skip blocks we already have, so that an import can be resumed. */
+                if(block.nHeight <= ChainState::nBestHeight.load())
+                {
+                    ++nSkipped;
+                    return true;
+                }
+
+                /* Process the block the same way as a sync block from the network. */
+                uint8_t nStatus = 0;
+                if(block.nVersion >= 7)
+                    Process(TritiumBlock(block), nStatus);
+                else
+                    Process(Legacy::LegacyBlock(block), nStatus);
+
+                /* Anything but an accepted block means the archive doesn't extend our chain. */
+                if(!(nStatus & PROCESS::ACCEPTED))
+                    return debug::error(FUNCTION, "block at height ", block.nHeight, " was not accepted (status ", uint32_t(nStatus), ")");
+
+                /* Build deferred keys between blocks, where the databases agree on the best chain. */
+                if(!LLD::BulkCheckpoint())
+                    return debug::error(FUNCTION, "failed to build keychains at height ", block.nHeight);
+
+                /* Log the progress. */
+                if(++nBlocks % PROGRESS_INTERVAL == 0)
+                    debug::log(0, FUNCTION, "Imported ", nBlocks, " blocks height=", block.nHeight,
+                        " [", nBlocks / (timer.Elapsed() + 1), " blocks/s]");
+
+                return true;
+            });
+
+            debug::log(0, FUNCTION, "Imported ", nBlocks, " blocks (", nSkipped, " skipped) from ", strPath, " in ", timer.Elapsed(), " seconds");
+
+            return fRead;
+        }
+    }
+}
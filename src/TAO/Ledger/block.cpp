@@ -288,6 +288,35 @@ namespace TAO
         }
 
 
+        /* Hash one level of a merkle tree and append the next level, hashing all pairs in one batch. */
+        void BuildMerkleLevel(std::vector<uint512_t> &vMerkleTree, const uint32_t nOffset, const uint32_t nSize)
+        {
+            /* Copy each pair of leaves into one buffer, an odd leaf at the end is paired with itself. */
+            const uint32_t nPairs = (nSize + 1) / 2;
+            std::vector<uint8_t> vPairs(nPairs * 128);
+
+            std::vector<std::pair<const uint8_t*, uint64_t> > vData(nPairs);
+            for(uint32_t i = 0; i < nSize; i += 2)
+            {
+                /* get the references to the left and right leaves in the merkle tree */
+                const uint512_t& hashLeft  = vMerkleTree[nOffset + i];
+                const uint512_t& hashRight = vMerkleTree[nOffset + std::min(i + 1, nSize - 1)];
+
+                uint8_t* pPair = &vPairs[(i / 2) * 128];
+                std::copy(BEGIN(hashLeft),  END(hashLeft),  pPair);
+                std::copy(BEGIN(hashRight), END(hashRight), pPair + 64);
+
+                vData[i / 2] = std::make_pair(pPair, uint64_t(128));
+            }
+
+            /* Hash the pairs, the same as SK512 over the left and right leaves. */
+            std::vector<uint512_t> vHashes;
+            LLC::SK512Batch(vData, vHashes);
+
+            vMerkleTree.insert(vMerkleTree.end(), vHashes.begin(), vHashes.end());
+        }
+
+
         /* Generate the Merkle Tree from uint512_t hashes. */
         uint512_t Block::BuildMerkleTree(const std::vector<uint512_t>& vtx) const
         {
@@ -297,19 +326,10 @@ namespace TAO
                 vMerkleTree.push_back(hash);
 
             /* Compute the merkle root. */
-            uint32_t i = 0;
             uint32_t j = 0;
-            for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) >> 1)
+            for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) / 2)
             {
-                for(i = 0; i < nSize; i += 2)
-                {
-                    /* get the references to the left and right leaves in the merkle tree */
-                    const uint512_t& hashLeft  = vMerkleTree[j + i];
-                    const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
-
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
-                }
+                BuildMerkleLevel(vMerkleTree, j, nSize);
 
                 j += nSize;
             }
@@ -327,19 +347,10 @@ namespace TAO
                 vMerkleTree.push_back(hash.second);
 
             /* Compute the merkle root. */
-            uint32_t i = 0;
             uint32_t j = 0;
             for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) / 2)
             {
-                for(i = 0; i < nSize; i += 2)
-                {
-                    /* get the references to the left and right leaves in the merkle tree */
-                    const uint512_t& hashLeft  = vMerkleTree[j + i];
-                    const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
-
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
-                }
+                BuildMerkleLevel(vMerkleTree, j, nSize);
 
                 j += nSize;
             }
@@ -20,6 +20,9 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/create.h>
 #include <TAO/Ledger/include/timelocks.h>
+#include <TAO/Ledger/types/mempool.h>
+
+#include <Util/include/metrics.h>
 
 /* Global TAO namespace. */
 namespace TAO
@@ -203,6 +206,11 @@ namespace TAO
             nBestHeight     = stateBest.load().nHeight;
             nBestChainTrust = stateBest.load().nChainTrust;
 
+            /* The register history index only covers blocks connected after it was started. */
+            uint32_t nHistoryHeight = 0;
+            if(!LLD::Ledger->ReadHistoryHeight(nHistoryHeight) && !LLD::Ledger->WriteHistoryHeight(nBestHeight.load()))
+                return debug::error(FUNCTION, "failed to write history height");
+
             /* Set the checkpoint. */
             hashCheckpoint = stateBest.load().hashCheckpoint;
 
@@ -251,6 +259,10 @@ namespace TAO
 
             stateBest.load().print();
 
+            /* Expose the chain height and mempool size to the metrics exporters. */
+            metrics::RegisterCallback("nexus_ledger_height", "", []{ return static_cast<int64_t>(nBestHeight.load()); });
+            metrics::RegisterCallback("nexus_mempool_transactions", "", []{ return static_cast<int64_t>(mempool.Size()); });
+
             /* Log the weights. */
             debug::log(0, FUNCTION, "WEIGHTS",
                 " Prime ", stateBest.load().nChannelWeight[1].Get64(),
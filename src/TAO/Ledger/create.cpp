@@ -87,7 +87,7 @@ namespace TAO
             }
 
             /* Get the last transaction. */
-            else if(LLD::Ledger->ReadLast(user->Genesis(), hashLast))
+            else if(LLD::Ledger->ReadLast(hashGenesis, hashLast))
             {
                 /* Get previous transaction */
                 if(!LLD::Ledger->ReadTx(hashLast, txPrev))
@@ -148,7 +148,7 @@ namespace TAO
 
             /* Genesis Transaction. */
             tx.NextHash(user->Generate(tx.nSequence + 1, pin), tx.nNextType);
-            tx.hashGenesis = user->Genesis();
+            tx.hashGenesis = hashGenesis;
 
             return true;
         }
@@ -441,7 +441,7 @@ namespace TAO
                     txProducer[0] << uint8_t(TAO::Operation::OP::COINBASE);
 
                     /* Add the spendable genesis. */
-                    txProducer[0] << user->Genesis();
+                    txProducer[0] << hashGenesis;
 
                     /* The total to be credited. */
                     uint64_t nCredit = nBlockReward;
@@ -554,7 +554,7 @@ namespace TAO
                     txProducer[0] << uint8_t(TAO::Operation::OP::COINBASE);
 
                     /* Add the spendable genesis. */
-                    txProducer[0] << user->Genesis();
+                    txProducer[0] << hashGenesis;
 
                     /* The total to be credited. */
                     uint64_t nCredit = nBlockReward;
@@ -0,0 +1,82 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_ARCHIVE_H
+#define NEXUS_TAO_LEDGER_INCLUDE_ARCHIVE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+        class SyncBlock;
+
+
+        /** The version of the block archive format. **/
+        const uint32_t ARCHIVE_VERSION = 1;
+
+
+        /** ExportBlocks
+         *
+         *  Write the best chain after genesis to a flat block archive. The archive holds a
+         *  header with the format version and genesis hash, followed by length prefixed
+         *  SyncBlock records that carry their transactions.
+         *
+         *  @param[in] strPath The path of the archive file to write.
+         *  @param[out] nBlocks The total number of blocks written.
+         *
+         *  @return True if the whole best chain was written.
+         *
+         **/
+        bool ExportBlocks(const std::string& strPath, uint32_t &nBlocks);
+
+
+        /** ReadArchive
+         *
+         *  Read a block archive written by ExportBlocks and pass each record to a callback in
+         *  chain order. The header must match this node's archive version and genesis, and a
+         *  truncated, oversized or undecodable record fails the whole read.
+         *
+         *  @param[in] strPath The path of the archive file to read.
+         *  @param[in] fnBlock Called with each block, returns false to stop reading.
+         *
+         *  @return True if every record was read and accepted by the callback.
+         *
+         **/
+        bool ReadArchive(const std::string& strPath, const std::function<bool(const SyncBlock&)>& fnBlock);
+
+
+        /** ImportBlocks
+         *
+         *  Read a block archive written by ExportBlocks and feed each block through Process.
+         *  Blocks already in the ledger are skipped, so an import can be resumed.
+         *
+         *  @param[in] strPath The path of the archive file to read.
+         *  @param[out] nBlocks The total number of blocks accepted.
+         *
+         *  @return True if the whole archive was read without a rejected block.
+         *
+         **/
+        bool ImportBlocks(const std::string& strPath, uint32_t &nBlocks);
+
+    }
+}
+
+#endif
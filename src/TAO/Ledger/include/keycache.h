@@ -0,0 +1,92 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_KEYCACHE_H
+#define NEXUS_TAO_LEDGER_INCLUDE_KEYCACHE_H
+
+#include <LLC/types/uint1024.h>
+
+#include <LLC/include/flkey.h>
+#include <LLC/include/eckey.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** PregenerateKey
+         *
+         *  Derive the key pair for a sigchain key secret ahead of time, so that a later
+         *  Transaction::Sign or Transaction::NextHash with the same secret skips key generation.
+         *
+         *  @param[in] hashGenesis The genesis of the sigchain the secret belongs to.
+         *  @param[in] hashSecret The private key secret generated from the sigchain.
+         *  @param[in] nType The signature type of the key to derive.
+         *
+         *  @return True if the key pair was derived or already cached.
+         *
+         **/
+        bool PregenerateKey(const uint256_t& hashGenesis, const uint512_t& hashSecret, const uint8_t nType);
+
+
+        /** GetPregeneratedKey
+         *
+         *  Get a falcon key pair derived by PregenerateKey.
+         *
+         *  @param[in] hashSecret The private key secret the key was derived from.
+         *  @param[out] key The key pair to return.
+         *
+         *  @return True if the key pair was found.
+         *
+         **/
+        bool GetPregeneratedKey(const uint512_t& hashSecret, LLC::FLKey &key);
+
+
+        /** GetPregeneratedKey
+         *
+         *  Get a brainpool key pair derived by PregenerateKey.
+         *
+         *  @param[in] hashSecret The private key secret the key was derived from.
+         *  @param[out] key The key pair to return.
+         *
+         *  @return True if the key pair was found.
+         *
+         **/
+        bool GetPregeneratedKey(const uint512_t& hashSecret, LLC::ECKey &key);
+
+
+        /** PurgeKeys
+         *
+         *  Remove every key pair derived for a sigchain, so its private keys don't outlive the session.
+         *
+         *  @param[in] hashGenesis The genesis of the sigchain to purge.
+         *
+         **/
+        void PurgeKeys(const uint256_t& hashGenesis);
+
+
+        /** PurgeKeys
+         *
+         *  Remove every key pair derived for any sigchain, used at shutdown.
+         *
+         **/
+        void PurgeKeys();
+
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_MERKLECACHE_H
+#define NEXUS_TAO_LEDGER_INCLUDE_MERKLECACHE_H
+
+#include <LLC/types/uint1024.h>
+
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+        /* Forward declarations. */
+        class BlockState;
+
+
+        /** GetMerkleBranch
+         *
+         *  Get the merkle branch of a transaction in a block. The merkle tree and the
+         *  position of every transaction are kept for recently used blocks, so repeated
+         *  proofs from the same block are lookups without any hashing. The tree is checked
+         *  against the block's merkle root once when it is built.
+         *
+         *  @param[in] state The block state containing the transaction.
+         *  @param[in] hashTx The txid to build the branch for.
+         *  @param[out] vMerkleBranch The merkle branch of the transaction.
+         *  @param[out] nIndex The index of the transaction in the block.
+         *
+         *  @return True if the transaction was found in a block with a valid merkle root.
+         *
+         **/
+        bool GetMerkleBranch(const BlockState& state, const uint512_t& hashTx,
+                             std::vector<uint512_t> &vMerkleBranch, uint32_t &nIndex);
+
+    }
+}
+
+#endif
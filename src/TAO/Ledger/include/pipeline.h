@@ -0,0 +1,262 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_PIPELINE_H
+#define NEXUS_TAO_LEDGER_INCLUDE_PIPELINE_H
+
+#include <TAO/Ledger/types/syncblock.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** @class SyncPipeline
+         *
+         *  Pipelined validation for blocks received during synchronization.
+         *
+         *  Sync blocks from any peer are numbered in arrival order and queued. Worker
+         *  threads deserialize and hash the tritium transactions in parallel, which
+         *  touches no shared state. A single commit thread takes the prepared blocks
+         *  out of a bounded reorder buffer in arrival order, builds the full block
+         *  (which accepts its transactions into the mempool) and hands it to
+         *  Process(), so everything that reads or writes chain state runs exactly as
+         *  on the serial path. The network threads never wait on the pipeline: when
+         *  the buffer is full Push fails fast and the block is processed directly.
+         *
+         **/
+        class SyncPipeline
+        {
+            /** Pending
+             *
+             *  A sync block waiting for a worker thread.
+             *
+             **/
+            struct Pending
+            {
+                /** The arrival order of this block. **/
+                uint64_t nSequence;
+
+                /** The session the block came from. **/
+                uint64_t nSession;
+
+                /** The block as received from the network. **/
+                SyncBlock block;
+            };
+
+
+            /** Prepared
+             *
+             *  A sync block with its transactions deserialized and hashed by a worker, waiting to be committed.
+             *
+             **/
+            struct Prepared
+            {
+                /** The session the block came from. **/
+                uint64_t nSession;
+
+                /** The block as received from the network. **/
+                SyncBlock block;
+
+                /** The tritium transactions of the block in order. **/
+                std::vector<Transaction> vTritium;
+
+                /** The hashes of vTritium. **/
+                std::vector<uint512_t> vTritiumHashes;
+
+                /** Flag set if the transactions could be deserialized. **/
+                bool fPrepared;
+            };
+
+
+            /** Mutex to protect the queues and reorder buffer. **/
+            std::mutex PIPELINE_MUTEX;
+
+
+            /** Condition to wake the worker threads. **/
+            std::condition_variable CHECK_CONDITION;
+
+
+            /** Condition to wake the commit thread. **/
+            std::condition_variable COMMIT_CONDITION;
+
+
+            /** Blocks waiting to be prepared. **/
+            std::deque<Pending> queueCheck;
+
+
+            /** Reorder buffer of prepared blocks by arrival order. **/
+            std::map<uint64_t, Prepared> mapReorder;
+
+
+            /** Status flags of each committed block by session, collected by the next Push or Status. **/
+            std::map<uint64_t, std::vector<uint8_t>> mapStatus;
+
+
+            /** Sessions that have pushed blocks and not been removed, only these get statuses recorded. **/
+            std::set<uint64_t> setSessions;
+
+
+            /** The arrival number given to the next block pushed. **/
+            uint64_t nNextSequence;
+
+
+            /** The arrival number of the next block to commit. **/
+            uint64_t nNextCommit;
+
+
+            /** The maximum number of blocks between arrival and commit. **/
+            uint32_t nCapacity;
+
+
+            /** Flag to determine if the pipeline is accepting blocks. **/
+            std::atomic<bool> fRunning;
+
+
+            /** Flag to signal the threads to exit. **/
+            std::atomic<bool> fStop;
+
+
+            /** The worker threads preparing blocks. **/
+            std::vector<std::thread> vWorkers;
+
+
+            /** The thread committing blocks in order. **/
+            std::thread COMMIT_THREAD;
+
+        public:
+
+            /** Default Constructor. **/
+            SyncPipeline();
+
+
+            /** Default Destructor. **/
+            ~SyncPipeline();
+
+
+            /** Singleton instance. **/
+            static SyncPipeline& GetInstance();
+
+
+            /** Start
+             *
+             *  Start the worker and commit threads.
+             *
+             *  @param[in] nWorkers The number of threads preparing blocks.
+             *  @param[in] nCapacityIn The maximum number of blocks between arrival and commit.
+             *
+             **/
+            void Start(const uint32_t nWorkers, const uint32_t nCapacityIn);
+
+
+            /** Stop
+             *
+             *  Stop accepting blocks and join the threads. Blocks not yet committed are discarded.
+             *
+             **/
+            void Stop();
+
+
+            /** Running
+             *
+             *  Returns true if the pipeline is accepting blocks.
+             *
+             **/
+            bool Running() const;
+
+
+            /** Push
+             *
+             *  Queue a sync block for preparing and commit. Never waits: if the reorder buffer is full the
+             *  block is not queued, and the caller processes it directly. A block processed ahead of ones
+             *  still in the buffer is held as an orphan until they are committed.
+             *
+             *  @param[in] block The sync block received.
+             *  @param[in] nSession The session the block came from.
+             *  @param[out] vStatus The status of each of this session's blocks committed since the last push, in order.
+             *
+             *  @return True if the block was queued, false if the caller should process it directly.
+             *
+             **/
+            bool Push(const SyncBlock& block, const uint64_t nSession, std::vector<uint8_t> &vStatus);
+
+
+            /** Status
+             *
+             *  Collect the status of a session's blocks committed since the last Push or Status, so the
+             *  last blocks of a sync are reported without waiting for another block to arrive.
+             *
+             *  @param[in] nSession The session to collect for.
+             *  @param[out] vStatus The status of each of the session's committed blocks, in order.
+             *
+             *  @return True if there were any statuses.
+             *
+             **/
+            bool Status(const uint64_t nSession, std::vector<uint8_t> &vStatus);
+
+
+            /** Remove
+             *
+             *  Drop the statuses of a disconnected session. Its blocks still in the buffer are committed,
+             *  but their statuses are no longer recorded.
+             *
+             *  @param[in] nSession The session to remove.
+             *
+             **/
+            void Remove(const uint64_t nSession);
+
+
+            /** Size
+             *
+             *  Returns the number of blocks between arrival and commit.
+             *
+             **/
+            uint64_t Size();
+
+        private:
+
+            /** Worker
+             *
+             *  Deserialize and hash the transactions of blocks off the queue.
+             *
+             **/
+            void Worker();
+
+
+            /** Commit
+             *
+             *  Build prepared blocks and pass them to Process() in arrival order.
+             *
+             **/
+            void Commit();
+        };
+
+    }
+}
+
+#endif
@@ -114,6 +114,18 @@ namespace TAO
         uint1024_t FermatTest(const uint1024_t& hashTest);
 
 
+        /** FermatTest
+         *
+         *  Run the fermat test over a batch of numbers, such as all offsets of
+         *  a prime cluster. Remainders are returned in the same order.
+         *
+         *  @param[in] vTests The numbers to check
+         *  @param[out] vRemainders The remainders of the fermat tests.
+         *
+         **/
+        void FermatTest(const std::vector<uint1024_t>& vTests, std::vector<uint1024_t>& vRemainders);
+
+
         /** MillerRabin
          *
          *  Wrapper for is_prime from OpenSSL
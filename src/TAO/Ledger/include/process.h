@@ -66,7 +66,7 @@ namespace TAO
          *  Processes a block incoming over the network.
          *
          *  @param[in] block The block being processed
-         *  @param[out] pnode The node that block came from.
+         *  @param[out] nStatus The status flags of the processed block.
          *
          **/
         void Process(const TAO::Ledger::Block& block, uint8_t &nStatus);
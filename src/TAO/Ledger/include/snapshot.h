@@ -0,0 +1,136 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_SNAPSHOT_H
+#define NEXUS_TAO_LEDGER_INCLUDE_SNAPSHOT_H
+
+#include <LLC/types/uint1024.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class DataStream;
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** The version of the ledger snapshot format. **/
+        const uint32_t SNAPSHOT_VERSION = 2;
+
+
+        /** Types of the records in a ledger snapshot. **/
+        namespace SNAPSHOT
+        {
+            enum
+            {
+                /** A block state, followed by the records of its transactions. **/
+                BLOCK    = 0x01,
+
+                /** A tritium transaction of the last block. **/
+                TRITIUM  = 0x02,
+
+                /** A legacy transaction of the last block and its spent outputs. **/
+                LEGACY   = 0x03,
+
+                /** A proof that a debit, coinbase or legacy output was credited. **/
+                PROOF    = 0x04,
+
+                /** The amount claimed from a partially credited output. **/
+                CLAIMED  = 0x05,
+
+                /** The caller that fulfilled a conditional contract. **/
+                CONTRACT = 0x06,
+
+                /** A register state. **/
+                REGISTER = 0x07,
+
+                /** The first, last and last stake transaction of a signature chain. **/
+                SIGCHAIN = 0x08,
+
+                /** A legacy trust key and whether it was migrated. **/
+                TRUSTKEY = 0x09,
+
+                /** The tritium and legacy events of an address. **/
+                EVENT    = 0x0a
+            };
+        }
+
+
+        /** ExportSnapshot
+         *
+         *  Write the ledger at the last hardened checkpoint to a snapshot file. Blocks after the
+         *  checkpoint are disconnected inside an LLD transaction that is aborted once the snapshot
+         *  is written, so the best chain and the database are left untouched. Block processing is
+         *  held off until then so that every record comes from one chain state.
+         *
+         *  This is a full ledger bootstrap, not a register state dump: the snapshot holds every
+         *  block state and transaction from genesis to the checkpoint along with everything Connect
+         *  and Verify read from them: credit proofs, claimed amounts, fulfilled contracts, legacy
+         *  spends and trust keys, register states and signature chain indexes. It saves replaying
+         *  the chain, not downloading it, and is about the size of the ledger database.
+         *  Every record is folded into a commitment hash that is stored in the header.
+         *
+         *  @param[in] strPath The path of the snapshot file to write.
+         *  @param[out] hashCommitment The commitment hash of the snapshot.
+         *
+         *  @return True if the whole snapshot was written.
+         *
+         **/
+        bool ExportSnapshot(const std::string& strPath, uint256_t &hashCommitment);
+
+
+        /** ReadSnapshot
+         *
+         *  Read a snapshot written by ExportSnapshot and pass each record to a callback with its
+         *  type. The header must match this node's snapshot version and genesis, the block states
+         *  must form a chain from genesis to the checkpoint, and the commitment must cover every
+         *  record. A truncated, oversized or undecodable record fails the whole read.
+         *
+         *  @param[in] strPath The path of the snapshot file to read.
+         *  @param[in] fnRecord Called with the type and payload of each record, returns false to stop reading.
+         *  @param[out] hashCommitment The commitment hash of the snapshot.
+         *
+         *  @return True if every record was read, accepted by the callback and matched the commitment.
+         *
+         **/
+        bool ReadSnapshot(const std::string& strPath, const std::function<bool(const uint8_t, DataStream&)>& fnRecord,
+                          uint256_t &hashCommitment);
+
+
+        /** ImportSnapshot
+         *
+         *  Load a snapshot written by ExportSnapshot into an empty ledger and make its
+         *  checkpoint block the best chain, so the node syncs normally from that height.
+         *  The commitment of the snapshot must match -snapshothash. Keys are built into the
+         *  keychains in bulk as the records are loaded, and a load that fails part way leaves
+         *  no best chain, so it is loaded again from the start.
+         *
+         *  @param[in] strPath The path of the snapshot file to read.
+         *  @param[out] hashCommitment The commitment hash of the snapshot.
+         *
+         *  @return True if the snapshot was verified and loaded.
+         *
+         **/
+        bool ImportSnapshot(const std::string& strPath, uint256_t &hashCommitment);
+
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_TALLY_H
+#define NEXUS_TAO_LEDGER_INCLUDE_TALLY_H
+
+#include <LLC/types/uint1024.h>
+
+#include <cstdint>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Operation Layer namespace. */
+    namespace Operation
+    {
+        class Contract;
+    }
+
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** VoteWeight
+         *
+         *  Get the weight of one vote from a sigchain. Every vote is worth one NXS_COIN, plus a bonus
+         *  for stakers with a trust score above 0.5% based on up to 10,000 NXS of their stake.
+         *
+         *  @param[in] hashGenesis The genesis of the voting sigchain.
+         *  @param[out] nWeight The weight of the vote in NXS_COIN units.
+         *
+         *  @return True if the sigchain can vote, which needs a trust account.
+         *
+         **/
+        bool VoteWeight(const uint256_t& hashGenesis, uint64_t &nWeight);
+
+
+        /** ConnectVote
+         *
+         *  Add a credit to the vote tally of its account, if the account has a tally.
+         *
+         *  @param[in] contract The contract being connected, bound to its transaction.
+         *
+         *  @return True if the tally was updated or the contract isn't a tallied vote.
+         *
+         **/
+        bool ConnectVote(const TAO::Operation::Contract& contract);
+
+
+        /** DisconnectVote
+         *
+         *  Remove a credit from the vote tally of its account, if the account has a tally.
+         *
+         *  @param[in] contract The contract being disconnected, bound to its transaction.
+         *
+         *  @return True if the tally was updated or the contract isn't a tallied vote.
+         *
+         **/
+        bool DisconnectVote(const TAO::Operation::Contract& contract);
+
+
+        /** RebuildTally
+         *
+         *  Count every credit made to an account and write its vote tally, so that it is kept up to
+         *  date as blocks are connected and disconnected from then on. The owner's sigchain is walked
+         *  without holding off blocks, then the transactions connected since are counted and the
+         *  voters rewritten under the processing lock.
+         *
+         *  @param[in] hashAccount The address of the vote account.
+         *  @param[out] nVotes The number of sigchains that voted.
+         *  @param[out] nWeight The total vote weight in NXS_COIN units.
+         *
+         *  @return True if the tally was written.
+         *
+         **/
+        bool RebuildTally(const uint256_t& hashAccount, uint64_t &nVotes, uint64_t &nWeight);
+
+    }
+}
+
+#endif
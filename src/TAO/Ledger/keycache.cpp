@@ -0,0 +1,202 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/include/keycache.h>
+#include <TAO/Ledger/include/enum.h>
+
+#include <LLC/hash/SK.h>
+
+#include <LLD/cache/template_lru.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Key pairs derived ahead of time, indexed by a hash of the secret and key type. Brainpool keys are held in
+         * encoded form so no OpenSSL objects outlive the library at shutdown. */
+        static LLD::TemplateLRU<uint512_t, LLC::FLKey> cacheFalcon(8);
+        static LLD::TemplateLRU<uint512_t, LLC::CPrivKey> cacheBrainpool(8);
+
+
+        /* The cache indexes derived for each sigchain, so its keys can be purged when the session ends. */
+        static std::map<uint256_t, std::set<uint512_t>> mapIndexes;
+        static std::mutex INDEX_MUTEX;
+
+
+        /* Record a cache index against its sigchain, dropping any indexes the caches have already evicted. */
+        static void add_index(const uint256_t& hashGenesis, const uint512_t& hashIndex)
+        {
+            LOCK(INDEX_MUTEX);
+
+            for(auto& entry : mapIndexes)
+            {
+                std::set<uint512_t>& setIndexes = entry.second;
+                for(auto it = setIndexes.begin(); it != setIndexes.end(); )
+                {
+                    if(!cacheFalcon.Has(*it) && !cacheBrainpool.Has(*it))
+                        it = setIndexes.erase(it);
+                    else
+                        ++it;
+                }
+            }
+
+            /* Drop sigchains with nothing left in the caches. */
+            for(auto it = mapIndexes.begin(); it != mapIndexes.end(); )
+            {
+                if(it->second.empty())
+                    it = mapIndexes.erase(it);
+                else
+                    ++it;
+            }
+
+            mapIndexes[hashGenesis].insert(hashIndex);
+        }
+
+
+        /* Get the cache index for a secret, so the secret itself is never kept as a map key. */
+        static uint512_t get_index(const uint512_t& hashSecret, const uint8_t nType)
+        {
+            std::vector<uint8_t> vBytes = hashSecret.GetBytes();
+
+            return LLC::SK512(vBytes, &nType, &nType + 1);
+        }
+
+
+        /* Derive the key pair for a sigchain key secret ahead of time. */
+        bool PregenerateKey(const uint256_t& hashGenesis, const uint512_t& hashSecret, const uint8_t nType)
+        {
+            /* Get the secret from new key. */
+            std::vector<uint8_t> vBytes = hashSecret.GetBytes();
+            LLC::CSecret vchSecret(vBytes.begin(), vBytes.end());
+
+            /* Get the cache index. */
+            const uint512_t hashIndex = get_index(hashSecret, nType);
+
+            /* Switch based on signature type. */
+            switch(nType)
+            {
+                /* Support for the FALCON signature scheeme. */
+                case SIGNATURE::FALCON:
+                {
+                    /* Check for an existing key. */
+                    if(cacheFalcon.Has(hashIndex))
+                        return true;
+
+                    /* Create the FL Key object. */
+                    LLC::FLKey key;
+
+                    /* Set the secret key. */
+                    if(!key.SetSecret(vchSecret))
+                        return false;
+
+                    cacheFalcon.Put(hashIndex, key);
+                    add_index(hashGenesis, hashIndex);
+
+                    return true;
+                }
+
+                /* Support for the BRAINPOOL signature scheme. */
+                case SIGNATURE::BRAINPOOL:
+                {
+                    /* Check for an existing key. */
+                    if(cacheBrainpool.Has(hashIndex))
+                        return true;
+
+                    /* Create EC Key object. */
+                    LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+
+                    /* Set the secret key. */
+                    if(!key.SetSecret(vchSecret, true))
+                        return false;
+
+                    cacheBrainpool.Put(hashIndex, key.GetPrivKey());
+                    add_index(hashGenesis, hashIndex);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+
+        /* Get a falcon key pair derived by PregenerateKey. */
+        bool GetPregeneratedKey(const uint512_t& hashSecret, LLC::FLKey &key)
+        {
+            /* Get the cache index. */
+            const uint512_t hashIndex = get_index(hashSecret, SIGNATURE::FALCON);
+            return cacheFalcon.Get(hashIndex, key);
+        }
+
+
+        /* Get a brainpool key pair derived by PregenerateKey. */
+        bool GetPregeneratedKey(const uint512_t& hashSecret, LLC::ECKey &key)
+        {
+            /* Get the cache index. */
+            const uint512_t hashIndex = get_index(hashSecret, SIGNATURE::BRAINPOOL);
+
+            LLC::CPrivKey vchPrivKey;
+            if(!cacheBrainpool.Get(hashIndex, vchPrivKey))
+                return false;
+
+            return key.SetPrivKey(vchPrivKey);
+        }
+
+
+        /* Remove every key pair derived for a sigchain. */
+        void PurgeKeys(const uint256_t& hashGenesis)
+        {
+            LOCK(INDEX_MUTEX);
+
+            /* Check for any keys derived for this sigchain. */
+            auto it = mapIndexes.find(hashGenesis);
+            if(it == mapIndexes.end())
+                return;
+
+            /* Remove from both caches, as the index already includes the key type. */
+            for(const uint512_t& hashIndex : it->second)
+            {
+                cacheFalcon.Remove(hashIndex);
+                cacheBrainpool.Remove(hashIndex);
+            }
+
+            mapIndexes.erase(it);
+        }
+
+
+        /* Remove every key pair derived for any sigchain. */
+        void PurgeKeys()
+        {
+            LOCK(INDEX_MUTEX);
+
+            for(const auto& entry : mapIndexes)
+            {
+                for(const uint512_t& hashIndex : entry.second)
+                {
+                    cacheFalcon.Remove(hashIndex);
+                    cacheBrainpool.Remove(hashIndex);
+                }
+            }
+
+            mapIndexes.clear();
+        }
+    }
+}
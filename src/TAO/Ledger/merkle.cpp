@@ -13,6 +13,8 @@ ________________________________________________________________________________
 
 #include <LLD/include/global.h>
 
+#include <TAO/Ledger/include/merklecache.h>
+
 #include <TAO/Ledger/types/merkle.h>
 #include <TAO/Ledger/types/state.h>
 
@@ -184,24 +186,8 @@ namespace TAO
             /* Cache this txid. */
             uint512_t hash = GetHash();
 
-            /* Find the index of this transaction. */
-            for(nIndex = 0; nIndex < state.vtx.size(); ++nIndex)
-                if(state.vtx[nIndex].second == hash)
-                    break;
-
-            /* Check for valid index. */
-            if(nIndex == state.vtx.size())
-                return debug::error(FUNCTION, "transaction not found");
-
-            /* Build merkle branch. */
-            vMerkleBranch = state.GetMerkleBranch(state.vtx, nIndex);
-
-            /* NOTE: extra expensive check for testing, consider removing in production */
-            uint512_t hashCheck = Block::CheckMerkleBranch(hash, vMerkleBranch, nIndex);
-            if(state.hashMerkleRoot != hashCheck)
-                return debug::error(FUNCTION, "merkle root mismatch ", hashCheck.SubString());
-
-            return true;
+            /* Build the merkle branch from the cached tree of this block. */
+            return GetMerkleBranch(state, hash, vMerkleBranch, nIndex);
         }
 
 
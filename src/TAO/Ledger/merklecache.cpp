@@ -0,0 +1,106 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/cache/template_lru.h>
+
+#include <TAO/Ledger/include/merklecache.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+
+#include <map>
+#include <memory>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* A block's merkle tree with the position of each of its transactions. */
+        struct MerkleTree
+        {
+            /* All levels of the tree, leaves first, as built by Block::BuildMerkleTree. */
+            std::vector<uint512_t> vTree;
+
+            /* The index of each txid in the block. */
+            std::map<uint512_t, uint32_t> mapIndex;
+
+            /* The number of transactions in the block. */
+            uint32_t nSize;
+        };
+
+
+        /* Get the cache of merkle trees, keyed by merkle root so no block hash is needed. */
+        static LLD::TemplateLRU<uint512_t, std::shared_ptr<const MerkleTree>>& merkle_cache()
+        {
+            static LLD::TemplateLRU<uint512_t, std::shared_ptr<const MerkleTree>> cache(
+                static_cast<uint32_t>(config::GetArg("-merklecache", 256)));
+
+            return cache;
+        }
+
+
+        /* Get the merkle branch of a transaction in a block. */
+        bool GetMerkleBranch(const BlockState& state, const uint512_t& hashTx,
+                             std::vector<uint512_t> &vMerkleBranch, uint32_t &nIndex)
+        {
+            /* Check the cache for this block's tree. */
+            std::shared_ptr<const MerkleTree> ptree;
+            if(!merkle_cache().Get(state.hashMerkleRoot, ptree))
+            {
+                /* Build the tree once for this block. */
+                std::shared_ptr<MerkleTree> pnew = std::make_shared<MerkleTree>();
+                pnew->nSize = static_cast<uint32_t>(state.vtx.size());
+
+                const uint512_t hashRoot = state.BuildMerkleTree(state.vtx);
+                if(hashRoot != state.hashMerkleRoot)
+                    return debug::error(FUNCTION, "merkle root mismatch ", hashRoot.SubString());
+
+                /* Copy the tree, the caller's block state keeps its own. */
+                pnew->vTree = state.vMerkleTree;
+                for(uint32_t n = 0; n < pnew->nSize; ++n)
+                    pnew->mapIndex.insert(std::make_pair(state.vtx[n].second, n));
+
+                /* Add to the cache for the next proof from this block. */
+                ptree = pnew;
+                merkle_cache().Put(state.hashMerkleRoot, ptree);
+            }
+
+            /* Find the index of this transaction. */
+            auto it = ptree->mapIndex.find(hashTx);
+            if(it == ptree->mapIndex.end())
+                return debug::error(FUNCTION, "transaction not found");
+
+            nIndex = it->second;
+
+            /* Walk the levels of the tree, taking the sibling at each one. */
+            vMerkleBranch.clear();
+
+            uint32_t j = 0;
+            uint32_t i = nIndex;
+            for(uint32_t nSize = ptree->nSize; nSize > 1; nSize = (nSize + 1) / 2)
+            {
+                vMerkleBranch.push_back(ptree->vTree[j + std::min(i ^ 1, nSize - 1)]);
+
+                i >>= 1;
+                j += nSize;
+            }
+
+            return true;
+        }
+    }
+}
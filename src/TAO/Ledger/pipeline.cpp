@@ -0,0 +1,329 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/include/pipeline.h>
+#include <TAO/Ledger/include/process.h>
+
+#include <TAO/Ledger/types/tritium.h>
+
+#include <Legacy/types/legacy.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+
+#include <algorithm>
+#include <functional>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Default Constructor. */
+        SyncPipeline::SyncPipeline()
+        : PIPELINE_MUTEX    ( )
+        , CHECK_CONDITION   ( )
+        , COMMIT_CONDITION  ( )
+        , queueCheck        ( )
+        , mapReorder        ( )
+        , mapStatus         ( )
+        , setSessions       ( )
+        , nNextSequence     (0)
+        , nNextCommit       (0)
+        , nCapacity         (0)
+        , fRunning          (false)
+        , fStop             (false)
+        , vWorkers          ( )
+        , COMMIT_THREAD     ( )
+        {
+        }
+
+
+        /* Default Destructor. */
+        SyncPipeline::~SyncPipeline()
+        {
+            Stop();
+        }
+
+
+        /* Singleton instance. */
+        SyncPipeline& SyncPipeline::GetInstance()
+        {
+            static SyncPipeline ret;
+            return ret;
+        }
+
+
+        /* Start the worker and commit threads. */
+        void SyncPipeline::Start(const uint32_t nWorkers, const uint32_t nCapacityIn)
+        {
+            /* Don't start twice. */
+            if(fRunning.load() || COMMIT_THREAD.joinable())
+                return;
+
+            /* Reset the state. */
+            {
+                LOCK(PIPELINE_MUTEX);
+
+                queueCheck.clear();
+                mapReorder.clear();
+                mapStatus.clear();
+                setSessions.clear();
+
+                nNextSequence = 0;
+                nNextCommit   = 0;
+                nCapacity     = std::max(nCapacityIn, nWorkers + 1);
+            }
+
+            fStop.store(false);
+
+            /* Start the threads. */
+            for(uint32_t n = 0; n < nWorkers; ++n)
+                vWorkers.push_back(std::thread(std::bind(&SyncPipeline::Worker, this)));
+
+            COMMIT_THREAD = std::thread(std::bind(&SyncPipeline::Commit, this));
+
+            fRunning.store(true);
+
+            debug::log(0, FUNCTION, "Sync pipeline started with ", nWorkers, " workers and ", nCapacity, " block buffer");
+        }
+
+
+        /* Stop accepting blocks and join the threads. */
+        void SyncPipeline::Stop()
+        {
+            fRunning.store(false);
+
+            /* Signal all threads to exit. */
+            {
+                LOCK(PIPELINE_MUTEX);
+                fStop.store(true);
+            }
+
+            CHECK_CONDITION.notify_all();
+            COMMIT_CONDITION.notify_all();
+
+            /* Join the threads. */
+            for(auto& thread : vWorkers)
+                if(thread.joinable())
+                    thread.join();
+
+            vWorkers.clear();
+
+            if(COMMIT_THREAD.joinable())
+                COMMIT_THREAD.join();
+
+            /* Discard anything left over, it will be requested again on the next sync. */
+            LOCK(PIPELINE_MUTEX);
+            queueCheck.clear();
+            mapReorder.clear();
+            mapStatus.clear();
+            setSessions.clear();
+        }
+
+
+        /* Returns true if the pipeline is accepting blocks. */
+        bool SyncPipeline::Running() const
+        {
+            return fRunning.load();
+        }
+
+
+        /* Queue a sync block for preparing and commit. */
+        bool SyncPipeline::Push(const SyncBlock& block, const uint64_t nSession, std::vector<uint8_t> &vStatus)
+        {
+            /* Let the caller process directly if we are not running. */
+            if(!fRunning.load())
+                return false;
+
+            {
+                LOCK(PIPELINE_MUTEX);
+
+                /* Don't hold up the network thread when the reorder buffer is full. */
+                if(fStop.load() || nNextSequence - nNextCommit >= nCapacity)
+                    return false;
+
+                /* Hand back the status of each of this session's committed blocks. */
+                auto it = mapStatus.find(nSession);
+                if(it != mapStatus.end())
+                {
+                    vStatus.swap(it->second);
+                    mapStatus.erase(it);
+                }
+
+                /* Queue the block in arrival order. */
+                setSessions.insert(nSession);
+                queueCheck.push_back(Pending{nNextSequence++, nSession, block});
+            }
+
+            CHECK_CONDITION.notify_one();
+
+            return true;
+        }
+
+
+        /* Collect the status of a session's blocks committed since the last Push or Status. */
+        bool SyncPipeline::Status(const uint64_t nSession, std::vector<uint8_t> &vStatus)
+        {
+            LOCK(PIPELINE_MUTEX);
+
+            auto it = mapStatus.find(nSession);
+            if(it == mapStatus.end())
+                return false;
+
+            vStatus.swap(it->second);
+            mapStatus.erase(it);
+
+            return true;
+        }
+
+
+        /* Drop the statuses of a disconnected session. */
+        void SyncPipeline::Remove(const uint64_t nSession)
+        {
+            LOCK(PIPELINE_MUTEX);
+
+            mapStatus.erase(nSession);
+            setSessions.erase(nSession);
+        }
+
+
+        /* Returns the number of blocks between arrival and commit. */
+        uint64_t SyncPipeline::Size()
+        {
+            LOCK(PIPELINE_MUTEX);
+            return nNextSequence - nNextCommit;
+        }
+
+
+        /* Deserialize and hash the transactions of blocks off the queue. */
+        void SyncPipeline::Worker()
+        {
+            while(true)
+            {
+                /* Grab the next block to prepare. */
+                Pending pending;
+                {
+                    std::unique_lock<std::mutex> lock(PIPELINE_MUTEX);
+                    CHECK_CONDITION.wait(lock, [this]{ return fStop.load() || !queueCheck.empty(); });
+                    if(fStop.load())
+                        return;
+
+                    pending = std::move(queueCheck.front());
+                    queueCheck.pop_front();
+                }
+
+                /* Only the pure steps run here. Building the block touches the mempool, and Check() reads the
+                 * ledger, so both stay on the commit thread where they run in the same order as the serial path. */
+                Prepared prepared;
+                prepared.nSession  = pending.nSession;
+                prepared.fPrepared = true;
+                try
+                {
+                    if(pending.block.nVersion >= 7)
+                        TritiumBlock::Prepare(pending.block, prepared.vTritium, prepared.vTritiumHashes);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "failed to prepare sync block: ", e.what());
+
+                    prepared.fPrepared = false;
+                }
+
+                prepared.block = std::move(pending.block);
+
+                /* Put the block into the reorder buffer. */
+                {
+                    LOCK(PIPELINE_MUTEX);
+                    mapReorder.insert(std::make_pair(pending.nSequence, std::move(prepared)));
+                }
+
+                COMMIT_CONDITION.notify_one();
+            }
+        }
+
+
+        /* Build prepared blocks and pass them to Process() in arrival order. */
+        void SyncPipeline::Commit()
+        {
+            while(true)
+            {
+                /* Wait for the next block in arrival order. */
+                Prepared prepared;
+                {
+                    std::unique_lock<std::mutex> lock(PIPELINE_MUTEX);
+                    COMMIT_CONDITION.wait(lock, [this]{ return fStop.load() || mapReorder.count(nNextCommit); });
+                    if(fStop.load())
+                        return;
+
+                    auto it = mapReorder.find(nNextCommit);
+                    prepared = std::move(it->second);
+                    mapReorder.erase(it);
+                }
+
+                /* Build and process the block the same way the serial path does. */
+                uint8_t nStatus = 0;
+                try
+                {
+                    if(!prepared.fPrepared)
+                        nStatus |= PROCESS::REJECTED;
+
+                    /* Check version switch. */
+                    else if(prepared.block.nVersion >= 7)
+                    {
+                        /* Build a tritium block from the prepared sync block. */
+                        TritiumBlock tritium(prepared.block, prepared.vTritium, prepared.vTritiumHashes);
+
+                        /* Verbose debug output. */
+                        if(config::nVerbose >= 3)
+                            debug::log(3, FUNCTION, "committing sync block ", tritium.GetHash().SubString(), " height = ", tritium.nHeight);
+
+                        /* Process the block. */
+                        Process(tritium, nStatus);
+                    }
+                    else
+                    {
+                        /* Build a legacy block from sync block. */
+                        Legacy::LegacyBlock legacy(prepared.block);
+
+                        /* Verbose debug output. */
+                        if(config::nVerbose >= 3)
+                            debug::log(3, FUNCTION, "committing sync block ", legacy.GetHash().SubString(), " height = ", legacy.nHeight);
+
+                        /* Process the block. */
+                        Process(legacy, nStatus);
+                    }
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "failed to build sync block: ", e.what());
+
+                    nStatus |= PROCESS::REJECTED;
+                }
+
+                /* Record the status for the session if it is still connected, and free the slot. */
+                {
+                    LOCK(PIPELINE_MUTEX);
+
+                    if(setSessions.count(prepared.nSession))
+                        mapStatus[prepared.nSession].push_back(nStatus);
+
+                    ++nNextCommit;
+                }
+            }
+        }
+    }
+}
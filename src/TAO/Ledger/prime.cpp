@@ -13,8 +13,10 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/prime.h>
 #include <LLC/types/bignum.h>
+#include <LLC/prime/fermat.h>
 #include <openssl/bn.h>
 
+#include <Util/include/args.h>
 #include <Util/include/debug.h>
 #include <Util/include/softfloat.h>
 
@@ -29,6 +31,16 @@ namespace TAO
 
         static const uint16_t nSmallPrimes[11] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31 };
 
+
+        /* Fractional difficulty from a composite and its already computed fermat remainder. */
+        static uint32_t FractionalDifficulty(const uint1024_t& hashComposite, const uint1024_t& hashRemainder)
+        {
+            uint1056_t a(hashComposite);
+            uint1056_t b(hashRemainder);
+
+            return ((a - b << 24) / a).getuint32();
+        }
+
         /* Convert Double to unsigned int Representative. */
         uint32_t SetBits(double nDiff)
         {
@@ -54,8 +66,14 @@ namespace TAO
             uint1024_t hashNext = hashPrime;
             if(!vOffsets.empty())
             {
-                /* Loop through offsets pattern. */
+                /* Offsets need at least the four fractional difficulty bytes. */
                 uint32_t nSize = vOffsets.size();
+                if(nSize < 4)
+                    return 0.0;
+
+                /* Collect the candidates from the offsets pattern so they can be tested as one batch. */
+                std::vector<uint1024_t> vCandidates;
+                vCandidates.reserve(nSize - 3);
                 for(uint32_t n = 0; n < nSize - 4; ++n)
                 {
                     /* Get the offset. */
@@ -68,19 +86,41 @@ namespace TAO
                     /* Set the next offset position. */
                     hashNext += nOffset;
 
-                    /* Check prime at offset. */
-                    if(!fVerify || PrimeCheck(hashNext))
+                    /* Without verification every offset counts towards the cluster. */
+                    if(!fVerify)
                         ++nClusterSize;
 
+                    /* Small divisors are cheap, only survivors need the fermat test. */
+                    else if(SmallDivisors(hashNext))
+                        vCandidates.push_back(hashNext);
                 }
 
                 /* Get fractional difficulty. */
                 uint32_t nFraction = 0;
                 std::copy((uint8_t*)&vOffsets[nSize - 4], (uint8_t*)&vOffsets[nSize - 1], (uint8_t*)&nFraction);
 
-                /* If verifying check the fractional difficulty. */
-                if(fVerify && GetFractionalDifficulty(hashNext + 14) != nFraction)
-                    return 0.0;
+                /* If verifying batch the cluster with the fractional composite. */
+                if(fVerify)
+                {
+                    /* The composite for the fractional difficulty rides at the end of the batch. */
+                    vCandidates.push_back(hashNext + 14);
+
+                    /* Run all the fermat tests for the cluster. */
+                    std::vector<uint1024_t> vRemainders;
+                    FermatTest(vCandidates, vRemainders);
+
+                    /* Check prime at offsets. */
+                    const uint32_t nPrimes = vRemainders.size() - 1;
+                    for(uint32_t n = 0; n < nPrimes; ++n)
+                    {
+                        if(vRemainders[n] == 1)
+                            ++nClusterSize;
+                    }
+
+                    /* Check the fractional difficulty. */
+                    if(FractionalDifficulty(vCandidates.back(), vRemainders.back()) != nFraction)
+                        return 0.0;
+                }
 
                 /* Calculate the rarity of cluster from proportion of fermat remainder of last prime + 2. */
                 cv::softdouble nRemainder = cv::softdouble(1000000.0) / cv::softdouble(nFraction);
@@ -159,13 +199,7 @@ namespace TAO
         /* Breaks the remainder of last composite in Prime Cluster into an integer. */
         uint32_t GetFractionalDifficulty(const uint1024_t& hashComposite)
     	{
-            //LLC::CBigNum a(nComposite);
-            //LLC::CBigNum b(FermatTest(nComposite));
-
-            uint1056_t a(hashComposite);
-            uint1056_t b(FermatTest(hashComposite));
-
-            return ((a - b << 24) / a).getuint32();
+            return FractionalDifficulty(hashComposite, FermatTest(hashComposite));
     	}
 
 
@@ -184,11 +218,9 @@ namespace TAO
         }
 
 
-        /* Used after Miller-Rabin and Divisor tests to verify primality. */
-        uint1024_t FermatTest(const uint1024_t& hashTest)
+        /* Fermat test using a caller supplied context, so batches can share one allocation. */
+        static uint1024_t FermatBN(const uint1024_t& hashTest, LLC::CAutoBN_CTX& pctx)
         {
-            LLC::CAutoBN_CTX pctx;
-
             LLC::CBigNum bnPrime(hashTest);
             LLC::CBigNum bnBase(2);
             LLC::CBigNum bnExp = bnPrime - 1;
@@ -200,6 +232,37 @@ namespace TAO
         }
 
 
+        /* Used after Miller-Rabin and Divisor tests to verify primality. */
+        uint1024_t FermatTest(const uint1024_t& hashTest)
+        {
+            LLC::CAutoBN_CTX pctx;
+
+            return FermatBN(hashTest, pctx);
+        }
+
+
+        /* Run the fermat test over a batch of numbers, such as all offsets of a prime cluster. */
+        void FermatTest(const std::vector<uint1024_t>& vTests, std::vector<uint1024_t>& vRemainders)
+        {
+            vRemainders.clear();
+            vRemainders.reserve(vTests.size());
+
+            /* The fixed-width montgomery kernel is opt-in, OpenSSL's assembly exponentiation is faster on most hosts. */
+            const bool fKernel = config::GetBoolArg("-fermatkernel", false);
+
+            /* Share one context across the whole batch. */
+            LLC::CAutoBN_CTX pctx;
+            for(const auto& hashTest : vTests)
+            {
+                /* The kernel handles any odd modulus above one. */
+                if(fKernel && (hashTest.get(0) & 1) && hashTest > 1)
+                    vRemainders.push_back(fermat_prime(hashTest));
+                else
+                    vRemainders.push_back(FermatBN(hashTest, pctx));
+            }
+        }
+
+
         /* Wrapper for is_prime from OpenSSL */
         bool Miller_Rabin(const uint1024_t& hashTest)
         {
@@ -18,6 +18,9 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/process.h>
 #include <TAO/Ledger/include/chainstate.h>
 
+#include <Util/include/metrics.h>
+#include <Util/include/trace.h>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -45,11 +48,19 @@ namespace TAO
         std::set<uint1024_t> setIncomplete;
 
 
-        /* Processes a block incoming over the network. */
-        void Process(const TAO::Ledger::Block& block, uint8_t &nStatus)
+        /* Processes a block under the processing lock, flagging it if it was slow enough to dump the spans. */
+        static void Process(const TAO::Ledger::Block& block, uint8_t &nStatus, bool &fSlow)
         {
             LOCK(PROCESSING_MUTEX);
 
+            /* Track the latency of every block processed, whatever the outcome. */
+            static metrics::Histogram& PROCESS_LATENCY = metrics::GetHistogram("nexus_ledger_process_seconds");
+            metrics::Timer timer(PROCESS_LATENCY);
+
+            /* Trace the stages of processing this block. */
+            trace::Span span("Ledger::Process", "ledger");
+            const uint64_t nTraceStart = trace::Now();
+
             /* Get the block's hash. */
             const uint1024_t hashBlock = block.GetHash();
 
@@ -151,6 +162,11 @@ namespace TAO
                 /* Set the status. */
                 nStatus |= PROCESS::ACCEPTED;
 
+                /* Flag the spans to be dumped when a block was slow, so the stages can be analysed later. */
+                const uint64_t nTraceSlow = trace::nSlow.load();
+                if(nTraceSlow > 0 && trace::fEnabled.load() && trace::Now() - nTraceStart > nTraceSlow * 1000)
+                    fSlow = true;
+
                 /* Special meter for synchronizing. */
                 if(block.nHeight % (config::fClient ? 5000 : 1000) == 0 && TAO::Ledger::ChainState::Synchronizing())
                 {
@@ -241,5 +257,17 @@ namespace TAO
                 return;
             }
         }
+
+
+        /* Processes a block incoming over the network. */
+        void Process(const TAO::Ledger::Block& block, uint8_t &nStatus)
+        {
+            bool fSlow = false;
+            Process(block, nStatus, fSlow);
+
+            /* Hand the dump off once the processing span has been recorded and the lock released. */
+            if(fSlow)
+                trace::WriteAsync(debug::safe_printstr(config::GetDataDir(), "trace-", block.nHeight, ".json"));
+        }
     }
 }
@@ -0,0 +1,1056 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+
+#include <LLD/include/global.h>
+
+#include <Legacy/types/transaction.h>
+#include <Legacy/types/trustkey.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/process.h>
+#include <TAO/Ledger/include/snapshot.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+#include <TAO/Operation/types/contract.h>
+
+#include <TAO/Register/include/constants.h>
+#include <TAO/Register/types/address.h>
+#include <TAO/Register/types/state.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <set>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+
+        /* Magic bytes at the start of every ledger snapshot. */
+        const char SNAPSHOT_MAGIC[4] = { 'N', 'X', 'S', 'S' };
+
+
+        /* The size of the snapshot header after the magic bytes. */
+        const uint32_t SNAPSHOT_HEADER_SIZE = 4 + 128 + 4 + 128 + 4 + 32;
+
+
+        /* The maximum size of a single snapshot record. */
+        const uint32_t MAX_SNAPSHOT_RECORD = 16 * 1024 * 1024;
+
+
+        /* The number of records between progress messages. */
+        const uint32_t SNAPSHOT_PROGRESS = 100000;
+
+
+        /** SnapshotHeader
+         *
+         *  The fixed size header following the snapshot magic bytes.
+         *
+         **/
+        struct SnapshotHeader
+        {
+            uint32_t   nVersion;
+            uint1024_t hashGenesis;
+            uint32_t   nHeight;
+            uint1024_t hashBlock;
+            uint32_t   nRecords;
+            uint256_t  hashCommitment;
+
+            IMPLEMENT_SERIALIZE
+            (
+                READWRITE(nVersion);
+                READWRITE(hashGenesis);
+                READWRITE(nHeight);
+                READWRITE(hashBlock);
+                READWRITE(nRecords);
+                READWRITE(hashCommitment);
+            )
+
+            SnapshotHeader()
+            : nVersion       (SNAPSHOT_VERSION)
+            , hashGenesis    (0)
+            , nHeight        (0)
+            , hashBlock      (0)
+            , nRecords       (0)
+            , hashCommitment (0)
+            {
+            }
+        };
+
+
+        /* Fold a record into the running commitment hash. */
+        void fold_commitment(uint256_t &hashCommitment, const std::vector<uint8_t>& vRecord)
+        {
+            std::vector<uint8_t> vData = hashCommitment.GetBytes();
+            vData.insert(vData.end(), vRecord.begin(), vRecord.end());
+
+            hashCommitment = LLC::SK256(vData);
+        }
+
+
+        /* Write a length prefixed record, counting it and folding it into the header commitment. */
+        bool write_record(std::ofstream &stream, const DataStream& ssRecord, SnapshotHeader &header)
+        {
+            DataStream ssSize(SER_LLD, LLD::DATABASE_VERSION);
+            ssSize << static_cast<uint32_t>(ssRecord.size());
+
+            stream.write((char*)ssSize.Bytes().data(), ssSize.size());
+            stream.write((char*)ssRecord.Bytes().data(), ssRecord.size());
+
+            fold_commitment(header.hashCommitment, ssRecord.Bytes());
+            ++header.nRecords;
+
+            if(header.nRecords % SNAPSHOT_PROGRESS == 0)
+                debug::log(0, FUNCTION, "Exported ", header.nRecords, " records");
+
+            return stream.good();
+        }
+
+
+        /* Read a length prefixed record and fold it into the commitment. */
+        bool read_record(std::ifstream &stream, DataStream &ssRecord, uint256_t &hashCommitment)
+        {
+            /* Get the length of the record. */
+            std::vector<uint8_t> vSize(4);
+            if(!stream.read((char*)&vSize[0], vSize.size()))
+                return debug::error(FUNCTION, "snapshot truncated");
+
+            uint32_t nSize = 0;
+            DataStream ssSize(vSize, SER_LLD, LLD::DATABASE_VERSION);
+            ssSize >> nSize;
+
+            if(nSize == 0 || nSize > MAX_SNAPSHOT_RECORD)
+                return debug::error(FUNCTION, "invalid record size ", nSize);
+
+            /* Read the record. */
+            std::vector<uint8_t> vRecord(nSize);
+            if(!stream.read((char*)&vRecord[0], nSize))
+                return debug::error(FUNCTION, "snapshot truncated");
+
+            fold_commitment(hashCommitment, vRecord);
+            ssRecord = DataStream(vRecord, SER_LLD, LLD::DATABASE_VERSION);
+
+            return true;
+        }
+
+
+        /* Read and check the magic bytes and header of a snapshot. */
+        bool read_header(std::ifstream &stream, SnapshotHeader &header)
+        {
+            /* Check the magic bytes. */
+            char vchMagic[sizeof(SNAPSHOT_MAGIC)];
+            if(!stream.read(vchMagic, sizeof(vchMagic)) || !std::equal(vchMagic, vchMagic + sizeof(vchMagic), SNAPSHOT_MAGIC))
+                return debug::error(FUNCTION, "not a ledger snapshot");
+
+            /* Read the header. */
+            std::vector<uint8_t> vHeader(SNAPSHOT_HEADER_SIZE);
+            if(!stream.read((char*)&vHeader[0], vHeader.size()))
+                return debug::error(FUNCTION, "failed to read snapshot header");
+
+            DataStream ssHeader(vHeader, SER_LLD, LLD::DATABASE_VERSION);
+            ssHeader >> header;
+
+            /* Check the header against this node. */
+            if(header.nVersion != SNAPSHOT_VERSION)
+                return debug::error(FUNCTION, "unsupported snapshot version ", header.nVersion);
+
+            if(header.hashGenesis != ChainState::Genesis())
+                return debug::error(FUNCTION, "snapshot is for a different network, genesis ", header.hashGenesis.SubString());
+
+            if(header.nRecords == 0)
+                return debug::error(FUNCTION, "snapshot has no records");
+
+            return true;
+        }
+
+
+        /* Write a tritium transaction along with the proofs, claimed amounts and fulfilled conditions of its contracts. */
+        bool write_tritium(std::ofstream &stream, const uint512_t& hashTx, const Transaction& tx, SnapshotHeader &header,
+                           std::set<uint256_t> &setRegisters, std::set<uint256_t> &setEvents)
+        {
+            DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+            ssRecord << uint8_t(SNAPSHOT::TRITIUM) << tx;
+
+            if(!write_record(stream, ssRecord, header))
+                return debug::error(FUNCTION, "failed to write tx ", hashTx.SubString());
+
+            /* Events are indexed by sigchain. */
+            setEvents.insert(tx.hashGenesis);
+            for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+            {
+                const TAO::Operation::Contract& contract = tx[nContract];
+
+                /* Credits, claims and migrates leave a proof against the output they spent. */
+                bool fProof = false;
+                uint256_t hashProof = 0;
+                uint512_t hashFrom  = 0;
+                uint32_t  nFrom     = 0;
+                try
+                {
+                    uint8_t nOP = 0;
+                    contract.SeekToPrimitive();
+                    contract >> nOP;
+
+                    switch(nOP)
+                    {
+                        /* Every register is created by an OP::CREATE. */
+                        case TAO::Operation::OP::CREATE:
+                        {
+                            uint256_t hashAddress = 0;
+                            contract >> hashAddress;
+
+                            setRegisters.insert(hashAddress);
+                            break;
+                        }
+
+                        /* The recipient of a transfer gets an event. */
+                        case TAO::Operation::OP::TRANSFER:
+                        {
+                            uint256_t hashAddress  = 0;
+                            uint256_t hashTransfer = 0;
+                            contract >> hashAddress >> hashTransfer;
+
+                            setEvents.insert(hashTransfer);
+                            break;
+                        }
+
+                        case TAO::Operation::OP::CREDIT:
+                        {
+                            uint256_t hashAddress = 0;
+                            contract >> hashFrom >> nFrom >> hashAddress >> hashProof;
+
+                            fProof = true;
+                            break;
+                        }
+
+                        case TAO::Operation::OP::CLAIM:
+                        {
+                            contract >> hashFrom >> nFrom >> hashProof;
+
+                            fProof = true;
+                            break;
+                        }
+
+                        /* Migrates always spend output zero of a legacy trust key. */
+                        case TAO::Operation::OP::MIGRATE:
+                        {
+                            contract >> hashFrom;
+                            hashProof = TAO::Register::WILDCARD_ADDRESS;
+
+                            fProof = true;
+                            break;
+                        }
+                    }
+
+                    contract.Reset();
+                }
+                catch(const std::exception& e)
+                {
+                    return debug::error(FUNCTION, "failed to read contract ", nContract, " of ", hashTx.SubString(), ": ", e.what());
+                }
+
+                /* Write the proof so the output can't be credited twice. */
+                if(fProof && LLD::Ledger->HasProof(hashProof, hashFrom, nFrom))
+                {
+                    DataStream ssProof(SER_LLD, LLD::DATABASE_VERSION);
+                    ssProof << uint8_t(SNAPSHOT::PROOF) << hashProof << hashFrom << nFrom;
+
+                    if(!write_record(stream, ssProof, header))
+                        return debug::error(FUNCTION, "failed to write proof ", hashFrom.SubString());
+                }
+
+                /* Coinbases and other partially credited outputs keep the amount claimed so far. */
+                uint64_t nClaimed = 0;
+                if(LLD::Ledger->ReadClaimed(hashTx, nContract, nClaimed))
+                {
+                    DataStream ssClaimed(SER_LLD, LLD::DATABASE_VERSION);
+                    ssClaimed << uint8_t(SNAPSHOT::CLAIMED) << hashTx << nContract << nClaimed;
+
+                    if(!write_record(stream, ssClaimed, header))
+                        return debug::error(FUNCTION, "failed to write claimed ", hashTx.SubString());
+                }
+
+                /* Conditional contracts may have been fulfilled. */
+                uint256_t hashCaller = 0;
+                if(!contract.Empty(TAO::Operation::Contract::CONDITIONS)
+                && LLD::Contract->ReadContract(std::make_pair(hashTx, nContract), hashCaller))
+                {
+                    DataStream ssContract(SER_LLD, LLD::DATABASE_VERSION);
+                    ssContract << uint8_t(SNAPSHOT::CONTRACT) << hashTx << nContract << hashCaller;
+
+                    if(!write_record(stream, ssContract, header))
+                        return debug::error(FUNCTION, "failed to write contract ", hashTx.SubString());
+                }
+            }
+
+            return true;
+        }
+
+
+        /* Write a legacy transaction along with its spent outputs and the amounts claimed from them. */
+        bool write_legacy(std::ofstream &stream, const uint512_t& hashTx, const Legacy::Transaction& tx, SnapshotHeader &header,
+                          std::set<uint576_t> &setTrust)
+        {
+            /* Get the spent outputs. */
+            std::vector<uint32_t> vSpent;
+            for(uint32_t nOutput = 0; nOutput < tx.vout.size(); ++nOutput)
+            {
+                if(LLD::Legacy->IsSpent(hashTx, nOutput))
+                    vSpent.push_back(nOutput);
+            }
+
+            DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+            ssRecord << uint8_t(SNAPSHOT::LEGACY) << tx << vSpent;
+
+            if(!write_record(stream, ssRecord, header))
+                return debug::error(FUNCTION, "failed to write legacy tx ", hashTx.SubString());
+
+            /* Outputs sent to tritium registers keep the amount claimed so far. */
+            for(uint32_t nOutput = 0; nOutput < tx.vout.size(); ++nOutput)
+            {
+                uint64_t nClaimed = 0;
+                if(!LLD::Ledger->ReadClaimed(hashTx, nOutput, nClaimed))
+                    continue;
+
+                DataStream ssClaimed(SER_LLD, LLD::DATABASE_VERSION);
+                ssClaimed << uint8_t(SNAPSHOT::CLAIMED) << hashTx << nOutput << nClaimed;
+
+                if(!write_record(stream, ssClaimed, header))
+                    return debug::error(FUNCTION, "failed to write claimed ", hashTx.SubString());
+            }
+
+            /* Coinstakes carry the trust key that staked them. */
+            uint576_t cKey;
+            if(tx.IsCoinStake() && tx.TrustKey(cKey))
+                setTrust.insert(cKey);
+
+            return true;
+        }
+
+
+        /** SnapshotLoader
+         *
+         *  Checks each snapshot record and, once the snapshot is verified, writes it to the databases.
+         *
+         **/
+        struct SnapshotLoader
+        {
+            /* Write the records as well as checking them. */
+            const bool fWrite;
+
+            /* The last block read, which the transaction records that follow belong to. */
+            BlockState stateBlock;
+            uint1024_t hashBlock;
+
+            /* The transactions of the last block that haven't been read yet. */
+            std::set<uint512_t> setPending;
+
+            /* The number of records of each kind. */
+            uint32_t nBlocks;
+            uint32_t nTransactions;
+            uint32_t nRegisters;
+            uint32_t nSigchains;
+
+            SnapshotLoader(const bool fWriteIn)
+            : fWrite        (fWriteIn)
+            , stateBlock    ( )
+            , hashBlock     (0)
+            , setPending    ( )
+            , nBlocks       (0)
+            , nTransactions (0)
+            , nRegisters    (0)
+            , nSigchains    (0)
+            {
+            }
+
+
+            /* Take a transaction of the last block off the pending list. */
+            bool take(const uint512_t& hashTx)
+            {
+                if(setPending.erase(hashTx) == 0)
+                    return debug::error(FUNCTION, "tx ", hashTx.SubString(), " isn't in block ", hashBlock.SubString());
+
+                return true;
+            }
+
+
+            /* Check and write one record. */
+            bool Record(const uint8_t nType, DataStream &ssRecord)
+            {
+                switch(nType)
+                {
+                    case SNAPSHOT::BLOCK:
+                    {
+                        /* Every transaction of the previous block must have been in the snapshot. */
+                        if(!setPending.empty())
+                            return debug::error(FUNCTION, "block ", hashBlock.SubString(), " is missing ", setPending.size(), " transactions");
+
+                        ssRecord >> stateBlock;
+                        hashBlock = stateBlock.GetHash();
+
+                        for(const auto& proof : stateBlock.vtx)
+                        {
+                            if(proof.first == TRANSACTION::TRITIUM || proof.first == TRANSACTION::LEGACY)
+                                setPending.insert(proof.second);
+                        }
+
+                        if(fWrite)
+                        {
+                            if(!LLD::Ledger->WriteBlock(hashBlock, stateBlock))
+                                return debug::error(FUNCTION, "failed to write block ", hashBlock.SubString());
+
+                            if(config::GetBoolArg("-indexheight") && !LLD::Ledger->IndexBlock(stateBlock.nHeight, hashBlock))
+                                return debug::error(FUNCTION, "failed to index height ", stateBlock.nHeight);
+                        }
+
+                        if(++nBlocks % SNAPSHOT_PROGRESS == 0)
+                            debug::log(0, FUNCTION, fWrite ? "Loaded " : "Verified ", nBlocks, " blocks");
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::TRITIUM:
+                    {
+                        Transaction tx;
+                        ssRecord >> tx;
+
+                        const uint512_t hashTx = tx.GetHash();
+                        if(!take(hashTx))
+                            return false;
+
+                        if(fWrite && (!LLD::Ledger->WriteTx(hashTx, tx) || !LLD::Ledger->IndexBlock(hashTx, hashBlock)))
+                            return debug::error(FUNCTION, "failed to write tx ", hashTx.SubString());
+
+                        ++nTransactions;
+                        return true;
+                    }
+
+                    case SNAPSHOT::LEGACY:
+                    {
+                        Legacy::Transaction tx;
+                        std::vector<uint32_t> vSpent;
+                        ssRecord >> tx >> vSpent;
+
+                        const uint512_t hashTx = tx.GetHash();
+                        if(!take(hashTx))
+                            return false;
+
+                        if(fWrite)
+                        {
+                            if(!LLD::Legacy->WriteTx(hashTx, tx) || !LLD::Ledger->IndexBlock(hashTx, hashBlock))
+                                return debug::error(FUNCTION, "failed to write legacy tx ", hashTx.SubString());
+
+                            for(const auto& nOutput : vSpent)
+                            {
+                                if(!LLD::Legacy->WriteSpend(hashTx, nOutput))
+                                    return debug::error(FUNCTION, "failed to write spend ", hashTx.SubString(), ":", nOutput);
+                            }
+                        }
+
+                        ++nTransactions;
+                        return true;
+                    }
+
+                    case SNAPSHOT::PROOF:
+                    {
+                        uint256_t hashProof = 0;
+                        uint512_t hashTx    = 0;
+                        uint32_t  nContract = 0;
+                        ssRecord >> hashProof >> hashTx >> nContract;
+
+                        if(fWrite && !LLD::Ledger->WriteProof(hashProof, hashTx, nContract))
+                            return debug::error(FUNCTION, "failed to write proof ", hashTx.SubString());
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::CLAIMED:
+                    {
+                        uint512_t hashTx    = 0;
+                        uint32_t  nContract = 0;
+                        uint64_t  nClaimed  = 0;
+                        ssRecord >> hashTx >> nContract >> nClaimed;
+
+                        if(fWrite && !LLD::Ledger->WriteClaimed(hashTx, nContract, nClaimed))
+                            return debug::error(FUNCTION, "failed to write claimed ", hashTx.SubString());
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::CONTRACT:
+                    {
+                        uint512_t hashTx     = 0;
+                        uint32_t  nContract  = 0;
+                        uint256_t hashCaller = 0;
+                        ssRecord >> hashTx >> nContract >> hashCaller;
+
+                        if(fWrite && !LLD::Contract->WriteContract(std::make_pair(hashTx, nContract), hashCaller))
+                            return debug::error(FUNCTION, "failed to write contract ", hashTx.SubString());
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::REGISTER:
+                    {
+                        uint256_t hashAddress = 0;
+                        TAO::Register::State state;
+                        uint8_t fTrust = 0;
+                        ssRecord >> hashAddress >> state >> fTrust;
+
+                        /* Each state carries its own checksum. */
+                        if(!state.IsValid())
+                            return debug::error(FUNCTION, "register ", hashAddress.SubString(), " failed its checksum");
+
+                        if(fWrite)
+                        {
+                            if(!LLD::Register->WriteState(hashAddress, state))
+                                return debug::error(FUNCTION, "failed to write register ", hashAddress.SubString());
+
+                            /* Trust accounts that have staked are indexed by their genesis. */
+                            if(fTrust && !LLD::Register->IndexTrust(state.hashOwner, hashAddress))
+                                return debug::error(FUNCTION, "failed to index trust ", hashAddress.SubString());
+                        }
+
+                        if(++nRegisters % SNAPSHOT_PROGRESS == 0)
+                            debug::log(0, FUNCTION, fWrite ? "Loaded " : "Verified ", nRegisters, " registers");
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::SIGCHAIN:
+                    {
+                        uint256_t hashGenesis = 0;
+                        uint512_t hashFirst   = 0;
+                        uint512_t hashLast    = 0;
+                        uint512_t hashStake   = 0;
+                        ssRecord >> hashGenesis >> hashFirst >> hashLast >> hashStake;
+
+                        if(fWrite)
+                        {
+                            /* The transactions were written with their blocks. */
+                            Transaction tx;
+                            if(!LLD::Ledger->ReadTx(hashLast, tx) || tx.hashGenesis != hashGenesis || !LLD::Ledger->HasTx(hashFirst))
+                                return debug::error(FUNCTION, "sigchain ", hashGenesis.SubString(), " doesn't match its transactions");
+
+                            if(!LLD::Ledger->WriteGenesis(hashGenesis, hashFirst) || !LLD::Ledger->WriteLast(hashGenesis, hashLast))
+                                return debug::error(FUNCTION, "failed to write sigchain ", hashGenesis.SubString());
+
+                            if(hashStake != 0 && !LLD::Ledger->WriteStake(hashGenesis, hashStake))
+                                return debug::error(FUNCTION, "failed to write stake ", hashGenesis.SubString());
+                        }
+
+                        ++nSigchains;
+                        return true;
+                    }
+
+                    case SNAPSHOT::TRUSTKEY:
+                    {
+                        uint576_t cKey;
+                        Legacy::TrustKey trustKey;
+                        uint8_t fConverted = 0;
+                        ssRecord >> cKey >> trustKey >> fConverted;
+
+                        if(fWrite)
+                        {
+                            if(!LLD::Trust->WriteTrustKey(cKey, trustKey))
+                                return debug::error(FUNCTION, "failed to write trust key");
+
+                            if(fConverted && !LLD::Legacy->WriteTrustConversion(cKey))
+                                return debug::error(FUNCTION, "failed to write trust conversion");
+                        }
+
+                        return true;
+                    }
+
+                    case SNAPSHOT::EVENT:
+                    {
+                        uint256_t hashAddress = 0;
+                        std::vector<uint512_t> vEvents;
+                        std::vector<uint512_t> vLegacy;
+                        ssRecord >> hashAddress >> vEvents >> vLegacy;
+
+                        if(fWrite)
+                        {
+                            /* Events are written in sequence order, each indexing a transaction already loaded. */
+                            for(const auto& hashTx : vEvents)
+                            {
+                                if(!LLD::Ledger->WriteEvent(hashAddress, hashTx))
+                                    return debug::error(FUNCTION, "failed to write event ", hashTx.SubString());
+                            }
+
+                            for(const auto& hashTx : vLegacy)
+                            {
+                                if(!LLD::Legacy->WriteEvent(hashAddress, hashTx))
+                                    return debug::error(FUNCTION, "failed to write legacy event ", hashTx.SubString());
+                            }
+                        }
+
+                        return true;
+                    }
+                }
+
+                return debug::error(FUNCTION, "unknown record type ", uint32_t(nType));
+            }
+        };
+
+
+        /* Disconnect the blocks after the checkpoint inside the open LLD transaction, so the export reads the
+         * ledger as it was at the checkpoint. Unlike BlockState::Disconnect this leaves the wallet alone, as the
+         * transaction is aborted once the snapshot is written. */
+        bool rollback_to(const BlockState& stateCheckpoint)
+        {
+            BlockState state = ChainState::stateBest.load();
+            while(state.GetHash() != stateCheckpoint.GetHash())
+            {
+                if(state.nHeight <= stateCheckpoint.nHeight)
+                    return debug::error(FUNCTION, "checkpoint is not on the best chain");
+
+                /* Disconnect the transactions in reverse order to preserve sigchain ordering. */
+                for(auto proof = state.vtx.rbegin(); proof != state.vtx.rend(); ++proof)
+                {
+                    if(proof->first == TRANSACTION::TRITIUM)
+                    {
+                        Transaction tx;
+                        if(!LLD::Ledger->ReadTx(proof->second, tx))
+                            return debug::error(FUNCTION, "failed to read tx ", proof->second.SubString());
+
+                        if(!tx.Disconnect())
+                            return debug::error(FUNCTION, "failed to disconnect tx ", proof->second.SubString());
+                    }
+                    else if(proof->first == TRANSACTION::LEGACY)
+                    {
+                        Legacy::Transaction tx;
+                        if(!LLD::Legacy->ReadTx(proof->second, tx))
+                            return debug::error(FUNCTION, "failed to read legacy tx ", proof->second.SubString());
+
+                        if(!tx.Disconnect(state))
+                            return debug::error(FUNCTION, "failed to disconnect legacy tx ", proof->second.SubString());
+                    }
+
+                    LLD::Ledger->EraseIndex(proof->second);
+                }
+
+                state = state.Prev();
+                if(!state)
+                    return debug::error(FUNCTION, "failed to read previous block");
+            }
+
+            return true;
+        }
+
+
+        /* Write the snapshot records for the ledger as it stands at the checkpoint. */
+        bool write_snapshot(const std::string& strPath, const BlockState& stateCheckpoint, uint256_t &hashCommitment,
+                            runtime::timer &timer)
+        {
+            /* Open the snapshot file. */
+            std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "failed to open ", strPath);
+
+            SnapshotHeader header;
+            header.hashGenesis = ChainState::Genesis();
+            header.nHeight     = stateCheckpoint.nHeight;
+            header.hashBlock   = stateCheckpoint.GetHash();
+
+            /* Write a placeholder header, filled in once the count and commitment are known. */
+            DataStream ssHeader(SER_LLD, LLD::DATABASE_VERSION);
+            ssHeader << header;
+
+            stream.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+            stream.write((char*)ssHeader.Bytes().data(), ssHeader.size());
+
+            /* The registers, sigchains, event addresses and trust keys to write once the chain is done. */
+            std::set<uint256_t> setRegisters;
+            std::set<uint256_t> setEvents;
+            std::set<uint576_t> setTrust;
+
+            /* Walk the best chain from genesis, writing each block and then its transactions. */
+            BlockState state = ChainState::stateGenesis;
+            while(!config::fShutdown.load())
+            {
+                const uint1024_t hashBlock = state.GetHash();
+
+                /* Nothing follows the checkpoint in the snapshot. */
+                if(hashBlock == header.hashBlock)
+                    state.hashNextBlock = 0;
+
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                ssRecord << uint8_t(SNAPSHOT::BLOCK) << state;
+
+                if(!write_record(stream, ssRecord, header))
+                    return debug::error(FUNCTION, "failed to write block ", state.nHeight);
+
+                for(const auto& proof : state.vtx)
+                {
+                    if(proof.first == TRANSACTION::TRITIUM)
+                    {
+                        Transaction tx;
+                        if(!LLD::Ledger->ReadTx(proof.second, tx))
+                            return debug::error(FUNCTION, "failed to read tx ", proof.second.SubString());
+
+                        if(!write_tritium(stream, proof.second, tx, header, setRegisters, setEvents))
+                            return false;
+                    }
+                    else if(proof.first == TRANSACTION::LEGACY)
+                    {
+                        Legacy::Transaction tx;
+                        if(!LLD::Legacy->ReadTx(proof.second, tx))
+                            return debug::error(FUNCTION, "failed to read legacy tx ", proof.second.SubString());
+
+                        if(!write_legacy(stream, proof.second, tx, header, setTrust))
+                            return false;
+                    }
+                }
+
+                if(hashBlock == header.hashBlock)
+                    break;
+
+                if(state.nHeight % 10000 == 0)
+                    debug::log(0, FUNCTION, "Exported to height ", state.nHeight, " registers=", setRegisters.size());
+
+                state = state.Next();
+                if(!state)
+                    return debug::error(FUNCTION, "failed to read next block");
+            }
+
+            if(config::fShutdown.load())
+                return false;
+
+            /* Write the registers in address order. */
+            for(const auto& hashAddress : setRegisters)
+            {
+                TAO::Register::State reg;
+                if(!LLD::Register->ReadState(hashAddress, reg))
+                    continue;
+
+                /* Keep the genesis index of trust accounts. */
+                const uint8_t fTrust = (TAO::Register::Address(hashAddress).IsTrust() && LLD::Register->HasTrust(reg.hashOwner)) ? 1 : 0;
+
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                ssRecord << uint8_t(SNAPSHOT::REGISTER) << hashAddress << reg << fTrust;
+
+                if(!write_record(stream, ssRecord, header))
+                    return debug::error(FUNCTION, "failed to write register ", hashAddress.SubString());
+            }
+
+            /* Write the signature chain indexes. Every sigchain is also an event address. */
+            for(const auto& hashGenesis : setEvents)
+            {
+                uint512_t hashFirst = 0, hashLast = 0;
+                if(!LLD::Ledger->ReadGenesis(hashGenesis, hashFirst) || !LLD::Ledger->ReadLast(hashGenesis, hashLast))
+                    continue;
+
+                uint512_t hashStake = 0;
+                LLD::Ledger->ReadStake(hashGenesis, hashStake);
+
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                ssRecord << uint8_t(SNAPSHOT::SIGCHAIN) << hashGenesis << hashFirst << hashLast << hashStake;
+
+                if(!write_record(stream, ssRecord, header))
+                    return debug::error(FUNCTION, "failed to write sigchain ", hashGenesis.SubString());
+            }
+
+            /* Write the legacy trust keys and whether they have been migrated. */
+            for(const auto& cKey : setTrust)
+            {
+                Legacy::TrustKey trustKey;
+                if(!LLD::Trust->ReadTrustKey(cKey, trustKey))
+                    continue;
+
+                const uint8_t fConverted = LLD::Legacy->HasTrustConversion(cKey) ? 1 : 0;
+
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                ssRecord << uint8_t(SNAPSHOT::TRUSTKEY) << cKey << trustKey << fConverted;
+
+                if(!write_record(stream, ssRecord, header))
+                    return debug::error(FUNCTION, "failed to write trust key");
+            }
+
+            /* Write the events of every sigchain and transfer recipient, in sequence order. */
+            for(const auto& hashAddress : setEvents)
+            {
+                std::vector<uint512_t> vEvents;
+
+                uint32_t nSequence = 0;
+                LLD::Ledger->ReadSequence(hashAddress, nSequence);
+                for(uint32_t n = 0; n < nSequence; ++n)
+                {
+                    Transaction tx;
+                    if(!LLD::Ledger->ReadEvent(hashAddress, n, tx))
+                        return debug::error(FUNCTION, "failed to read event ", n, " of ", hashAddress.SubString());
+
+                    vEvents.push_back(tx.GetHash());
+                }
+
+                std::vector<uint512_t> vLegacy;
+
+                nSequence = 0;
+                LLD::Legacy->ReadSequence(hashAddress, nSequence);
+                for(uint32_t n = 0; n < nSequence; ++n)
+                {
+                    Legacy::Transaction tx;
+                    if(!LLD::Legacy->ReadEvent(hashAddress, n, tx))
+                        return debug::error(FUNCTION, "failed to read legacy event ", n, " of ", hashAddress.SubString());
+
+                    vLegacy.push_back(tx.GetHash());
+                }
+
+                if(vEvents.empty() && vLegacy.empty())
+                    continue;
+
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                ssRecord << uint8_t(SNAPSHOT::EVENT) << hashAddress << vEvents << vLegacy;
+
+                if(!write_record(stream, ssRecord, header))
+                    return debug::error(FUNCTION, "failed to write events ", hashAddress.SubString());
+            }
+
+            /* Fill in the header. */
+            hashCommitment = header.hashCommitment;
+
+            DataStream ssFinal(SER_LLD, LLD::DATABASE_VERSION);
+            ssFinal << header;
+
+            stream.seekp(sizeof(SNAPSHOT_MAGIC), std::ios::beg);
+            stream.write((char*)ssFinal.Bytes().data(), ssFinal.size());
+            stream.close();
+
+            if(!stream)
+                return debug::error(FUNCTION, "failed to write ", strPath);
+
+            debug::log(0, FUNCTION, "Exported snapshot at height ", header.nHeight, " with ", header.nRecords, " records, ",
+                setRegisters.size(), " registers to ", strPath, " in ", timer.Elapsed(), " seconds");
+            debug::log(0, FUNCTION, "Snapshot commitment ", hashCommitment.ToString());
+
+            return true;
+        }
+
+
+        /* Write the ledger at the last hardened checkpoint to a snapshot file. */
+        bool ExportSnapshot(const std::string& strPath, uint256_t &hashCommitment)
+        {
+            hashCommitment = 0;
+
+            if(config::fClient.load())
+                return debug::error(FUNCTION, "snapshots need a full ledger");
+
+            runtime::timer timer;
+            timer.Start();
+
+            /* Hold off blocks until the snapshot is written, so every record comes from the same chain state. */
+            LOCK(PROCESSING_MUTEX);
+
+            /* Blocks before the hardened checkpoint can't be reorganized away. */
+            BlockState stateCheckpoint;
+            if(!LLD::Ledger->ReadBlock(ChainState::hashCheckpoint.load(), stateCheckpoint))
+                return debug::error(FUNCTION, "failed to read checkpoint ", ChainState::hashCheckpoint.load().SubString());
+
+            /* Undo the blocks after the checkpoint in a transaction that is never committed, so the best chain and
+             * everything on disk are left as they were. */
+            LLD::TxnBegin();
+
+            if(ChainState::stateBest.load() != stateCheckpoint)
+                debug::log(0, FUNCTION, "Reading ledger at checkpoint ", stateCheckpoint.GetHash().SubString(),
+                    " at height ", stateCheckpoint.nHeight, ", ", ChainState::nBestHeight.load() - stateCheckpoint.nHeight,
+                    " blocks below the best chain");
+
+            const bool fWritten = rollback_to(stateCheckpoint) && write_snapshot(strPath, stateCheckpoint, hashCommitment, timer);
+
+            LLD::TxnAbort();
+
+            if(!fWritten)
+                hashCommitment = 0;
+
+            return fWritten;
+        }
+
+
+        /* Read every record of a snapshot, checking the chain of blocks and the commitment. */
+        bool ReadSnapshot(const std::string& strPath, const std::function<bool(const uint8_t, DataStream&)>& fnRecord,
+                          uint256_t &hashCommitment)
+        {
+            hashCommitment = 0;
+
+            /* Open the snapshot file. */
+            std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "failed to open ", strPath);
+
+            SnapshotHeader header;
+            if(!read_header(stream, header))
+                return false;
+
+            /* Read the records in order. */
+            uint1024_t hashPrev = 0;
+            for(uint32_t n = 0; n < header.nRecords; ++n)
+            {
+                DataStream ssRecord(SER_LLD, LLD::DATABASE_VERSION);
+                if(!read_record(stream, ssRecord, hashCommitment))
+                    return false;
+
+                try
+                {
+                    uint8_t nType = 0;
+                    ssRecord >> nType;
+
+                    /* The blocks must form a chain from genesis. */
+                    if(nType == SNAPSHOT::BLOCK)
+                    {
+                        BlockState state;
+                        ssRecord >> state;
+
+                        const uint1024_t hashBlock = state.GetHash();
+                        if(hashPrev == 0 && hashBlock != ChainState::Genesis())
+                            return debug::error(FUNCTION, "first block ", hashBlock.SubString(), " isn't genesis");
+
+                        if(hashPrev != 0 && state.hashPrevBlock != hashPrev)
+                            return debug::error(FUNCTION, "block ", hashBlock.SubString(), " doesn't follow ", hashPrev.SubString());
+
+                        hashPrev = hashBlock;
+
+                        /* Hand the record back from its start. */
+                        ssRecord.SetPos(1);
+                    }
+                    else if(hashPrev == 0)
+                        return debug::error(FUNCTION, "record before the first block");
+
+                    if(!fnRecord(nType, ssRecord))
+                        return false;
+                }
+                catch(const std::exception& e)
+                {
+                    return debug::error(FUNCTION, "failed to decode record ", n, ": ", e.what());
+                }
+            }
+
+            /* Nothing may follow the last record. */
+            if(stream.peek() != std::ifstream::traits_type::eof())
+                return debug::error(FUNCTION, "trailing data after the last record");
+
+            /* The last block is the checkpoint. */
+            if(hashPrev != header.hashBlock)
+                return debug::error(FUNCTION, "last block doesn't match the snapshot checkpoint");
+
+            /* Check the commitment covers what was read. */
+            if(hashCommitment != header.hashCommitment)
+                return debug::error(FUNCTION, "snapshot commitment mismatch ", hashCommitment.SubString());
+
+            return true;
+        }
+
+
+        /* Load a snapshot into an empty ledger. */
+        bool ImportSnapshot(const std::string& strPath, uint256_t &hashCommitment)
+        {
+            hashCommitment = 0;
+
+            if(config::fClient.load())
+                return debug::error(FUNCTION, "snapshots need a full ledger");
+
+            /* Snapshots replace the chain, so only load one into a fresh ledger. */
+            if(ChainState::nBestHeight.load() != 0)
+                return debug::error(FUNCTION, "ledger already has blocks at height ", ChainState::nBestHeight.load());
+
+            /* A snapshot is only trusted against a commitment given out of band. */
+            const std::string strHash = config::GetArg("-snapshothash", "");
+            if(strHash.empty())
+                return debug::error(FUNCTION, "-loadsnapshot needs -snapshothash");
+
+            uint256_t hashTrusted;
+            hashTrusted.SetHex(strHash);
+
+            runtime::timer timer;
+            timer.Start();
+
+            /* Check every record before anything is written. */
+            {
+                SnapshotLoader loader(false);
+                if(!ReadSnapshot(strPath, std::bind(&SnapshotLoader::Record, &loader, std::placeholders::_1, std::placeholders::_2), hashCommitment))
+                    return false;
+
+                if(!loader.setPending.empty())
+                    return debug::error(FUNCTION, "checkpoint block is missing ", loader.setPending.size(), " transactions");
+            }
+
+            if(hashTrusted != hashCommitment)
+                return debug::error(FUNCTION, "snapshot commitment ", hashCommitment.ToString(), " doesn't match -snapshothash");
+
+            /* Load the records, building the keychains in bulk since every key is new. The best chain
+             * isn't written until every record is loaded, so a load that is cut short leaves the ledger
+             * at height zero and is loaded again over the same keys on the next start. */
+            SnapshotLoader loader(true);
+            LLD::BulkBegin();
+
+            uint256_t hashLoaded = 0;
+            const bool fLoaded = ReadSnapshot(strPath, [&](const uint8_t nType, DataStream& ssRecord)
+            {
+                if(!loader.Record(nType, ssRecord))
+                    return false;
+
+                /* Build the held keys between records, so they don't all sit in memory until the end. */
+                if(!LLD::BulkCheckpoint())
+                    return debug::error(FUNCTION, "failed to build snapshot keychains at block ", loader.hashBlock.SubString());
+
+                return true;
+            }, hashLoaded);
+
+            if(!fLoaded)
+            {
+                LLD::BulkAbort();
+                return debug::error(FUNCTION, "failed to load snapshot records, restart with -loadsnapshot to load it again");
+            }
+
+            if(!LLD::BulkCommit())
+                return debug::error(FUNCTION, "failed to build snapshot keychains");
+
+            /* The file can't have changed since it was checked. */
+            if(hashLoaded != hashTrusted)
+                return debug::error(FUNCTION, "snapshot changed while loading");
+
+            /* Make the checkpoint block the best chain. */
+            if(!LLD::Ledger->WriteSnapshot(loader.hashBlock) || !LLD::Ledger->WriteBestChain(loader.hashBlock))
+                return debug::error(FUNCTION, "failed to write best chain");
+
+            /* The register history index has nothing before the snapshot. */
+            if(!LLD::Ledger->WriteHistoryHeight(loader.stateBlock.nHeight))
+                return debug::error(FUNCTION, "failed to write history height");
+
+            if(!ChainState::Initialize())
+                return debug::error(FUNCTION, "failed to initialize chain state from snapshot");
+
+            debug::log(0, FUNCTION, "Imported snapshot at height ", loader.stateBlock.nHeight, " with ", loader.nBlocks, " blocks, ",
+                loader.nTransactions, " transactions, ", loader.nRegisters, " registers, ", loader.nSigchains, " sigchains in ",
+                timer.Elapsed(), " seconds");
+
+            return true;
+        }
+    }
+}
@@ -27,6 +27,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/include/keycache.h>
 #include <TAO/Ledger/include/process.h>
 #include <TAO/Ledger/include/stake.h>
 
@@ -707,38 +708,43 @@ namespace TAO
             if(!txProducer.Build())
                 return debug::error(FUNCTION, "Coinstake transaction failed to build");
 
-            /* Coinstake producer now complete. Sign the transaction. */
-            txProducer.Sign(user->Generate(txProducer.nSequence, strPIN));
-
-            if(block.nVersion < 9)
-                block.producer = txProducer;
-            else
+            /* Keep the sigchain decrypted while signing both the producer and the block. */
             {
-                /* Replace last producer in block with the completed & signed one */
-                block.vProducer.erase(block.vProducer.begin() + (block.vProducer.size() - 1));
-                block.vProducer.push_back(txProducer);
-            }
+                memory::decrypted_view<TAO::Ledger::SignatureChain> unlocked(user);
 
-            /* Build the Merkle Root. */
-            std::vector<uint512_t> vHashes;
+                /* Coinstake producer now complete. Sign the transaction. */
+                txProducer.Sign(unlocked->Generate(txProducer.nSequence, strPIN));
 
-            for(const auto& item : block.vtx)
-                vHashes.push_back(item.second);
+                if(block.nVersion < 9)
+                    block.producer = txProducer;
+                else
+                {
+                    /* Replace last producer in block with the completed & signed one */
+                    block.vProducer.erase(block.vProducer.begin() + (block.vProducer.size() - 1));
+                    block.vProducer.push_back(txProducer);
+                }
 
-            /* producers are not part of vtx, add to vHashes last */
-            if(block.nVersion < 9)
-                vHashes.push_back(block.producer.GetHash());
-            else
-            {
-                for(const TAO::Ledger::Transaction& tx : block.vProducer)
-                    vHashes.push_back(tx.GetHash());
-            }
+                /* Build the Merkle Root. */
+                std::vector<uint512_t> vHashes;
 
-            block.hashMerkleRoot = block.BuildMerkleTree(vHashes);
+                for(const auto& item : block.vtx)
+                    vHashes.push_back(item.second);
 
-            /* Sign the block. */
-            if(!SignBlock(user, strPIN))
-                return false;
+                /* producers are not part of vtx, add to vHashes last */
+                if(block.nVersion < 9)
+                    vHashes.push_back(block.producer.GetHash());
+                else
+                {
+                    for(const TAO::Ledger::Transaction& tx : block.vProducer)
+                        vHashes.push_back(tx.GetHash());
+                }
+
+                block.hashMerkleRoot = block.BuildMerkleTree(vHashes);
+
+                /* Sign the block. */
+                if(!SignBlock(user, strPIN))
+                    return false;
+            }
 
             /* Print the newly found block. */
             block.print();
@@ -777,6 +783,10 @@ namespace TAO
             if(fGenesis)
                 fGenesis = false;
 
+            /* Pregenerate the keys for the next producer now that this one is accepted. */
+            if(TAO::API::users && TAO::API::users->KEY_PIPELINE)
+                TAO::API::users->KEY_PIPELINE->Queue(txProducer.hashGenesis, strPIN, txProducer.nSequence);
+
             return true;
         }
 
@@ -792,7 +802,8 @@ namespace TAO
             else
                 txProducer = block.vProducer.back();
 
-            std::vector<uint8_t> vBytes = user->Generate(txProducer.nSequence, strPIN).GetBytes();
+            const uint512_t hashSecret = user->Generate(txProducer.nSequence, strPIN);
+            std::vector<uint8_t> vBytes = hashSecret.GetBytes();
             uint8_t nKeyType = txProducer.nKeyType;
 
             LLC::CSecret vchSecret(vBytes.begin(), vBytes.end());
@@ -806,8 +817,8 @@ namespace TAO
                     /* Create the FL Key object. */
                     LLC::FLKey key;
 
-                    /* Set the secret parameter. */
-                    if(!key.SetSecret(vchSecret))
+                    /* Set the secret parameter, unless it was already derived in the background. */
+                    if(!TAO::Ledger::GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret))
                         return debug::error(FUNCTION, "StakeMinter: Unable to set key for signing Tritium Block ",
                                             block.GetHash().SubString());
 
@@ -825,8 +836,8 @@ namespace TAO
                     /* Create EC Key object. */
                     LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
 
-                    /* Set the secret parameter. */
-                    if(!key.SetSecret(vchSecret, true))
+                    /* Set the secret parameter, unless it was already derived in the background. */
+                    if(!TAO::Ledger::GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret, true))
                         return debug::error(FUNCTION, "StakeMinter: Unable to set key for signing Tritium Block ",
                                             block.GetHash().SubString());
 
@@ -47,6 +47,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/types/client.h>
 
 #include <Util/include/string.h>
+#include <Util/include/trace.h>
 
 
 
@@ -497,6 +498,8 @@ namespace TAO
         /* Accept a block state into chain. */
         bool BlockState::Index()
         {
+            trace::Span span("BlockState::Index", "ledger");
+
             /* Runtime calculations. */
             runtime::timer timer;
             timer.Start();
@@ -833,6 +836,8 @@ namespace TAO
 
         bool BlockState::SetBest()
         {
+            trace::Span span("BlockState::SetBest", "ledger");
+
             /* Reset timers for meters. */
             swContract.reset();
             swScript.reset();
@@ -1073,6 +1078,8 @@ namespace TAO
         /** Connect a block state into chain. **/
         bool BlockState::Connect()
         {
+            trace::Span span("BlockState::Connect", "ledger");
+
             /* Reset the transaction fees. */
             nFees = 0;
 
@@ -1082,6 +1089,11 @@ namespace TAO
             uint64_t nPoolFeeTotal = 0;
             uint512_t hashBlockFinder = vtx.back().second; //block finder is last in vtx
 
+            /* Write any wallet updates from this block in one database transaction. */
+            #ifndef NO_WALLET
+            Legacy::WalletBatch batch;
+            #endif
+
             /* Check through all the transactions. */
             for(const auto& proof : vtx)
             {
@@ -0,0 +1,333 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/process.h>
+#include <TAO/Ledger/include/tally.h>
+
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+#include <TAO/Operation/types/contract.h>
+
+#include <TAO/Register/types/address.h>
+#include <TAO/Register/types/object.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Get the account and voting sigchain of a credit to an account with a vote tally. */
+        bool tallied_vote(const TAO::Operation::Contract& contract, uint256_t &hashAccount, uint256_t &hashSender)
+        {
+            /* Only credits are counted as votes. */
+            if(contract.Primitive() != TAO::Operation::OP::CREDIT)
+                return false;
+
+            /* Skip over the txid and contract-id of the debit. */
+            uint8_t nOP = 0;
+            uint512_t hashTx = 0;
+            uint32_t nContract = 0;
+
+            contract.SeekToPrimitive();
+            contract >> nOP >> hashTx >> nContract;
+
+            /* Get the account credited and the account debited. */
+            TAO::Register::Address hashFrom;
+            contract >> hashAccount;
+            contract >> hashFrom;
+
+            /* Reset before return. */
+            contract.Reset();
+
+            /* Check that the account has a tally. */
+            std::pair<uint64_t, uint64_t> pairTally;
+            if(!LLD::Ledger->ReadTally(hashAccount, pairTally))
+                return false;
+
+            /* The vote belongs to the owner of the debited account. */
+            TAO::Register::State from;
+            if(!LLD::Register->ReadState(hashFrom, from))
+                return false;
+
+            hashSender = from.hashOwner;
+
+            return true;
+        }
+
+
+        /* Get the weight of one vote from a sigchain. */
+        bool VoteWeight(const uint256_t& hashGenesis, uint64_t &nWeight)
+        {
+            /* Every vote counts once. */
+            nWeight = NXS_COIN;
+
+            /* Get trust account. Any trust account that has completed Genesis will be indexed. */
+            TAO::Register::Object trust;
+            if(!LLD::Register->ReadTrust(hashGenesis, trust)
+            && !LLD::Register->ReadState(TAO::Register::Address(std::string("trust"), hashGenesis, TAO::Register::Address::TRUST), trust))
+                return false;
+
+            /* Parse the object. */
+            if(!trust.Parse())
+                return debug::error(FUNCTION, "unable to parse trust account");
+
+            /* The amount staked */
+            const uint64_t nStake = trust.get<uint64_t>("stake");
+
+            /* The sender's trust score as a % */
+            const double dTrustScore = (double)trust.get<uint64_t>("trust") / 10000000.0;
+
+            /* Only apply the trust weighting if they are staking, capped at 10k NXS so that large accounts cannot dominate. */
+            if(nStake > 0 && dTrustScore > 0.5)
+                nWeight = NXS_COIN + ((std::min(nStake, 10000 * NXS_COIN) / 10000) * dTrustScore);
+
+            return true;
+        }
+
+
+        /* Add a credit to the vote tally of its account. */
+        bool ConnectVote(const TAO::Operation::Contract& contract)
+        {
+            /* Check for a tallied vote. */
+            uint256_t hashAccount = 0;
+            uint256_t hashSender  = 0;
+            if(!tallied_vote(contract, hashAccount, hashSender))
+                return true;
+
+            /* Further votes from the same sigchain only count once. */
+            std::pair<uint64_t, uint32_t> pairVoter;
+            if(LLD::Ledger->ReadVoter(hashAccount, hashSender, pairVoter))
+            {
+                ++pairVoter.second;
+
+                return LLD::Ledger->WriteVoter(hashAccount, hashSender, pairVoter);
+            }
+
+            /* Sigchains without a trust account can't vote. */
+            uint64_t nWeight = 0;
+            if(!VoteWeight(hashSender, nWeight))
+                return true;
+
+            /* Add the vote to the tally. */
+            std::pair<uint64_t, uint64_t> pairTally;
+            if(!LLD::Ledger->ReadTally(hashAccount, pairTally))
+                return debug::error(FUNCTION, "failed to read tally");
+
+            ++pairTally.first;
+            pairTally.second += nWeight;
+
+            if(!LLD::Ledger->WriteVoter(hashAccount, hashSender, std::make_pair(nWeight, uint32_t(1))))
+                return debug::error(FUNCTION, "failed to write voter");
+
+            return LLD::Ledger->WriteTally(hashAccount, pairTally);
+        }
+
+
+        /* Remove a credit from the vote tally of its account. */
+        bool DisconnectVote(const TAO::Operation::Contract& contract)
+        {
+            /* Check for a tallied vote. */
+            uint256_t hashAccount = 0;
+            uint256_t hashSender  = 0;
+            if(!tallied_vote(contract, hashAccount, hashSender))
+                return true;
+
+            /* Votes that weren't counted have no voter. */
+            std::pair<uint64_t, uint32_t> pairVoter;
+            if(!LLD::Ledger->ReadVoter(hashAccount, hashSender, pairVoter))
+                return true;
+
+            /* Keep the vote while the sigchain has other credits. */
+            if(pairVoter.second > 1)
+            {
+                --pairVoter.second;
+
+                return LLD::Ledger->WriteVoter(hashAccount, hashSender, pairVoter);
+            }
+
+            /* Remove the vote from the tally. */
+            std::pair<uint64_t, uint64_t> pairTally;
+            if(!LLD::Ledger->ReadTally(hashAccount, pairTally))
+                return debug::error(FUNCTION, "failed to read tally");
+
+            pairTally.first  -= std::min(pairTally.first,  uint64_t(1));
+            pairTally.second -= std::min(pairTally.second, pairVoter.first);
+
+            if(!LLD::Ledger->EraseVoter(hashAccount, hashSender))
+                return debug::error(FUNCTION, "failed to erase voter");
+
+            return LLD::Ledger->WriteTally(hashAccount, pairTally);
+        }
+
+
+        /* Count the credits to an account in a transaction, by the sigchain that made them. */
+        void tally_credits(const Transaction& tx, const uint256_t& hashAccount,
+                           std::map<uint256_t, std::pair<uint64_t, uint32_t> > &mapVoters, std::set<uint256_t> &setSenders)
+        {
+            /* Check all contracts for credits to the account. */
+            for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+            {
+                const TAO::Operation::Contract& contract = tx[nContract];
+                if(contract.Primitive() != TAO::Operation::OP::CREDIT)
+                    continue;
+
+                /* Skip over the txid and contract-id of the debit. */
+                uint8_t nOP = 0;
+                uint512_t hashTx = 0;
+                uint32_t nID = 0;
+
+                contract.SeekToPrimitive();
+                contract >> nOP >> hashTx >> nID;
+
+                /* Get the account credited and the account debited. */
+                TAO::Register::Address hashAddress;
+                TAO::Register::Address hashFrom;
+                contract >> hashAddress;
+                contract >> hashFrom;
+
+                contract.Reset();
+
+                if(hashAddress != hashAccount)
+                    continue;
+
+                /* The vote belongs to the owner of the debited account. */
+                TAO::Register::State from;
+                if(!LLD::Register->ReadState(hashFrom, from))
+                    continue;
+
+                /* Remember every sender, one that can't vote now may still have an old voter record. */
+                setSenders.insert(from.hashOwner);
+
+                /* Count further credits from the same sigchain. */
+                auto it = mapVoters.find(from.hashOwner);
+                if(it != mapVoters.end())
+                {
+                    ++it->second.second;
+                    continue;
+                }
+
+                /* Sigchains without a trust account can't vote. */
+                uint64_t nVote = 0;
+                if(!VoteWeight(from.hashOwner, nVote))
+                    continue;
+
+                mapVoters[from.hashOwner] = std::make_pair(nVote, uint32_t(1));
+            }
+        }
+
+
+        /* Walk a sigchain back from a transaction, counting credits until a stop transaction or genesis. */
+        bool tally_chain(const uint256_t& hashAccount, uint512_t hashLast, const uint512_t& hashStop,
+                         std::map<uint256_t, std::pair<uint64_t, uint32_t> > &mapVoters, std::set<uint256_t> &setSenders)
+        {
+            /* Loop until the stop transaction or genesis. */
+            while(hashLast != 0)
+            {
+                if(hashLast == hashStop)
+                    return true;
+
+                /* Get the transaction from disk. */
+                Transaction tx;
+                if(!LLD::Ledger->ReadTx(hashLast, tx))
+                    return debug::error(FUNCTION, "failed to read transaction ", hashLast.SubString());
+
+                tally_credits(tx, hashAccount, mapVoters, setSenders);
+
+                /* Set the next last. */
+                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+            }
+
+            /* Reaching genesis is only expected without a stop transaction. */
+            return hashStop == 0;
+        }
+
+
+        /* Count every credit made to an account and write its vote tally. */
+        bool RebuildTally(const uint256_t& hashAccount, uint64_t &nVotes, uint64_t &nWeight)
+        {
+            /* A reorganization can disconnect the snapshot, in which case the walk is started again. */
+            for(uint32_t nAttempt = 0; nAttempt < 3; ++nAttempt)
+            {
+                nVotes  = 0;
+                nWeight = 0;
+
+                /* Get the account. */
+                TAO::Register::State account;
+                if(!LLD::Register->ReadState(hashAccount, account))
+                    return debug::error(FUNCTION, "account not found");
+
+                /* Get the last transaction of the account owner as the snapshot to walk from. */
+                uint512_t hashSnapshot = 0;
+                if(!LLD::Ledger->ReadLast(account.hashOwner, hashSnapshot))
+                    return debug::error(FUNCTION, "no transactions found");
+
+                /* The credits and weight of each voting sigchain, and every sigchain that made a credit. */
+                std::map<uint256_t, std::pair<uint64_t, uint32_t> > mapVoters;
+                std::set<uint256_t> setSenders;
+
+                /* Walk the sigchain without holding off blocks. */
+                if(!tally_chain(hashAccount, hashSnapshot, 0, mapVoters, setSenders))
+                    return debug::error(FUNCTION, "failed to walk sigchain");
+
+                /* Hold off blocks while the walk is brought up to date and written. */
+                LOCK(PROCESSING_MUTEX);
+
+                /* Count the transactions connected since the snapshot. */
+                uint512_t hashLast = 0;
+                if(!LLD::Ledger->ReadLast(account.hashOwner, hashLast)
+                || !tally_chain(hashAccount, hashLast, hashSnapshot, mapVoters, setSenders))
+                {
+                    debug::log(0, FUNCTION, "sigchain changed during tally of ", hashAccount.SubString(), ", counting again");
+                    continue;
+                }
+
+                /* Clear the old voter records so none are left for sigchains that no longer count. */
+                for(const auto& hashSender : setSenders)
+                    LLD::Ledger->EraseVoter(hashAccount, hashSender);
+
+                /* Write the voters and the tally. */
+                for(const auto& voter : mapVoters)
+                {
+                    if(!LLD::Ledger->WriteVoter(hashAccount, voter.first, voter.second))
+                        return debug::error(FUNCTION, "failed to write voter");
+
+                    ++nVotes;
+                    nWeight += voter.second.first;
+                }
+
+                if(!LLD::Ledger->WriteTally(hashAccount, std::make_pair(nVotes, nWeight)))
+                    return debug::error(FUNCTION, "failed to write tally");
+
+                debug::log(0, FUNCTION, "Tallied ", nVotes, " votes for ", hashAccount.SubString());
+
+                return true;
+            }
+
+            return debug::error(FUNCTION, "sigchain kept changing during tally of ", hashAccount.SubString());
+        }
+    }
+}
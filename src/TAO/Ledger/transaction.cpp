@@ -41,8 +41,10 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/keycache.h>
 #include <TAO/Ledger/include/stake.h>
 #include <TAO/Ledger/include/stake_change.h>
+#include <TAO/Ledger/include/tally.h>
 #include <TAO/Ledger/include/timelocks.h>
 #include <TAO/Ledger/types/merkle.h>
 #include <TAO/Ledger/types/mempool.h>
@@ -1054,6 +1056,21 @@ namespace TAO
             if(nFlags == FLAGS::BLOCK && !LLD::Ledger->WriteLast(hashGenesis, hash))
                 return debug::error(FUNCTION, "failed to write last hash");
 
+            /* Index the contracts by the register they operate on. */
+            if(nFlags == FLAGS::BLOCK && !config::fClient.load())
+            {
+                for(uint32_t nContract = 0; nContract < vContracts.size(); ++nContract)
+                {
+                    uint256_t hashRegister = 0;
+                    if(vContracts[nContract].Address(hashRegister) && !LLD::Ledger->WriteHistory(hashRegister, hash, nContract))
+                        return debug::error(FUNCTION, "failed to write register history");
+
+                    /* Count credits to accounts with a vote tally. */
+                    if(!ConnectVote(vContracts[nContract]))
+                        return debug::error(FUNCTION, "failed to update vote tally");
+                }
+            }
+
             return true;
         }
 
@@ -1109,12 +1126,25 @@ namespace TAO
                 }
             }
 
+            /* Get the transaction's hash. */
+            const uint512_t hash = GetHash();
+
             /* Run through all the contracts in reverse order to disconnect. */
             for(auto contract = vContracts.rbegin(); contract != vContracts.rend(); ++contract)
             {
                 contract->Bind(this);
                 if(!TAO::Register::Rollback(*contract, nFlags))
                     return false;
+
+                /* Remove the contract from the register history index. */
+                uint256_t hashRegister = 0;
+                if(nFlags == FLAGS::BLOCK && !config::fClient.load() && contract->Address(hashRegister)
+                && !LLD::Ledger->EraseHistory(hashRegister, hash))
+                    return debug::error(FUNCTION, "failed to erase register history");
+
+                /* Remove credits from accounts with a vote tally. */
+                if(nFlags == FLAGS::BLOCK && !config::fClient.load() && !DisconnectVote(*contract))
+                    return debug::error(FUNCTION, "failed to update vote tally");
             }
 
             return true;
@@ -1275,6 +1305,33 @@ namespace TAO
         }
 
 
+        /* Gets the hashes of a list of transactions, hashing them together in one batch. */
+        void Transaction::GetHashes(const std::vector<Transaction>& vtx, std::vector<uint512_t> &vHashes)
+        {
+            /* Serialize each transaction the same way as GetHash. */
+            std::vector<DataStream> vStreams;
+            vStreams.reserve(vtx.size());
+
+            std::vector<std::pair<const uint8_t*, uint64_t> > vData;
+            vData.reserve(vtx.size());
+
+            for(const auto& tx : vtx)
+            {
+                vStreams.emplace_back(SER_GETHASH, tx.nVersion);
+                vStreams.back() << tx;
+
+                vData.push_back(std::make_pair(vStreams.back().Bytes().data(), vStreams.back().size()));
+            }
+
+            /* Get the hashes. */
+            LLC::SK512Batch(vData, vHashes);
+
+            /* Type of 0xff designates tritium tx. */
+            for(auto& hash : vHashes)
+                hash.SetType(TAO::Ledger::TRITIUM);
+        }
+
+
         /* Gets a proof hash of the transaction object. */
         uint512_t Transaction::ProofHash() const
         {
@@ -1355,8 +1412,8 @@ namespace TAO
                     /* Create the FL Key object. */
                     LLC::FLKey key;
 
-                    /* Set the secret key. */
-                    if(!key.SetSecret(vchSecret))
+                    /* Set the secret key, unless it was already derived in the background. */
+                    if(!GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret))
                         return;
 
                     /* Calculate the next hash. */
@@ -1371,8 +1428,8 @@ namespace TAO
                     /* Create EC Key object. */
                     LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
 
-                    /* Set the secret key. */
-                    if(!key.SetSecret(vchSecret, true))
+                    /* Set the secret key, unless it was already derived in the background. */
+                    if(!GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret, true))
                         return;
 
                     /* Calculate the next hash. */
@@ -1416,8 +1473,8 @@ namespace TAO
                     /* Create the FL Key object. */
                     LLC::FLKey key;
 
-                    /* Set the secret key. */
-                    if(!key.SetSecret(vchSecret))
+                    /* Set the secret key, unless it was already derived in the background. */
+                    if(!GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret))
                         return false;
 
                     /* Set the public key. */
@@ -1433,8 +1490,8 @@ namespace TAO
                     /* Create EC Key object. */
                     LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
 
-                    /* Set the secret key. */
-                    if(!key.SetSecret(vchSecret, true))
+                    /* Set the secret key, unless it was already derived in the background. */
+                    if(!GetPregeneratedKey(hashSecret, key) && !key.SetSecret(vchSecret, true))
                         return false;
 
                     /* Set the public key. */
@@ -43,6 +43,7 @@ ________________________________________________________________________________
 
 #include <Util/include/args.h>
 #include <Util/include/hex.h>
+#include <Util/include/trace.h>
 
 #include <cmath>
 
@@ -229,7 +230,64 @@ namespace TAO
             if(block.nVersion < 7)
                 throw debug::exception(FUNCTION, "invalid sync block version for tritium block");
 
+            /* Build the tritium transactions first, so that their hashes are computed in one batch. */
+            std::vector<Transaction> vTritium;
+            std::vector<uint512_t> vTritiumHashes;
+            Prepare(block, vTritium, vTritiumHashes);
+
+            build(block, vTritium, vTritiumHashes);
+        }
+
+
+        /* Copy Constructor. */
+        TritiumBlock::TritiumBlock(const SyncBlock& block, const std::vector<Transaction>& vTritium,
+                                   const std::vector<uint512_t>& vTritiumHashes)
+        : Block     (block)
+        , nTime     (block.nTime)
+        , producer  ( )
+        , vProducer ( )
+        , ssSystem  (block.ssSystem)
+        , vtx       ( )
+        {
+            /* Check for version conversions. */
+            if(block.nVersion < 7)
+                throw debug::exception(FUNCTION, "invalid sync block version for tritium block");
+
+            build(block, vTritium, vTritiumHashes);
+        }
+
+
+        /* Deserialize and hash the tritium transactions of a sync block. */
+        void TritiumBlock::Prepare(const SyncBlock& block, std::vector<Transaction>& vTritium, std::vector<uint512_t>& vTritiumHashes)
+        {
+            vTritium.clear();
+            for(const auto& tx : block.vtx)
+            {
+                if(tx.first != TRANSACTION::TRITIUM)
+                    continue;
+
+                /* Serialize stream. */
+                DataStream ssData(tx.second, SER_DISK, LLD::DATABASE_VERSION);
+
+                /* Build the transaction. */
+                vTritium.push_back(Transaction());
+                ssData >> vTritium.back();
+            }
+
+            Transaction::GetHashes(vTritium, vTritiumHashes);
+        }
+
+
+        /* Fill the block from a sync block and its prepared tritium transactions. */
+        void TritiumBlock::build(const SyncBlock& block, const std::vector<Transaction>& vTritium,
+                                 const std::vector<uint512_t>& vTritiumHashes)
+        {
+            /* The prepared transactions must line up with the sync block. */
+            if(vTritium.size() != vTritiumHashes.size())
+                throw debug::exception(FUNCTION, "prepared transaction and hash counts differ");
+
             /* Loop through transctions. */
+            uint32_t nTritium = 0;
             for(uint32_t n = 0; n < block.vtx.size(); ++n)
             {
                 /* Switch for type. */
@@ -238,12 +296,13 @@ namespace TAO
                     /* Check for tritium. */
                     case TRANSACTION::TRITIUM:
                     {
-                        /* Serialize stream. */
-                        DataStream ssData(block.vtx[n].second, SER_DISK, LLD::DATABASE_VERSION);
+                        /* Get the transaction built by Prepare. */
+                        if(nTritium >= vTritium.size())
+                            throw debug::exception(FUNCTION, "missing prepared transaction");
 
-                        /* Build the transaction. */
-                        Transaction tx;
-                        ssData >> tx;
+                        const Transaction& tx = vTritium[nTritium];
+                        const uint512_t& hash = vTritiumHashes[nTritium];
+                        ++nTritium;
 
                         /* Add transaction to binary data. */
                         if(nVersion < 9 && n == (block.vtx.size() - 1))
@@ -254,14 +313,11 @@ namespace TAO
 
                         else
                         {
-                            /* Get the transaction hash */
-                            uint512_t hash = tx.GetHash();
-
                             /* Accept into memory pool. */
-                            if(!LLD::Ledger->HasTx(tx.GetHash()))
+                            if(!LLD::Ledger->HasTx(hash))
                                 mempool.AddUnchecked(tx);
 
-                            vtx.push_back(std::make_pair(block.vtx[n].first, tx.GetHash()));
+                            vtx.push_back(std::make_pair(block.vtx[n].first, hash));
                         }
 
                         break;
@@ -365,6 +421,8 @@ namespace TAO
         /* Checks if a block is valid if not connected to chain. */
         bool TritiumBlock::Check() const
         {
+            trace::Span span("TritiumBlock::Check", "ledger");
+
             /* Read ledger DB for duplicate block. */
             if(LLD::Ledger->HasBlock(GetHash()))
                 return false;//debug::error(FUNCTION, "already have block ", GetHash().SubString());
@@ -625,8 +683,8 @@ namespace TAO
                     if(mapLast.count(tx.hashGenesis) && tx.hashPrevTx != mapLast[tx.hashGenesis])
                         return debug::error(FUNCTION, "transaction in sigchain out of sequence");
 
-                    /* Set the last hash for given genesis. */
-                    mapLast[tx.hashGenesis] = tx.GetHash();
+                    /* Set the last hash for given genesis, the transaction was read by its hash. */
+                    mapLast[tx.hashGenesis] = vtx[i].second;
                 }
                 else
                     return debug::error(FUNCTION, "unknown transaction type");
@@ -687,6 +745,8 @@ namespace TAO
             /* Verify producer signature(s) (if not synchronizing) */
             if(!TAO::Ledger::ChainState::Synchronizing())
             {
+                trace::Span span("TritiumBlock::VerifySignature", "ledger");
+
                 TAO::Ledger::Transaction txProducer;
 
                 if(nVersion < 9)
@@ -741,6 +801,8 @@ namespace TAO
         /** Accept a tritium block. **/
         bool TritiumBlock::Accept() const
         {
+            trace::Span span("TritiumBlock::Accept", "ledger");
+
             /* Read ledger DB for previous block. */
             TAO::Ledger::BlockState statePrev;
             if(!LLD::Ledger->ReadBlock(hashPrevBlock, statePrev))
@@ -163,6 +163,9 @@ namespace TAO
             nTrust = 0;
             nBlockAge = 0;
 
+            /* Get the genesis of the staking sigchain. */
+            const uint256_t hashGenesis = user->Genesis();
+
             /* Get the appropriate producer transaction to build the coinstake */
             TAO::Ledger::Transaction txProducer;
             if(block.nVersion < 9)
@@ -179,14 +182,14 @@ namespace TAO
 
                 /* Get the previous stake tx for the trust account. */
                 uint512_t hashLast;
-                if(!FindLastStake(user->Genesis(), hashLast))
+                if(!FindLastStake(hashGenesis, hashLast))
                 {
                     nSleepTime = 5000;
                     return debug::error(FUNCTION, "Failed to get last stake for trust account");
                 }
 
                 /* Find a stake change request. */
-                if(!FindStakeChange(user->Genesis(), hashLast))
+                if(!FindStakeChange(hashGenesis, hashLast))
                 {
                     /* Failed to retrieve stake change request. Process with no request. */
                     fStakeChange = false;
@@ -256,11 +259,11 @@ namespace TAO
 
                 /* Pending stake change request not allowed while staking Genesis */
                 fStakeChange = false;
-                if(LLD::Local->ReadStakeChange(user->Genesis(), stakeChange))
+                if(LLD::Local->ReadStakeChange(hashGenesis, stakeChange))
                 {
                     debug::log(0, FUNCTION, "Stake change request not allowed for trust account Genesis...removing");
 
-                    if(!LLD::Local->EraseStakeChange(user->Genesis()))
+                    if(!LLD::Local->EraseStakeChange(hashGenesis))
                         debug::error(FUNCTION, "Failed to remove stake change request");
                 }
 
@@ -464,7 +467,7 @@ namespace TAO
                 SecureString strPIN = session.GetActivePIN()->PIN();
 
                 /* Retrieve the latest trust account data */
-                if(!pTritiumMinter->FindTrustAccount(session.GetAccount()->Genesis()))
+                if(!pTritiumMinter->FindTrustAccount(session.Genesis()))
                     break;
 
                 /* Set up the candidate block the minter is attempting to mine */
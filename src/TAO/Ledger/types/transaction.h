@@ -383,6 +383,17 @@ namespace TAO
             uint512_t GetHash() const;
 
 
+            /** GetHashes
+             *
+             *  Gets the hashes of a list of transactions, hashing them together in one batch.
+             *
+             *  @param[in] vtx The transactions to hash.
+             *  @param[out] vHashes The 512-bit hashes, in the same order as the transactions.
+             *
+             **/
+            static void GetHashes(const std::vector<Transaction>& vtx, std::vector<uint512_t> &vHashes);
+
+
             /** ProofHash
              *
              *  Gets a proof hash of the transaction object.
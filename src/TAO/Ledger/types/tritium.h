@@ -142,6 +142,31 @@ namespace TAO
             TritiumBlock(const SyncBlock& block);
 
 
+            /** Copy Constructor.
+             *
+             *  Build from a sync block whose tritium transactions were already deserialized and hashed by Prepare.
+             *
+             *  @param[in] block The sync block received.
+             *  @param[in] vTritium The tritium transactions of the sync block in order.
+             *  @param[in] vTritiumHashes The hashes of vTritium.
+             *
+             **/
+            TritiumBlock(const SyncBlock& block, const std::vector<Transaction>& vTritium, const std::vector<uint512_t>& vTritiumHashes);
+
+
+            /** Prepare
+             *
+             *  Deserialize and hash the tritium transactions of a sync block. This reads no shared state, so it
+             *  can run ahead of the block being built on the processing thread.
+             *
+             *  @param[in] block The sync block received.
+             *  @param[out] vTritium The tritium transactions of the sync block in order.
+             *  @param[out] vTritiumHashes The hashes of vTritium.
+             *
+             **/
+            static void Prepare(const SyncBlock& block, std::vector<Transaction>& vTritium, std::vector<uint512_t>& vTritiumHashes);
+
+
 
             /** Clone
              *
@@ -244,6 +269,20 @@ namespace TAO
             std::string ToString() const override;
 
 
+        private:
+
+            /** build
+             *
+             *  Fill the block from a sync block and its prepared tritium transactions, accepting the
+             *  transactions into the memory pool.
+             *
+             *  @param[in] block The sync block received.
+             *  @param[in] vTritium The tritium transactions of the sync block in order.
+             *  @param[in] vTritiumHashes The hashes of vTritium.
+             *
+             **/
+            void build(const SyncBlock& block, const std::vector<Transaction>& vTritium, const std::vector<uint512_t>& vTritiumHashes);
+
         };
     }
 }
@@ -16,6 +16,8 @@ ________________________________________________________________________________
 #include <TAO/Operation/include/enum.h>
 #include <TAO/Operation/types/contract.h>
 
+#include <TAO/Register/types/address.h>
+
 #include <TAO/Ledger/types/transaction.h>
 #include <TAO/Ledger/include/timelocks.h>
 
@@ -477,6 +479,72 @@ namespace TAO
         }
 
 
+        /* Get the address of the register the contract operates on. */
+        bool Contract::Address(uint256_t &hashAddress) const
+        {
+            /* Reset value. */
+            hashAddress = 0;
+
+            /* Reset the contract to the position of the primitive. */
+            SeekToPrimitive();
+
+            /* Get the operation code.*/
+            uint8_t nOP = 0;
+            ssOperation >> nOP;
+
+            /* Switch for the register operations. */
+            switch(nOP)
+            {
+                /* Check for operations that start with the address. */
+                case OP::WRITE:
+                case OP::APPEND:
+                case OP::CREATE:
+                case OP::TRANSFER:
+                case OP::DEBIT:
+                case OP::FEE:
+                case OP::LEGACY:
+                {
+                    ssOperation >> hashAddress;
+
+                    break;
+                }
+
+                /* Check for operations that start with their dependant. */
+                case OP::CLAIM:
+                case OP::CREDIT:
+                {
+                    /* Skip over the txid and contract-id. */
+                    uint512_t hashPrev = 0;
+                    ssOperation >> hashPrev;
+
+                    uint32_t nContract = 0;
+                    ssOperation >> nContract;
+
+                    ssOperation >> hashAddress;
+
+                    break;
+                }
+
+                /* Check for trust operations. */
+                case OP::TRUST:
+                case OP::GENESIS:
+                case OP::TRUSTPOOL:
+                case OP::GENESISPOOL:
+                case OP::MIGRATE:
+                {
+                    hashAddress = TAO::Register::Address(std::string("trust"), hashCaller, TAO::Register::Address::TRUST);
+
+                    break;
+                }
+            }
+
+            /* Reset before return. */
+            ssOperation.seek(0, STREAM::BEGIN);
+
+            return (hashAddress != 0);
+        }
+
+
         /* Get the legacy converted output of the contract if valid */
         bool Contract::Legacy(Legacy::TxOut& txout) const
         {
@@ -239,6 +239,19 @@ namespace TAO
             bool Dependant(uint512_t &hashPrev, uint32_t &nContract) const;
 
 
+            /** Address
+             *
+             *  Get the address of the register the contract operates on. Trust operations
+             *  don't include one, so the caller's trust account is returned for them.
+             *
+             *  @param[out] hashAddress The register address.
+             *
+             *  @return True if the contract operates on a register.
+             *
+             **/
+            bool Address(uint256_t &hashAddress) const;
+
+
             /** Legacy
              *
              *  Get the legacy converted output of the contract if valid
@@ -17,6 +17,7 @@ ________________________________________________________________________________
 #include <Util/include/config.h>
 #include <Util/include/convert.h>
 #include <Util/include/filesystem.h>
+#include <Util/include/logger.h>
 #include <Util/include/mutex.h>
 #include <Util/include/runtime.h>
 #include <Util/include/version.h>
@@ -97,12 +98,19 @@ namespace debug
         /* Get the debug logging configuration parameters (or default if none specified) */
         nLogFiles  = config::GetArg("-logfiles", 20);
         nLogSizeMB = config::GetArg("-logsizeMB", 5);
+
+        /* Start the asynchronous logger if enabled. Policy is either block (default) or drop when the buffer is full. */
+        if(config::GetBoolArg("-logasync", false))
+            LOGGER.Start(config::GetArg("-logbuffer", 8192), config::GetArg("-logpolicy", "block") != "drop");
     }
 
 
     /*  Close the debug log file. */
     void Shutdown()
     {
+        /* Drain any queued messages before the file is closed. */
+        LOGGER.Stop();
+
         LOCK(DEBUG_MUTEX);
 
         if(ssFile.is_open())
@@ -235,18 +243,8 @@ namespace debug
      *  Encapsulated log for improved compile time. Not thread safe. */
     void log_(time_t &timestamp, std::string &debug_str)
     {
-        /* Build the timestamp */
-        std::string time_str = safe_printstr(
-            "[",
-            std::put_time(std::localtime(&timestamp), "%H:%M:%S"),
-            ".",
-            std::setfill('0'),
-            std::setw(3),
-            (runtime::timestamp(true) % 1000),
-            "] ");
-
         /* Get the final timestamped debug string. */
-        std::string final_str = time_str + debug_str;
+        std::string final_str = time_prefix(timestamp, runtime::timestamp(true) % 1000) + debug_str;
 
         /* Dump it to the console. */
         std::cout << final_str << std::endl;
@@ -260,6 +258,20 @@ namespace debug
     }
 
 
+    /*  Builds the timestamp prefix for a log line. Not thread safe. */
+    std::string time_prefix(const time_t timestamp, const uint64_t nMilliseconds)
+    {
+        return safe_printstr(
+            "[",
+            std::put_time(std::localtime(&timestamp), "%H:%M:%S"),
+            ".",
+            std::setfill('0'),
+            std::setw(3),
+            nMilliseconds,
+            "] ");
+    }
+
+
     /* Gets the last error string logged via debug::error and clears the last error */
     std::string GetLastError()
     {
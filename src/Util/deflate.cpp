@@ -0,0 +1,85 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <Util/include/deflate.h>
+
+#include <zlib.h>
+
+namespace encoding
+{
+
+    /* Compress data with zlib, in either gzip or zlib (HTTP deflate) format. */
+    bool Deflate(const std::string& strData, std::string &strCompressed, const bool fGzip, const int32_t nLevel)
+    {
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree  = Z_NULL;
+        stream.opaque = Z_NULL;
+
+        /* Window bits of 15 + 16 writes the gzip header instead of the zlib header. */
+        if(deflateInit2(&stream, nLevel, Z_DEFLATED, fGzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return false;
+
+        /* Size the output for the worst case so it is done in one pass. */
+        strCompressed.resize(deflateBound(&stream, static_cast<uLong>(strData.size())) + (fGzip ? 18 : 0));
+
+        stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(strData.data()));
+        stream.avail_in  = static_cast<uInt>(strData.size());
+        stream.next_out  = reinterpret_cast<Bytef*>(&strCompressed[0]);
+        stream.avail_out = static_cast<uInt>(strCompressed.size());
+
+        const int32_t nStatus = deflate(&stream, Z_FINISH);
+        strCompressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        return nStatus == Z_STREAM_END;
+    }
+
+
+    /* Decompress data in either gzip or zlib format. */
+    bool Inflate(const std::string& strCompressed, std::string &strData)
+    {
+        z_stream stream;
+        stream.zalloc   = Z_NULL;
+        stream.zfree    = Z_NULL;
+        stream.opaque   = Z_NULL;
+        stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(strCompressed.data()));
+        stream.avail_in = static_cast<uInt>(strCompressed.size());
+
+        /* Window bits of 15 + 32 detects the gzip or zlib header. */
+        if(inflateInit2(&stream, 15 + 32) != Z_OK)
+            return false;
+
+        /* Inflate in blocks until the end of the stream. */
+        strData.clear();
+
+        char chBuffer[16384];
+        int32_t nStatus = Z_OK;
+        while(nStatus == Z_OK)
+        {
+            stream.next_out  = reinterpret_cast<Bytef*>(chBuffer);
+            stream.avail_out = sizeof(chBuffer);
+
+            nStatus = inflate(&stream, Z_NO_FLUSH);
+            if(nStatus != Z_OK && nStatus != Z_STREAM_END)
+                break;
+
+            strData.append(chBuffer, sizeof(chBuffer) - stream.avail_out);
+        }
+        inflateEnd(&stream);
+
+        return nStatus == Z_STREAM_END;
+    }
+
+}
@@ -190,6 +190,32 @@ namespace debug
      void log_(time_t &timestamp, std::string &debug_str);
 
 
+    /** log_async
+     *
+     *  Queues log output on the asynchronous logger if -logasync is enabled.
+     *  Encapsulated log for improved compile time.
+     *
+     *  @param[in] debug_str The message to queue. Moved from on success.
+     *
+     *  @return True if the message was handled by the asynchronous logger.
+     *
+     **/
+     bool log_async(std::string &debug_str);
+
+
+    /** time_prefix
+     *
+     *  Builds the timestamp prefix for a log line. Not thread safe.
+     *
+     *  @param[in] timestamp The UNIX timestamp in seconds.
+     *  @param[in] nMilliseconds The milliseconds within the second.
+     *
+     *  @return The formatted timestamp prefix.
+     *
+     **/
+     std::string time_prefix(const time_t timestamp, const uint64_t nMilliseconds);
+
+
     /** log
      *
      *  Safe constant format debugging logs.
@@ -206,12 +232,16 @@ namespace debug
         if(config::nVerbose < nLevel)
             return;
 
-        /* Lock the mutex. */
-        LOCK(DEBUG_MUTEX);
-
         /* Get the debug string and log file. */
         std::string debug = safe_printstr(args...);
 
+        /* Hand off to the asynchronous logger if it is running. */
+        if(log_async(debug))
+            return;
+
+        /* Lock the mutex. */
+        LOCK(DEBUG_MUTEX);
+
         /* Get the timestamp. */
         time_t timestamp = std::time(nullptr);
 
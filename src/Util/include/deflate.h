@@ -0,0 +1,53 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#pragma once
+#ifndef NEXUS_UTIL_INCLUDE_DEFLATE_H
+#define NEXUS_UTIL_INCLUDE_DEFLATE_H
+
+#include <cstdint>
+#include <string>
+
+namespace encoding
+{
+
+    /** Deflate
+     *
+     *  Compress data with zlib, in either gzip or zlib (HTTP deflate) format.
+     *
+     *  @param[in] strData The data to compress.
+     *  @param[out] strCompressed The compressed data.
+     *  @param[in] fGzip True for the gzip format, false for the zlib format.
+     *  @param[in] nLevel The compression level from 1 to 9, -1 for the zlib default.
+     *
+     *  @return True if the data was compressed.
+     *
+     **/
+    bool Deflate(const std::string& strData, std::string &strCompressed, const bool fGzip, const int32_t nLevel = -1);
+
+
+    /** Inflate
+     *
+     *  Decompress data in either gzip or zlib format.
+     *
+     *  @param[in] strCompressed The compressed data.
+     *  @param[out] strData The decompressed data.
+     *
+     *  @return True if the data was decompressed.
+     *
+     **/
+    bool Inflate(const std::string& strCompressed, std::string &strData);
+
+}
+#endif
@@ -0,0 +1,233 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_UTIL_INCLUDE_JSON_WRITER_H
+#define NEXUS_UTIL_INCLUDE_JSON_WRITER_H
+
+#include <Util/include/json.h>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace json
+{
+
+    /** @class writer
+     *
+     *  Streaming JSON serializer that appends directly into an output string (such as
+     *  an HTTP response body) without building a json::json tree first. The output is
+     *  byte for byte identical to json::json::dump() of the equivalent tree, so the
+     *  streaming and tree paths can be mixed freely.
+     *
+     *  Commas and key separators are tracked internally, so callers only need to
+     *  open and close containers, write keys, and write values.
+     *
+     **/
+    class writer
+    {
+        /** The output buffer being appended to. **/
+        std::string& strBuffer;
+
+
+        /** Serializer used for numbers and nested json::json values. **/
+        detail::serializer<json> serializer;
+
+
+        /** Stack of flags for each open container, true until the first element is written. **/
+        std::vector<bool> vFirst;
+
+
+        /** Flag set when a key was just written, so the next value needs no separator. **/
+        bool fKey;
+
+
+    public:
+
+        /** Constructor
+         *
+         *  @param[out] strBufferIn The buffer to append output to.
+         *
+         **/
+        writer(std::string& strBufferIn);
+
+
+        /** Deleted copy constructor, the serializer holds a reference to the buffer. **/
+        writer(const writer&) = delete;
+
+
+        /** Deleted copy assignment. **/
+        writer& operator=(const writer&) = delete;
+
+
+        /** BeginObject
+         *
+         *  Open a JSON object.
+         *
+         **/
+        void BeginObject();
+
+
+        /** EndObject
+         *
+         *  Close the current JSON object.
+         *
+         **/
+        void EndObject();
+
+
+        /** BeginArray
+         *
+         *  Open a JSON array.
+         *
+         **/
+        void BeginArray();
+
+
+        /** EndArray
+         *
+         *  Close the current JSON array.
+         *
+         **/
+        void EndArray();
+
+
+        /** Key
+         *
+         *  Write an object key. Must be followed by a value or a container.
+         *
+         *  @param[in] strKey The key to write.
+         *
+         **/
+        void Key(const std::string& strKey);
+
+
+        /** Null
+         *
+         *  Write a null value.
+         *
+         **/
+        void Null();
+
+
+        /** Value
+         *
+         *  Write a string value.
+         *
+         *  @param[in] strValue The string to write.
+         *
+         **/
+        void Value(const std::string& strValue);
+
+
+        /** Value
+         *
+         *  Write a string value from a C string.
+         *
+         *  @param[in] pszValue The string to write.
+         *
+         **/
+        void Value(const char* pszValue);
+
+
+        /** Value
+         *
+         *  Write a boolean value.
+         *
+         *  @param[in] fValue The boolean to write.
+         *
+         **/
+        void Value(const bool fValue);
+
+
+        /** Value
+         *
+         *  Write a floating point value.
+         *
+         *  @param[in] dValue The number to write.
+         *
+         **/
+        void Value(const double dValue);
+
+
+        /** Value
+         *
+         *  Write an already built json value (used for small per-item subtrees).
+         *
+         *  @param[in] jsonValue The value to write.
+         *
+         **/
+        void Value(const json& jsonValue);
+
+
+        /** Value
+         *
+         *  Write an integral value.
+         *
+         *  @param[in] nValue The number to write.
+         *
+         **/
+        template<typename Type>
+        typename std::enable_if<std::is_integral<Type>::value && !std::is_same<Type, bool>::value>::type
+        Value(const Type nValue)
+        {
+            separator();
+
+            if(std::is_signed<Type>::value)
+                serializer.dump(json(static_cast<int64_t>(nValue)), false, false, 0);
+            else
+                serializer.dump(json(static_cast<uint64_t>(nValue)), false, false, 0);
+        }
+
+
+        /** Field
+         *
+         *  Write a key and value pair.
+         *
+         *  @param[in] strKey The key to write.
+         *  @param[in] value The value to write.
+         *
+         **/
+        template<typename Type>
+        void Field(const std::string& strKey, const Type& value)
+        {
+            Key(strKey);
+            Value(value);
+        }
+
+
+    private:
+
+        /** separator
+         *
+         *  Write the comma before an element if it is not the first in its container.
+         *
+         **/
+        void separator();
+
+
+        /** escape
+         *
+         *  Write a quoted and escaped string.
+         *
+         *  @param[in] pszValue The string data.
+         *  @param[in] nSize The length of the string data.
+         *
+         **/
+        void escape(const char* pszValue, const uint64_t nSize);
+    };
+}
+
+#endif
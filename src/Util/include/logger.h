@@ -0,0 +1,253 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_UTIL_INCLUDE_LOGGER_H
+#define NEXUS_UTIL_INCLUDE_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace debug
+{
+
+    /** @class AsyncLogger
+     *
+     *  Asynchronous backend for debug::log. Producers claim a slot in a bounded
+     *  multi-producer, single-consumer ring buffer without taking a lock, and a
+     *  single writer thread drains the buffer in batches. It writes each batch to
+     *  the console and to the debug file with a single flush, then runs the
+     *  normal archive rotation.
+     *
+     *  When the buffer is full, producers either wait for free space (block) or
+     *  discard the message (drop). The writer logs a running count of dropped
+     *  messages.
+     *
+     **/
+    class AsyncLogger
+    {
+        /** Slot
+         *
+         *  A single ring buffer cell. The sequence number tells producers and the
+         *  consumer who currently owns the cell.
+         *
+         **/
+        struct Slot
+        {
+            /** Sequence number for ownership of this cell. **/
+            std::atomic<uint64_t> nSequence;
+
+            /** Time the message was produced (in milliseconds). **/
+            uint64_t nTimestamp;
+
+            /** The formatted message without timestamp. **/
+            std::string strMessage;
+        };
+
+
+        /** The ring buffer cells. **/
+        std::vector<Slot> vSlots;
+
+
+        /** Mask for wrapping positions into the buffer (capacity - 1). **/
+        uint64_t nMask;
+
+
+        /** Next position producers will claim. **/
+        alignas(64) std::atomic<uint64_t> nHead;
+
+
+        /** Next position the writer will consume. **/
+        alignas(64) std::atomic<uint64_t> nTail;
+
+
+        /** Total messages dropped due to a full buffer. **/
+        std::atomic<uint64_t> nDropped;
+
+
+        /** Total messages written by the writer thread. **/
+        std::atomic<uint64_t> nWritten;
+
+
+        /** Number of producers currently inside Push. **/
+        std::atomic<uint32_t> nProducers;
+
+
+        /** Number of producers waiting on a full buffer. **/
+        std::atomic<uint32_t> nWaiting;
+
+
+        /** Dropped count at the last time the writer reported it. **/
+        uint64_t nDroppedReported;
+
+
+        /** Flag to determine if producers wait on a full buffer. **/
+        std::atomic<bool> fBlock;
+
+
+        /** Flag to determine if the writer thread is accepting messages. **/
+        std::atomic<bool> fRunning;
+
+
+        /** Flag to signal the writer thread to drain and exit. **/
+        std::atomic<bool> fShutdown;
+
+
+        /** Mutex for the writer and space conditions. **/
+        std::mutex WRITER_MUTEX;
+
+
+        /** Condition to wake the writer thread. **/
+        std::condition_variable WRITER_CONDITION;
+
+
+        /** Condition to wake producers waiting for a free cell. **/
+        std::condition_variable SPACE_CONDITION;
+
+
+        /** The writer thread. **/
+        std::thread WRITER_THREAD;
+
+
+    public:
+
+        /** Default Constructor. **/
+        AsyncLogger();
+
+
+        /** Default Destructor. **/
+        ~AsyncLogger();
+
+
+        /** Start
+         *
+         *  Allocate the ring buffer and start the writer thread.
+         *
+         *  @param[in] nCapacity The number of slots (rounded up to a power of two).
+         *  @param[in] fBlockIn True to wait on a full buffer, false to drop.
+         *
+         **/
+        void Start(const uint32_t nCapacity, const bool fBlockIn);
+
+
+        /** Stop
+         *
+         *  Stop accepting messages, drain the buffer, and join the writer thread.
+         *
+         **/
+        void Stop();
+
+
+        /** Running
+         *
+         *  Returns true if the writer thread is accepting messages.
+         *
+         **/
+        bool Running() const;
+
+
+        /** Push
+         *
+         *  Queue a message for the writer thread.
+         *
+         *  @param[in] strMessage The message to queue. Moved from on success.
+         *
+         *  @return True if the message was queued or dropped by policy. False if the
+         *          logger is not running and the caller should write synchronously.
+         *
+         **/
+        bool Push(std::string& strMessage);
+
+
+        /** Dropped
+         *
+         *  Returns the total number of messages dropped by policy.
+         *
+         **/
+        uint64_t Dropped() const;
+
+
+        /** Written
+         *
+         *  Returns the total number of messages written by the writer thread.
+         *
+         **/
+        uint64_t Written() const;
+
+
+    private:
+
+        /** push
+         *
+         *  Claim a cell and publish the message into it. Called by Push while it is
+         *  counted in nProducers.
+         *
+         *  @param[in] strMessage The message to queue. Moved from on success.
+         *
+         *  @return Same as Push.
+         *
+         **/
+        bool push(std::string& strMessage);
+
+
+        /** pop
+         *
+         *  Take the next message off the buffer (single consumer only).
+         *
+         *  @param[out] nTimestamp The time the message was produced.
+         *  @param[out] strMessage The message.
+         *
+         *  @return True if a message was available.
+         *
+         **/
+        bool pop(uint64_t &nTimestamp, std::string &strMessage);
+
+
+        /** ready
+         *
+         *  Returns true if the next slot for the writer has been published.
+         *
+         **/
+        bool ready() const;
+
+
+        /** drain
+         *
+         *  Write out everything currently in the buffer in batches.
+         *
+         *  @return The number of messages written.
+         *
+         **/
+        uint64_t drain();
+
+
+        /** Thread
+         *
+         *  Writer thread that sleeps until woken or until the flush interval elapses.
+         *  On shutdown it keeps draining until every claimed cell has been published.
+         *
+         **/
+        void Thread();
+    };
+
+
+    /** Global asynchronous logger, started by debug::Initialize when -logasync is set. **/
+    extern AsyncLogger LOGGER;
+}
+
+#endif
@@ -691,6 +691,119 @@ namespace memory
     };
 
 
+    /* Forward declaration. */
+    template<class TypeName>
+    class encrypted_ptr;
+
+
+    /** decrypted_view
+     *
+     *  Holds an encrypted_ptr decrypted and locked for the scope of this object.
+     *  Any member access through the view, or through the encrypted_ptr itself on
+     *  the same thread, skips the decrypt and encrypt passes until the view is
+     *  destroyed. Keep the scope short, since other threads block on the pointer
+     *  while the view is alive.
+     *
+     **/
+    template<class TypeName>
+    class decrypted_view
+    {
+        /** Reference of the mutex. **/
+        std::recursive_mutex& MUTEX;
+
+        /** The pointer being locked. **/
+        TypeName* data;
+
+        /** The reference count to ensure it knows when to re-encrypt the memory. */
+        std::atomic<uint32_t>& nRefs;
+
+    public:
+
+        /** Basic constructor
+         *
+         *  Lock and decrypt the pointer for the scope of this view.
+         *
+         *  @param[in] pointer The encrypted pointer to unlock.
+         *
+         **/
+        explicit decrypted_view(const encrypted_ptr<TypeName>& pointer)
+        : MUTEX(pointer.MUTEX)
+        , data(nullptr)
+        , nRefs(pointer.nRefs)
+        {
+            /* Lock the mutex. */
+            MUTEX.lock();
+
+            /* Read the pointer under lock. */
+            data = pointer.data;
+
+            /* Decrypt memory on first reference. */
+            if(nRefs == 0 && data != nullptr)
+                data->Encrypt();
+
+            /* Increment the reference count. */
+            ++nRefs;
+        }
+
+
+        /** Copy Constructor. **/
+        decrypted_view(const decrypted_view<TypeName>& view) = delete;
+
+
+        /** Copy Assignment operator. **/
+        decrypted_view& operator=(const decrypted_view<TypeName>& view) = delete;
+
+
+        /** Destructor
+        *
+        *  Encrypt memory again and unlock the mutex.
+        *
+        **/
+        ~decrypted_view()
+        {
+            /* Decrement the ref count. */
+            --nRefs;
+
+            /* Encrypt memory again when ref count is 0. */
+            if(nRefs == 0 && data != nullptr)
+                data->Encrypt();
+
+            /* Unlock the mutex. */
+            MUTEX.unlock();
+        }
+
+
+        /** Member Access Operator.
+        *
+        *  Access the memory of the raw pointer.
+        *
+        **/
+        TypeName* operator->() const
+        {
+            /* Stop member access if poitner is null. */
+            if(data == nullptr)
+                throw std::runtime_error(debug::safe_printstr(FUNCTION, "member access to nullptr"));
+
+            return data;
+        }
+
+
+        /** Dereference operator.
+        *
+        *  Access the decrypted object.
+        *
+        **/
+        TypeName& operator*() const
+        {
+            /* Stop member access if poitner is null. */
+            if(data == nullptr)
+                throw std::runtime_error(debug::safe_printstr(FUNCTION, "dereferencing a nullptr"));
+
+            return *data;
+        }
+    };
+
+
     /** encrypted_ptr
      *
      *  Protects a pointer with a mutex.
@@ -710,6 +823,10 @@ namespace memory
         /** Reference count for decrypted_proxy. **/
         mutable std::atomic<uint32_t> nRefs;
 
+
+        /** Views lock and decrypt the pointer directly. **/
+        friend class decrypted_view<TypeName>;
+
     public:
 
         /** Default Constructor. **/
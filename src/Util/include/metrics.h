@@ -0,0 +1,370 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#pragma once
+#ifndef NEXUS_UTIL_INCLUDE_METRICS_H
+#define NEXUS_UTIL_INCLUDE_METRICS_H
+
+#include <Util/include/runtime.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace metrics
+{
+
+    /** The maximum number of metrics in the registry. **/
+    const uint32_t MAX_METRICS = 4096;
+
+
+    /** The number of histogram buckets, including the +Inf bucket. **/
+    const uint32_t HISTOGRAM_BUCKETS = 20;
+
+
+    /** The upper bounds of the histogram buckets in microseconds. **/
+    extern const uint64_t BUCKET_BOUNDS[HISTOGRAM_BUCKETS - 1];
+
+
+    /** The types of metrics in the registry. **/
+    namespace TYPE
+    {
+        enum
+        {
+            COUNTER   = 0,
+            GAUGE     = 1,
+            HISTOGRAM = 2,
+        };
+    }
+
+
+    /** Counter
+     *
+     *  Monotonic counter that is safe to increment from any thread.
+     *
+     **/
+    class Counter
+    {
+        std::atomic<uint64_t> nValue;
+
+    public:
+
+        Counter()
+        : nValue(0)
+        {
+        }
+
+
+        /** Add
+         *
+         *  Add to the counter.
+         *
+         *  @param[in] nAmount The amount to add.
+         *
+         **/
+        void Add(const uint64_t nAmount = 1)
+        {
+            nValue.fetch_add(nAmount, std::memory_order_relaxed);
+        }
+
+
+        /** Get
+         *
+         *  Get the current value of the counter.
+         *
+         **/
+        uint64_t Get() const
+        {
+            return nValue.load(std::memory_order_relaxed);
+        }
+    };
+
+
+    /** Gauge
+     *
+     *  Value that can go up and down, safe to update from any thread.
+     *
+     **/
+    class Gauge
+    {
+        std::atomic<int64_t> nValue;
+
+    public:
+
+        Gauge()
+        : nValue(0)
+        {
+        }
+
+
+        /** Set
+         *
+         *  Set the gauge to a new value.
+         *
+         *  @param[in] nValueIn The value to set.
+         *
+         **/
+        void Set(const int64_t nValueIn)
+        {
+            nValue.store(nValueIn, std::memory_order_relaxed);
+        }
+
+
+        /** Add
+         *
+         *  Add to or subtract from the gauge.
+         *
+         *  @param[in] nAmount The amount to add, negative to subtract.
+         *
+         **/
+        void Add(const int64_t nAmount)
+        {
+            nValue.fetch_add(nAmount, std::memory_order_relaxed);
+        }
+
+
+        /** Get
+         *
+         *  Get the current value of the gauge.
+         *
+         **/
+        int64_t Get() const
+        {
+            return nValue.load(std::memory_order_relaxed);
+        }
+    };
+
+
+    /** Histogram
+     *
+     *  Latency histogram with fixed exponential buckets from 10us to 10s.
+     *
+     **/
+    class Histogram
+    {
+        std::atomic<uint64_t> nBuckets[HISTOGRAM_BUCKETS];
+        std::atomic<uint64_t> nCount;
+        std::atomic<uint64_t> nSum;
+
+    public:
+
+        Histogram();
+
+
+        /** Observe
+         *
+         *  Record a latency in its bucket.
+         *
+         *  @param[in] nMicroseconds The latency in microseconds.
+         *
+         **/
+        void Observe(const uint64_t nMicroseconds);
+
+
+        /** Bucket
+         *
+         *  Get the number of observations in a bucket, not cumulative.
+         *
+         *  @param[in] nBucket The index of the bucket.
+         *
+         **/
+        uint64_t Bucket(const uint32_t nBucket) const
+        {
+            return nBuckets[nBucket].load(std::memory_order_relaxed);
+        }
+
+
+        /** Count
+         *
+         *  Get the total number of observations.
+         *
+         **/
+        uint64_t Count() const
+        {
+            return nCount.load(std::memory_order_relaxed);
+        }
+
+
+        /** Sum
+         *
+         *  Get the sum of all observations in microseconds.
+         *
+         **/
+        uint64_t Sum() const
+        {
+            return nSum.load(std::memory_order_relaxed);
+        }
+
+
+        /** Quantile
+         *
+         *  Estimate a quantile as the upper bound of the bucket it falls in.
+         *
+         *  @param[in] dQuantile The quantile between 0 and 1.
+         *
+         *  @return The estimate in microseconds, capped at the largest finite bound.
+         *
+         **/
+        uint64_t Quantile(const double dQuantile) const;
+    };
+
+
+    /** Metric
+     *
+     *  One entry in the registry, identified by its name and labels.
+     *
+     **/
+    struct Metric
+    {
+        /** The metric name. **/
+        const std::string strName;
+
+
+        /** The labels in the Prometheus form of key="value" pairs. **/
+        const std::string strLabels;
+
+
+        /** The type of the metric. **/
+        const uint8_t nType;
+
+
+        /** The value holders, only the one matching the type is used. **/
+        Counter   counter;
+        Gauge     gauge;
+        Histogram histogram;
+
+
+        /** Callback to read a gauge on export instead of storing it. **/
+        const std::function<int64_t()> fnValue;
+
+
+        Metric(const std::string& strNameIn, const std::string& strLabelsIn, const uint8_t nTypeIn,
+               const std::function<int64_t()>& fnValueIn = nullptr);
+
+
+        /** Value
+         *
+         *  Get the value of a counter or gauge.
+         *
+         **/
+        int64_t Value() const;
+    };
+
+
+    /** Timer
+     *
+     *  Records the time from construction to destruction into a histogram.
+     *
+     **/
+    class Timer
+    {
+        Histogram& histogram;
+        runtime::timer timer;
+
+    public:
+
+        Timer(Histogram& histogramIn)
+        : histogram(histogramIn)
+        , timer()
+        {
+            timer.Start();
+        }
+
+
+        ~Timer()
+        {
+            histogram.Observe(timer.ElapsedMicroseconds());
+        }
+    };
+
+
+    /** Label
+     *
+     *  Build a label pair, escaping the value for the Prometheus format.
+     *
+     *  @param[in] strKey The label name.
+     *  @param[in] strValue The label value.
+     *
+     *  @return The label in the form key="value".
+     *
+     **/
+    std::string Label(const std::string& strKey, const std::string& strValue);
+
+
+    /** GetCounter
+     *
+     *  Find or register a counter. Lookups are lock-free, so callers on hot paths should keep
+     *  the returned reference, which stays valid for the lifetime of the process.
+     *
+     *  @param[in] strName The metric name.
+     *  @param[in] strLabels The labels of this instance.
+     *
+     **/
+    Counter& GetCounter(const std::string& strName, const std::string& strLabels = "");
+
+
+    /** GetGauge
+     *
+     *  Find or register a gauge.
+     *
+     *  @param[in] strName The metric name.
+     *  @param[in] strLabels The labels of this instance.
+     *
+     **/
+    Gauge& GetGauge(const std::string& strName, const std::string& strLabels = "");
+
+
+    /** GetHistogram
+     *
+     *  Find or register a latency histogram.
+     *
+     *  @param[in] strName The metric name.
+     *  @param[in] strLabels The labels of this instance.
+     *
+     **/
+    Histogram& GetHistogram(const std::string& strName, const std::string& strLabels = "");
+
+
+    /** RegisterCallback
+     *
+     *  Register a gauge that is read from a callback on export. The first registration of a
+     *  name and labels wins.
+     *
+     *  @param[in] strName The metric name.
+     *  @param[in] strLabels The labels of this instance.
+     *  @param[in] fnValue The callback returning the current value.
+     *
+     **/
+    void RegisterCallback(const std::string& strName, const std::string& strLabels, const std::function<int64_t()>& fnValue);
+
+
+    /** List
+     *
+     *  Get all registered metrics sorted by name and labels.
+     *
+     **/
+    std::vector<const Metric*> List();
+
+
+    /** Prometheus
+     *
+     *  Export all metrics in the Prometheus text exposition format.
+     *
+     **/
+    std::string Prometheus();
+
+}
+#endif
@@ -0,0 +1,148 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#pragma once
+#ifndef NEXUS_UTIL_INCLUDE_TRACE_H
+#define NEXUS_UTIL_INCLUDE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace trace
+{
+
+    /** The default number of spans kept per thread. **/
+    const uint32_t DEFAULT_BUFFER = 16384;
+
+
+    /** Flag to enable recording of spans, set by -trace. **/
+    extern std::atomic<bool> fEnabled;
+
+
+    /** Milliseconds a block can take to process before its spans are dumped, set by -traceslow. **/
+    extern std::atomic<uint64_t> nSlow;
+
+
+    /** Initialize
+     *
+     *  Read the -trace, -tracebuffer and -traceslow arguments, and start the thread that
+     *  dumps spans for slow blocks.
+     *
+     **/
+    void Initialize();
+
+
+    /** Shutdown
+     *
+     *  Write any queued dumps and stop the dump thread.
+     *
+     **/
+    void Shutdown();
+
+
+    /** Now
+     *
+     *  Get the microseconds elapsed since the tracer was loaded.
+     *
+     **/
+    uint64_t Now();
+
+
+    /** Record
+     *
+     *  Add a finished span to the buffer of the calling thread. Older spans are overwritten
+     *  once the buffer is full.
+     *
+     *  @param[in] pName The span name, must be a string literal.
+     *  @param[in] pCategory The span category, must be a string literal.
+     *  @param[in] nStart The start of the span in microseconds.
+     *  @param[in] nDuration The duration of the span in microseconds.
+     *
+     **/
+    void Record(const char* pName, const char* pCategory, const uint64_t nStart, const uint64_t nDuration);
+
+
+    /** Dump
+     *
+     *  Get all buffered spans in the Chrome trace_event JSON format.
+     *
+     *  @param[out] nEvents The number of spans written.
+     *
+     *  @return The JSON document, loadable in chrome://tracing or Perfetto.
+     *
+     **/
+    std::string Dump(uint64_t &nEvents);
+
+
+    /** Write
+     *
+     *  Write all buffered spans to a file in the Chrome trace_event JSON format.
+     *
+     *  @param[in] strPath The file to write.
+     *  @param[out] nEvents The number of spans written.
+     *
+     *  @return True if the file was written.
+     *
+     **/
+    bool Write(const std::string& strPath, uint64_t &nEvents);
+
+
+    /** WriteAsync
+     *
+     *  Queue all buffered spans to be written to a file by the dump thread, so the caller
+     *  doesn't wait on the file.
+     *
+     *  @param[in] strPath The file to write.
+     *
+     *  @return True if the dump was queued, false if the thread isn't running or is behind.
+     *
+     **/
+    bool WriteAsync(const std::string& strPath);
+
+
+    /** Span
+     *
+     *  Records the time from construction to destruction as a span, if tracing is enabled.
+     *
+     **/
+    class Span
+    {
+        const char* pName;
+        const char* pCategory;
+        uint64_t nStart;
+        const bool fActive;
+
+    public:
+
+        Span(const char* pNameIn, const char* pCategoryIn)
+        : pName(pNameIn)
+        , pCategory(pCategoryIn)
+        , nStart(0)
+        , fActive(fEnabled.load(std::memory_order_relaxed))
+        {
+            if(fActive)
+                nStart = Now();
+        }
+
+
+        ~Span()
+        {
+            if(fActive)
+                Record(pName, pCategory, nStart, Now() - nStart);
+        }
+    };
+
+}
+#endif
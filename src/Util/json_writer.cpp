@@ -0,0 +1,200 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/json_writer.h>
+
+#include <cstring>
+
+namespace json
+{
+
+    /* Constructor */
+    writer::writer(std::string& strBufferIn)
+    : strBuffer  (strBufferIn)
+    , serializer (detail::output_adapter<char>(strBufferIn), ' ')
+    , vFirst     ( )
+    , fKey       (false)
+    {
+    }
+
+
+    /* Open a JSON object. */
+    void writer::BeginObject()
+    {
+        separator();
+
+        strBuffer.push_back('{');
+        vFirst.push_back(true);
+    }
+
+
+    /* Close the current JSON object. */
+    void writer::EndObject()
+    {
+        strBuffer.push_back('}');
+        vFirst.pop_back();
+    }
+
+
+    /* Open a JSON array. */
+    void writer::BeginArray()
+    {
+        separator();
+
+        strBuffer.push_back('[');
+        vFirst.push_back(true);
+    }
+
+
+    /* Close the current JSON array. */
+    void writer::EndArray()
+    {
+        strBuffer.push_back(']');
+        vFirst.pop_back();
+    }
+
+
+    /* Write an object key. Must be followed by a value or a container. */
+    void writer::Key(const std::string& strKey)
+    {
+        separator();
+
+        escape(strKey.data(), strKey.size());
+        strBuffer.push_back(':');
+
+        fKey = true;
+    }
+
+
+    /* Write a null value. */
+    void writer::Null()
+    {
+        separator();
+
+        strBuffer.append("null", 4);
+    }
+
+
+    /* Write a string value. */
+    void writer::Value(const std::string& strValue)
+    {
+        separator();
+
+        escape(strValue.data(), strValue.size());
+    }
+
+
+    /* Write a string value from a C string. */
+    void writer::Value(const char* pszValue)
+    {
+        separator();
+
+        escape(pszValue, std::strlen(pszValue));
+    }
+
+
+    /* Write a boolean value. */
+    void writer::Value(const bool fValue)
+    {
+        separator();
+
+        if(fValue)
+            strBuffer.append("true", 4);
+        else
+            strBuffer.append("false", 5);
+    }
+
+
+    /* Write a floating point value. */
+    void writer::Value(const double dValue)
+    {
+        separator();
+
+        /* Use the tree serializer so float formatting matches dump() exactly. */
+        serializer.dump(json(dValue), false, false, 0);
+    }
+
+
+    /* Write an already built json value (used for small per-item subtrees). */
+    void writer::Value(const json& jsonValue)
+    {
+        separator();
+
+        serializer.dump(jsonValue, false, false, 0);
+    }
+
+
+    /* Write the comma before an element if it is not the first in its container. */
+    void writer::separator()
+    {
+        /* Values directly after a key take no separator. */
+        if(fKey)
+        {
+            fKey = false;
+            return;
+        }
+
+        /* Top level values take no separator. */
+        if(vFirst.empty())
+            return;
+
+        /* Only the first element in a container goes without a comma. */
+        if(vFirst.back())
+            vFirst.back() = false;
+        else
+            strBuffer.push_back(',');
+    }
+
+
+    /* Write a quoted and escaped string. */
+    void writer::escape(const char* pszValue, const uint64_t nSize)
+    {
+        static const char* HEX = "0123456789abcdef";
+
+        strBuffer.push_back('"');
+
+        /* Copy runs of characters that need no escaping in one append. */
+        uint64_t nStart = 0;
+        for(uint64_t n = 0; n < nSize; ++n)
+        {
+            const uint8_t nChar = static_cast<uint8_t>(pszValue[n]);
+            if(nChar > 0x1f && nChar != '"' && nChar != '\\')
+                continue;
+
+            strBuffer.append(pszValue + nStart, n - nStart);
+            nStart = n + 1;
+
+            /* Escape the same set of characters as json::json::dump(). */
+            switch(nChar)
+            {
+                case '"':  strBuffer.append("\\\"", 2); break;
+                case '\\': strBuffer.append("\\\\", 2); break;
+                case '\b': strBuffer.append("\\b",  2); break;
+                case '\f': strBuffer.append("\\f",  2); break;
+                case '\n': strBuffer.append("\\n",  2); break;
+                case '\r': strBuffer.append("\\r",  2); break;
+                case '\t': strBuffer.append("\\t",  2); break;
+
+                default:
+                {
+                    const char vchEscape[6] = { '\\', 'u', '0', '0', HEX[nChar >> 4], HEX[nChar & 0x0f] };
+                    strBuffer.append(vchEscape, 6);
+                    break;
+                }
+            }
+        }
+
+        strBuffer.append(pszValue + nStart, nSize - nStart);
+        strBuffer.push_back('"');
+    }
+}
@@ -0,0 +1,369 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/logger.h>
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace debug
+{
+    /* The maximum number of messages written per batch. */
+    const uint32_t MAX_BATCH_SIZE = 1024;
+
+    /* The time in milliseconds the writer sleeps between batches when not woken. */
+    const uint32_t FLUSH_INTERVAL = 10;
+
+
+    /* Global asynchronous logger. */
+    AsyncLogger LOGGER;
+
+
+    /* Default Constructor. */
+    AsyncLogger::AsyncLogger()
+    : vSlots            ( )
+    , nMask             (0)
+    , nHead             (0)
+    , nTail             (0)
+    , nDropped          (0)
+    , nWritten          (0)
+    , nProducers        (0)
+    , nWaiting          (0)
+    , nDroppedReported  (0)
+    , fBlock            (true)
+    , fRunning          (false)
+    , fShutdown         (false)
+    , WRITER_MUTEX      ( )
+    , WRITER_CONDITION  ( )
+    , SPACE_CONDITION   ( )
+    , WRITER_THREAD     ( )
+    {
+    }
+
+
+    /* Default Destructor. */
+    AsyncLogger::~AsyncLogger()
+    {
+        Stop();
+    }
+
+
+    /* Allocate the ring buffer and start the writer thread. */
+    void AsyncLogger::Start(const uint32_t nCapacity, const bool fBlockIn)
+    {
+        /* Don't start twice. */
+        if(fRunning.load() || WRITER_THREAD.joinable())
+            return;
+
+        /* Round the capacity up to a power of two so positions can be masked. */
+        uint64_t nSize = 2;
+        while(nSize < nCapacity)
+            nSize <<= 1;
+
+        /* Allocate the slots and give each one its initial sequence. */
+        std::vector<Slot> vNew(nSize);
+        for(uint64_t n = 0; n < nSize; ++n)
+            vNew[n].nSequence.store(n, std::memory_order_relaxed);
+
+        vSlots.swap(vNew);
+        nMask = nSize - 1;
+
+        /* Reset the state. */
+        nHead.store(0);
+        nTail.store(0);
+        nDropped.store(0);
+        nWritten.store(0);
+        nDroppedReported = 0;
+
+        fBlock.store(fBlockIn);
+        fShutdown.store(false);
+
+        /* Start the writer thread and begin accepting messages. */
+        WRITER_THREAD = std::thread(std::bind(&AsyncLogger::Thread, this));
+        fRunning.store(true, std::memory_order_release);
+    }
+
+
+    /* Stop accepting messages, drain the buffer, and join the writer thread. */
+    void AsyncLogger::Stop()
+    {
+        /* Stop accepting new messages. Producers fall back to synchronous writes. */
+        fRunning.store(false);
+
+        /* Signal the writer thread to drain and exit, and release producers waiting on a full buffer. */
+        if(WRITER_THREAD.joinable())
+        {
+            {
+                std::unique_lock<std::mutex> lock(WRITER_MUTEX);
+                fShutdown.store(true);
+            }
+            WRITER_CONDITION.notify_all();
+            SPACE_CONDITION.notify_all();
+
+            WRITER_THREAD.join();
+        }
+
+        /* Write out anything published after the writer's last pass. */
+        if(!vSlots.empty())
+            drain();
+    }
+
+
+    /* Returns true if the writer thread is accepting messages. */
+    bool AsyncLogger::Running() const
+    {
+        return fRunning.load(std::memory_order_acquire);
+    }
+
+
+    /* Queue a message for the writer thread. */
+    bool AsyncLogger::Push(std::string& strMessage)
+    {
+        /* Count ourselves in before checking the running flag, so Stop's writer waits for our slot to be published. */
+        ++nProducers;
+        const bool fQueued = push(strMessage);
+        --nProducers;
+
+        return fQueued;
+    }
+
+
+    /* Claim a cell and publish the message into it. */
+    bool AsyncLogger::push(std::string& strMessage)
+    {
+        /* Let the caller write synchronously if we are not running. */
+        if(!fRunning.load())
+            return false;
+
+        /* Claim a slot by advancing the head past a cell that is free for this position. */
+        uint64_t nPos = nHead.load(std::memory_order_relaxed);
+        Slot* pslot = nullptr;
+        while(true)
+        {
+            pslot = &vSlots[nPos & nMask];
+
+            /* A free cell carries the sequence of the position that may claim it. */
+            const uint64_t nSequence = pslot->nSequence.load(std::memory_order_acquire);
+            const int64_t  nDiff     = static_cast<int64_t>(nSequence) - static_cast<int64_t>(nPos);
+            if(nDiff == 0)
+            {
+                if(nHead.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                    break;
+            }
+
+            /* The cell still holds a message from the previous lap: the buffer is full. */
+            else if(nDiff < 0)
+            {
+                /* Drop policy discards the message and counts it. */
+                if(!fBlock.load(std::memory_order_relaxed))
+                {
+                    ++nDropped;
+                    return true;
+                }
+
+                /* Block policy wakes the writer and sleeps until it frees this cell. */
+                WRITER_CONDITION.notify_one();
+                {
+                    std::unique_lock<std::mutex> lock(WRITER_MUTEX);
+
+                    ++nWaiting;
+                    SPACE_CONDITION.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL), [this, pslot, nPos]
+                    {
+                        return !fRunning.load() ||
+                            static_cast<int64_t>(pslot->nSequence.load(std::memory_order_acquire)) - static_cast<int64_t>(nPos) >= 0;
+                    });
+                    --nWaiting;
+                }
+
+                if(!fRunning.load())
+                    return false;
+
+                nPos = nHead.load(std::memory_order_relaxed);
+            }
+
+            /* Another producer claimed this position first. */
+            else
+                nPos = nHead.load(std::memory_order_relaxed);
+        }
+
+        /* Fill the cell and publish it to the writer. */
+        pslot->nTimestamp = runtime::timestamp(true);
+        pslot->strMessage.swap(strMessage);
+        pslot->nSequence.store(nPos + 1, std::memory_order_release);
+
+        /* Wake the writer early once the buffer is half full. */
+        const uint64_t nTailPos = nTail.load(std::memory_order_relaxed);
+        if(nPos >= nTailPos && nPos - nTailPos >= (nMask >> 1))
+            WRITER_CONDITION.notify_one();
+
+        return true;
+    }
+
+
+    /* Returns the total number of messages dropped by policy. */
+    uint64_t AsyncLogger::Dropped() const
+    {
+        return nDropped.load();
+    }
+
+
+    /* Returns the total number of messages written by the writer thread. */
+    uint64_t AsyncLogger::Written() const
+    {
+        return nWritten.load();
+    }
+
+
+    /* Take the next message off the buffer (single consumer only). */
+    bool AsyncLogger::pop(uint64_t &nTimestamp, std::string &strMessage)
+    {
+        const uint64_t nPos = nTail.load(std::memory_order_relaxed);
+
+        /* A published cell carries the sequence of its position plus one. */
+        Slot& slot = vSlots[nPos & nMask];
+        if(slot.nSequence.load(std::memory_order_acquire) != nPos + 1)
+            return false;
+
+        nTimestamp = slot.nTimestamp;
+        strMessage.swap(slot.strMessage);
+        slot.strMessage.clear();
+
+        /* Hand the cell back to producers for the next lap. */
+        slot.nSequence.store(nPos + nMask + 1, std::memory_order_release);
+        nTail.store(nPos + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+
+    /* Returns true if the next slot for the writer has been published. */
+    bool AsyncLogger::ready() const
+    {
+        const uint64_t nPos = nTail.load(std::memory_order_relaxed);
+
+        return vSlots[nPos & nMask].nSequence.load(std::memory_order_acquire) == nPos + 1;
+    }
+
+
+    /* Write out everything currently in the buffer in batches. */
+    uint64_t AsyncLogger::drain()
+    {
+        uint64_t nTotal = 0;
+
+        std::string strBatch;
+        std::string strMessage;
+        while(true)
+        {
+            /* Collect the raw messages for this batch. */
+            std::vector<std::pair<uint64_t, std::string>> vBatch;
+            uint64_t nTimestamp = 0;
+            while(vBatch.size() < MAX_BATCH_SIZE && pop(nTimestamp, strMessage))
+            {
+                vBatch.push_back(std::make_pair(nTimestamp, std::string()));
+                vBatch.back().second.swap(strMessage);
+            }
+
+            /* Wake producers waiting for the cells we just freed. */
+            if(!vBatch.empty() && nWaiting.load() > 0)
+            {
+                { std::unique_lock<std::mutex> lock(WRITER_MUTEX); }
+                SPACE_CONDITION.notify_all();
+            }
+
+            /* Report any messages that were dropped since the last batch. */
+            const uint64_t nDroppedNow = nDropped.load();
+            const bool fReport = (nDroppedNow != nDroppedReported);
+            if(vBatch.empty() && !fReport)
+                break;
+
+            /* Format and write the batch under the debug lock (localtime is not thread safe). */
+            {
+                LOCK(DEBUG_MUTEX);
+
+                strBatch.clear();
+                for(const auto& entry : vBatch)
+                {
+                    strBatch += time_prefix(entry.first / 1000, entry.first % 1000);
+                    strBatch += entry.second;
+                    strBatch += '\n';
+                }
+
+                if(fReport)
+                {
+                    const uint64_t nNow = runtime::timestamp(true);
+                    strBatch += time_prefix(nNow / 1000, nNow % 1000);
+                    strBatch += safe_printstr(ANSI_COLOR_BRIGHT_YELLOW, "DROPPED: ", ANSI_COLOR_RESET,
+                        nDroppedNow - nDroppedReported, " log messages (", nDroppedNow, " total)");
+                    strBatch += '\n';
+
+                    nDroppedReported = nDroppedNow;
+                }
+
+                /* Dump it to the console. */
+                std::cout << strBatch << std::flush;
+
+                /* Write it to the debug file and check if it should be archived. */
+                if(ssFile.is_open())
+                {
+                    ssFile << strBatch << std::flush;
+                    check_log_archive(ssFile);
+                }
+            }
+
+            nWritten += vBatch.size();
+            nTotal   += vBatch.size();
+        }
+
+        return nTotal;
+    }
+
+
+    /* Writer thread that sleeps until woken or until the flush interval elapses. */
+    void AsyncLogger::Thread()
+    {
+        while(!fShutdown.load())
+        {
+            /* Sleep until there is work, shutdown, or the flush interval elapses. */
+            {
+                std::unique_lock<std::mutex> lock(WRITER_MUTEX);
+                WRITER_CONDITION.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL),
+                    [this]{ return fShutdown.load() || ready(); });
+            }
+
+            drain();
+        }
+
+        /* Producers that got past the running check before Stop may still hold claimed cells, so keep
+         * draining until all of them have left Push and every claimed cell has been written. */
+        while(true)
+        {
+            drain();
+
+            if(nProducers.load() == 0 && nTail.load() == nHead.load())
+                break;
+
+            std::unique_lock<std::mutex> lock(WRITER_MUTEX);
+            WRITER_CONDITION.wait_for(lock, std::chrono::milliseconds(1), [this]{ return ready(); });
+        }
+    }
+
+
+    /* Queue a log message on the asynchronous logger if it is running. */
+    bool log_async(std::string &debug_str)
+    {
+        return LOGGER.Push(debug_str);
+    }
+}
@@ -0,0 +1,315 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/metrics.h>
+#include <Util/include/debug.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace metrics
+{
+
+    /* The upper bounds of the histogram buckets in microseconds. */
+    const uint64_t BUCKET_BOUNDS[HISTOGRAM_BUCKETS - 1] =
+    {
+        10, 25, 50, 100, 250, 500,
+        1000, 2500, 5000, 10000, 25000, 50000,
+        100000, 250000, 500000, 1000000, 2500000, 5000000,
+        10000000
+    };
+
+
+    /* The open addressed table of metrics. Slots are only ever filled, never cleared, so lookups need no lock. */
+    static std::atomic<Metric*> TABLE[MAX_METRICS];
+
+
+    /* Get the metric returned when the table is full or a name is reused with another type. */
+    static Metric* overflow(const uint8_t nType)
+    {
+        static Metric OVERFLOW_COUNTER("nexus_metrics_overflow", "", TYPE::COUNTER);
+        static Metric OVERFLOW_GAUGE("nexus_metrics_overflow", "", TYPE::GAUGE);
+        static Metric OVERFLOW_HISTOGRAM("nexus_metrics_overflow", "", TYPE::HISTOGRAM);
+
+        if(nType == TYPE::COUNTER)
+            return &OVERFLOW_COUNTER;
+
+        if(nType == TYPE::GAUGE)
+            return &OVERFLOW_GAUGE;
+
+        return &OVERFLOW_HISTOGRAM;
+    }
+
+
+    /* Find a metric in the table, or publish a new one into the first empty slot. */
+    static Metric* lookup(const std::string& strName, const std::string& strLabels, const uint8_t nType,
+                        const std::function<int64_t()>& fnValue = nullptr)
+    {
+        /* Hash the name and labels to the starting slot. */
+        const uint64_t nHash = std::hash<std::string>()(strName + '\0' + strLabels);
+
+        /* Probe linearly until we find the metric or an empty slot. */
+        for(uint32_t nProbe = 0; nProbe < MAX_METRICS; ++nProbe)
+        {
+            std::atomic<Metric*>& slot = TABLE[(nHash + nProbe) % MAX_METRICS];
+
+            /* Try to claim an empty slot. */
+            Metric* pMetric = slot.load(std::memory_order_acquire);
+            if(!pMetric)
+            {
+                Metric* pNew = new Metric(strName, strLabels, nType, fnValue);
+                if(slot.compare_exchange_strong(pMetric, pNew, std::memory_order_acq_rel))
+                    return pNew;
+
+                /* Another thread won the slot, check if it was for the same metric. */
+                delete pNew;
+            }
+
+            /* Check the entry in this slot. */
+            if(pMetric->strName == strName && pMetric->strLabels == strLabels)
+            {
+                if(pMetric->nType != nType)
+                {
+                    debug::error(FUNCTION, strName, " already registered with another type");
+                    return overflow(nType);
+                }
+
+                return pMetric;
+            }
+        }
+
+        debug::error(FUNCTION, "registry is full, dropping ", strName);
+        return overflow(nType);
+    }
+
+
+    /* Format microseconds as seconds without trailing zeros. */
+    static std::string seconds(const uint64_t nMicroseconds)
+    {
+        std::string strFraction = std::to_string(nMicroseconds % 1000000);
+        strFraction.insert(0, 6 - strFraction.size(), '0');
+
+        /* Trim the trailing zeros of the fraction. */
+        while(!strFraction.empty() && strFraction.back() == '0')
+            strFraction.pop_back();
+
+        const std::string strSeconds = std::to_string(nMicroseconds / 1000000);
+        if(strFraction.empty())
+            return strSeconds;
+
+        return strSeconds + "." + strFraction;
+    }
+
+
+    /* Histogram constructor. */
+    Histogram::Histogram()
+    : nBuckets()
+    , nCount(0)
+    , nSum(0)
+    {
+        for(uint32_t n = 0; n < HISTOGRAM_BUCKETS; ++n)
+            nBuckets[n].store(0, std::memory_order_relaxed);
+    }
+
+
+    /* Record a latency in its bucket. */
+    void Histogram::Observe(const uint64_t nMicroseconds)
+    {
+        const uint32_t nBucket = static_cast<uint32_t>(
+            std::lower_bound(BUCKET_BOUNDS, BUCKET_BOUNDS + HISTOGRAM_BUCKETS - 1, nMicroseconds) - BUCKET_BOUNDS);
+
+        nBuckets[nBucket].fetch_add(1, std::memory_order_relaxed);
+        nCount.fetch_add(1, std::memory_order_relaxed);
+        nSum.fetch_add(nMicroseconds, std::memory_order_relaxed);
+    }
+
+
+    /* Estimate a quantile as the upper bound of the bucket it falls in. */
+    uint64_t Histogram::Quantile(const double dQuantile) const
+    {
+        /* Take one pass over the buckets so the total matches the counts we walk. */
+        uint64_t nCounts[HISTOGRAM_BUCKETS];
+
+        uint64_t nTotal = 0;
+        for(uint32_t n = 0; n < HISTOGRAM_BUCKETS; ++n)
+        {
+            nCounts[n] = Bucket(n);
+            nTotal    += nCounts[n];
+        }
+
+        if(nTotal == 0)
+            return 0;
+
+        /* Find the first bucket that reaches the rank of the quantile. */
+        const uint64_t nRank = std::max(uint64_t(1), static_cast<uint64_t>(dQuantile * nTotal + 0.5));
+
+        uint64_t nCumulative = 0;
+        for(uint32_t n = 0; n < HISTOGRAM_BUCKETS - 1; ++n)
+        {
+            nCumulative += nCounts[n];
+            if(nCumulative >= nRank)
+                return BUCKET_BOUNDS[n];
+        }
+
+        return BUCKET_BOUNDS[HISTOGRAM_BUCKETS - 2];
+    }
+
+
+    /* Metric constructor. */
+    Metric::Metric(const std::string& strNameIn, const std::string& strLabelsIn, const uint8_t nTypeIn,
+                   const std::function<int64_t()>& fnValueIn)
+    : strName(strNameIn)
+    , strLabels(strLabelsIn)
+    , nType(nTypeIn)
+    , counter()
+    , gauge()
+    , histogram()
+    , fnValue(fnValueIn)
+    {
+    }
+
+
+    /* Get the value of a counter or gauge. */
+    int64_t Metric::Value() const
+    {
+        if(nType == TYPE::COUNTER)
+            return static_cast<int64_t>(counter.Get());
+
+        if(fnValue)
+            return fnValue();
+
+        return gauge.Get();
+    }
+
+
+    /* Build a label pair, escaping the value for the Prometheus format. */
+    std::string Label(const std::string& strKey, const std::string& strValue)
+    {
+        std::string strRet = strKey + "=\"";
+        for(const char ch : strValue)
+        {
+            if(ch == '\\' || ch == '"')
+                strRet += '\\';
+
+            if(ch == '\n')
+                strRet += "\\n";
+            else
+                strRet += ch;
+        }
+
+        return strRet + "\"";
+    }
+
+
+    /* Find or register a counter. */
+    Counter& GetCounter(const std::string& strName, const std::string& strLabels)
+    {
+        return lookup(strName, strLabels, TYPE::COUNTER)->counter;
+    }
+
+
+    /* Find or register a gauge. */
+    Gauge& GetGauge(const std::string& strName, const std::string& strLabels)
+    {
+        return lookup(strName, strLabels, TYPE::GAUGE)->gauge;
+    }
+
+
+    /* Find or register a latency histogram. */
+    Histogram& GetHistogram(const std::string& strName, const std::string& strLabels)
+    {
+        return lookup(strName, strLabels, TYPE::HISTOGRAM)->histogram;
+    }
+
+
+    /* Register a gauge that is read from a callback on export. */
+    void RegisterCallback(const std::string& strName, const std::string& strLabels, const std::function<int64_t()>& fnValue)
+    {
+        lookup(strName, strLabels, TYPE::GAUGE, fnValue);
+    }
+
+
+    /* Get all registered metrics sorted by name and labels. */
+    std::vector<const Metric*> List()
+    {
+        std::vector<const Metric*> vMetrics;
+        for(uint32_t n = 0; n < MAX_METRICS; ++n)
+        {
+            const Metric* pMetric = TABLE[n].load(std::memory_order_acquire);
+            if(pMetric)
+                vMetrics.push_back(pMetric);
+        }
+
+        /* Sort so that instances of the same name are grouped. */
+        std::sort(vMetrics.begin(), vMetrics.end(), [](const Metric* a, const Metric* b)
+        {
+            if(a->strName != b->strName)
+                return a->strName < b->strName;
+
+            return a->strLabels < b->strLabels;
+        });
+
+        return vMetrics;
+    }
+
+
+    /* Export all metrics in the Prometheus text exposition format. */
+    std::string Prometheus()
+    {
+        std::ostringstream ssRet;
+
+        std::string strLast;
+        for(const auto& pMetric : List())
+        {
+            /* Write the type line once per name. */
+            if(pMetric->strName != strLast)
+            {
+                static const char* TYPES[] = { "counter", "gauge", "histogram" };
+
+                ssRet << "# TYPE " << pMetric->strName << " " << TYPES[pMetric->nType] << "\n";
+                strLast = pMetric->strName;
+            }
+
+            /* Counters and gauges are a single sample. */
+            if(pMetric->nType != TYPE::HISTOGRAM)
+            {
+                ssRet << pMetric->strName;
+                if(!pMetric->strLabels.empty())
+                    ssRet << "{" << pMetric->strLabels << "}";
+
+                ssRet << " " << pMetric->Value() << "\n";
+                continue;
+            }
+
+            /* Histograms export cumulative buckets in seconds. */
+            const std::string strPrefix = pMetric->strLabels.empty() ? "" : pMetric->strLabels + ",";
+            const Histogram& histogram = pMetric->histogram;
+
+            uint64_t nCumulative = 0;
+            for(uint32_t n = 0; n < HISTOGRAM_BUCKETS; ++n)
+            {
+                nCumulative += histogram.Bucket(n);
+
+                const std::string strBound = (n + 1 < HISTOGRAM_BUCKETS ? seconds(BUCKET_BOUNDS[n]) : "+Inf");
+                ssRet << pMetric->strName << "_bucket{" << strPrefix << "le=\"" << strBound << "\"} " << nCumulative << "\n";
+            }
+
+            const std::string strLabels = pMetric->strLabels.empty() ? "" : "{" + pMetric->strLabels + "}";
+            ssRet << pMetric->strName << "_sum" << strLabels << " " << seconds(histogram.Sum()) << "\n";
+            ssRet << pMetric->strName << "_count" << strLabels << " " << nCumulative << "\n";
+        }
+
+        return ssRet.str();
+    }
+
+}
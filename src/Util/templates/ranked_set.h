@@ -0,0 +1,343 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_UTIL_TEMPLATES_RANKED_SET_H
+#define NEXUS_UTIL_TEMPLATES_RANKED_SET_H
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+/** ranked_set
+ *
+ *  Ordered set that can find the element at a given rank in O(log n).
+ *
+ *  Implemented as a treap with subtree sizes, so insert, erase and rank
+ *  selection are all O(log n) expected without copying the elements.
+ *
+ **/
+template<typename T, typename Compare = std::less<T> >
+class ranked_set
+{
+    /** Node
+     *
+     *  Tree node holding one element.
+     *
+     **/
+    struct Node
+    {
+        /** The element stored. **/
+        T value;
+
+        /** The random heap priority. **/
+        uint32_t nPriority;
+
+        /** The number of elements in this subtree. **/
+        uint32_t nSize;
+
+        /** The children. **/
+        Node* left;
+        Node* right;
+
+        Node(const T& valueIn, const uint32_t nPriorityIn)
+        : value     (valueIn)
+        , nPriority (nPriorityIn)
+        , nSize     (1)
+        , left      (nullptr)
+        , right     (nullptr)
+        {
+        }
+    };
+
+
+    /** The root of the tree. **/
+    Node* root;
+
+
+    /** The comparison for ordering elements. **/
+    Compare compare;
+
+
+    /** The state for generating node priorities. **/
+    uint64_t nSeed;
+
+
+    /** Returns the size of a subtree. **/
+    static uint32_t size(const Node* node)
+    {
+        return node ? node->nSize : 0;
+    }
+
+
+    /** Recalculates the size of a subtree after its children changed. **/
+    static void update(Node* node)
+    {
+        node->nSize = 1 + size(node->left) + size(node->right);
+    }
+
+
+    /** Returns the next node priority (xorshift64). **/
+    uint32_t priority()
+    {
+        nSeed ^= nSeed << 13;
+        nSeed ^= nSeed >> 7;
+        nSeed ^= nSeed << 17;
+
+        return static_cast<uint32_t>(nSeed >> 32);
+    }
+
+
+    /** Splits a subtree into elements ordered before value and the rest. **/
+    void split(Node* node, const T& value, Node* &left, Node* &right)
+    {
+        if(!node)
+        {
+            left = right = nullptr;
+            return;
+        }
+
+        if(compare(node->value, value))
+        {
+            split(node->right, value, node->right, right);
+            left = node;
+        }
+        else
+        {
+            split(node->left, value, left, node->left);
+            right = node;
+        }
+
+        update(node);
+    }
+
+
+    /** Merges two subtrees where every element of left is ordered before right. **/
+    Node* merge(Node* left, Node* right)
+    {
+        if(!left)
+            return right;
+
+        if(!right)
+            return left;
+
+        if(left->nPriority > right->nPriority)
+        {
+            left->right = merge(left->right, right);
+            update(left);
+
+            return left;
+        }
+
+        right->left = merge(left, right->left);
+        update(right);
+
+        return right;
+    }
+
+
+    /** Deletes a subtree. **/
+    static void destroy(Node* node)
+    {
+        if(!node)
+            return;
+
+        destroy(node->left);
+        destroy(node->right);
+
+        delete node;
+    }
+
+public:
+
+    /** Default Constructor. **/
+    ranked_set()
+    : root    (nullptr)
+    , compare ( )
+    , nSeed   (0x9e3779b97f4a7c15)
+    {
+    }
+
+
+    /** Copy Constructor. **/
+    ranked_set(const ranked_set<T, Compare>& set) = delete;
+
+
+    /** Assignment operator. **/
+    ranked_set& operator=(const ranked_set<T, Compare>& set) = delete;
+
+
+    /** Default Destructor. **/
+    ~ranked_set()
+    {
+        destroy(root);
+    }
+
+
+    /** size
+     *
+     *  Returns the number of elements in the set.
+     *
+     **/
+    uint32_t size() const
+    {
+        return size(root);
+    }
+
+
+    /** empty
+     *
+     *  Returns true if the set has no elements.
+     *
+     **/
+    bool empty() const
+    {
+        return root == nullptr;
+    }
+
+
+    /** clear
+     *
+     *  Removes all elements from the set.
+     *
+     **/
+    void clear()
+    {
+        destroy(root);
+        root = nullptr;
+    }
+
+
+    /** count
+     *
+     *  Returns 1 if the set has the element, 0 otherwise.
+     *
+     **/
+    uint32_t count(const T& value) const
+    {
+        const Node* node = root;
+        while(node)
+        {
+            if(compare(value, node->value))
+                node = node->left;
+            else if(compare(node->value, value))
+                node = node->right;
+            else
+                return 1;
+        }
+
+        return 0;
+    }
+
+
+    /** insert
+     *
+     *  Adds an element to the set.
+     *
+     *  @param[in] value The element to add.
+     *
+     *  @return True if the element was added, false if it already existed.
+     *
+     **/
+    bool insert(const T& value)
+    {
+        if(count(value))
+            return false;
+
+        Node* left  = nullptr;
+        Node* right = nullptr;
+        split(root, value, left, right);
+
+        root = merge(merge(left, new Node(value, priority())), right);
+
+        return true;
+    }
+
+
+    /** erase
+     *
+     *  Removes an element from the set.
+     *
+     *  @param[in] value The element to remove.
+     *
+     *  @return True if the element was removed, false if it didn't exist.
+     *
+     **/
+    bool erase(const T& value)
+    {
+        /* Find the link pointing to the element. */
+        Node** link = &root;
+        while(*link)
+        {
+            if(compare(value, (*link)->value))
+                link = &(*link)->left;
+            else if(compare((*link)->value, value))
+                link = &(*link)->right;
+            else
+                break;
+        }
+
+        if(!*link)
+            return false;
+
+        /* Replace the node with the merge of its children. */
+        Node* node = *link;
+        *link = merge(node->left, node->right);
+        delete node;
+
+        /* Fix the sizes on the path down to the removed node. */
+        Node* parent = root;
+        while(parent && parent != *link)
+        {
+            --parent->nSize;
+
+            if(compare(value, parent->value))
+                parent = parent->left;
+            else
+                parent = parent->right;
+        }
+
+        return true;
+    }
+
+
+    /** at
+     *
+     *  Get the element at a given rank, zero being the first in order.
+     *
+     *  @param[in] nRank The rank of the element, must be less than size().
+     *
+     **/
+    const T& at(uint32_t nRank) const
+    {
+        if(nRank >= size())
+            throw std::out_of_range("ranked_set::at rank out of range");
+
+        const Node* node = root;
+        while(true)
+        {
+            const uint32_t nLeft = size(node->left);
+            if(nRank < nLeft)
+                node = node->left;
+            else if(nRank == nLeft)
+                return node->value;
+            else
+            {
+                nRank -= nLeft + 1;
+                node   = node->right;
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,284 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/trace.h>
+#include <Util/include/debug.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace trace
+{
+
+    /* Flag to enable recording of spans. */
+    std::atomic<bool> fEnabled(false);
+
+
+    /* Milliseconds a block can take to process before its spans are dumped. */
+    std::atomic<uint64_t> nSlow(0);
+
+
+    /* One recorded span. Names are literals, so recording never allocates. */
+    struct Event
+    {
+        const char* pName;
+        const char* pCategory;
+        uint64_t nStart;
+        uint64_t nDuration;
+    };
+
+
+    /* Ring buffer of spans owned by one thread. The mutex is only contended while dumping. */
+    struct Buffer
+    {
+        std::mutex MUTEX;
+        std::vector<Event> vEvents;
+        uint64_t nNext;
+        uint32_t nThread;
+
+        Buffer(const uint32_t nSize, const uint32_t nThreadIn)
+        : MUTEX()
+        , vEvents(nSize)
+        , nNext(0)
+        , nThread(nThreadIn)
+        {
+        }
+    };
+
+
+    /* The number of spans kept per thread. */
+    static std::atomic<uint32_t> nBufferSize(DEFAULT_BUFFER);
+
+
+    /* All thread buffers. A buffer outlives its thread, so its spans are still dumped, and is handed to the next new thread. */
+    static std::mutex BUFFERS_MUTEX;
+    static std::vector<std::unique_ptr<Buffer>> vBuffers;
+    static std::vector<Buffer*> vFree;
+
+
+    /* Holds the buffer of the calling thread, and returns it for reuse when the thread exits. */
+    struct Handle
+    {
+        Buffer* pBuffer;
+
+        Handle()
+        : pBuffer(nullptr)
+        {
+        }
+
+        ~Handle()
+        {
+            if(!pBuffer)
+                return;
+
+            LOCK(BUFFERS_MUTEX);
+            vFree.push_back(pBuffer);
+        }
+    };
+
+
+    /* The buffer of the calling thread. */
+    static thread_local Handle tBuffer;
+
+
+    /* Paths waiting to be written by the dump thread. */
+    static std::mutex WRITER_MUTEX;
+    static std::condition_variable WRITER_CONDITION;
+    static std::deque<std::string> queuePaths;
+    static std::thread WRITER_THREAD;
+    static bool fStop = false;
+
+
+    /* The most dumps that can wait for the dump thread, so a run of slow blocks can't pile them up. */
+    static const uint32_t MAX_QUEUED = 4;
+
+
+    /* Write the queued dumps until stopped. */
+    static void writer()
+    {
+        std::unique_lock<std::mutex> lock(WRITER_MUTEX);
+        while(true)
+        {
+            WRITER_CONDITION.wait(lock, []{ return fStop || !queuePaths.empty(); });
+            if(queuePaths.empty())
+                return;
+
+            const std::string strPath = std::move(queuePaths.front());
+            queuePaths.pop_front();
+
+            /* Don't hold up new requests while writing. */
+            lock.unlock();
+
+            uint64_t nEvents = 0;
+            Write(strPath, nEvents);
+
+            lock.lock();
+        }
+    }
+
+
+    /* Read the -trace, -tracebuffer and -traceslow arguments. */
+    void Initialize()
+    {
+        nBufferSize = static_cast<uint32_t>(std::max(int64_t(1024), config::GetArg("-tracebuffer", DEFAULT_BUFFER)));
+        nSlow       = static_cast<uint64_t>(std::max(int64_t(0), config::GetArg("-traceslow", 0)));
+        fEnabled    = config::GetBoolArg("-trace", false);
+
+        if(fEnabled.load())
+            debug::log(0, FUNCTION, "recording spans, ", nBufferSize.load(), " per thread");
+
+        /* Start the dump thread for slow blocks. */
+        if(fEnabled.load() && nSlow.load() > 0 && !WRITER_THREAD.joinable())
+        {
+            fStop = false;
+            WRITER_THREAD = std::thread(writer);
+        }
+    }
+
+
+    /* Write any queued dumps and stop the dump thread. */
+    void Shutdown()
+    {
+        if(!WRITER_THREAD.joinable())
+            return;
+
+        {
+            LOCK(WRITER_MUTEX);
+            fStop = true;
+        }
+        WRITER_CONDITION.notify_all();
+
+        WRITER_THREAD.join();
+    }
+
+
+    /* Get the microseconds elapsed since the tracer was loaded. */
+    uint64_t Now()
+    {
+        static const std::chrono::steady_clock::time_point EPOCH = std::chrono::steady_clock::now();
+
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - EPOCH).count());
+    }
+
+
+    /* Add a finished span to the buffer of the calling thread. */
+    void Record(const char* pName, const char* pCategory, const uint64_t nStart, const uint64_t nDuration)
+    {
+        /* Take a buffer the first time this thread records, reusing one from an exited thread if there is one. */
+        Buffer* pBuffer = tBuffer.pBuffer;
+        if(!pBuffer)
+        {
+            LOCK(BUFFERS_MUTEX);
+
+            if(!vFree.empty())
+            {
+                pBuffer = vFree.back();
+                vFree.pop_back();
+            }
+            else
+            {
+                vBuffers.emplace_back(new Buffer(nBufferSize.load(), static_cast<uint32_t>(vBuffers.size() + 1)));
+                pBuffer = vBuffers.back().get();
+            }
+
+            tBuffer.pBuffer = pBuffer;
+        }
+
+        LOCK(pBuffer->MUTEX);
+
+        Event& event = pBuffer->vEvents[pBuffer->nNext++ % pBuffer->vEvents.size()];
+        event.pName     = pName;
+        event.pCategory = pCategory;
+        event.nStart    = nStart;
+        event.nDuration = nDuration;
+    }
+
+
+    /* Get all buffered spans in the Chrome trace_event JSON format. */
+    std::string Dump(uint64_t &nEvents)
+    {
+        std::ostringstream ssRet;
+        ssRet << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        nEvents = 0;
+        {
+            LOCK(BUFFERS_MUTEX);
+            for(const auto& buffer : vBuffers)
+            {
+                LOCK2(buffer->MUTEX);
+
+                /* Walk the ring from the oldest span still kept. */
+                const uint64_t nSize  = buffer->vEvents.size();
+                const uint64_t nBegin = (buffer->nNext > nSize ? buffer->nNext - nSize : 0);
+                for(uint64_t n = nBegin; n < buffer->nNext; ++n)
+                {
+                    const Event& event = buffer->vEvents[n % nSize];
+
+                    ssRet << (nEvents++ == 0 ? "" : ",")
+                          << "{\"name\":\"" << event.pName
+                          << "\",\"cat\":\"" << event.pCategory
+                          << "\",\"ph\":\"X\",\"ts\":" << event.nStart
+                          << ",\"dur\":" << event.nDuration
+                          << ",\"pid\":1,\"tid\":" << buffer->nThread << "}";
+                }
+            }
+        }
+
+        ssRet << "]}";
+
+        return ssRet.str();
+    }
+
+
+    /* Write all buffered spans to a file in the Chrome trace_event JSON format. */
+    bool Write(const std::string& strPath, uint64_t &nEvents)
+    {
+        const std::string strTrace = Dump(nEvents);
+
+        std::ofstream stream(strPath, std::ios::out | std::ios::trunc);
+        if(!stream.is_open())
+            return debug::error(FUNCTION, "failed to open ", strPath);
+
+        if(!stream.write(strTrace.data(), strTrace.size()))
+            return debug::error(FUNCTION, "failed to write ", strPath);
+
+        debug::log(0, FUNCTION, "wrote ", nEvents, " spans to ", strPath);
+
+        return true;
+    }
+
+
+    /* Queue all buffered spans to be written to a file by the dump thread. */
+    bool WriteAsync(const std::string& strPath)
+    {
+        {
+            LOCK(WRITER_MUTEX);
+            if(!WRITER_THREAD.joinable() || fStop || queuePaths.size() >= MAX_QUEUED)
+                return false;
+
+            queuePaths.push_back(strPath);
+        }
+        WRITER_CONDITION.notify_one();
+
+        return true;
+    }
+
+}
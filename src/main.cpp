@@ -26,7 +26,10 @@ ________________________________________________________________________________
 #include <TAO/API/include/global.h>
 #include <TAO/API/include/cmd.h>
 #include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/include/archive.h>
 #include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/pipeline.h>
+#include <TAO/Ledger/include/snapshot.h>
 #include <TAO/Ledger/types/stake_minter.h>
 #include <TAO/Ledger/include/timelocks.h>
 
@@ -34,6 +37,7 @@ ________________________________________________________________________________
 #include <Util/include/filesystem.h>
 #include <Util/include/signals.h>
 #include <Util/include/daemon.h>
+#include <Util/include/trace.h>
 
 #include <Legacy/include/ambassador.h>
 #include <Legacy/wallet/wallet.h>
@@ -69,6 +73,10 @@ int main(int argc, char** argv)
     debug::Initialize();
 
 
+    /* Initialize the span tracer. */
+    trace::Initialize();
+
+
     /* Initialize network resources. (Need before RPC/API for WSAStartup call in Windows) */
     LLP::Initialize();
 
@@ -147,6 +155,16 @@ int main(int argc, char** argv)
         TAO::Ledger::ChainState::Initialize();
 
 
+        /* Bootstrap a fresh ledger from a snapshot. */
+        std::string strSnapshot = config::GetArg(std::string("-loadsnapshot"), "");
+        if(!strSnapshot.empty() && TAO::Ledger::ChainState::nBestHeight.load() == 0)
+        {
+            uint256_t hashCommitment = 0;
+            if(!TAO::Ledger::ImportSnapshot(strSnapshot, hashCommitment))
+                return debug::error("Failed loading snapshot from ", strSnapshot);
+        }
+
+
         /* We don't need the wallet in client mode. */
         if(!config::fClient.load())
         {
@@ -199,6 +217,51 @@ int main(int argc, char** argv)
         }
 
 
+        /* Write the best chain to a block archive. */
+        std::string strExport = config::GetArg(std::string("-exportblocks"), "");
+        if(!strExport.empty())
+        {
+            uint32_t nBlocks = 0;
+            if(!TAO::Ledger::ExportBlocks(strExport, nBlocks))
+                return debug::error("Failed exporting blocks to ", strExport);
+        }
+
+
+        /* Write the ledger at the last hardened checkpoint to a snapshot. */
+        std::string strExportSnapshot = config::GetArg(std::string("-exportsnapshot"), "");
+        if(!strExportSnapshot.empty())
+        {
+            uint256_t hashCommitment = 0;
+            if(!TAO::Ledger::ExportSnapshot(strExportSnapshot, hashCommitment))
+                return debug::error("Failed exporting snapshot to ", strExportSnapshot);
+        }
+
+
+        /* Seed the ledger from a local block archive. */
+        std::string strImport = config::GetArg(std::string("-importblocks"), "");
+        if(!strImport.empty() && !config::fClient.load())
+        {
+            /* Defer keychain writes until the import is done. */
+            LLD::BulkBegin();
+
+            uint32_t nBlocks = 0;
+            if(!TAO::Ledger::ImportBlocks(strImport, nBlocks))
+                debug::error("Block import stopped after ", nBlocks, " blocks, continuing from height ", TAO::Ledger::ChainState::nBestHeight.load());
+
+            if(!LLD::BulkCommit())
+                return debug::error("Failed building keychains after block import");
+        }
+
+
+        /* Start the sync pipeline to check blocks ahead of the serial processing stage. */
+        if(!config::fClient.load() && config::GetArg(std::string("-syncworkers"), 0) > 0)
+        {
+            TAO::Ledger::SyncPipeline::GetInstance().Start(
+                static_cast<uint32_t>(config::GetArg(std::string("-syncworkers"), 0)),
+                static_cast<uint32_t>(config::GetArg(std::string("-syncbuffer"), 1024)));
+        }
+
+
         /* Get the port for Tritium Server. Allow serverport or port params to be used (serverport takes preference)*/
         uint16_t nPort = static_cast<uint16_t>(config::GetArg(std::string("-port"), config::fTestNet.load() ? (TRITIUM_TESTNET_PORT + (config::GetArg("-testnet", 0) - 1)) : TRITIUM_MAINNET_PORT)); 
         nPort = static_cast<uint16_t>(config::GetArg(std::string("-serverport"), nPort));
@@ -307,6 +370,10 @@ int main(int argc, char** argv)
     LLP::Shutdown();
 
 
+    /* Stop the sync pipeline before the databases close. */
+    TAO::Ledger::SyncPipeline::GetInstance().Stop();
+
+
     /* Shutdown database instances. */
     LLD::Shutdown();
 
@@ -334,6 +401,10 @@ int main(int argc, char** argv)
     debug::log(0, FUNCTION, "Closed in ", nElapsed, "ms");
 
 
+    /* Write any pending span dumps. */
+    trace::Shutdown();
+
+
     /* Close the debug log file once and for all. */
     debug::Shutdown();
 
@@ -0,0 +1,120 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+#include <LLC/types/uint1024.h>
+
+#include <Util/include/debug.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+#include <map>
+#include <unordered_set>
+
+
+TEST_CASE( "Base Uint Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin Base Uint Benchmarks =====");
+
+    const uint32_t nCount = 10000;
+
+    /* Operands shaped like chain trust and difficulty targets. */
+    std::vector<uint1024_t> vTrust(nCount);
+    std::vector<uint1024_t> vTarget(nCount);
+    std::vector<uint64_t>   vSmall(nCount);
+    for(uint32_t n = 0; n < nCount; ++n)
+    {
+        vTrust[n]  = LLC::GetRand1024();
+        vTarget[n] = LLC::GetRand1024() >> (LLC::GetRand(512) + 256);
+        vSmall[n]  = LLC::GetRand() | 1;
+    }
+
+    /* Arithmetic on 1024-bit numbers. */
+    {
+        uint1024_t nSum = 0;
+
+        bench::Run("LLC", "uint1024::Add", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum += vTrust[n];
+        });
+
+        bench::Run("LLC", "uint1024::Subtract", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum -= vTarget[n];
+        });
+
+        bench::Run("LLC", "uint1024::Multiply", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum ^= vTrust[n] * vTarget[n];
+        });
+
+        bench::Run("LLC", "uint1024::Multiply64", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum ^= vTarget[n] * vSmall[n];
+        });
+
+        bench::Run("LLC", "uint1024::Divide", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum ^= vTrust[n] / vTarget[n];
+        });
+
+        bench::Run("LLC", "uint1024::Divide64", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nSum ^= vTrust[n] / vSmall[n];
+        });
+
+        bench::Keep(nSum);
+    }
+
+    /* Hashes as keys of ordered and hashed containers. */
+    {
+        std::vector<uint512_t> vHashes(nCount);
+        for(auto& hash : vHashes)
+            hash = LLC::GetRand512();
+
+        std::map<uint512_t, uint32_t> mapHashes;
+        std::unordered_set<uint512_t> setHashes;
+
+        bench::Run("LLC", "uint512::MapInsert", nCount, [&]
+        {
+            mapHashes.clear();
+            for(uint32_t n = 0; n < nCount; ++n)
+                mapHashes[vHashes[n]] = n;
+        });
+
+        uint64_t nFound = 0;
+        bench::Run("LLC", "uint512::MapFind", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                nFound += mapHashes.count(vHashes[n]);
+        });
+
+        bench::Run("LLC", "uint512::HashSetInsert", nCount, [&]
+        {
+            setHashes.clear();
+            for(uint32_t n = 0; n < nCount; ++n)
+                setHashes.insert(vHashes[n]);
+        });
+
+        bench::Keep(nFound);
+        REQUIRE(mapHashes.size() == setHashes.size());
+    }
+}
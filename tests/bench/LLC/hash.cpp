@@ -0,0 +1,116 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/include/random.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+
+/* Build a set of random messages of the given size. */
+std::vector<std::vector<uint8_t>> BenchMessages(const uint32_t nCount, const uint32_t nSize)
+{
+    std::vector<std::vector<uint8_t>> vMessages(nCount);
+    for(auto& vData : vMessages)
+    {
+        vData.resize(nSize);
+        for(auto& nByte : vData)
+            nByte = static_cast<uint8_t>(LLC::GetRand(256));
+    }
+
+    return vMessages;
+}
+
+
+/* Get the pointer and size pairs of a set of messages for the batch functions. */
+std::vector<std::pair<const uint8_t*, uint64_t>> BenchData(const std::vector<std::vector<uint8_t>>& vMessages)
+{
+    std::vector<std::pair<const uint8_t*, uint64_t>> vData;
+    for(const auto& vMessage : vMessages)
+        vData.push_back(std::make_pair(vMessage.data(), vMessage.size()));
+
+    return vData;
+}
+
+
+TEST_CASE( "SK Hashing Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin SK Hashing Benchmarks =====");
+    debug::log(0, "Batch backend: ", LLC::SKBatchBackend());
+
+    const uint32_t nCount = 100000;
+
+    /* Keccak-f[1600] permutation. */
+    {
+        uint64_t state[25] = { 0 };
+
+        bench::Run("LLC", "Keccak-f1600::Compact", 1000000, [&]
+        {
+            for(uint32_t n = 0; n < 1000000; ++n)
+                KeccakF1600_StatePermute_Compact(state);
+        });
+
+        bench::Run("LLC", "Keccak-f1600::Unrolled", 1000000, [&]
+        {
+            for(uint32_t n = 0; n < 1000000; ++n)
+                KeccakF1600_StatePermute(state);
+        });
+
+        bench::Keep(state);
+    }
+
+    /* SK512 on merkle pairs (128 bytes) and transaction sized messages. */
+    for(const uint32_t nSize : { 128u, 512u })
+    {
+        std::vector<std::vector<uint8_t>> vMessages = BenchMessages(nCount, nSize);
+        std::vector<std::pair<const uint8_t*, uint64_t>> vData = BenchData(vMessages);
+
+        bench::Run("LLC", "SK512::" + std::to_string(nSize), nCount, [&]
+        {
+            for(const auto& vMessage : vMessages)
+                bench::Keep(LLC::SK512(vMessage.begin(), vMessage.end()));
+        });
+
+        std::vector<uint512_t> vHashes;
+        bench::Run("LLC", "SK512Batch::" + std::to_string(nSize), nCount, [&]
+        {
+            LLC::SK512Batch(vData, vHashes);
+        });
+    }
+
+    /* SK1024 on block header sized messages. */
+    {
+        std::vector<std::vector<uint8_t>> vMessages = BenchMessages(nCount, 216);
+        std::vector<std::pair<const uint8_t*, uint64_t>> vData = BenchData(vMessages);
+
+        bench::Run("LLC", "SK1024::216", nCount, [&]
+        {
+            for(const auto& vMessage : vMessages)
+                bench::Keep(LLC::SK1024(vMessage.begin(), vMessage.end()));
+        });
+
+        std::vector<uint1024_t> vHashes;
+        bench::Run("LLC", "SK1024Batch::216", nCount, [&]
+        {
+            LLC::SK1024Batch(vData, vHashes);
+        });
+    }
+
+    debug::log(0, "===== End SK Hashing Benchmarks =====\n");
+}
@@ -0,0 +1,85 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <LLC/include/eckey.h>
+#include <LLC/include/flkey.h>
+#include <LLC/include/random.h>
+#include <LLC/hash/SK.h>
+
+#include <Util/include/debug.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+
+TEST_CASE( "Signature Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin Signature Benchmarks =====");
+
+    /* Sign transaction hashes like the ledger does. */
+    const uint32_t nCount = 100;
+
+    std::vector<std::vector<uint8_t>> vMessages(nCount);
+    for(auto& vData : vMessages)
+        vData = LLC::GetRand512().GetBytes();
+
+    /* Falcon keys used by signature chains. */
+    {
+        LLC::FLKey key;
+        key.MakeNewKey();
+
+        std::vector<std::vector<uint8_t>> vSignatures(nCount);
+        bool fValid = true;
+
+        bench::Run("LLC", "FLKey::Sign", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                fValid &= key.Sign(vMessages[n], vSignatures[n]);
+        });
+
+        bench::Run("LLC", "FLKey::Verify", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                fValid &= key.Verify(vMessages[n], vSignatures[n]);
+        });
+
+        REQUIRE(fValid);
+    }
+
+    /* Brainpool keys used by signature chains and legacy. */
+    {
+        LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+        key.MakeNewKey(true);
+
+        std::vector<std::vector<uint8_t>> vSignatures(nCount);
+        bool fValid = true;
+
+        bench::Run("LLC", "ECKey::Sign", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                fValid &= key.Sign(vMessages[n], vSignatures[n]);
+        });
+
+        bench::Run("LLC", "ECKey::Verify", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+                fValid &= key.Verify(vMessages[n], vSignatures[n]);
+        });
+
+        REQUIRE(fValid);
+    }
+
+    debug::log(0, "===== End Signature Benchmarks =====\n");
+}
@@ -10,42 +10,38 @@
 
 #include <unit/catch2/catch.hpp>
 
+#include <bench/harness.h>
+
 
 TEST_CASE( "LLD Benchamrks", "[LLD]")
 {
     debug::log(0, "===== Begin Ledger Random Read / Write Benchmarks =====");
 
+    const uint32_t nCount = 5000;
+
     //benchmarks
-    uint256_t hash = LLC::GetRand256();
+    bool fValid = true;
     {
-        runtime::timer timer;
-        timer.Start();
-
         TAO::Ledger::BlockState state;
-        for(int i = 0; i < 5000; i++)
+        bench::Run("LLD", "Ledger::WriteBlock", nCount, [&]
         {
-            LLD::Ledger->WriteBlock(uint1024_t(i), state);
-        }
-
-        uint64_t nTime = timer.ElapsedMicroseconds();
-        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Put::", ANSI_COLOR_RESET, "5k records in ", nTime, " microseconds (", (5000000000) / nTime, ") per/s");
+            for(uint32_t i = 0; i < nCount; ++i)
+                fValid &= LLD::Ledger->WriteBlock(uint1024_t(i), state);
+        });
     }
 
 
     {
-        runtime::timer timer;
-        timer.Start();
-
         TAO::Ledger::BlockState state;
-        for(int i = 0; i < 5000; i++)
+        bench::Run("LLD", "Ledger::ReadBlock", nCount, [&]
         {
-            LLD::Ledger->ReadBlock(uint1024_t(i), state);
-        }
-
-        uint64_t nTime = timer.ElapsedMicroseconds();
-        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Get::", ANSI_COLOR_RESET, "5k records in ", nTime, " microseconds (", (5000000000) / nTime, ") per/s");
+            for(uint32_t i = 0; i < nCount; ++i)
+                fValid &= LLD::Ledger->ReadBlock(uint1024_t(i), state);
+        });
     }
 
+    REQUIRE(fValid);
+
 
     debug::log(0, "===== End Ledger Random Read / Write Benchmarks =====\n");
 
@@ -54,14 +50,12 @@ TEST_CASE( "LLD Benchamrks", "[LLD]")
 
 
     {
-        runtime::timer timer;
-        timer.Start();
-
         std::vector<TAO::Ledger::BlockState> vStates;
-        LLD::Ledger->BatchRead("block", vStates, 5000);
-
-        uint64_t nTime = timer.ElapsedMicroseconds();
-        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Get::", ANSI_COLOR_RESET, vStates.size(), " records in ", nTime, " microseconds (", (vStates.size() * 1000000) / nTime, ") per/s");
+        bench::Run("LLD", "Ledger::BatchRead", nCount, [&]
+        {
+            vStates.clear();
+            LLD::Ledger->BatchRead("block", vStates, nCount);
+        });
     }
 
 
@@ -0,0 +1,109 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <LLP/include/base_address.h>
+#include <LLP/templates/socket.h>
+
+#include <Util/include/debug.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+#include <algorithm>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+TEST_CASE( "LLP Loopback Benchmarks", "[LLP]")
+{
+    debug::log(0, "===== Begin LLP Loopback Benchmarks =====");
+
+    /* Listen on an ephemeral loopback port. */
+    int32_t nListen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(nListen >= 0);
+
+    struct sockaddr_in addrListen;
+    std::fill((char*)&addrListen, (char*)&addrListen + sizeof(addrListen), 0);
+    addrListen.sin_family      = AF_INET;
+    addrListen.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addrListen.sin_port        = 0;
+
+    socklen_t nLength = sizeof(addrListen);
+    REQUIRE(bind(nListen, (struct sockaddr*)&addrListen, sizeof(addrListen)) == 0);
+    REQUIRE(listen(nListen, 1) == 0);
+    REQUIRE(getsockname(nListen, (struct sockaddr*)&addrListen, &nLength) == 0);
+
+    /* Connect the two ends. */
+    LLP::Socket client(LLP::BaseAddress("127.0.0.1", ntohs(addrListen.sin_port)));
+
+    struct sockaddr_in addrAccept;
+    nLength = sizeof(addrAccept);
+
+    int32_t nAccept = accept(nListen, (struct sockaddr*)&addrAccept, &nLength);
+    REQUIRE(nAccept >= 0);
+
+    LLP::Socket server(nAccept, LLP::BaseAddress(addrAccept));
+    close(nListen);
+
+    /* Stream messages of packet sizes from small to block sized. */
+    std::vector<int8_t> vRead(256 * 1024);
+    for(const uint32_t nSize : { 64u, 1024u, 65536u })
+    {
+        const uint32_t nMessages = std::max(256u, (16u * 1024 * 1024) / nSize / 8);
+        const uint64_t nTotal    = uint64_t(nSize) * nMessages;
+
+        const std::vector<uint8_t> vMessage(nSize, 0xab);
+
+        bool fValid = true;
+        bench::Run("LLP", "Loopback::" + std::to_string(nSize), nMessages, [&]
+        {
+            uint64_t nReceived = 0;
+            uint32_t nSent     = 0;
+            while(nReceived < nTotal && fValid)
+            {
+                /* Keep the send buffer bounded like the data threads do. */
+                if(nSent < nMessages && client.Buffered() < 1024 * 1024)
+                {
+                    client.Write(vMessage, nSize);
+                    ++nSent;
+                }
+                else
+                    client.Flush();
+
+                /* Drain what has arrived on the other end. */
+                const int32_t nAvailable = server.Available();
+                if(nAvailable > 0)
+                {
+                    const int32_t nRead = server.Read(vRead, std::min(static_cast<size_t>(nAvailable), vRead.size()));
+                    if(nRead > 0)
+                        nReceived += nRead;
+                }
+
+                if(client.Errors() || server.Errors())
+                    fValid = false;
+            }
+        });
+
+        REQUIRE(fValid);
+    }
+
+    client.Close();
+    server.Close();
+
+    debug::log(0, "===== End LLP Loopback Benchmarks =====\n");
+}
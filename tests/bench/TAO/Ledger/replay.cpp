@@ -0,0 +1,126 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/types/block.h>
+#include <TAO/Ledger/types/sigchain.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+
+TEST_CASE( "Block Validation Replay Benchmarks", "[ledger]")
+{
+    using namespace TAO::Operation;
+
+    debug::log(0, "===== Begin Block Validation Replay Benchmarks =====");
+
+    /* Build a block worth of signed transactions and store them like a synced node would. */
+    const uint32_t nCount = 200;
+
+    const uint256_t hashGenesis = TAO::Ledger::SignatureChain::Genesis("benchuser");
+
+    std::vector<uint512_t> vHashes;
+    std::vector<std::pair<uint8_t, uint512_t>> vtx;
+    {
+        uint512_t hashSecret = LLC::GetRand512();
+        uint512_t hashPrevTx = 0;
+
+        for(uint32_t n = 0; n < nCount; ++n)
+        {
+            const uint512_t hashNext = LLC::GetRand512();
+
+            TAO::Ledger::Transaction tx;
+            tx.hashGenesis = hashGenesis;
+            tx.nSequence   = n;
+            tx.nTimestamp  = runtime::unifiedtimestamp();
+            tx.hashPrevTx  = hashPrevTx;
+            tx.nKeyType    = TAO::Ledger::SIGNATURE::FALCON;
+            tx.nNextType   = TAO::Ledger::SIGNATURE::FALCON;
+            tx.NextHash(hashNext, TAO::Ledger::SIGNATURE::FALCON);
+
+            tx[0] << uint8_t(OP::COINBASE) << hashGenesis << uint64_t(1000 * TAO::Ledger::NXS_COIN) << uint64_t(0);
+
+            REQUIRE(tx.Build());
+            REQUIRE(tx.Sign(hashSecret));
+
+            hashPrevTx = tx.GetHash();
+            hashSecret = hashNext;
+
+            REQUIRE(LLD::Ledger->WriteTx(hashPrevTx, tx));
+
+            vHashes.push_back(hashPrevTx);
+            vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, hashPrevTx));
+        }
+    }
+
+    /* Read every transaction of the block back from disk. */
+    bool fValid = true;
+    bench::Run("Ledger", "Replay::ReadTx", nCount, [&]
+    {
+        for(const auto& hash : vHashes)
+        {
+            TAO::Ledger::Transaction tx;
+            fValid &= LLD::Ledger->ReadTx(hash, tx);
+        }
+    });
+
+    /* Stateless checks and signature verification of every transaction. */
+    std::vector<TAO::Ledger::Transaction> vTransactions(nCount);
+    for(uint32_t n = 0; n < nCount; ++n)
+    {
+        REQUIRE(LLD::Ledger->ReadTx(vHashes[n], vTransactions[n]));
+    }
+
+    bench::Run("Ledger", "Replay::Check", nCount, [&]
+    {
+        for(const auto& tx : vTransactions)
+            fValid &= tx.Check();
+    });
+
+    /* Merkle root of the block. */
+    TAO::Ledger::Block block;
+    bench::Run("Ledger", "Replay::MerkleRoot", 1, [&]
+    {
+        bench::Keep(block.BuildMerkleTree(vtx));
+    });
+
+    /* The whole replay of the block from disk. */
+    bench::Run("Ledger", "Replay::Block", nCount, [&]
+    {
+        for(const auto& hash : vHashes)
+        {
+            TAO::Ledger::Transaction tx;
+            fValid &= (LLD::Ledger->ReadTx(hash, tx) && tx.Check());
+        }
+
+        bench::Keep(block.BuildMerkleTree(vtx));
+    });
+
+    REQUIRE(fValid);
+
+    debug::log(0, "===== End Block Validation Replay Benchmarks =====\n");
+}
@@ -0,0 +1,140 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <LLC/include/random.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Register/types/address.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/deflate.h>
+#include <Util/include/json.h>
+#include <Util/templates/datastream.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <bench/harness.h>
+
+
+TEST_CASE( "Serialization Benchmarks", "[Util]")
+{
+    using namespace TAO::Operation;
+
+    debug::log(0, "===== Begin Serialization Benchmarks =====");
+
+    const uint32_t nCount = 10000;
+
+    /* Transaction with a few contracts and a falcon sized signature. */
+    {
+        TAO::Ledger::Transaction tx;
+        tx.nTimestamp  = 989798;
+        tx.hashGenesis = LLC::GetRand256();
+        tx.hashPrevTx  = LLC::GetRand512();
+        tx.vchPubKey   = std::vector<uint8_t>(897, 0x11);
+        tx.vchSig      = std::vector<uint8_t>(690, 0x22);
+
+        for(uint32_t n = 0; n < 4; ++n)
+            tx[n] << uint8_t(OP::DEBIT) << TAO::Register::Address(TAO::Register::Address::ACCOUNT)
+                  << TAO::Register::Address(TAO::Register::Address::ACCOUNT) << uint64_t(500) << uint64_t(0);
+
+        DataStream ssTx(SER_LLD, LLD::DATABASE_VERSION);
+        bench::Run("Util", "Serialize::Transaction", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+            {
+                ssTx.clear();
+                ssTx << tx;
+            }
+        });
+
+        bench::Run("Util", "Deserialize::Transaction", nCount, [&]
+        {
+            for(uint32_t n = 0; n < nCount; ++n)
+            {
+                ssTx.SetPos(0);
+
+                TAO::Ledger::Transaction txRead;
+                ssTx >> txRead;
+                bench::Keep(txRead);
+            }
+        });
+    }
+
+    /* Block state with a full list of transactions. */
+    {
+        TAO::Ledger::BlockState state;
+        for(uint32_t n = 0; n < 1000; ++n)
+            state.vtx.push_back(std::make_pair(uint8_t(0), LLC::GetRand512()));
+
+        DataStream ssBlock(SER_LLD, LLD::DATABASE_VERSION);
+        bench::Run("Util", "Serialize::BlockState", 1000, [&]
+        {
+            for(uint32_t n = 0; n < 1000; ++n)
+            {
+                ssBlock.clear();
+                ssBlock << state;
+            }
+        });
+
+        bench::Run("Util", "Deserialize::BlockState", 1000, [&]
+        {
+            for(uint32_t n = 0; n < 1000; ++n)
+            {
+                ssBlock.SetPos(0);
+
+                TAO::Ledger::BlockState stateRead;
+                ssBlock >> stateRead;
+                bench::Keep(stateRead);
+            }
+        });
+    }
+
+    /* JSON responses like the API list methods return. */
+    {
+        json::json jsonList = json::json::array();
+        for(uint32_t n = 0; n < nCount; ++n)
+        {
+            json::json jsonEntry;
+            jsonEntry["txid"]      = LLC::GetRand512().ToString();
+            jsonEntry["timestamp"] = 1570000000 + n;
+            jsonEntry["amount"]    = 1.5 * n;
+            jsonEntry["operation"] = "DEBIT";
+
+            jsonList.push_back(jsonEntry);
+        }
+
+        std::string strJSON;
+        bench::Run("Util", "JSON::Dump", nCount, [&]
+        {
+            strJSON = jsonList.dump();
+        });
+
+        bench::Run("Util", "JSON::Parse", nCount, [&]
+        {
+            bench::Keep(json::json::parse(strJSON));
+        });
+
+        std::string strCompressed;
+        bench::Run("Util", "Deflate::JSON", nCount, [&]
+        {
+            encoding::Deflate(strJSON, strCompressed, true);
+        });
+    }
+
+    debug::log(0, "===== End Serialization Benchmarks =====\n");
+}
@@ -0,0 +1,190 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <bench/harness.h>
+
+#include <Util/include/debug.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+namespace bench
+{
+
+    /* The results of this run. */
+    std::vector<Result> vResults;
+
+
+    /* The number of timed repetitions for each benchmark. */
+    uint32_t& Repetitions()
+    {
+        static uint32_t nReps = 10;
+
+        return nReps;
+    }
+
+
+    /* The number of untimed repetitions before timing. */
+    uint32_t& Warmup()
+    {
+        static uint32_t nWarmup = 2;
+
+        return nWarmup;
+    }
+
+
+    /* Get the value at a percentile of sorted times. */
+    double Percentile(const std::vector<uint64_t>& vTimes, const double dPercentile)
+    {
+        const uint64_t nIndex = static_cast<uint64_t>(dPercentile * (vTimes.size() - 1) + 0.5);
+
+        return static_cast<double>(vTimes[nIndex]);
+    }
+
+
+    /* Build the result of a benchmark from the time of each repetition. */
+    Result Summarize(const std::string& strSuite, const std::string& strName, const uint64_t nOps, std::vector<uint64_t> vTimes)
+    {
+        Result result;
+        result.strSuite = strSuite;
+        result.strName  = strName;
+        result.nOps     = std::max(nOps, uint64_t(1));
+        result.nReps    = static_cast<uint32_t>(vTimes.size());
+
+        if(vTimes.empty())
+            vTimes.push_back(0);
+
+        /* Sort for the percentiles. */
+        std::sort(vTimes.begin(), vTimes.end());
+
+        uint64_t nTotal = 0;
+        for(const auto& nTime : vTimes)
+            nTotal += nTime;
+
+        const double dOps = static_cast<double>(result.nOps);
+        result.dMin  = vTimes.front() / dOps;
+        result.dMean = nTotal / (dOps * vTimes.size());
+        result.dP50  = Percentile(vTimes, 0.50) / dOps;
+        result.dP90  = Percentile(vTimes, 0.90) / dOps;
+        result.dP99  = Percentile(vTimes, 0.99) / dOps;
+        result.dMax  = vTimes.back() / dOps;
+
+        result.dOpsPerSecond = (result.dP50 > 0 ? 1000000000.0 / result.dP50 : 0);
+
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, strSuite, "::", strName, ANSI_COLOR_RESET,
+            " ", uint64_t(result.dOpsPerSecond), " ops/s",
+            " (p50 ", result.dP50, " ns, p90 ", result.dP90, " ns, p99 ", result.dP99, " ns, ",
+            result.nReps, " x ", result.nOps, " ops)");
+
+        vResults.push_back(result);
+
+        return result;
+    }
+
+
+    /* Get the results of this run as JSON. */
+    json::json Results()
+    {
+        json::json jsonResults = json::json::array();
+        for(const auto& result : vResults)
+        {
+            json::json jsonResult;
+            jsonResult["suite"]    = result.strSuite;
+            jsonResult["name"]     = result.strName;
+            jsonResult["ops"]      = result.nOps;
+            jsonResult["reps"]     = result.nReps;
+            jsonResult["min_ns"]   = result.dMin;
+            jsonResult["mean_ns"]  = result.dMean;
+            jsonResult["p50_ns"]   = result.dP50;
+            jsonResult["p90_ns"]   = result.dP90;
+            jsonResult["p99_ns"]   = result.dP99;
+            jsonResult["max_ns"]   = result.dMax;
+            jsonResult["ops_per_second"] = result.dOpsPerSecond;
+
+            jsonResults.push_back(jsonResult);
+        }
+
+        json::json jsonRun;
+        jsonRun["timestamp"]  = runtime::unifiedtimestamp();
+        jsonRun["warmup"]     = Warmup();
+        jsonRun["reps"]       = Repetitions();
+        jsonRun["benchmarks"] = jsonResults;
+
+        return jsonRun;
+    }
+
+
+    /* Write the results of this run to a JSON file. */
+    bool Write(const std::string& strPath)
+    {
+        std::ofstream stream(strPath, std::ios::out | std::ios::trunc);
+        if(!stream.is_open())
+            return debug::error(FUNCTION, "failed to open ", strPath);
+
+        stream << Results().dump(4) << std::endl;
+
+        return stream.good();
+    }
+
+
+    /* Compare the results of this run to a baseline written by an earlier run. */
+    int32_t Compare(const std::string& strPath, const double dThreshold)
+    {
+        std::ifstream stream(strPath);
+        if(!stream.is_open())
+        {
+            debug::error(FUNCTION, "failed to open ", strPath);
+            return -1;
+        }
+
+        /* Index the baseline by suite and name. */
+        std::map<std::string, double> mapBaseline;
+        try
+        {
+            json::json jsonBaseline = json::json::parse(stream);
+            for(const auto& jsonResult : jsonBaseline["benchmarks"])
+                mapBaseline[jsonResult["suite"].get<std::string>() + "::" + jsonResult["name"].get<std::string>()]
+                    = jsonResult["ops_per_second"].get<double>();
+        }
+        catch(const std::exception& e)
+        {
+            debug::error(FUNCTION, "invalid baseline ", strPath, ": ", e.what());
+            return -1;
+        }
+
+        debug::log(0, "===== Comparing to ", strPath, " =====");
+
+        int32_t nRegressions = 0;
+        for(const auto& result : vResults)
+        {
+            const std::string strKey = result.strSuite + "::" + result.strName;
+            if(!mapBaseline.count(strKey) || mapBaseline[strKey] <= 0)
+                continue;
+
+            const double dChange = (result.dOpsPerSecond - mapBaseline[strKey]) / mapBaseline[strKey];
+            const bool fRegression = (dChange < -dThreshold);
+            if(fRegression)
+                ++nRegressions;
+
+            debug::log(0, fRegression ? ANSI_COLOR_BRIGHT_RED : ANSI_COLOR_BRIGHT_GREEN, strKey, ANSI_COLOR_RESET,
+                " ", dChange >= 0 ? "+" : "", dChange * 100, "%", fRegression ? " REGRESSION" : "");
+        }
+
+        debug::log(0, "===== ", nRegressions, " regressions over ", dThreshold * 100, "% =====\n");
+
+        return nRegressions;
+    }
+
+}
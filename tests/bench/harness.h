@@ -0,0 +1,173 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#pragma once
+#ifndef NEXUS_BENCH_HARNESS_H
+#define NEXUS_BENCH_HARNESS_H
+
+#include <Util/include/json.h>
+#include <Util/include/runtime.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+    /** Result
+     *
+     *  The summary of one benchmark. Latencies are in nanoseconds per operation.
+     *
+     **/
+    struct Result
+    {
+        /** The suite the benchmark belongs to. **/
+        std::string strSuite;
+
+        /** The name of the benchmark. **/
+        std::string strName;
+
+        /** The number of operations in each repetition. **/
+        uint64_t nOps;
+
+        /** The number of timed repetitions. **/
+        uint32_t nReps;
+
+        /** The per operation latencies. **/
+        double dMin;
+        double dMean;
+        double dP50;
+        double dP90;
+        double dP99;
+        double dMax;
+
+        /** The operations per second at the median. **/
+        double dOpsPerSecond;
+    };
+
+
+    /** Repetitions
+     *
+     *  The number of timed repetitions for each benchmark, set with --bench-reps.
+     *
+     **/
+    uint32_t& Repetitions();
+
+
+    /** Warmup
+     *
+     *  The number of untimed repetitions before timing, set with --bench-warmup.
+     *
+     **/
+    uint32_t& Warmup();
+
+
+    /** Summarize
+     *
+     *  Build the result of a benchmark from the time of each repetition, log it, and add
+     *  it to the results of this run.
+     *
+     *  @param[in] strSuite The suite the benchmark belongs to.
+     *  @param[in] strName The name of the benchmark.
+     *  @param[in] nOps The number of operations in each repetition.
+     *  @param[in] vTimes The nanoseconds of each repetition.
+     *
+     *  @return The summary of the benchmark.
+     *
+     **/
+    Result Summarize(const std::string& strSuite, const std::string& strName, const uint64_t nOps, std::vector<uint64_t> vTimes);
+
+
+    /** Keep
+     *
+     *  Stop the compiler from optimizing away a value computed by a benchmark.
+     *
+     **/
+    template<typename Type>
+    inline void Keep(const Type& value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+
+    /** Run
+     *
+     *  Run a benchmark with warmup and repetitions, timing each repetition.
+     *
+     *  @param[in] strSuite The suite the benchmark belongs to.
+     *  @param[in] strName The name of the benchmark.
+     *  @param[in] nOps The number of operations each call of the function does.
+     *  @param[in] func The function to benchmark.
+     *
+     *  @return The summary of the benchmark.
+     *
+     **/
+    template<typename Function>
+    Result Run(const std::string& strSuite, const std::string& strName, const uint64_t nOps, const Function& func)
+    {
+        for(uint32_t n = 0; n < Warmup(); ++n)
+            func();
+
+        std::vector<uint64_t> vTimes;
+        vTimes.reserve(Repetitions());
+
+        runtime::timer timer;
+        for(uint32_t n = 0; n < Repetitions(); ++n)
+        {
+            timer.Start();
+            func();
+            vTimes.push_back(timer.ElapsedNanoseconds());
+        }
+
+        return Summarize(strSuite, strName, nOps, vTimes);
+    }
+
+
+    /** Results
+     *
+     *  Get the results of this run as JSON.
+     *
+     **/
+    json::json Results();
+
+
+    /** Write
+     *
+     *  Write the results of this run to a JSON file.
+     *
+     *  @param[in] strPath The path of the file to write.
+     *
+     *  @return True if the file was written.
+     *
+     **/
+    bool Write(const std::string& strPath);
+
+
+    /** Compare
+     *
+     *  Compare the results of this run to a baseline written by an earlier run, logging
+     *  the change in operations per second of each benchmark in both runs.
+     *
+     *  @param[in] strPath The path of the baseline file.
+     *  @param[in] dThreshold The fraction of throughput loss that counts as a regression.
+     *
+     *  @return The number of regressions, or -1 if the baseline couldn't be read.
+     *
+     **/
+    int32_t Compare(const std::string& strPath, const double dThreshold);
+
+}
+
+#endif
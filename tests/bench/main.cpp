@@ -11,9 +11,11 @@
 
 ____________________________________________________________________________________________*/
 
-#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_RUNNER
 #include <unit/catch2/catch.hpp>
 
+#include <bench/harness.h>
+
 #include <LLD/include/global.h>
 
 #include <Util/include/filesystem.h>
@@ -50,3 +52,39 @@ TEST_CASE("Arguments Tests", "[args]")
     LLD::Legacy   = new LLD::LegacyDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
 
 }
+
+
+/* Run the benchmarks, then write and compare the results if requested. */
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    /* Add the harness options to the Catch command line. */
+    std::string strJSON;
+    std::string strBaseline;
+    double dThreshold = 0.10;
+
+    using namespace Catch::clara;
+    session.cli(session.cli()
+        | Opt(strJSON, "path")["--bench-json"]("write the results as JSON")
+        | Opt(strBaseline, "path")["--bench-baseline"]("compare the results to an earlier JSON run")
+        | Opt(dThreshold, "fraction")["--bench-threshold"]("throughput loss counted as a regression (default 0.10)")
+        | Opt(bench::Repetitions(), "count")["--bench-reps"]("timed repetitions per benchmark (default 10)")
+        | Opt(bench::Warmup(), "count")["--bench-warmup"]("untimed repetitions per benchmark (default 2)"));
+
+    int32_t nStatus = session.applyCommandLine(argc, argv);
+    if(nStatus != 0)
+        return nStatus;
+
+    nStatus = session.run();
+
+    /* Write the results for later runs to compare against. */
+    if(!strJSON.empty() && !bench::Write(strJSON))
+        return 1;
+
+    /* Fail the run on regressions. */
+    if(!strBaseline.empty() && bench::Compare(strBaseline, dThreshold) != 0)
+        return 1;
+
+    return nStatus;
+}
@@ -0,0 +1,296 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/types/uint1024.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <map>
+#include <unordered_set>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/* Reference arithmetic on little endian 32-bit words, using the original schoolbook algorithms. */
+typedef std::vector<uint32_t> Words;
+
+
+/* Get the words of a number. */
+template<uint32_t BITS>
+Words ref_words(const base_uint<BITS>& n)
+{
+    Words vWords(BITS / 32);
+    for(uint32_t i = 0; i < BITS / 32; ++i)
+        vWords[i] = n.get(i);
+
+    return vWords;
+}
+
+
+/* Compare two numbers of the same width. */
+int ref_compare(const Words& a, const Words& b)
+{
+    for(int32_t i = static_cast<int32_t>(a.size()) - 1; i >= 0; --i)
+    {
+        if(a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+
+/* Add two numbers, wrapping at the width. */
+Words ref_add(const Words& a, const Words& b)
+{
+    Words vRet(a.size());
+
+    uint64_t carry = 0;
+    for(uint32_t i = 0; i < a.size(); ++i)
+    {
+        const uint64_t n = carry + a[i] + b[i];
+        vRet[i] = static_cast<uint32_t>(n);
+        carry   = n >> 32;
+    }
+
+    return vRet;
+}
+
+
+/* Subtract two numbers, wrapping at the width. */
+Words ref_sub(const Words& a, const Words& b)
+{
+    Words vRet(a.size());
+
+    int64_t borrow = 0;
+    for(uint32_t i = 0; i < a.size(); ++i)
+    {
+        const int64_t n = static_cast<int64_t>(a[i]) - b[i] - borrow;
+        vRet[i] = static_cast<uint32_t>(n);
+        borrow  = (n < 0);
+    }
+
+    return vRet;
+}
+
+
+/* Multiply two numbers, truncating to the width. */
+Words ref_mul(const Words& a, const Words& b)
+{
+    Words vRet(a.size(), 0);
+    for(uint32_t j = 0; j < a.size(); ++j)
+    {
+        uint64_t carry = 0;
+        for(uint32_t i = 0; i + j < a.size(); ++i)
+        {
+            const uint64_t n = carry + vRet[i + j] + static_cast<uint64_t>(a[j]) * b[i];
+            vRet[i + j] = static_cast<uint32_t>(n);
+            carry       = n >> 32;
+        }
+    }
+
+    return vRet;
+}
+
+
+/* Divide two numbers one bit at a time. */
+Words ref_div(const Words& a, const Words& b)
+{
+    /* The remainder has an extra word so the shift never overflows. */
+    Words vQuotient(a.size(), 0);
+    Words vRemainder(a.size() + 1, 0);
+    Words vDivisor(b);
+    vDivisor.push_back(0);
+
+    for(int32_t nBit = static_cast<int32_t>(a.size() * 32) - 1; nBit >= 0; --nBit)
+    {
+        /* Shift the next bit of the numerator into the remainder. */
+        for(int32_t i = static_cast<int32_t>(vRemainder.size()) - 1; i > 0; --i)
+            vRemainder[i] = (vRemainder[i] << 1) | (vRemainder[i - 1] >> 31);
+        vRemainder[0] = (vRemainder[0] << 1) | ((a[nBit / 32] >> (nBit % 32)) & 1);
+
+        if(ref_compare(vRemainder, vDivisor) >= 0)
+        {
+            vRemainder = ref_sub(vRemainder, vDivisor);
+            vQuotient[nBit / 32] |= (1u << (nBit % 32));
+        }
+    }
+
+    return vQuotient;
+}
+
+
+/* Build a random number, biased towards the word patterns that trip carries and quotient estimates. */
+template<uint32_t BITS>
+base_uint<BITS> random_uint(std::mt19937_64& rng)
+{
+    std::vector<uint32_t> vWords(BITS / 32, 0);
+
+    const uint32_t nUsed = 1 + rng() % (BITS / 32);
+    for(uint32_t i = 0; i < nUsed; ++i)
+    {
+        switch(rng() % 4)
+        {
+            case 0:  vWords[i] = 0;                                    break;
+            case 1:  vWords[i] = 0xffffffff;                           break;
+            case 2:  vWords[i] = static_cast<uint32_t>(1) << (rng() % 32); break;
+            default: vWords[i] = static_cast<uint32_t>(rng());         break;
+        }
+    }
+
+    base_uint<BITS> nRet;
+    nRet.set(vWords);
+
+    return nRet;
+}
+
+
+/* Check every operator against the reference for random operands of one width. */
+template<uint32_t BITS>
+void check_equivalence(const uint32_t nRounds)
+{
+    std::mt19937_64 rng(BITS);
+
+    for(uint32_t n = 0; n < nRounds; ++n)
+    {
+        const base_uint<BITS> a = random_uint<BITS>(rng);
+        const base_uint<BITS> b = random_uint<BITS>(rng);
+
+        const Words vA = ref_words(a);
+        const Words vB = ref_words(b);
+
+        REQUIRE(ref_words(a + b) == ref_add(vA, vB));
+        REQUIRE(ref_words(a - b) == ref_sub(vA, vB));
+        REQUIRE(ref_words(a * b) == ref_mul(vA, vB));
+
+        /* The 64-bit multiply is a full multiply by a number with two words. */
+        const uint64_t n64 = b.Get64(0);
+        REQUIRE(ref_words(a * n64) == ref_mul(vA, ref_words(base_uint<BITS>(n64))));
+
+        /* Divide by the full number and by a shortened one, to cover short and long division. */
+        if(b != 0)
+        {
+            REQUIRE(ref_words(a / b) == ref_div(vA, vB));
+        }
+
+        const base_uint<BITS> c = (b >> (rng() % BITS)) + 1;
+        REQUIRE(ref_words(a / c) == ref_div(vA, ref_words(c)));
+
+        /* The ordering agrees with the reference in every operator. */
+        const int nCompare = ref_compare(vA, vB);
+        REQUIRE((a <  b) == (nCompare <  0));
+        REQUIRE((a <= b) == (nCompare <= 0));
+        REQUIRE((a >  b) == (nCompare >  0));
+        REQUIRE((a >= b) == (nCompare >= 0));
+        REQUIRE((a == b) == (nCompare == 0));
+        REQUIRE((a != b) == (nCompare != 0));
+
+        /* Every bit counts towards the size. */
+        uint32_t nBits = 0;
+        for(uint32_t i = 0; i < BITS; ++i)
+        {
+            if(vA[i / 32] & (1u << (i % 32)))
+                nBits = i + 1;
+        }
+        REQUIRE(a.bits() == nBits);
+    }
+}
+
+
+TEST_CASE( "Base Uint Arithmetic Equivalence", "[LLC]")
+{
+    check_equivalence<128>(2000);
+    check_equivalence<256>(2000);
+    check_equivalence<512>(1000);
+    check_equivalence<576>(1000);
+    check_equivalence<1024>(500);
+    check_equivalence<1056>(500);
+    check_equivalence<1088>(500);
+}
+
+
+TEST_CASE( "Base Uint Arithmetic Edge Cases", "[LLC]")
+{
+    const uint1024_t nMax = ~uint1024_t(0);
+
+    /* Carries and borrows run through every limb. */
+    REQUIRE(nMax + 1 == 0);
+    REQUIRE(uint1024_t(0) - 1 == nMax);
+    REQUIRE(nMax * nMax == 1);
+    REQUIRE(nMax / nMax == 1);
+    REQUIRE(nMax / 1 == nMax);
+    REQUIRE(uint1024_t(7) / nMax == 0);
+
+    /* The odd top word of a 1056-bit number is kept and truncated like the others. */
+    uint1056_t nTop = 1;
+    nTop <<= 1055;
+    REQUIRE((nTop * 2) == 0);
+    REQUIRE((nTop / nTop) == 1);
+    REQUIRE(((nTop - 1) + 1) == nTop);
+    REQUIRE(nTop.bits() == 1056);
+    REQUIRE(nTop > (nTop - 1));
+
+    /* Division by zero still throws. */
+    uint256_t nZero = 0;
+    REQUIRE_THROWS_AS(uint256_t(5) / nZero, std::domain_error);
+    REQUIRE(nZero.bits() == 0);
+}
+
+
+TEST_CASE( "Base Uint Serialization Layout", "[LLC]")
+{
+    /* The words stay in little endian order, so serialized bytes are unchanged. */
+    uint256_t n;
+    n.SetHex("0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+
+    const std::vector<uint8_t> vBytes(n.begin(), n.end());
+    REQUIRE(vBytes.size() == 32);
+    REQUIRE(vBytes[0]  == 0x20);
+    REQUIRE(vBytes[31] == 0x01);
+    REQUIRE(n.get(0) == 0x1d1e1f20);
+
+    /* Arithmetic results are stored back in the same layout. */
+    const uint256_t nSum = n + n;
+    REQUIRE(nSum.GetHex() == "020406080a0c0e10121416181a1c1e20222426282a2c2e30323436383a3c3e40");
+}
+
+
+TEST_CASE( "Base Uint Map Keys", "[LLC]")
+{
+    std::mt19937_64 rng(1);
+
+    /* Ordered and hashed containers agree on the number of distinct keys. */
+    std::map<uint256_t, uint32_t> mapKeys;
+    std::vector<uint256_t> vKeys;
+    for(uint32_t n = 0; n < 1000; ++n)
+    {
+        const uint256_t hash = random_uint<256>(rng);
+
+        mapKeys[hash] = n;
+        vKeys.push_back(hash);
+    }
+
+    std::unordered_set<uint256_t> setKeys(vKeys.begin(), vKeys.end());
+    REQUIRE(setKeys.size() == mapKeys.size());
+
+    /* Keys iterate in ascending order. */
+    uint256_t hashLast = 0;
+    bool fFirst = true;
+    for(const auto& entry : mapKeys)
+    {
+        REQUIRE((fFirst || hashLast < entry.first));
+
+        hashLast = entry.first;
+        fFirst   = false;
+    }
+}
@@ -15,6 +15,8 @@ ________________________________________________________________________________
 #include <LLC/types/bignum.h>
 #include <LLC/include/random.h>
 #include <LLC/prime/fermat.h>
+#include <TAO/Ledger/include/prime.h>
+#include <Util/include/args.h>
 #include <openssl/bn.h>
 #include <unit/catch2/catch.hpp>
 
@@ -82,3 +84,60 @@ TEST_CASE("Fermat Tests", "[LLC]")
 
 
 }
+
+
+TEST_CASE("Fermat Full Width Tests", "[LLC]")
+{
+    /* Origins are at least 1016 bits and the top bit is often set, which needs the extra carry word. */
+    for(uint32_t i = 0; i < 1000; ++i)
+    {
+        uint1024_t bn1 = LLC::GetRand1024();
+        bn1 |= 1; //make odd
+
+        /* Force the highest order bit on half of the runs. */
+        if(i % 2 == 0)
+            bn1 |= (uint1024_t(0x80000000) << 992);
+
+        /* All ones words exercise the borrow and carry chains. */
+        if(i % 10 == 0)
+            bn1 |= (uint1024_t(0xffffffffffffffff) << 512);
+
+        LLC::CBigNum bn2(bn1);
+
+        REQUIRE(fermat_prime(bn1).GetHex() == FermatTest2(bn2).getuint1024().GetHex());
+        REQUIRE(TAO::Ledger::FermatTest(bn1).GetHex() == FermatTest2(bn2).getuint1024().GetHex());
+    }
+
+    /* Largest odd value. */
+    uint1024_t bnMax = ~uint1024_t(0);
+    REQUIRE(fermat_prime(bnMax).GetHex() == FermatTest2(LLC::CBigNum(bnMax)).getuint1024().GetHex());
+}
+
+
+TEST_CASE("Fermat Batch Tests", "[LLC]")
+{
+    /* Build a cluster style batch of odd offsets from a random origin, even numbers fall back to OpenSSL. */
+    uint1024_t hashOrigin = LLC::GetRand1024() | (uint1024_t(0x80000000) << 992);
+    hashOrigin |= 1;
+
+    std::vector<uint1024_t> vTests;
+    for(uint32_t i = 0; i < 64; ++i)
+        vTests.push_back(hashOrigin + i);
+
+    /* Run the batch through both the OpenSSL path and the montgomery kernel. */
+    for(const char* strKernel : {"0", "1"})
+    {
+        config::mapArgs["-fermatkernel"] = strKernel;
+
+        std::vector<uint1024_t> vRemainders;
+        TAO::Ledger::FermatTest(vTests, vRemainders);
+
+        REQUIRE(vRemainders.size() == vTests.size());
+        for(uint32_t i = 0; i < vTests.size(); ++i)
+        {
+            REQUIRE(vRemainders[i].GetHex() == FermatTest2(LLC::CBigNum(vTests[i])).getuint1024().GetHex());
+        }
+    }
+
+    config::mapArgs.erase("-fermatkernel");
+}
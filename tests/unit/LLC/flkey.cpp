@@ -0,0 +1,189 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/flkey.h>
+#include <LLC/include/flverifier.h>
+#include <LLC/include/random.h>
+
+#include <LLC/falcon/avx2.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE( "FLKey Verify Tests", "[LLC]")
+{
+    LLC::FLKey key;
+    key.MakeNewKey();
+    REQUIRE(key.IsValid());
+
+    std::vector<uint8_t> vchData = LLC::GetRand256().GetBytes();
+
+    std::vector<uint8_t> vchSig;
+    REQUIRE(key.Sign(vchData, vchSig));
+
+    /* Verify from a public key only, twice so the second pass hits the expanded key cache. */
+    LLC::FLKey keyPub;
+    REQUIRE(keyPub.SetPubKey(key.GetPubKey()));
+    REQUIRE(keyPub.Verify(vchData, vchSig));
+    REQUIRE(keyPub.Verify(vchData, vchSig));
+
+    /* Verifier with its own cache must agree with the reference implementation. */
+    LLC::FLVerifier verifier(2);
+    std::vector<uint8_t> vchPubKey = key.GetPubKey();
+    std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_VERIFY(9), 0);
+    REQUIRE(falcon_verify(&vchSig[0], vchSig.size(), &vchPubKey[0], vchPubKey.size(),
+        &vchData[0], vchData.size(), &vchTemp[0], vchTemp.size()) == 0);
+    REQUIRE(verifier.Verify(vchPubKey, vchData, vchSig));
+
+    /* Tampered data must fail. */
+    std::vector<uint8_t> vchBad = vchData;
+    vchBad[0] ^= 0x01;
+    REQUIRE_FALSE(keyPub.Verify(vchBad, vchSig));
+    REQUIRE_FALSE(verifier.Verify(vchPubKey, vchBad, vchSig));
+
+    /* A different key must fail even while the first key is cached. */
+    LLC::FLKey keyOther;
+    keyOther.MakeNewKey();
+    REQUIRE_FALSE(verifier.Verify(keyOther.GetPubKey(), vchData, vchSig));
+    REQUIRE(verifier.Verify(vchPubKey, vchData, vchSig));
+
+    /* Malformed signatures and keys must fail cleanly. */
+    std::vector<uint8_t> vchShort(vchSig.begin(), vchSig.begin() + 10);
+    REQUIRE_FALSE(verifier.Verify(vchPubKey, vchData, vchShort));
+
+    std::vector<uint8_t> vchKeyBad(vchPubKey.begin(), vchPubKey.end() - 1);
+    REQUIRE_FALSE(verifier.Verify(vchKeyBad, vchData, vchSig));
+}
+
+
+/* Make a falcon key pair and signature of any degree from a fixed seed. */
+static void make_falcon(const uint32_t nLogN, const std::vector<uint8_t>& vchData,
+                        std::vector<uint8_t> &vchPubKey, std::vector<uint8_t> &vchSig)
+{
+    shake256_context ctx;
+    shake256_init_prng_from_seed(&ctx, "flverifier", 10);
+
+    std::vector<uint8_t> vchPrivKey(FALCON_PRIVKEY_SIZE(nLogN), 0);
+    vchPubKey.assign(FALCON_PUBKEY_SIZE(nLogN), 0);
+
+    std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_KEYGEN(nLogN), 0);
+    REQUIRE(falcon_keygen_make(&ctx, nLogN, &vchPrivKey[0], vchPrivKey.size(),
+        &vchPubKey[0], vchPubKey.size(), &vchTemp[0], vchTemp.size()) == 0);
+
+    vchSig.assign(FALCON_SIG_CT_SIZE(nLogN), 0);
+    vchTemp.assign(FALCON_TMPSIZE_SIGNDYN(nLogN), 0);
+
+    size_t nSize = vchSig.size();
+    REQUIRE(falcon_sign_dyn(&ctx, &vchSig[0], &nSize, &vchPrivKey[0], vchPrivKey.size(),
+        &vchData[0], vchData.size(), 1, &vchTemp[0], vchTemp.size()) == 0);
+    vchSig.resize(nSize);
+}
+
+
+TEST_CASE( "FLVerifier Degree Consensus Tests", "[LLC]")
+{
+    const std::vector<uint8_t> vchData(32, 0x42);
+
+    /* A genuine logn 10 signature is valid to falcon, but FLKey::Verify always rejected it. */
+    {
+        std::vector<uint8_t> vchPubKey, vchSig;
+        make_falcon(10, vchData, vchPubKey, vchSig);
+
+        std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_VERIFY(10), 0);
+        REQUIRE(falcon_verify(&vchSig[0], vchSig.size(), &vchPubKey[0], vchPubKey.size(),
+            &vchData[0], vchData.size(), &vchTemp[0], vchTemp.size()) == 0);
+
+        LLC::FLVerifier verifier(2);
+        REQUIRE_FALSE(verifier.Verify(vchPubKey, vchData, vchSig));
+
+        LLC::FLKey keyPub;
+        REQUIRE(keyPub.SetPubKey(vchPubKey));
+        REQUIRE_FALSE(keyPub.Verify(vchData, vchSig));
+    }
+
+    /* Smaller degrees fit the logn 9 scratch space, so the old rules accepted them and so must we. */
+    {
+        std::vector<uint8_t> vchPubKey, vchSig;
+        make_falcon(8, vchData, vchPubKey, vchSig);
+
+        std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_VERIFY(9), 0);
+        REQUIRE(falcon_verify(&vchSig[0], vchSig.size(), &vchPubKey[0], vchPubKey.size(),
+            &vchData[0], vchData.size(), &vchTemp[0], vchTemp.size()) == 0);
+
+        LLC::FLVerifier verifier(2);
+        REQUIRE(verifier.Verify(vchPubKey, vchData, vchSig));
+    }
+}
+
+
+TEST_CASE( "Falcon AVX2 Build Tests", "[LLC]")
+{
+#if FALCON_AVX2_DISPATCH
+    if(!falcon_avx2_supported())
+        return;
+
+    /* Both builds generate the same key pair from the same seed. */
+    const std::vector<uint8_t> vchSeed = LLC::GetRand256().GetBytes();
+
+    std::vector<uint8_t> vchPriv[2], vchPub[2], vchSig[2];
+    for(uint32_t n = 0; n < 2; ++n)
+    {
+        vchPriv[n].resize(FALCON_PRIVKEY_SIZE(9));
+        vchPub[n].resize(FALCON_PUBKEY_SIZE(9));
+
+        std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_KEYGEN(9), 0);
+
+        shake256_context ctx;
+        shake256_init_prng_from_seed(&ctx, &vchSeed[0], vchSeed.size());
+
+        const int nRet = (n == 0 ?
+            falcon_keygen_make(&ctx, 9, &vchPriv[n][0], vchPriv[n].size(), &vchPub[n][0], vchPub[n].size(), &vchTemp[0], vchTemp.size()) :
+            falcon_avx2_keygen_make(&ctx, 9, &vchPriv[n][0], vchPriv[n].size(), &vchPub[n][0], vchPub[n].size(), &vchTemp[0], vchTemp.size()));
+
+        REQUIRE(nRet == 0);
+    }
+
+    REQUIRE(vchPriv[0] == vchPriv[1]);
+    REQUIRE(vchPub[0] == vchPub[1]);
+
+    /* And the same signature from the same random state. */
+    const std::vector<uint8_t> vchData = LLC::GetRand256().GetBytes();
+    for(uint32_t n = 0; n < 2; ++n)
+    {
+        vchSig[n].resize(1025);
+        size_t nSize = vchSig[n].size();
+
+        std::vector<uint8_t> vchTemp(FALCON_TMPSIZE_SIGNDYN(9), 0);
+
+        shake256_context ctx;
+        shake256_init_prng_from_seed(&ctx, &vchSeed[0], vchSeed.size());
+
+        const int nRet = (n == 0 ?
+            falcon_sign_dyn(&ctx, &vchSig[n][0], &nSize, &vchPriv[0][0], vchPriv[0].size(), &vchData[0], vchData.size(), 1, &vchTemp[0], vchTemp.size()) :
+            falcon_avx2_sign_dyn(&ctx, &vchSig[n][0], &nSize, &vchPriv[0][0], vchPriv[0].size(), &vchData[0], vchData.size(), 1, &vchTemp[0], vchTemp.size()));
+
+        REQUIRE(nRet == 0);
+        vchSig[n].resize(nSize);
+    }
+
+    REQUIRE(vchSig[0] == vchSig[1]);
+
+    /* The dispatched key signs and verifies. */
+    LLC::FLKey key;
+    REQUIRE(key.SetSecret(LLC::CSecret(vchSeed.begin(), vchSeed.end())));
+    REQUIRE(key.GetPubKey() == vchPub[0]);
+
+    std::vector<uint8_t> vchCheck;
+    REQUIRE(key.Sign(vchData, vchCheck));
+    REQUIRE(key.Verify(vchData, vchCheck));
+#endif
+}
@@ -0,0 +1,151 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/hash/SK/times4.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <cstring>
+
+
+/* Messages of every size around the Skein and Keccak block boundaries, with deterministic contents. */
+std::vector<std::vector<uint8_t>> SKTestMessages()
+{
+    std::vector<std::vector<uint8_t>> vMessages;
+
+    uint64_t nState = 0x9e3779b97f4a7c15;
+    for(uint32_t nSize = 0; nSize <= 300; ++nSize)
+    {
+        std::vector<uint8_t> vData(nSize);
+        for(auto& nByte : vData)
+        {
+            nState = nState * 6364136223846793005 + 1442695040888963407;
+            nByte  = static_cast<uint8_t>(nState >> 56);
+        }
+
+        vMessages.push_back(vData);
+    }
+
+    /* Add a few large messages. */
+    vMessages.push_back(std::vector<uint8_t>(1000, 0x5a));
+    vMessages.push_back(std::vector<uint8_t>(4096, 0xa5));
+
+    return vMessages;
+}
+
+
+TEST_CASE("Keccak-f1600 unrolled permutation", "[LLC]")
+{
+    uint64_t a[25];
+    uint64_t b[25];
+    for(uint32_t i = 0; i < 25; ++i)
+        a[i] = b[i] = 0x0123456789abcdef * (i + 1);
+
+    for(uint32_t n = 0; n < 16; ++n)
+    {
+        KeccakF1600_StatePermute(a);
+        KeccakF1600_StatePermute_Compact(b);
+
+        REQUIRE(memcmp(a, b, sizeof(a)) == 0);
+    }
+}
+
+
+TEST_CASE("SK512 batch matches SK512", "[LLC]")
+{
+    std::vector<std::vector<uint8_t>> vMessages = SKTestMessages();
+
+    std::vector<std::pair<const uint8_t*, uint64_t>> vData;
+    for(const auto& vMessage : vMessages)
+        vData.push_back(std::make_pair(vMessage.data(), vMessage.size()));
+
+    std::vector<uint512_t> vHashes;
+    LLC::SK512Batch(vData, vHashes);
+
+    REQUIRE(vHashes.size() == vMessages.size());
+    for(uint32_t n = 0; n < vMessages.size(); ++n)
+    {
+        REQUIRE(vHashes[n] == LLC::SK512(vMessages[n].begin(), vMessages[n].end()));
+    }
+
+    /* Merkle style pairs of hashes, as hashed by SK512 over the left and right leaves. */
+    std::vector<uint8_t> vPairs(7 * 128);
+    for(uint32_t n = 0; n < vPairs.size(); ++n)
+        vPairs[n] = static_cast<uint8_t>(n * 31);
+
+    vData.clear();
+    for(uint32_t n = 0; n < 7; ++n)
+        vData.push_back(std::make_pair(&vPairs[n * 128], uint64_t(128)));
+
+    LLC::SK512Batch(vData, vHashes);
+    for(uint32_t n = 0; n < 7; ++n)
+    {
+        const uint8_t* pLeft  = &vPairs[n * 128];
+        const uint8_t* pRight = pLeft + 64;
+
+        REQUIRE(vHashes[n] == LLC::SK512(pLeft, pLeft + 64, pRight, pRight + 64));
+    }
+
+    /* An empty batch. */
+    vData.clear();
+    LLC::SK512Batch(vData, vHashes);
+    REQUIRE(vHashes.empty());
+}
+
+
+TEST_CASE("SK1024 batch matches SK1024", "[LLC]")
+{
+    std::vector<std::vector<uint8_t>> vMessages = SKTestMessages();
+
+    std::vector<std::pair<const uint8_t*, uint64_t>> vData;
+    for(const auto& vMessage : vMessages)
+        vData.push_back(std::make_pair(vMessage.data(), vMessage.size()));
+
+    std::vector<uint1024_t> vHashes;
+    LLC::SK1024Batch(vData, vHashes);
+
+    REQUIRE(vHashes.size() == vMessages.size());
+    for(uint32_t n = 0; n < vMessages.size(); ++n)
+    {
+        REQUIRE(vHashes[n] == LLC::SK1024(vMessages[n].begin(), vMessages[n].end()));
+    }
+}
+
+
+#ifdef SK_TIMES4_AVX2
+TEST_CASE("Keccak-f1600 times4 permutation", "[LLC]")
+{
+    if(!LLC::SupportsAVX2())
+        return;
+
+    /* Four different states, interleaved. */
+    uint64_t states[25 * 4];
+    uint64_t single[4][25];
+    for(uint32_t k = 0; k < 25; ++k)
+        for(uint32_t i = 0; i < 4; ++i)
+            states[k * 4 + i] = single[i][k] = 0x0123456789abcdef * (k + 1) + i;
+
+    LLC::KeccakF1600_StatePermute_times4(states);
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        KeccakF1600_StatePermute(single[i]);
+
+        for(uint32_t k = 0; k < 25; ++k)
+        {
+            REQUIRE(states[k * 4 + i] == single[i][k]);
+        }
+    }
+}
+#endif
@@ -0,0 +1,246 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <LLD/cache/binary_lru.h>
+#include <LLD/cache/cache_budget.h>
+#include <LLD/templates/key.h>
+
+#include <string>
+#include <vector>
+
+/* Build a binary key from a number. */
+static std::vector<uint8_t> test_key(const uint32_t nKey)
+{
+    const std::string strKey = "key" + std::to_string(nKey);
+
+    return std::vector<uint8_t>(strKey.begin(), strKey.end());
+}
+
+
+/* Add a record, by default using the key number as its sector so slots don't collide. */
+static void test_put(LLD::BinaryLRU& cache, const uint32_t nKey, const uint32_t nSize = 1000, const uint32_t nSector = 0)
+{
+    const std::vector<uint8_t> vKey = test_key(nKey);
+
+    cache.Put(LLD::SectorKey(0, vKey, 0, nSector ? nSector : nKey, nSize), vKey,
+              std::vector<uint8_t>(nSize, static_cast<uint8_t>(nKey)));
+}
+
+
+TEST_CASE( "BinaryLRU get and remove", "[LLD]")
+{
+    LLD::BinaryLRU cache(64 * 1024);
+
+    test_put(cache, 1);
+    REQUIRE(cache.Has(test_key(1)));
+    REQUIRE(!cache.Has(test_key(2)));
+
+    std::vector<uint8_t> vData;
+    REQUIRE(cache.Get(test_key(1), vData));
+    REQUIRE(vData == std::vector<uint8_t>(1000, 1));
+
+    /* Overwriting a key replaces the data. */
+    const std::vector<uint8_t> vKey = test_key(1);
+    cache.Put(LLD::SectorKey(0, vKey, 0, 1, 3), vKey, std::vector<uint8_t>(3, 7));
+    REQUIRE(cache.Get(vKey, vData));
+    REQUIRE(vData == std::vector<uint8_t>(3, 7));
+
+    REQUIRE(cache.Remove(vKey));
+    REQUIRE(!cache.Has(vKey));
+    REQUIRE(!cache.Get(vKey, vData));
+
+    /* Stats count the lookups since the last call. */
+    uint64_t nHits = 0, nMisses = 0;
+    cache.Stats(nHits, nMisses);
+    REQUIRE(nHits == 2);
+    REQUIRE(nMisses == 1);
+
+    cache.Stats(nHits, nMisses);
+    REQUIRE(nHits == 0);
+    REQUIRE(nMisses == 0);
+}
+
+
+TEST_CASE( "BinaryLRU scan resistance", "[LLD]")
+{
+    LLD::BinaryLRU cache(64 * 1024);
+
+    /* Allocate the nodes of the scan's sectors up front, so their memory doesn't count against the working set. */
+    for(uint32_t nSector = 100; nSector < 150; ++nSector)
+        test_put(cache, 1000 + nSector, 1000, nSector);
+
+    /* Build a working set that is read often. */
+    std::vector<uint8_t> vData;
+    for(uint32_t nKey = 0; nKey < 20; ++nKey)
+    {
+        test_put(cache, nKey);
+        for(uint32_t nRead = 0; nRead < 4; ++nRead)
+            cache.Get(test_key(nKey), vData);
+    }
+
+    /* Scan through four times the capacity of the cache, reading every record once. */
+    for(uint32_t nKey = 100; nKey < 300; ++nKey)
+    {
+        test_put(cache, nKey, 1000, 100 + nKey % 50);
+        cache.Get(test_key(nKey), vData);
+    }
+
+    /* A plain LRU would have evicted the whole working set. Only keys whose bucket was taken are lost. */
+    uint32_t nKept = 0;
+    for(uint32_t nKey = 0; nKey < 20; ++nKey)
+        if(cache.Has(test_key(nKey)))
+            ++nKept;
+
+    REQUIRE(nKept >= 10);
+}
+
+
+TEST_CASE( "BinaryLRU resize", "[LLD]")
+{
+    LLD::BinaryLRU cache(256 * 1024);
+    REQUIRE(cache.MaxSize() == 256 * 1024);
+
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        test_put(cache, nKey);
+
+    uint32_t nBefore = 0;
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        if(cache.Has(test_key(nKey)))
+            ++nBefore;
+
+    /* Shrinking evicts down to the new size straight away. */
+    cache.SetMaxSize(32 * 1024);
+    REQUIRE(cache.MaxSize() == 32 * 1024);
+
+    uint32_t nAfter = 0;
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        if(cache.Has(test_key(nKey)))
+            ++nAfter;
+
+    REQUIRE(nAfter < nBefore);
+    REQUIRE(nAfter <= 32);
+}
+
+
+TEST_CASE( "BinaryLRU grow and shrink rehash", "[LLD]")
+{
+    /* A small cache only has buckets for a few hundred records. */
+    LLD::BinaryLRU cache(32 * 1024);
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        test_put(cache, nKey);
+
+    uint32_t nSmall = 0;
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        if(cache.Has(test_key(nKey)))
+            ++nSmall;
+
+    REQUIRE(nSmall <= 32);
+
+    /* Once grown, the cache holds the whole set instead of losing keys to bucket collisions. */
+    cache.SetMaxSize(256 * 1024);
+    REQUIRE(cache.MaxSize() == 256 * 1024);
+
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        test_put(cache, nKey);
+
+    uint32_t nGrown = 0;
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+        if(cache.Has(test_key(nKey)))
+            ++nGrown;
+
+    REQUIRE(nGrown > nSmall);
+    REQUIRE(nGrown >= 90);
+
+    /* Records kept through the rehash can still be read. */
+    std::vector<uint8_t> vData;
+    for(uint32_t nKey = 0; nKey < 100; ++nKey)
+    {
+        if(cache.Get(test_key(nKey), vData))
+        {
+            REQUIRE(vData == std::vector<uint8_t>(1000, static_cast<uint8_t>(nKey)));
+        }
+    }
+
+    /* A large cache shrunk below the fixed cost of its old buckets still keeps new records. */
+    LLD::BinaryLRU large(4 * 1024 * 1024);
+    large.SetMaxSize(LLD::MIN_CACHE_SIZE);
+
+    for(uint32_t nKey = 0; nKey < 10; ++nKey)
+        test_put(large, nKey);
+
+    uint32_t nKept = 0;
+    for(uint32_t nKey = 0; nKey < 10; ++nKey)
+        if(large.Has(test_key(nKey)))
+            ++nKept;
+
+    REQUIRE(nKept == 10);
+}
+
+
+TEST_CASE( "CacheBudget rebalance", "[LLD]")
+{
+    LLD::BinaryLRU cold(1024 * 1024);
+    LLD::BinaryLRU hot(1024 * 1024);
+
+    LLD::CacheBudget budget(2 * 1024 * 1024, 0);
+    budget.Add("cold", &cold);
+    budget.Add("hot", &hot);
+
+    /* Nothing moves without misses. */
+    budget.Rebalance();
+    REQUIRE(cold.MaxSize() == 1024 * 1024);
+    REQUIRE(hot.MaxSize() == 1024 * 1024);
+
+    /* One cache keeps missing, the other keeps hitting. */
+    std::vector<uint8_t> vData;
+    test_put(cold, 1);
+    for(uint32_t nKey = 0; nKey < 1000; ++nKey)
+    {
+        cold.Get(test_key(1), vData);
+        hot.Get(test_key(nKey), vData);
+    }
+
+    budget.Rebalance();
+    REQUIRE(hot.MaxSize() > cold.MaxSize());
+    REQUIRE(cold.MaxSize() >= LLD::MIN_CACHE_SIZE);
+
+    /* The budget is preserved within rounding. */
+    uint64_t nTotal = uint64_t(hot.MaxSize()) + cold.MaxSize();
+    REQUIRE(nTotal <= 2 * 1024 * 1024);
+    REQUIRE(nTotal >= 2 * 1024 * 1024 - 2);
+
+    /* With a small budget the even share is below the minimum, so the cold cache ends up held at it. */
+    LLD::BinaryLRU small(512 * 1024);
+    LLD::BinaryLRU busy(512 * 1024);
+
+    LLD::CacheBudget tight(1024 * 1024, 0);
+    tight.Add("small", &small);
+    tight.Add("busy", &busy);
+
+    for(uint32_t nRound = 0; nRound < 8; ++nRound)
+    {
+        for(uint32_t nKey = 0; nKey < 1000; ++nKey)
+            busy.Get(test_key(nKey), vData);
+
+        tight.Rebalance();
+    }
+
+    REQUIRE(small.MaxSize() == LLD::MIN_CACHE_SIZE);
+
+    /* The minimum comes out of the budget rather than adding to it. */
+    nTotal = uint64_t(small.MaxSize()) + busy.MaxSize();
+    REQUIRE(nTotal <= 1024 * 1024);
+    REQUIRE(nTotal >= 1024 * 1024 - 2);
+}
@@ -0,0 +1,158 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <Util/include/args.h>
+#include <Util/include/filesystem.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <fstream>
+
+
+/* A key that no other test writes. */
+static std::pair<std::string, uint256_t> bulk_key()
+{
+    return std::make_pair(std::string("bulktest"), LLC::GetRand256());
+}
+
+
+/* Lose the keys held in memory the way a shutdown would, leaving the files as they are. */
+static void bulk_crash()
+{
+    LLD::Contract->BulkAbort();
+    LLD::Register->BulkAbort();
+    LLD::Ledger->BulkAbort();
+    LLD::Trust->BulkAbort();
+    LLD::Legacy->BulkAbort();
+}
+
+
+TEST_CASE("LLD bulk load tests", "[LLD]")
+{
+    const std::string strActive = config::GetDataDir() + "bulk.active";
+    const std::string strCommit = config::GetDataDir() + "bulk.commit";
+
+
+    /* Keys erased during a bulk load stay erased once the held keys are built. */
+    {
+        const auto keyOld   = bulk_key();
+        const auto keyNew   = bulk_key();
+        const auto keyAgain = bulk_key();
+
+        REQUIRE(LLD::Register->Write(keyOld,   uint256_t(1)));
+        REQUIRE(LLD::Register->Write(keyAgain, uint256_t(2)));
+
+        LLD::BulkBegin();
+        REQUIRE(filesystem::exists(strActive));
+
+        uint256_t hashRead = 0;
+        REQUIRE(LLD::Register->Erase(keyOld));
+        REQUIRE_FALSE(LLD::Register->Read(keyOld, hashRead));
+
+        REQUIRE(LLD::Register->Write(keyNew, uint256_t(3)));
+        REQUIRE(LLD::Register->Erase(keyNew));
+        REQUIRE_FALSE(LLD::Register->Read(keyNew, hashRead));
+
+        REQUIRE(LLD::Register->Erase(keyAgain));
+        REQUIRE(LLD::Register->Write(keyAgain, uint256_t(4)));
+
+        /* A flush in the middle of the load builds the erases too. */
+        REQUIRE(LLD::BulkFlush());
+        REQUIRE_FALSE(LLD::Register->Read(keyOld, hashRead));
+        REQUIRE_FALSE(LLD::Register->Read(keyNew, hashRead));
+
+        REQUIRE(LLD::Register->Erase(keyAgain));
+        REQUIRE(LLD::Register->Write(keyAgain, uint256_t(5)));
+
+        REQUIRE(LLD::BulkCommit());
+        REQUIRE_FALSE(filesystem::exists(strActive));
+        REQUIRE_FALSE(filesystem::exists(strCommit));
+
+        REQUIRE_FALSE(LLD::Register->Read(keyOld, hashRead));
+        REQUIRE_FALSE(LLD::Register->Read(keyNew, hashRead));
+
+        REQUIRE(LLD::Register->Read(keyAgain, hashRead));
+        REQUIRE(hashRead == 5);
+    }
+
+
+    /* A shutdown after the commit marker finishes the build on the next start. */
+    {
+        const auto keyRegister = bulk_key();
+        const auto keyLedger   = bulk_key();
+
+        LLD::BulkBegin();
+        REQUIRE(LLD::Register->Write(keyRegister, uint256_t(6)));
+        REQUIRE(LLD::Ledger->Write(keyLedger, uint256_t(7)));
+
+        /* Stop the flush after the register keychain is built but before the ledger's. */
+        REQUIRE(LLD::Register->BulkPrepare());
+        REQUIRE(LLD::Ledger->BulkPrepare());
+        {
+            std::ofstream stream(strCommit, std::ios::out | std::ios::trunc);
+        }
+        REQUIRE(LLD::Register->BulkBuild());
+
+        bulk_crash();
+
+        uint256_t hashRead = 0;
+        REQUIRE(LLD::Register->Read(keyRegister, hashRead));
+        REQUIRE_FALSE(LLD::Ledger->Read(keyLedger, hashRead));
+
+        LLD::BulkRecovery();
+        REQUIRE_FALSE(filesystem::exists(strActive));
+        REQUIRE_FALSE(filesystem::exists(strCommit));
+
+        REQUIRE(LLD::Ledger->Read(keyLedger, hashRead));
+        REQUIRE(hashRead == 7);
+    }
+
+
+    /* A shutdown before the commit marker rolls every database back to the last flush. */
+    {
+        const auto keyWritten = bulk_key();
+        const auto keyErased  = bulk_key();
+        const auto keyLedger  = bulk_key();
+
+        REQUIRE(LLD::Register->Write(keyWritten, uint256_t(8)));
+        REQUIRE(LLD::Register->Write(keyErased,  uint256_t(9)));
+
+        LLD::BulkBegin();
+        REQUIRE(LLD::Register->Write(keyWritten, uint256_t(10)));
+        REQUIRE(LLD::Register->Erase(keyErased));
+        REQUIRE(LLD::Ledger->Write(keyLedger, uint256_t(11)));
+
+        /* Stop the flush while the spools are being written. */
+        REQUIRE(LLD::Register->BulkPrepare());
+
+        bulk_crash();
+        LLD::BulkRecovery();
+        REQUIRE_FALSE(filesystem::exists(strActive));
+
+        /* The uncommitted spool is gone, so a later build can't apply it. */
+        REQUIRE(LLD::Register->BulkBuild());
+
+        uint256_t hashRead = 0;
+        REQUIRE(LLD::Register->Read(keyWritten, hashRead));
+        REQUIRE(hashRead == 8);
+
+        REQUIRE(LLD::Register->Read(keyErased, hashRead));
+        REQUIRE(hashRead == 9);
+
+        REQUIRE_FALSE(LLD::Ledger->Read(keyLedger, hashRead));
+    }
+}
@@ -0,0 +1,174 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/compress.h>
+#include <LLD/templates/sector.h>
+#include <LLD/keychain/hashmap.h>
+#include <LLD/cache/binary_lru.h>
+
+#include <Util/include/args.h>
+#include <Util/include/filesystem.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+
+/* A sector database that isn't shared with the other tests. */
+typedef LLD::SectorDatabase<LLD::BinaryHashMap, LLD::BinaryLRU> TestDB;
+
+
+/* Bytes that compress well. */
+static std::vector<uint8_t> repeated(const uint32_t nSize, const uint8_t nByte)
+{
+    return std::vector<uint8_t>(nSize, nByte);
+}
+
+
+/* Bytes that don't compress, the same for the same seed. */
+static std::vector<uint8_t> noise(const uint32_t nSize, uint32_t nSeed)
+{
+    std::vector<uint8_t> vData(nSize);
+    for(uint32_t n = 0; n < nSize; ++n)
+    {
+        nSeed ^= nSeed << 13;
+        nSeed ^= nSeed >> 17;
+        nSeed ^= nSeed << 5;
+
+        vData[n] = static_cast<uint8_t>(nSeed);
+    }
+
+    return vData;
+}
+
+
+TEST_CASE("LLD record compression tests", "[LLD]")
+{
+    /* Records compress and decompress back to the same bytes. */
+    {
+        const std::vector< std::vector<uint8_t> > vRecords =
+        {
+            repeated(LLD::MIN_COMPRESS_SIZE, 0x01),
+            repeated(4096, 0x00),
+            repeated(1024 * 1024, 0xab),
+            noise(512, 7)
+        };
+
+        for(const auto& vData : vRecords)
+        {
+            /* Records that don't get smaller are left raw. */
+            std::vector<uint8_t> vRecord;
+            if(!LLD::CompressRecord(vData, vRecord))
+            {
+                continue;
+            }
+
+            REQUIRE(LLD::IsCompressed(vRecord));
+            REQUIRE(vRecord.size() < vData.size());
+
+            std::vector<uint8_t> vRaw;
+            REQUIRE(LLD::DecompressRecord(vRecord, vRaw));
+            REQUIRE(vRaw == vData);
+        }
+
+        /* Small and incompressible records are stored raw. */
+        std::vector<uint8_t> vRecord;
+        REQUIRE_FALSE(LLD::CompressRecord(repeated(LLD::MIN_COMPRESS_SIZE - 1, 0x01), vRecord));
+        REQUIRE_FALSE(LLD::CompressRecord(noise(4096, 11), vRecord));
+
+        /* Raw records, truncated and corrupt headers don't decompress. */
+        std::vector<uint8_t> vRaw;
+        REQUIRE_FALSE(LLD::DecompressRecord(repeated(128, 0x01), vRaw));
+
+        REQUIRE(LLD::CompressRecord(repeated(4096, 0x02), vRecord));
+        REQUIRE_FALSE(LLD::DecompressRecord(std::vector<uint8_t>(vRecord.begin(), vRecord.begin() + 5), vRaw));
+        REQUIRE_FALSE(LLD::DecompressRecord(std::vector<uint8_t>(vRecord.begin(), vRecord.end() - 1), vRaw));
+
+        std::vector<uint8_t> vCorrupt = vRecord;
+        vCorrupt[1] ^= 0x01;
+        REQUIRE_FALSE(LLD::DecompressRecord(vCorrupt, vRaw));
+    }
+
+
+    const std::string strName = "compresstest";
+    filesystem::remove_directories(config::GetDataDir() + strName);
+
+
+    /* Raw records are written before compression is turned on. */
+    {
+        TestDB db(strName, LLD::FLAGS::CREATE | LLD::FLAGS::FORCE, 1024, 1024 * 64);
+        REQUIRE(db.Write(std::string("raw"),     repeated(512, 0x10), "rec"));
+        REQUIRE(db.Write(std::string("noise"),   noise(512, 1),      "rec"));
+        REQUIRE(db.Write(std::string("growing"), noise(512, 2),      "rec"));
+    }
+
+
+    /* Compressed records go in the same sector file, replacing some of the raw ones. */
+    {
+        TestDB db(strName, LLD::FLAGS::CREATE | LLD::FLAGS::FORCE | LLD::FLAGS::COMPRESS, 1024, 1024 * 64);
+
+        /* Incompressible data the same size as the raw record is updated in place. */
+        REQUIRE(db.Write(std::string("noise"), noise(512, 3), "rec"));
+
+        /* Compressible data over a raw record is appended compressed. */
+        REQUIRE(db.Write(std::string("growing"), repeated(512, 0x20), "rec"));
+
+        REQUIRE(db.Write(std::string("packed"), repeated(2048, 0x30), "rec"));
+
+        /* A compressed record the same size as the old one is updated in place. */
+        REQUIRE(db.Write(std::string("packed"), repeated(2048, 0x31), "rec"));
+    }
+
+
+    /* A fresh instance reads every record from disk, whichever way it was written. */
+    {
+        TestDB db(strName, LLD::FLAGS::CREATE | LLD::FLAGS::FORCE, 1024, 1024 * 64);
+
+        std::vector<uint8_t> vData;
+        REQUIRE(db.Read(std::string("raw"), vData));
+        REQUIRE(vData == repeated(512, 0x10));
+
+        REQUIRE(db.Read(std::string("noise"), vData));
+        REQUIRE(vData == noise(512, 3));
+
+        REQUIRE(db.Read(std::string("growing"), vData));
+        REQUIRE(vData == repeated(512, 0x20));
+
+        REQUIRE(db.Read(std::string("packed"), vData));
+        REQUIRE(vData == repeated(2048, 0x31));
+
+        /* A sequential read decodes raw and compressed records alike, including the replaced ones. */
+        std::vector< std::vector<uint8_t> > vRecords;
+        REQUIRE(db.BatchRead("rec", vRecords, -1));
+        REQUIRE(vRecords.size() == 5);
+
+        REQUIRE(vRecords[0] == repeated(512, 0x10));
+        REQUIRE(vRecords[1] == noise(512, 3));
+        REQUIRE(vRecords[2] == noise(512, 2));
+        REQUIRE(vRecords[3] == repeated(512, 0x20));
+        REQUIRE(vRecords[4] == repeated(2048, 0x31));
+
+        /* A limited read stops at the limit across the compressed records too. */
+        REQUIRE(db.BatchRead("rec", vRecords, 4));
+        REQUIRE(vRecords.size() == 4);
+        REQUIRE(vRecords[3] == repeated(512, 0x20));
+
+        /* Reading on from a compressed record's key. */
+        REQUIRE(db.BatchRead(std::string("growing"), "rec", vRecords, -1));
+        REQUIRE(vRecords.size() == 1);
+        REQUIRE(vRecords[0] == repeated(2048, 0x31));
+    }
+
+    filesystem::remove_directories(config::GetDataDir() + strName);
+}
@@ -0,0 +1,210 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <LLP/types/httpnode.h>
+#include <LLP/types/time.h>
+
+#include <string>
+
+/* Node that is fed from a string instead of a socket. */
+class TestHTTPNode : public LLP::HTTPNode
+{
+public:
+
+    void Event(uint8_t EVENT, uint32_t LENGTH = 0) override
+    {
+    }
+
+
+    bool ProcessPacket() override
+    {
+        return true;
+    }
+
+
+    bool Feed(const std::string& strData)
+    {
+        vchBuffer.insert(vchBuffer.end(), strData.begin(), strData.end());
+
+        return Parse();
+    }
+};
+
+
+TEST_CASE( "HTTPNode parses split requests", "[httpnode]")
+{
+    TestHTTPNode node;
+
+    /* Feed the request a few bytes at a time. */
+    const std::string strRequest =
+        "POST /system/get/info HTTP/1.1\r\n"
+        "Content-Type:  application/json \r\n"
+        "Content-Length: 13\r\n"
+        "\r\n"
+        "{\"verbose\":1}";
+
+    for(uint32_t n = 0; n < strRequest.size(); n += 5)
+    {
+        REQUIRE(!node.INCOMING.Complete());
+        REQUIRE(node.Feed(strRequest.substr(n, 5)));
+    }
+
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strType    == "POST");
+    REQUIRE(node.INCOMING.strRequest == "/system/get/info");
+    REQUIRE(node.INCOMING.strVersion == "HTTP/1.1");
+    REQUIRE(node.INCOMING.mapHeaders["content-type"] == "application/json");
+    REQUIRE(node.INCOMING.nContentLength == 13);
+    REQUIRE(node.INCOMING.strContent == "{\"verbose\":1}");
+}
+
+
+TEST_CASE( "HTTPNode pipelined requests", "[httpnode]")
+{
+    TestHTTPNode node;
+
+    /* Three requests in one read. */
+    REQUIRE(node.Feed(
+        "GET /ledger/get/info HTTP/1.1\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n"
+        "POST /a HTTP/1.1\r\n"
+        "Content-Length: 3\r\n"
+        "\r\n"
+        "abc"
+        "POST /b HTTP/1.1\r\n"
+        "Content-Length: 2\r\n"
+        "\r\n"
+        "d"));
+
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strRequest == "/ledger/get/info");
+    REQUIRE(node.INCOMING.mapHeaders["connection"] == "keep-alive");
+    REQUIRE(node.INCOMING.strContent.empty());
+
+    /* The second request is parsed from the data left in the buffer. */
+    node.ResetPacket();
+    REQUIRE(node.Feed(""));
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strRequest == "/a");
+    REQUIRE(node.INCOMING.strContent == "abc");
+
+    /* The third waits for the rest of its content. */
+    node.ResetPacket();
+    REQUIRE(node.Feed(""));
+    REQUIRE(!node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strRequest == "/b");
+
+    REQUIRE(node.Feed("e"));
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strContent == "de");
+}
+
+
+TEST_CASE( "HTTPNode lines split across reads", "[httpnode]")
+{
+    TestHTTPNode node;
+
+    /* A request followed by the start of a pipelined one. */
+    REQUIRE(node.Feed(
+        "GET /a HTTP/1.1\r\n"
+        "\r\n"
+        "GET /b HT"));
+
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strRequest == "/a");
+
+    /* The partial line is kept when the parsed request is dropped. */
+    node.ResetPacket();
+    REQUIRE(node.Feed("TP/1.1\r"));
+    REQUIRE(node.INCOMING.strType.empty());
+
+    /* Feed a long header a byte at a time, with the CRLF split. */
+    REQUIRE(node.Feed("\n"));
+    REQUIRE(node.INCOMING.strRequest == "/b");
+
+    const std::string strHeader = "X-Long: " + std::string(1024, 'x') + "\r\n\r\n";
+    for(const char ch : strHeader)
+    {
+        REQUIRE(!node.INCOMING.Complete());
+        REQUIRE(node.Feed(std::string(1, ch)));
+    }
+
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strVersion == "HTTP/1.1");
+    REQUIRE(node.INCOMING.mapHeaders["x-long"] == std::string(1024, 'x'));
+}
+
+
+TEST_CASE( "HTTPNode pipeline limit", "[httpnode]")
+{
+    /* Only HTTP nodes process more than one buffered packet per pass. */
+    REQUIRE(TestHTTPNode::MaxPipeline() == LLP::MAX_HTTP_PIPELINE);
+    REQUIRE(LLP::TimeNode::MaxPipeline() == 1);
+}
+
+
+TEST_CASE( "HTTPNode chunked transfer encoding", "[httpnode]")
+{
+    TestHTTPNode node;
+
+    REQUIRE(node.Feed(
+        "POST / HTTP/1.1\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "5\r\nhello\r\n"
+        "7;ext=1\r\n, world\r\n"));
+
+    REQUIRE(!node.INCOMING.Complete());
+
+    /* Split the last chunk and trailer over reads. */
+    REQUIRE(node.Feed("0\r"));
+    REQUIRE(!node.INCOMING.Complete());
+    REQUIRE(node.Feed("\nX-Trailer: 1\r\n\r\nGET /next HTTP/1.1\r\n\r\n"));
+
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strContent == "hello, world");
+    REQUIRE(node.INCOMING.nContentLength == 12);
+
+    /* The request after the chunked one is still intact. */
+    node.ResetPacket();
+    REQUIRE(node.Feed(""));
+    REQUIRE(node.INCOMING.Complete());
+    REQUIRE(node.INCOMING.strRequest == "/next");
+}
+
+
+TEST_CASE( "HTTPNode rejects malformed requests", "[httpnode]")
+{
+    {
+        TestHTTPNode node;
+        REQUIRE(!node.Feed("GARBAGE\r\n\r\n"));
+    }
+
+    {
+        TestHTTPNode node;
+        REQUIRE(!node.Feed("POST / HTTP/1.1\r\nContent-Length: 12abc\r\n\r\n"));
+    }
+
+    {
+        TestHTTPNode node;
+        REQUIRE(!node.Feed("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n"));
+    }
+
+    {
+        TestHTTPNode node;
+        REQUIRE(!node.Feed("GET / HTTP/1.1\r\n" + std::string(LLP::MAX_HTTP_LINE + 1, 'a')));
+    }
+}
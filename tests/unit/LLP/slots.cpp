@@ -0,0 +1,128 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <LLP/templates/slots.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "LLP::SlotTable", "[slots]")
+{
+    LLP::SlotTable<uint32_t> table;
+    REQUIRE(table.size() == 0);
+
+    /* Reserve and fill three slots. */
+    uint32_t n0 = 0, n1 = 0, n2 = 0;
+    REQUIRE(table.Reserve(n0));
+    REQUIRE(table.Reserve(n1));
+    REQUIRE(table.Reserve(n2));
+    REQUIRE(n0 == 0);
+    REQUIRE(n1 == 1);
+    REQUIRE(n2 == 2);
+    REQUIRE(table.size() == 3);
+
+    /* Reserved slots can't be claimed until they are stored. */
+    REQUIRE(!table.Claim(n1));
+
+    table.Store(n0, new uint32_t(10));
+    table.Store(n1, new uint32_t(11));
+    table.Store(n2, new uint32_t(12));
+    REQUIRE(*table.at(n1) == 11);
+
+    /* Only one claim can win. */
+    REQUIRE(table.Claim(n1));
+    REQUIRE(!table.Claim(n1));
+    table.Release(n1);
+    REQUIRE(!table.at(n1));
+
+    /* Released slots are reused before the table grows. */
+    uint32_t nReuse = 0;
+    REQUIRE(table.Reserve(nReuse));
+    REQUIRE(nReuse == n1);
+    REQUIRE(table.size() == 3);
+
+    /* Out of range access throws and claims fail. */
+    REQUIRE_THROWS(table.at(3));
+    REQUIRE(!table.Claim(3));
+
+    /* Clean up. */
+    table.Store(nReuse, new uint32_t(13));
+    for(uint32_t n = 0; n < table.size(); ++n)
+    {
+        REQUIRE(table.Claim(n));
+        table.Release(n);
+    }
+}
+
+
+TEST_CASE( "LLP::SlotTable concurrent churn", "[slots]")
+{
+    LLP::SlotTable<uint32_t> table;
+
+    /* Each thread repeatedly takes and returns slots. */
+    const uint32_t nThreads = 8;
+    const uint32_t nRounds  = 2000;
+
+    std::atomic<bool> fCollision(false);
+
+    std::vector<std::thread> vThreads;
+    for(uint32_t nThread = 0; nThread < nThreads; ++nThread)
+    {
+        vThreads.push_back(std::thread([&, nThread]
+        {
+            for(uint32_t nRound = 0; nRound < nRounds; ++nRound)
+            {
+                uint32_t nIndex = 0;
+                if(!table.Reserve(nIndex))
+                    continue;
+
+                /* No other thread may hold the same slot. */
+                if(table.at(nIndex).load())
+                    fCollision.store(true);
+
+                table.Store(nIndex, new uint32_t(nThread));
+
+                if(*table.at(nIndex) != nThread)
+                    fCollision.store(true);
+
+                if(!table.Claim(nIndex))
+                    fCollision.store(true);
+
+                table.Release(nIndex);
+            }
+        }));
+    }
+
+    for(auto& thread : vThreads)
+        thread.join();
+
+    REQUIRE(!fCollision.load());
+
+    /* The table never grows past the number of slots held at once. */
+    REQUIRE(table.size() <= nThreads);
+    REQUIRE(table.size() >= 1);
+
+    /* All slots are back on the free list. */
+    std::set<uint32_t> setIndex;
+    for(uint32_t n = 0; n < table.size(); ++n)
+    {
+        uint32_t nIndex = 0;
+        REQUIRE(table.Reserve(nIndex));
+        setIndex.insert(nIndex);
+    }
+    REQUIRE(setIndex.size() == table.size());
+}
@@ -0,0 +1,213 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <Legacy/types/wallettx.h>
+#include <Legacy/wallet/wallet.h>
+#include <Legacy/wallet/walletdb.h>
+
+#include <Util/include/mutex.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <thread>
+
+
+/* Read a wallet transaction on another thread, so that this thread's batch is not consulted. */
+static bool read_elsewhere(const uint512_t& hash, uint32_t &nTimeReceived)
+{
+    bool fRead = false;
+    std::thread thread([&]
+    {
+        Legacy::WalletDB walletdb(Legacy::WalletDB::DEFAULT_WALLET_DB);
+
+        Legacy::WalletTx wtx;
+        fRead = walletdb.ReadTx(hash, wtx);
+        nTimeReceived = wtx.nTimeReceived;
+    });
+    thread.join();
+
+    return fRead;
+}
+
+
+/* Build a wallet transaction that can be told apart by its received time. */
+static Legacy::WalletTx make_wtx(const uint32_t nTimeReceived)
+{
+    Legacy::WalletTx wtx(&Legacy::Wallet::GetInstance());
+    wtx.nTimeReceived = nTimeReceived;
+
+    return wtx;
+}
+
+
+TEST_CASE("Legacy wallet batch tests", "[legacy]")
+{
+    Legacy::WalletDB walletdb(Legacy::WalletDB::DEFAULT_WALLET_DB);
+
+    /* Writes are held by the batch until it commits. */
+    {
+        const uint512_t hash = LLC::GetRand512();
+        uint32_t nTime = 0;
+        {
+            Legacy::WalletBatch batch;
+
+            REQUIRE(walletdb.WriteTx(hash, make_wtx(111)));
+            REQUIRE(batch.Size() == 1);
+
+            /* This thread reads its own queued write. */
+            Legacy::WalletTx wtx;
+            REQUIRE(walletdb.ReadTx(hash, wtx));
+            REQUIRE(wtx.nTimeReceived == 111);
+
+            /* Other threads don't see it yet. */
+            REQUIRE_FALSE(read_elsewhere(hash, nTime));
+        }
+
+        /* Committed when the batch went out of scope. */
+        REQUIRE(read_elsewhere(hash, nTime));
+        REQUIRE(nTime == 111);
+    }
+
+
+    /* Erases are queued the same way, and the last record for a hash wins. */
+    {
+        const uint512_t hash = LLC::GetRand512();
+        REQUIRE(walletdb.WriteTx(hash, make_wtx(222)));
+
+        uint32_t nTime = 0;
+        {
+            Legacy::WalletBatch batch;
+
+            REQUIRE(walletdb.WriteTx(hash, make_wtx(333)));
+            REQUIRE(walletdb.EraseTx(hash));
+            REQUIRE(batch.Size() == 1);
+
+            Legacy::WalletTx wtx;
+            REQUIRE_FALSE(walletdb.ReadTx(hash, wtx));
+
+            REQUIRE(read_elsewhere(hash, nTime));
+            REQUIRE(nTime == 222);
+        }
+
+        REQUIRE_FALSE(read_elsewhere(hash, nTime));
+    }
+
+
+    /* A nested batch hands its writes to the outer one, which commits them. */
+    {
+        const uint512_t hash = LLC::GetRand512();
+        uint32_t nTime = 0;
+        {
+            Legacy::WalletBatch outer;
+            {
+                Legacy::WalletBatch inner;
+
+                REQUIRE(walletdb.WriteTx(hash, make_wtx(444)));
+                REQUIRE(inner.Size() == 0);
+                REQUIRE(outer.Size() == 1);
+            }
+
+            /* The inner batch going out of scope doesn't commit. */
+            REQUIRE_FALSE(read_elsewhere(hash, nTime));
+        }
+
+        REQUIRE(read_elsewhere(hash, nTime));
+        REQUIRE(nTime == 444);
+    }
+
+
+    /* A full batch commits on its own and keeps going. */
+    {
+        std::vector<uint512_t> vHashes;
+        for(uint32_t n = 0; n < 5; ++n)
+            vHashes.push_back(LLC::GetRand512());
+
+        uint32_t nTime = 0;
+        {
+            Legacy::WalletBatch batch(2);
+
+            for(uint32_t n = 0; n < vHashes.size(); ++n)
+            {
+                REQUIRE(walletdb.WriteTx(vHashes[n], make_wtx(500 + n)));
+            }
+
+            REQUIRE(batch.Size() == 1);
+
+            REQUIRE(read_elsewhere(vHashes[3], nTime));
+            REQUIRE(nTime == 503);
+            REQUIRE_FALSE(read_elsewhere(vHashes[4], nTime));
+
+            /* An explicit commit writes the rest. */
+            REQUIRE(batch.Commit());
+            REQUIRE(batch.Size() == 0);
+            REQUIRE(read_elsewhere(vHashes[4], nTime));
+        }
+    }
+
+
+    /* Writes from other threads are not part of an open batch and are visible at once. */
+    {
+        const uint512_t hashBatch = LLC::GetRand512();
+        const uint512_t hashOther = LLC::GetRand512();
+        uint32_t nTime = 0;
+        {
+            Legacy::WalletBatch batch;
+            REQUIRE(walletdb.WriteTx(hashBatch, make_wtx(666)));
+
+            std::thread thread([&]
+            {
+                Legacy::WalletDB walletdbOther(Legacy::WalletDB::DEFAULT_WALLET_DB);
+                walletdbOther.WriteTx(hashOther, make_wtx(777));
+            });
+            thread.join();
+
+            REQUIRE(batch.Size() == 1);
+            REQUIRE(read_elsewhere(hashOther, nTime));
+            REQUIRE(nTime == 777);
+        }
+    }
+
+
+    /* A batch committing under cs_wallet must not wait on a thread that needs cs_wallet. */
+    {
+        Legacy::Wallet& wallet = Legacy::Wallet::GetInstance();
+
+        const uint512_t hash = LLC::GetRand512();
+        bool fWritten = false;
+        std::thread thread([&]
+        {
+            Legacy::WalletDB walletdbOther(Legacy::WalletDB::DEFAULT_WALLET_DB);
+            Legacy::WalletBatch batch;
+
+            RLOCK(wallet.cs_wallet);
+            fWritten = walletdbOther.WriteTx(hash, make_wtx(888));
+        });
+
+        {
+            Legacy::WalletBatch batch;
+            REQUIRE(walletdb.WriteTx(LLC::GetRand512(), make_wtx(999)));
+
+            RLOCK(wallet.cs_wallet);
+            REQUIRE(batch.Commit());
+        }
+
+        thread.join();
+        REQUIRE(fWritten);
+
+        uint32_t nTime = 0;
+        REQUIRE(read_elsewhere(hash, nTime));
+        REQUIRE(nTime == 888);
+    }
+}
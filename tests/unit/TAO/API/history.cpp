@@ -0,0 +1,236 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include "util.h"
+
+#include <LLC/include/random.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/types/sigchain.h>
+#include <TAO/Ledger/types/transaction.h>
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+
+#include <TAO/Operation/include/enum.h>
+#include <TAO/Operation/types/stream.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/types/address.h>
+
+
+/* A signature chain that test transactions are added to. */
+struct HistoryChain
+{
+    uint256_t hashGenesis;
+    uint512_t hashKey;
+    uint512_t hashNext;
+    uint512_t hashPrevTx;
+    uint32_t  nSequence;
+
+    HistoryChain()
+    : hashGenesis(TAO::Ledger::SignatureChain::Genesis(("history" + std::to_string(LLC::GetRand())).c_str()))
+    , hashKey(0)
+    , hashNext(LLC::GetRand512())
+    , hashPrevTx(0)
+    , nSequence(0)
+    {
+    }
+
+
+    /* Start the next transaction of the chain. */
+    TAO::Ledger::Transaction Next()
+    {
+        hashKey  = hashNext;
+        hashNext = LLC::GetRand512();
+
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = nSequence;
+        tx.hashPrevTx  = hashPrevTx;
+        tx.nTimestamp  = runtime::timestamp();
+        tx.nKeyType    = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.nNextType   = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.NextHash(hashNext, TAO::Ledger::SIGNATURE::BRAINPOOL);
+
+        return tx;
+    }
+
+
+    /* Connect a transaction to the chain the way a block does. */
+    bool Confirm(TAO::Ledger::Transaction& tx)
+    {
+        if(!tx.Build())
+            return false;
+
+        if(nSequence > 0 && !tx.Sign(hashKey))
+            return false;
+
+        const uint512_t hash = tx.GetHash();
+        if(!LLD::Ledger->WriteTx(hash, tx) || !tx.Verify(TAO::Ledger::FLAGS::BLOCK) || !tx.Connect(TAO::Ledger::FLAGS::BLOCK))
+            return false;
+
+        if(!LLD::Ledger->IndexBlock(hash, TAO::Ledger::ChainState::Genesis()))
+            return false;
+
+        hashPrevTx = hash;
+        ++nSequence;
+
+        return true;
+    }
+};
+
+
+/* Get the asset history from the API, reading from the register history index or from a full sigchain walk. */
+static json::json asset_history(const TAO::Register::Address& hashAsset, const bool fIndex)
+{
+    LLD::Ledger->WriteHistoryHeight(fIndex ? 0 : 1);
+
+    json::json params;
+    params["session"] = SESSION1;
+    params["address"] = hashAsset.ToString();
+
+    json::json ret = APICall("assets/list/asset/history", params);
+    REQUIRE(ret.find("result") != ret.end());
+
+    return ret["result"];
+}
+
+
+/* Build an operation stream writing a new value to the asset. */
+static std::vector<uint8_t> asset_write(const std::string& strValue)
+{
+    TAO::Operation::Stream stream;
+    stream << std::string("data") << uint8_t(TAO::Operation::OP::TYPES::STRING) << strValue;
+
+    return stream.Bytes();
+}
+
+
+TEST_CASE( "Test Objects API - history from the register history index", "[assets/list/asset/history]")
+{
+    using namespace TAO::Operation;
+
+    /* Ensure user is logged in for name lookups */
+    InitializeUser(USERNAME1, PASSWORD, PIN, GENESIS1, SESSION1);
+
+    /* Keep the index height to restore once done. */
+    uint32_t nHistoryHeight = 0;
+    const bool fHistoryHeight = LLD::Ledger->ReadHistoryHeight(nHistoryHeight);
+
+    HistoryChain chainFrom;
+    HistoryChain chainTo;
+
+    const TAO::Register::Address hashAsset = TAO::Register::Address(TAO::Register::Address::OBJECT);
+
+    /* Create the asset, update it and hand it to the other sigchain. */
+    uint512_t hashTransfer = 0;
+    {
+        TAO::Register::Object asset = TAO::Register::CreateAsset();
+        asset << std::string("data") << uint8_t(TAO::Register::TYPES::MUTABLE) << uint8_t(TAO::Register::TYPES::STRING) << std::string("created");
+
+        TAO::Ledger::Transaction tx = chainFrom.Next();
+        tx[0] << uint8_t(OP::CREATE) << hashAsset << uint8_t(TAO::Register::REGISTER::OBJECT) << asset.GetState();
+        REQUIRE(chainFrom.Confirm(tx));
+
+        tx = chainFrom.Next();
+        tx[0] << uint8_t(OP::WRITE) << hashAsset << asset_write("updated");
+        REQUIRE(chainFrom.Confirm(tx));
+
+        tx = chainFrom.Next();
+        tx[0] << uint8_t(OP::TRANSFER) << hashAsset << chainTo.hashGenesis << uint8_t(TRANSFER::CLAIM);
+        REQUIRE(chainFrom.Confirm(tx));
+
+        hashTransfer = tx.GetHash();
+
+        tx = chainTo.Next();
+        tx[0] << uint8_t(OP::CLAIM) << hashTransfer << uint32_t(0) << hashAsset;
+        REQUIRE(chainTo.Confirm(tx));
+    }
+
+    /* Every contract on the asset is in the index, oldest first. */
+    {
+        uint32_t nSequence = 0;
+        REQUIRE(LLD::Ledger->ReadHistorySize(hashAsset, nSequence));
+        REQUIRE(nSequence == 4);
+
+        uint512_t hashTx = 0;
+        std::vector<uint32_t> vContracts;
+        REQUIRE(LLD::Ledger->ReadHistory(hashAsset, nSequence, hashTx, vContracts));
+        REQUIRE(hashTx == chainTo.hashPrevTx);
+        REQUIRE(vContracts.size() == 1);
+        REQUIRE(nSequence == 3);
+
+        REQUIRE(LLD::Ledger->ReadHistory(hashAsset, nSequence, hashTx, vContracts));
+        REQUIRE(hashTx == hashTransfer);
+    }
+
+    /* The new owner updates the asset in a transaction we'll disconnect. */
+    TAO::Ledger::Transaction txLast = chainTo.Next();
+    txLast[0] << uint8_t(OP::WRITE) << hashAsset << asset_write("owned");
+    REQUIRE(chainTo.Confirm(txLast));
+
+    /* The index and the full walk give the same history. */
+    {
+        const json::json jsonIndex = asset_history(hashAsset, true);
+        const json::json jsonScan  = asset_history(hashAsset, false);
+
+        REQUIRE(jsonIndex.size() == 5);
+        REQUIRE(jsonIndex == jsonScan);
+
+        REQUIRE(jsonIndex[0]["type"].get<std::string>() == "MODIFY");
+        REQUIRE(jsonIndex[4]["type"].get<std::string>() == "CREATE");
+    }
+
+    /* An erase for another transaction leaves the index alone. */
+    {
+        REQUIRE(LLD::Ledger->EraseHistory(hashAsset, LLC::GetRand512()));
+
+        uint32_t nSequence = 0;
+        REQUIRE(LLD::Ledger->ReadHistorySize(hashAsset, nSequence));
+        REQUIRE(nSequence == 5);
+    }
+
+    /* Disconnecting the last transaction rolls the index back with it. */
+    {
+        REQUIRE(txLast.Disconnect(TAO::Ledger::FLAGS::BLOCK));
+
+        uint32_t nSequence = 0;
+        REQUIRE(LLD::Ledger->ReadHistorySize(hashAsset, nSequence));
+        REQUIRE(nSequence == 4);
+
+        uint512_t hashTx = 0;
+        std::vector<uint32_t> vContracts;
+        REQUIRE(LLD::Ledger->ReadHistory(hashAsset, nSequence, hashTx, vContracts));
+        REQUIRE(hashTx != txLast.GetHash());
+
+        const json::json jsonIndex = asset_history(hashAsset, true);
+        const json::json jsonScan  = asset_history(hashAsset, false);
+
+        REQUIRE(jsonIndex.size() == 4);
+        REQUIRE(jsonIndex == jsonScan);
+        REQUIRE(jsonIndex[0]["type"].get<std::string>() == "CLAIM");
+    }
+
+    /* Restore the index height. */
+    if(fHistoryHeight)
+    {
+        REQUIRE(LLD::Ledger->WriteHistoryHeight(nHistoryHeight));
+    }
+    else
+    {
+        REQUIRE(LLD::Ledger->Erase(std::string("history.height")));
+    }
+}
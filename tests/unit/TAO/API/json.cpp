@@ -0,0 +1,81 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <TAO/API/include/json.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/types/address.h>
+
+#include <Util/include/json_writer.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE("API streaming JSON output tests", "[api]")
+{
+    using namespace TAO::Operation;
+
+    /* Build a transaction with a write contract that can be rendered without the database. */
+    TAO::Ledger::Transaction tx;
+    tx.nTimestamp  = 989798;
+    tx.nSequence   = 7;
+    tx.hashGenesis = LLC::GetRand256();
+    tx.hashNext    = LLC::GetRand256();
+
+    std::vector<uint8_t> vchData(32, 0xab);
+    tx[0] << uint8_t(OP::WRITE) << TAO::Register::Address(TAO::Register::Address::OBJECT) << vchData;
+    tx[1] << uint8_t(OP::APPEND) << TAO::Register::Address(TAO::Register::Address::OBJECT) << vchData;
+
+    /* Transactions must stream identically to their tree at every verbosity level. */
+    for(uint32_t nVerbose = 0; nVerbose <= 3; ++nVerbose)
+    {
+        std::string strBuffer;
+        json::writer writer(strBuffer);
+        TAO::API::TransactionToJSON(0, tx, TAO::Ledger::BlockState(), nVerbose, writer);
+
+        REQUIRE(strBuffer == TAO::API::TransactionToJSON(0, tx, TAO::Ledger::BlockState(), nVerbose).dump());
+    }
+
+    /* Contracts must stream identically to their tree. */
+    {
+        std::string strBuffer;
+        json::writer writer(strBuffer);
+        TAO::API::ContractsToJSON(0, tx, 3, writer);
+
+        REQUIRE(strBuffer == TAO::API::ContractsToJSON(0, tx, 3).dump());
+    }
+
+    /* Block headers must stream identically to their tree. */
+    {
+        TAO::Ledger::BlockState block;
+        block.nVersion       = 7;
+        block.nChannel       = 2;
+        block.nHeight        = 1000;
+        block.nBits          = 0x7b00ffff;
+        block.nNonce         = 12345;
+        block.nTime          = 1570000000;
+        block.hashPrevBlock  = LLC::GetRand1024();
+        block.hashMerkleRoot = LLC::GetRand512();
+
+        std::string strBuffer;
+        json::writer writer(strBuffer);
+        TAO::API::BlockToJSON(block, 1, writer);
+
+        REQUIRE(strBuffer == TAO::API::BlockToJSON(block, 1).dump());
+    }
+}
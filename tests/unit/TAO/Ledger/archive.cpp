@@ -0,0 +1,245 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/archive.h>
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/syncblock.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <fstream>
+#include <iterator>
+
+
+/* Read a whole file into a byte vector. */
+static std::vector<uint8_t> read_file(const std::string& strPath)
+{
+    std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+
+/* Write a byte vector over a file. */
+static void write_file(const std::string& strPath, const std::vector<uint8_t>& vData)
+{
+    std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    stream.write((const char*)vData.data(), vData.size());
+}
+
+
+TEST_CASE("Block archive export and import tests", "[ledger]")
+{
+    using namespace TAO::Ledger;
+
+    /* Keep the chain state to restore once done. */
+    const BlockState stateGenesis = ChainState::stateGenesis;
+    const uint32_t   nBestHeight  = ChainState::nBestHeight.load();
+
+    /* A transaction carried by one of the blocks. */
+    Transaction tx;
+    tx.nTimestamp  = 989798;
+    tx.hashGenesis = LLC::GetRand256();
+    tx[0] << uint8_t(TAO::Operation::OP::WRITE) << LLC::GetRand256() << std::vector<uint8_t>(32, 0xcd);
+
+    const uint512_t hashTx = tx.GetHash();
+    REQUIRE(LLD::Ledger->WriteTx(hashTx, tx));
+
+    /* Build a small chain following genesis. */
+    const uint32_t nChain = 5;
+    std::vector<BlockState> vChain;
+
+    BlockState statePrev = stateGenesis;
+    for(uint32_t n = 1; n <= nChain; ++n)
+    {
+        BlockState state;
+        state.nVersion       = 7;
+        state.nChannel       = 2;
+        state.nHeight        = stateGenesis.nHeight + n;
+        state.nBits          = 0x7b00ffff;
+        state.nNonce         = n;
+        state.nTime          = stateGenesis.nTime + n * 50;
+        state.hashPrevBlock  = statePrev.GetHash();
+        state.hashMerkleRoot = LLC::GetRand512();
+
+        if(n == 3)
+            state.vtx.push_back(std::make_pair(TRANSACTION::TRITIUM, hashTx));
+
+        vChain.push_back(state);
+        statePrev = state;
+    }
+
+    /* Link the chain forward and write it to the ledger. */
+    ChainState::stateGenesis.hashNextBlock = vChain[0].GetHash();
+    for(uint32_t n = 0; n < nChain; ++n)
+    {
+        if(n + 1 < nChain)
+            vChain[n].hashNextBlock = vChain[n + 1].GetHash();
+
+        REQUIRE(LLD::Ledger->WriteBlock(vChain[n].GetHash(), vChain[n]));
+    }
+
+    ChainState::nBestHeight.store(vChain.back().nHeight);
+
+    const std::string strPath    = config::GetDataDir() + "archive-test.bin";
+    const std::string strCorrupt = config::GetDataDir() + "archive-corrupt.bin";
+
+
+    /* Export should write every block after genesis, and reading it back should give the same chain. */
+    {
+        uint32_t nExported = 0;
+        REQUIRE(ExportBlocks(strPath, nExported));
+        REQUIRE(nExported == nChain);
+
+        std::vector<SyncBlock> vRead;
+        REQUIRE(ReadArchive(strPath, [&vRead](const SyncBlock& block)
+        {
+            vRead.push_back(block);
+            return true;
+        }));
+
+        REQUIRE(vRead.size() == nChain);
+        for(uint32_t n = 0; n < nChain; ++n)
+        {
+            REQUIRE(vRead[n].GetHash()   == vChain[n].GetHash());
+            REQUIRE(vRead[n].nHeight     == vChain[n].nHeight);
+            REQUIRE(vRead[n].vtx.size()  == vChain[n].vtx.size());
+        }
+
+        /* The transaction should come back with the block that carried it. */
+        REQUIRE(vRead[2].vtx[0].first == TRANSACTION::TRITIUM);
+
+        Transaction txRead;
+        DataStream ssTx(vRead[2].vtx[0].second, SER_DISK, LLD::DATABASE_VERSION);
+        ssTx >> txRead;
+
+        REQUIRE(txRead.GetHash() == hashTx);
+    }
+
+
+    /* Importing into a node that already has the chain should skip every block. */
+    {
+        uint32_t nImported = 0;
+        REQUIRE(ImportBlocks(strPath, nImported));
+        REQUIRE(nImported == 0);
+    }
+
+
+    /* A callback can stop the read. */
+    {
+        uint32_t nRead = 0;
+        REQUIRE_FALSE(ReadArchive(strPath, [&nRead](const SyncBlock& block)
+        {
+            return ++nRead < 2;
+        }));
+
+        REQUIRE(nRead == 2);
+    }
+
+
+    const std::vector<uint8_t> vArchive = read_file(strPath);
+    REQUIRE(vArchive.size() > 136);
+
+    const auto fnAny = [](const SyncBlock& block){ return true; };
+
+
+    /* Truncated archives should be rejected, whether the cut is inside a record or inside a length prefix. */
+    {
+        std::vector<uint8_t> vTruncated(vArchive.begin(), vArchive.end() - 10);
+        write_file(strCorrupt, vTruncated);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+
+        uint32_t nImported = 0;
+        REQUIRE_FALSE(ImportBlocks(strCorrupt, nImported));
+
+        vTruncated.assign(vArchive.begin(), vArchive.begin() + 136 + 2);
+        write_file(strCorrupt, vTruncated);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+
+        vTruncated.assign(vArchive.begin(), vArchive.begin() + 100);
+        write_file(strCorrupt, vTruncated);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+    }
+
+
+    /* A header-only archive is empty but valid. */
+    {
+        std::vector<uint8_t> vHeader(vArchive.begin(), vArchive.begin() + 136);
+        write_file(strCorrupt, vHeader);
+        REQUIRE(ReadArchive(strCorrupt, fnAny));
+    }
+
+
+    /* Bad magic, version and genesis should all be rejected. */
+    {
+        std::vector<uint8_t> vCorrupt = vArchive;
+        vCorrupt[0] = 'X';
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+
+        vCorrupt = vArchive;
+        vCorrupt[4] ^= 0xff;
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+
+        vCorrupt = vArchive;
+        vCorrupt[20] ^= 0xff;
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+    }
+
+
+    /* An oversized or zero record length should be rejected. */
+    {
+        std::vector<uint8_t> vCorrupt = vArchive;
+        vCorrupt[136] = vCorrupt[137] = vCorrupt[138] = vCorrupt[139] = 0xff;
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+
+        vCorrupt[136] = vCorrupt[137] = vCorrupt[138] = vCorrupt[139] = 0x00;
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+    }
+
+
+    /* A record that doesn't decode to a block should be rejected. */
+    {
+        std::vector<uint8_t> vCorrupt(vArchive.begin(), vArchive.begin() + 136);
+        vCorrupt.push_back(8);
+        vCorrupt.push_back(0);
+        vCorrupt.push_back(0);
+        vCorrupt.push_back(0);
+        for(uint32_t n = 0; n < 8; ++n)
+            vCorrupt.push_back(0xff);
+
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadArchive(strCorrupt, fnAny));
+    }
+
+
+    /* Restore the chain state. */
+    ChainState::stateGenesis = stateGenesis;
+    ChainState::nBestHeight.store(nBestHeight);
+}
@@ -0,0 +1,67 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/merklecache.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE( "Merkle branch cache tests", "[ledger]")
+{
+    /* Check odd and even sized trees, including a single transaction. */
+    for(uint32_t nSize = 1; nSize <= 17; ++nSize)
+    {
+        TAO::Ledger::BlockState state;
+        for(uint32_t n = 0; n < nSize; ++n)
+            state.vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, LLC::GetRand512()));
+
+        state.hashMerkleRoot = state.BuildMerkleTree(state.vtx);
+        const std::vector<uint512_t> vTree = state.vMerkleTree;
+
+        /* Get each branch twice so the second one comes from the cache. */
+        for(uint32_t nPass = 0; nPass < 2; ++nPass)
+        {
+            for(uint32_t n = 0; n < nSize; ++n)
+            {
+                std::vector<uint512_t> vMerkleBranch;
+                uint32_t nIndex = 0;
+                REQUIRE(TAO::Ledger::GetMerkleBranch(state, state.vtx[n].second, vMerkleBranch, nIndex));
+
+                /* Building the cached tree leaves the block's own tree in place. */
+                REQUIRE(state.vMerkleTree == vTree);
+
+                REQUIRE(nIndex == n);
+                REQUIRE(vMerkleBranch == state.GetMerkleBranch(state.vtx, n));
+                REQUIRE(TAO::Ledger::Block::CheckMerkleBranch(state.vtx[n].second, vMerkleBranch, nIndex) == state.hashMerkleRoot);
+            }
+        }
+
+        /* Unknown transactions are not found. */
+        std::vector<uint512_t> vMerkleBranch;
+        uint32_t nIndex = 0;
+        REQUIRE_FALSE(TAO::Ledger::GetMerkleBranch(state, LLC::GetRand512(), vMerkleBranch, nIndex));
+    }
+
+    /* A block whose merkle root doesn't match its transactions is refused. */
+    TAO::Ledger::BlockState state;
+    state.vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, LLC::GetRand512()));
+    state.vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, LLC::GetRand512()));
+    state.hashMerkleRoot = LLC::GetRand512();
+
+    std::vector<uint512_t> vMerkleBranch;
+    uint32_t nIndex = 0;
+    REQUIRE_FALSE(TAO::Ledger::GetMerkleBranch(state, state.vtx[0].second, vMerkleBranch, nIndex));
+}
@@ -0,0 +1,227 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/pipeline.h>
+#include <TAO/Ledger/include/process.h>
+
+#include <TAO/Ledger/types/syncblock.h>
+
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+
+/* A sync block that is processed as an orphan, since its previous block is unknown. */
+static TAO::Ledger::SyncBlock orphan_block(std::set<uint1024_t> &setPrev)
+{
+    TAO::Ledger::SyncBlock block;
+    block.nVersion      = 7;
+    block.nHeight       = 100000000;
+    block.hashPrevBlock = LLC::GetRand1024();
+
+    setPrev.insert(block.hashPrevBlock);
+
+    return block;
+}
+
+
+/* A sync block whose transactions can't be deserialized, which the pipeline rejects. */
+static TAO::Ledger::SyncBlock bad_block()
+{
+    TAO::Ledger::SyncBlock block;
+    block.nVersion      = 7;
+    block.nHeight       = 100000000;
+    block.hashPrevBlock = LLC::GetRand1024();
+    block.vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, std::vector<uint8_t>(1, 0x01)));
+
+    return block;
+}
+
+
+/* Collect a session's statuses until there are nCount of them or a few seconds pass. */
+static std::vector<uint8_t> collect(TAO::Ledger::SyncPipeline& pipeline, const uint64_t nSession, const uint32_t nCount)
+{
+    std::vector<uint8_t> vAll;
+    for(uint32_t nWait = 0; nWait < 5000 && vAll.size() < nCount; ++nWait)
+    {
+        std::vector<uint8_t> vStatus;
+        if(pipeline.Status(nSession, vStatus))
+            vAll.insert(vAll.end(), vStatus.begin(), vStatus.end());
+        else
+            runtime::sleep(1);
+    }
+
+    return vAll;
+}
+
+
+/* Push a block, waiting for room in the buffer, and keep the statuses handed back. */
+static bool push(TAO::Ledger::SyncPipeline& pipeline, const TAO::Ledger::SyncBlock& block, const uint64_t nSession, std::vector<uint8_t> &vAll)
+{
+    for(uint32_t nWait = 0; nWait < 5000; ++nWait)
+    {
+        std::vector<uint8_t> vStatus;
+        if(pipeline.Push(block, nSession, vStatus))
+        {
+            vAll.insert(vAll.end(), vStatus.begin(), vStatus.end());
+            return true;
+        }
+
+        runtime::sleep(1);
+    }
+
+    return false;
+}
+
+
+/* Remove the orphans the test blocks left behind. */
+static void clear_orphans(const std::set<uint1024_t>& setPrev)
+{
+    LOCK(TAO::Ledger::PROCESSING_MUTEX);
+    for(const auto& hashPrev : setPrev)
+        TAO::Ledger::mapOrphans.erase(hashPrev);
+}
+
+
+TEST_CASE( "Sync pipeline ordering and rejects", "[ledger]")
+{
+    TAO::Ledger::SyncPipeline pipeline;
+    pipeline.Start(4, 64);
+    REQUIRE(pipeline.Running());
+
+    std::set<uint1024_t> setPrev;
+
+    /* Two sessions interleaved, with a pattern of good and malformed blocks. */
+    std::vector<uint8_t> vStatus1, vStatus2;
+    std::vector<bool> vBad1, vBad2;
+    for(uint32_t n = 0; n < 100; ++n)
+    {
+        const bool fBad1 = (n % 3 == 0);
+        const bool fBad2 = (n % 5 == 1);
+
+        REQUIRE(push(pipeline, fBad1 ? bad_block() : orphan_block(setPrev), 1, vStatus1));
+        REQUIRE(push(pipeline, fBad2 ? bad_block() : orphan_block(setPrev), 2, vStatus2));
+
+        vBad1.push_back(fBad1);
+        vBad2.push_back(fBad2);
+    }
+
+    /* The statuses come back per session in the order the blocks were pushed, including the last ones. */
+    const std::vector<uint8_t> vFinal1 = collect(pipeline, 1, 100 - vStatus1.size());
+    const std::vector<uint8_t> vFinal2 = collect(pipeline, 2, 100 - vStatus2.size());
+    vStatus1.insert(vStatus1.end(), vFinal1.begin(), vFinal1.end());
+    vStatus2.insert(vStatus2.end(), vFinal2.begin(), vFinal2.end());
+
+    REQUIRE(vStatus1.size() == 100);
+    REQUIRE(vStatus2.size() == 100);
+
+    for(uint32_t n = 0; n < 100; ++n)
+    {
+        REQUIRE(bool(vStatus1[n] & TAO::Ledger::PROCESS::REJECTED) == vBad1[n]);
+        REQUIRE(bool(vStatus1[n] & TAO::Ledger::PROCESS::ORPHAN)   == !vBad1[n]);
+
+        REQUIRE(bool(vStatus2[n] & TAO::Ledger::PROCESS::REJECTED) == vBad2[n]);
+        REQUIRE(bool(vStatus2[n] & TAO::Ledger::PROCESS::ORPHAN)   == !vBad2[n]);
+    }
+
+    REQUIRE(pipeline.Size() == 0);
+
+    /* Nothing more to collect. */
+    std::vector<uint8_t> vStatus;
+    REQUIRE_FALSE(pipeline.Status(1, vStatus));
+
+    pipeline.Stop();
+    clear_orphans(setPrev);
+}
+
+
+TEST_CASE( "Sync pipeline full buffer and removed sessions", "[ledger]")
+{
+    TAO::Ledger::SyncPipeline pipeline;
+    pipeline.Start(1, 2);
+
+    std::set<uint1024_t> setPrev;
+
+    /* Hold the commit thread in Process so the buffer fills. */
+    {
+        LOCK(TAO::Ledger::PROCESSING_MUTEX);
+
+        std::vector<uint8_t> vStatus;
+        REQUIRE(pipeline.Push(orphan_block(setPrev), 1, vStatus));
+        REQUIRE(pipeline.Push(orphan_block(setPrev), 2, vStatus));
+
+        /* A full buffer hands the block straight back instead of waiting. */
+        REQUIRE_FALSE(pipeline.Push(orphan_block(setPrev), 1, vStatus));
+        REQUIRE(pipeline.Size() == 2);
+
+        /* Session 2 disconnects with a block still in the buffer. */
+        pipeline.Remove(2);
+    }
+
+    REQUIRE(collect(pipeline, 1, 1).size() == 1);
+
+    /* The removed session's block is committed but its status isn't kept. */
+    for(uint32_t nWait = 0; nWait < 5000 && pipeline.Size() > 0; ++nWait)
+        runtime::sleep(1);
+
+    REQUIRE(pipeline.Size() == 0);
+
+    std::vector<uint8_t> vStatus;
+    REQUIRE_FALSE(pipeline.Status(2, vStatus));
+
+    pipeline.Stop();
+    clear_orphans(setPrev);
+}
+
+
+TEST_CASE( "Sync pipeline stop", "[ledger]")
+{
+    TAO::Ledger::SyncPipeline pipeline;
+    pipeline.Start(2, 16);
+
+    std::set<uint1024_t> setPrev;
+
+    /* Stop with blocks in flight discards them. */
+    {
+        LOCK(TAO::Ledger::PROCESSING_MUTEX);
+
+        std::vector<uint8_t> vStatus;
+        for(uint32_t n = 0; n < 8; ++n)
+        {
+            REQUIRE(pipeline.Push(orphan_block(setPrev), 1, vStatus));
+        }
+    }
+
+    pipeline.Stop();
+    REQUIRE_FALSE(pipeline.Running());
+
+    /* A stopped pipeline hands every block back to the caller. */
+    std::vector<uint8_t> vStatus;
+    REQUIRE_FALSE(pipeline.Push(orphan_block(setPrev), 1, vStatus));
+    REQUIRE_FALSE(pipeline.Status(1, vStatus));
+
+    /* It can be started again. */
+    pipeline.Start(2, 16);
+    REQUIRE(pipeline.Push(orphan_block(setPrev), 1, vStatus));
+    REQUIRE(collect(pipeline, 1, 1).size() == 1);
+
+    pipeline.Stop();
+    clear_orphans(setPrev);
+}
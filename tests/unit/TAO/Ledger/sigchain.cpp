@@ -12,8 +12,11 @@
 ____________________________________________________________________________________________*/
 #include <LLC/include/random.h>
 
+#include <TAO/API/types/key_pipeline.h>
+
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/keycache.h>
 #include <TAO/Ledger/types/sigchain.h>
 
 #include <TAO/Operation/include/enum.h>
@@ -383,3 +386,77 @@ TEST_CASE( "Signature Chain Genesis Transaction checks", "[sigchain]")
     /* Finally reinstate private mode so the rest of the tests can continue */
     config::mapArgs["-private"] = "1";
 }
+
+
+TEST_CASE( "Signature Chain Pregenerated Keys", "[sigchain]")
+{
+    for(const uint8_t nType : {TAO::Ledger::SIGNATURE::FALCON, TAO::Ledger::SIGNATURE::BRAINPOOL})
+    {
+        uint256_t hashGenesis = LLC::GetRand256();
+        uint512_t hashSecret  = LLC::GetRand512();
+
+        /* Next hash derived on demand. */
+        TAO::Ledger::Transaction tx1;
+        tx1.NextHash(hashSecret, nType);
+
+        /* Next hash from a pregenerated key must match. */
+        REQUIRE(TAO::Ledger::PregenerateKey(hashGenesis, hashSecret, nType));
+
+        TAO::Ledger::Transaction tx2;
+        tx2.NextHash(hashSecret, nType);
+        REQUIRE(tx2.hashNext == tx1.hashNext);
+
+        /* Transaction signed with the pregenerated key must verify. */
+        TAO::Ledger::Transaction tx3;
+        tx3.nKeyType = nType;
+        REQUIRE(tx3.Sign(hashSecret));
+        REQUIRE(tx3.PrevHash() == tx1.hashNext);
+
+        if(nType == TAO::Ledger::SIGNATURE::FALCON)
+        {
+            LLC::FLKey key;
+            key.SetPubKey(tx3.vchPubKey);
+            REQUIRE(key.Verify(tx3.GetHash().GetBytes(), tx3.vchSig));
+        }
+        else
+        {
+            LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+            key.SetPubKey(tx3.vchPubKey);
+            REQUIRE(key.Verify(tx3.GetHash().GetBytes(), tx3.vchSig));
+        }
+    }
+}
+
+
+TEST_CASE( "Signature Chain Pregenerated Keys Purged", "[sigchain]")
+{
+    /* Two sigchains with keys of both types in the cache. */
+    const uint256_t hashGenesis1 = LLC::GetRand256();
+    const uint256_t hashGenesis2 = LLC::GetRand256();
+
+    const uint512_t hashSecret1 = LLC::GetRand512();
+    const uint512_t hashSecret2 = LLC::GetRand512();
+
+    REQUIRE(TAO::Ledger::PregenerateKey(hashGenesis1, hashSecret1, TAO::Ledger::SIGNATURE::FALCON));
+    REQUIRE(TAO::Ledger::PregenerateKey(hashGenesis1, hashSecret1, TAO::Ledger::SIGNATURE::BRAINPOOL));
+    REQUIRE(TAO::Ledger::PregenerateKey(hashGenesis2, hashSecret2, TAO::Ledger::SIGNATURE::FALCON));
+
+    LLC::FLKey keyFalcon;
+    LLC::ECKey keyBrainpool = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+    REQUIRE(TAO::Ledger::GetPregeneratedKey(hashSecret1, keyFalcon));
+    REQUIRE(TAO::Ledger::GetPregeneratedKey(hashSecret1, keyBrainpool));
+    REQUIRE(TAO::Ledger::GetPregeneratedKey(hashSecret2, keyFalcon));
+
+    {
+        TAO::API::KeyPipeline pipeline;
+
+        /* Logging out the first sigchain removes only its keys. */
+        pipeline.Remove(hashGenesis1);
+        REQUIRE(!TAO::Ledger::GetPregeneratedKey(hashSecret1, keyFalcon));
+        REQUIRE(!TAO::Ledger::GetPregeneratedKey(hashSecret1, keyBrainpool));
+        REQUIRE(TAO::Ledger::GetPregeneratedKey(hashSecret2, keyFalcon));
+    }
+
+    /* Shutting down the pipeline removes the rest. */
+    REQUIRE(!TAO::Ledger::GetPregeneratedKey(hashSecret2, keyFalcon));
+}
@@ -0,0 +1,578 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <Legacy/types/transaction.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/snapshot.h>
+
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/state.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/templates/datastream.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+
+/* Read a whole file into a byte vector. */
+static std::vector<uint8_t> read_file(const std::string& strPath)
+{
+    std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+
+/* Write a byte vector over a file. */
+static void write_file(const std::string& strPath, const std::vector<uint8_t>& vData)
+{
+    std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    stream.write((const char*)vData.data(), vData.size());
+}
+
+
+TEST_CASE("Ledger snapshot export and import tests", "[ledger]")
+{
+    using namespace TAO::Ledger;
+
+    /* Keep the chain state to restore once done. */
+    const BlockState stateGenesis    = ChainState::stateGenesis;
+    const BlockState stateBest       = ChainState::stateBest.load();
+    const uint1024_t hashBestChain   = ChainState::hashBestChain.load();
+    const uint1024_t hashCheckpoint  = ChainState::hashCheckpoint.load();
+    const uint32_t   nBestHeight     = ChainState::nBestHeight.load();
+    const uint32_t   nCheckpoint     = ChainState::nCheckpointHeight.load();
+
+    uint1024_t hashBestDisk = 0;
+    REQUIRE(LLD::Ledger->ReadBestChain(hashBestDisk));
+
+    uint32_t nHistoryHeight = 0;
+    REQUIRE(LLD::Ledger->ReadHistoryHeight(nHistoryHeight));
+
+    /* A sigchain transaction that creates a register, credits a debit and has a fulfilled condition. */
+    const uint256_t hashGenesis  = LLC::GetRand256();
+    const uint256_t hashRegister = LLC::GetRand256();
+    const uint256_t hashProof    = LLC::GetRand256();
+    const uint256_t hashCaller   = LLC::GetRand256();
+    const uint512_t hashDebit    = LLC::GetRand512();
+
+    Transaction tx;
+    tx.nTimestamp  = 989798;
+    tx.hashGenesis = hashGenesis;
+    tx[0] << uint8_t(TAO::Operation::OP::CREATE) << hashRegister << uint8_t(TAO::Register::REGISTER::RAW) << std::vector<uint8_t>(32, 0xcd);
+    tx[0] <= uint8_t(TAO::Operation::OP::TYPES::UINT64_T) << uint64_t(7);
+    tx[1] << uint8_t(TAO::Operation::OP::CREDIT) << hashDebit << uint32_t(2) << hashRegister << hashProof << uint64_t(500);
+
+    const uint512_t hashTx = tx.GetHash();
+    REQUIRE(LLD::Ledger->WriteTx(hashTx, tx));
+    REQUIRE(LLD::Ledger->WriteGenesis(hashGenesis, hashTx));
+    REQUIRE(LLD::Ledger->WriteLast(hashGenesis, hashTx));
+    REQUIRE(LLD::Ledger->WriteProof(hashProof, hashDebit, 2));
+    REQUIRE(LLD::Ledger->WriteClaimed(hashTx, 0, 77));
+    REQUIRE(LLD::Contract->WriteContract(std::make_pair(hashTx, uint32_t(0)), hashCaller));
+
+    /* The register it created. */
+    TAO::Register::State reg(std::vector<uint8_t>(32, 0xcd), TAO::Register::REGISTER::RAW, hashGenesis);
+    reg.nCreated = tx.nTimestamp;
+    reg.SetChecksum();
+    REQUIRE(LLD::Register->WriteState(hashRegister, reg));
+
+    /* A legacy transaction with one of its two outputs spent. */
+    Legacy::Transaction txLegacy;
+    txLegacy.nTime = 989799;
+    txLegacy.vout.resize(2);
+    txLegacy.vout[0].nValue = 5;
+    txLegacy.vout[1].nValue = 6;
+
+    const uint512_t hashLegacy = txLegacy.GetHash();
+    REQUIRE(LLD::Legacy->WriteTx(hashLegacy, txLegacy));
+    REQUIRE(LLD::Legacy->WriteSpend(hashLegacy, 1));
+
+    /* Build a small chain following genesis that carries both transactions. */
+    const uint32_t nChain = 4;
+    std::vector<BlockState> vChain;
+
+    BlockState statePrev = stateGenesis;
+    for(uint32_t n = 1; n <= nChain; ++n)
+    {
+        BlockState state;
+        state.nVersion       = 7;
+        state.nChannel       = 2;
+        state.nHeight        = stateGenesis.nHeight + n;
+        state.nBits          = 0x7b00ffff;
+        state.nNonce         = n;
+        state.nTime          = stateGenesis.nTime + n * 50;
+        state.hashPrevBlock  = statePrev.GetHash();
+        state.hashMerkleRoot = LLC::GetRand512();
+
+        if(n == 2)
+        {
+            state.vtx.push_back(std::make_pair(TRANSACTION::TRITIUM, hashTx));
+            state.vtx.push_back(std::make_pair(TRANSACTION::LEGACY,  hashLegacy));
+        }
+
+        vChain.push_back(state);
+        statePrev = state;
+    }
+
+    /* Link the chain forward, write it, and make the tip the best block and hardened checkpoint. */
+    ChainState::stateGenesis.hashNextBlock = vChain[0].GetHash();
+    for(uint32_t n = 0; n < nChain; ++n)
+    {
+        if(n + 1 < nChain)
+            vChain[n].hashNextBlock = vChain[n + 1].GetHash();
+
+        REQUIRE(LLD::Ledger->WriteBlock(vChain[n].GetHash(), vChain[n]));
+    }
+
+    const uint1024_t hashTip = vChain.back().GetHash();
+    ChainState::stateBest.store(vChain.back());
+    ChainState::hashBestChain.store(hashTip);
+    ChainState::hashCheckpoint.store(hashTip);
+    ChainState::nBestHeight.store(vChain.back().nHeight);
+
+    const std::string strPath    = config::GetDataDir() + "snapshot-test.bin";
+    const std::string strCorrupt = config::GetDataDir() + "snapshot-corrupt.bin";
+
+
+    /* Export should write every block from genesis and every record the transactions left behind. */
+    uint256_t hashCommitment = 0;
+    REQUIRE(ExportSnapshot(strPath, hashCommitment));
+    REQUIRE(hashCommitment != 0);
+
+    {
+        std::map<uint8_t, uint32_t> mapCount;
+        std::vector<BlockState> vBlocks;
+
+        uint256_t hashRead = 0;
+        REQUIRE(ReadSnapshot(strPath, [&](const uint8_t nType, DataStream& ssRecord)
+        {
+            ++mapCount[nType];
+            switch(nType)
+            {
+                case SNAPSHOT::BLOCK:
+                {
+                    BlockState state;
+                    ssRecord >> state;
+
+                    vBlocks.push_back(state);
+                    break;
+                }
+
+                case SNAPSHOT::TRITIUM:
+                {
+                    Transaction txRead;
+                    ssRecord >> txRead;
+
+                    REQUIRE(txRead.GetHash() == hashTx);
+                    REQUIRE(vBlocks.back().GetHash() == vChain[1].GetHash());
+                    break;
+                }
+
+                case SNAPSHOT::LEGACY:
+                {
+                    Legacy::Transaction txRead;
+                    std::vector<uint32_t> vSpent;
+                    ssRecord >> txRead >> vSpent;
+
+                    if(txRead.GetHash() == hashLegacy)
+                    {
+                        REQUIRE(vSpent.size() == 1);
+                        REQUIRE(vSpent[0] == 1);
+                    }
+                    break;
+                }
+
+                case SNAPSHOT::PROOF:
+                {
+                    uint256_t hashProofRead = 0;
+                    uint512_t hashTxRead    = 0;
+                    uint32_t  nContract     = 0;
+                    ssRecord >> hashProofRead >> hashTxRead >> nContract;
+
+                    REQUIRE(hashProofRead == hashProof);
+                    REQUIRE(hashTxRead    == hashDebit);
+                    REQUIRE(nContract     == 2);
+                    break;
+                }
+
+                case SNAPSHOT::CLAIMED:
+                {
+                    uint512_t hashTxRead = 0;
+                    uint32_t  nContract  = 0;
+                    uint64_t  nClaimed   = 0;
+                    ssRecord >> hashTxRead >> nContract >> nClaimed;
+
+                    REQUIRE(hashTxRead == hashTx);
+                    REQUIRE(nContract  == 0);
+                    REQUIRE(nClaimed   == 77);
+                    break;
+                }
+
+                case SNAPSHOT::CONTRACT:
+                {
+                    uint512_t hashTxRead     = 0;
+                    uint32_t  nContract      = 0;
+                    uint256_t hashCallerRead = 0;
+                    ssRecord >> hashTxRead >> nContract >> hashCallerRead;
+
+                    REQUIRE(hashTxRead     == hashTx);
+                    REQUIRE(hashCallerRead == hashCaller);
+                    break;
+                }
+
+                case SNAPSHOT::REGISTER:
+                {
+                    uint256_t hashAddress = 0;
+                    TAO::Register::State state;
+                    uint8_t fTrust = 0;
+                    ssRecord >> hashAddress >> state >> fTrust;
+
+                    REQUIRE(hashAddress == hashRegister);
+                    REQUIRE(state.GetHash() == reg.GetHash());
+                    REQUIRE(fTrust == 0);
+                    break;
+                }
+
+                case SNAPSHOT::SIGCHAIN:
+                {
+                    uint256_t hashGenesisRead = 0;
+                    uint512_t hashFirst = 0, hashLast = 0, hashStake = 0;
+                    ssRecord >> hashGenesisRead >> hashFirst >> hashLast >> hashStake;
+
+                    REQUIRE(hashGenesisRead == hashGenesis);
+                    REQUIRE(hashFirst == hashTx);
+                    REQUIRE(hashLast  == hashTx);
+                    REQUIRE(hashStake == 0);
+                    break;
+                }
+            }
+
+            return true;
+        }, hashRead));
+
+        /* Every block from genesis to the checkpoint, in order. */
+        REQUIRE(vBlocks.size() == nChain + 1);
+        REQUIRE(vBlocks.front().GetHash() == ChainState::Genesis());
+        REQUIRE(vBlocks.back().GetHash()  == hashTip);
+        REQUIRE(vBlocks.back().hashNextBlock == 0);
+
+        REQUIRE(mapCount[SNAPSHOT::TRITIUM]  == 1);
+        REQUIRE(mapCount[SNAPSHOT::PROOF]    == 1);
+        REQUIRE(mapCount[SNAPSHOT::CLAIMED]  == 1);
+        REQUIRE(mapCount[SNAPSHOT::CONTRACT] == 1);
+        REQUIRE(mapCount[SNAPSHOT::REGISTER] == 1);
+        REQUIRE(mapCount[SNAPSHOT::SIGCHAIN] == 1);
+        REQUIRE(mapCount[SNAPSHOT::LEGACY]   >= 1);
+
+        REQUIRE(hashRead == hashCommitment);
+    }
+
+
+    /* A callback can stop the read. */
+    {
+        uint256_t hashRead = 0;
+        REQUIRE_FALSE(ReadSnapshot(strPath, [](const uint8_t nType, DataStream& ssRecord)
+        {
+            return nType != SNAPSHOT::TRITIUM;
+        }, hashRead));
+    }
+
+
+    /* Import should refuse a ledger that already has blocks, and a snapshot without a trusted hash. */
+    {
+        uint256_t hashImport = 0;
+        REQUIRE_FALSE(ImportSnapshot(strPath, hashImport));
+
+        ChainState::nBestHeight.store(0);
+        config::mapArgs.erase("-snapshothash");
+        REQUIRE_FALSE(ImportSnapshot(strPath, hashImport));
+
+        config::mapArgs["-snapshothash"] = LLC::GetRand256().GetHex();
+        REQUIRE_FALSE(ImportSnapshot(strPath, hashImport));
+        REQUIRE(hashImport == hashCommitment);
+    }
+
+
+    /* Importing should bring back every record the snapshot carries. */
+    {
+        REQUIRE(LLD::Ledger->EraseProof(hashProof, hashDebit, 2));
+        REQUIRE(LLD::Ledger->WriteClaimed(hashTx, 0, 0));
+        REQUIRE(LLD::Contract->EraseContract(std::make_pair(hashTx, uint32_t(0))));
+        REQUIRE(LLD::Register->EraseState(hashRegister));
+        REQUIRE(LLD::Legacy->EraseSpend(hashLegacy, 1));
+        REQUIRE(LLD::Ledger->EraseLast(hashGenesis));
+
+        config::mapArgs["-snapshothash"] = hashCommitment.GetHex();
+
+        uint256_t hashImport = 0;
+        REQUIRE(ImportSnapshot(strPath, hashImport));
+        REQUIRE(hashImport == hashCommitment);
+
+        REQUIRE(ChainState::nBestHeight.load() == vChain.back().nHeight);
+        REQUIRE(ChainState::hashBestChain.load() == hashTip);
+
+        REQUIRE(LLD::Ledger->HasProof(hashProof, hashDebit, 2));
+
+        uint64_t nClaimed = 0;
+        REQUIRE(LLD::Ledger->ReadClaimed(hashTx, 0, nClaimed));
+        REQUIRE(nClaimed == 77);
+
+        uint256_t hashCallerRead = 0;
+        REQUIRE(LLD::Contract->ReadContract(std::make_pair(hashTx, uint32_t(0)), hashCallerRead));
+        REQUIRE(hashCallerRead == hashCaller);
+
+        TAO::Register::State regRead;
+        REQUIRE(LLD::Register->ReadState(hashRegister, regRead));
+        REQUIRE(regRead.GetHash() == reg.GetHash());
+
+        REQUIRE(LLD::Legacy->IsSpent(hashLegacy, 1));
+        REQUIRE_FALSE(LLD::Legacy->IsSpent(hashLegacy, 0));
+
+        uint512_t hashLast = 0;
+        REQUIRE(LLD::Ledger->ReadLast(hashGenesis, hashLast));
+        REQUIRE(hashLast == hashTx);
+
+        BlockState stateTx;
+        REQUIRE(LLD::Ledger->ReadBlock(hashTx, stateTx));
+        REQUIRE(stateTx.GetHash() == vChain[1].GetHash());
+
+        config::mapArgs.erase("-snapshothash");
+    }
+
+
+    const std::vector<uint8_t> vSnapshot = read_file(strPath);
+    REQUIRE(vSnapshot.size() > 304);
+
+    const auto fnAny = [](const uint8_t nType, DataStream& ssRecord){ return true; };
+
+
+    /* Corrupt, truncated or extended snapshots should be rejected. */
+    {
+        uint256_t hashRead = 0;
+
+        std::vector<uint8_t> vCorrupt = vSnapshot;
+        vCorrupt[vCorrupt.size() - 3] ^= 0xff;
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadSnapshot(strCorrupt, fnAny, hashRead));
+
+        vCorrupt.assign(vSnapshot.begin(), vSnapshot.end() - 10);
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadSnapshot(strCorrupt, fnAny, hashRead));
+
+        vCorrupt.assign(vSnapshot.begin(), vSnapshot.begin() + 100);
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadSnapshot(strCorrupt, fnAny, hashRead));
+
+        vCorrupt = vSnapshot;
+        vCorrupt.push_back(0);
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadSnapshot(strCorrupt, fnAny, hashRead));
+
+        vCorrupt = vSnapshot;
+        vCorrupt[0] = 'X';
+        write_file(strCorrupt, vCorrupt);
+        REQUIRE_FALSE(ReadSnapshot(strCorrupt, fnAny, hashRead));
+
+        /* A snapshot that doesn't match the trusted hash is never loaded. */
+        config::mapArgs["-snapshothash"] = hashCommitment.GetHex();
+        ChainState::nBestHeight.store(0);
+
+        vCorrupt = vSnapshot;
+        vCorrupt[vCorrupt.size() - 3] ^= 0xff;
+        write_file(strCorrupt, vCorrupt);
+
+        uint256_t hashImport = 0;
+        REQUIRE_FALSE(ImportSnapshot(strCorrupt, hashImport));
+
+        config::mapArgs.erase("-snapshothash");
+    }
+
+
+    /* Restore the chain state. */
+    REQUIRE(LLD::Ledger->WriteBlock(stateGenesis.GetHash(), stateGenesis));
+    REQUIRE(LLD::Ledger->WriteBestChain(hashBestDisk));
+    REQUIRE(LLD::Ledger->WriteHistoryHeight(nHistoryHeight));
+
+    ChainState::stateGenesis = stateGenesis;
+    ChainState::stateBest.store(stateBest);
+    ChainState::hashBestChain.store(hashBestChain);
+    ChainState::hashCheckpoint.store(hashCheckpoint);
+    ChainState::nBestHeight.store(nBestHeight);
+    ChainState::nCheckpointHeight.store(nCheckpoint);
+}
+
+
+TEST_CASE("Ledger snapshot export below the best chain", "[ledger]")
+{
+    using namespace TAO::Ledger;
+
+    /* Keep the chain state to restore once done. */
+    const BlockState stateGenesis    = ChainState::stateGenesis;
+    const BlockState stateBest       = ChainState::stateBest.load();
+    const uint1024_t hashBestChain   = ChainState::hashBestChain.load();
+    const uint1024_t hashCheckpoint  = ChainState::hashCheckpoint.load();
+    const uint32_t   nBestHeight     = ChainState::nBestHeight.load();
+
+    uint1024_t hashBestDisk = 0;
+    REQUIRE(LLD::Ledger->ReadBestChain(hashBestDisk));
+
+    /* A legacy transaction with output 1 spent before the checkpoint. */
+    Legacy::Transaction txFirst;
+    txFirst.nTime = 989801;
+    txFirst.vout.resize(2);
+    txFirst.vout[0].nValue = 5;
+    txFirst.vout[1].nValue = 6;
+
+    const uint512_t hashFirst = txFirst.GetHash();
+    REQUIRE(LLD::Legacy->WriteTx(hashFirst, txFirst));
+    REQUIRE(LLD::Legacy->WriteSpend(hashFirst, 1));
+
+    /* A legacy transaction after the checkpoint that spends output 0. */
+    Legacy::Transaction txAfter;
+    txAfter.nTime = 989802;
+    txAfter.vin.resize(1);
+    txAfter.vin[0].prevout.hash = hashFirst;
+    txAfter.vin[0].prevout.n    = 0;
+    txAfter.vout.resize(1);
+    txAfter.vout[0].nValue = 5;
+
+    const uint512_t hashAfter = txAfter.GetHash();
+    REQUIRE(LLD::Legacy->WriteTx(hashAfter, txAfter));
+    REQUIRE(LLD::Legacy->WriteSpend(hashFirst, 0));
+
+    /* Three blocks following genesis, checkpointed at the second. */
+    std::vector<BlockState> vChain;
+
+    BlockState statePrev = stateGenesis;
+    for(uint32_t n = 1; n <= 3; ++n)
+    {
+        BlockState state;
+        state.nVersion       = 7;
+        state.nChannel       = 2;
+        state.nHeight        = stateGenesis.nHeight + n;
+        state.nBits          = 0x7b00ffff;
+        state.nNonce         = n;
+        state.nTime          = stateGenesis.nTime + n * 50;
+        state.hashPrevBlock  = statePrev.GetHash();
+        state.hashMerkleRoot = LLC::GetRand512();
+
+        if(n == 1)
+            state.vtx.push_back(std::make_pair(TRANSACTION::LEGACY, hashFirst));
+
+        if(n == 3)
+            state.vtx.push_back(std::make_pair(TRANSACTION::LEGACY, hashAfter));
+
+        vChain.push_back(state);
+        statePrev = state;
+    }
+
+    ChainState::stateGenesis.hashNextBlock = vChain[0].GetHash();
+    for(uint32_t n = 0; n < vChain.size(); ++n)
+    {
+        if(n + 1 < vChain.size())
+            vChain[n].hashNextBlock = vChain[n + 1].GetHash();
+
+        REQUIRE(LLD::Ledger->WriteBlock(vChain[n].GetHash(), vChain[n]));
+    }
+
+    ChainState::stateBest.store(vChain.back());
+    ChainState::hashBestChain.store(vChain.back().GetHash());
+    ChainState::hashCheckpoint.store(vChain[1].GetHash());
+    ChainState::nBestHeight.store(vChain.back().nHeight);
+
+    const std::string strPath = config::GetDataDir() + "snapshot-below.bin";
+
+    uint256_t hashCommitment = 0;
+    REQUIRE(ExportSnapshot(strPath, hashCommitment));
+
+    /* The snapshot ends at the checkpoint and has the spends as they were there. */
+    {
+        std::vector<BlockState> vBlocks;
+        std::vector<uint512_t> vLegacy;
+        std::vector<uint32_t> vSpentFirst;
+
+        uint256_t hashRead = 0;
+        REQUIRE(ReadSnapshot(strPath, [&](const uint8_t nType, DataStream& ssRecord)
+        {
+            if(nType == SNAPSHOT::BLOCK)
+            {
+                BlockState state;
+                ssRecord >> state;
+
+                vBlocks.push_back(state);
+            }
+            else if(nType == SNAPSHOT::LEGACY)
+            {
+                Legacy::Transaction txRead;
+                std::vector<uint32_t> vSpent;
+                ssRecord >> txRead >> vSpent;
+
+                vLegacy.push_back(txRead.GetHash());
+                if(txRead.GetHash() == hashFirst)
+                    vSpentFirst = vSpent;
+            }
+
+            return true;
+        }, hashRead));
+
+        REQUIRE(hashRead == hashCommitment);
+        REQUIRE(vBlocks.back().GetHash() == vChain[1].GetHash());
+        REQUIRE(vBlocks.back().hashNextBlock == 0);
+
+        REQUIRE(std::find(vLegacy.begin(), vLegacy.end(), hashAfter) == vLegacy.end());
+        REQUIRE(vSpentFirst.size() == 1);
+        REQUIRE(vSpentFirst[0] == 1);
+    }
+
+    /* Nothing was disconnected. */
+    REQUIRE(ChainState::stateBest.load() == vChain.back());
+    REQUIRE(ChainState::nBestHeight.load() == vChain.back().nHeight);
+
+    uint1024_t hashBestRead = 0;
+    REQUIRE(LLD::Ledger->ReadBestChain(hashBestRead));
+    REQUIRE(hashBestRead == hashBestDisk);
+
+    BlockState stateRead;
+    REQUIRE(LLD::Ledger->ReadBlock(vChain[1].GetHash(), stateRead));
+    REQUIRE(stateRead.hashNextBlock == vChain[2].GetHash());
+    REQUIRE(LLD::Ledger->ReadBlock(vChain[2].GetHash(), stateRead));
+
+    REQUIRE(LLD::Legacy->IsSpent(hashFirst, 0));
+    REQUIRE(LLD::Legacy->IsSpent(hashFirst, 1));
+
+    /* Restore the chain state. */
+    REQUIRE(LLD::Ledger->WriteBlock(stateGenesis.GetHash(), stateGenesis));
+
+    ChainState::stateGenesis = stateGenesis;
+    ChainState::stateBest.store(stateBest);
+    ChainState::hashBestChain.store(hashBestChain);
+    ChainState::hashCheckpoint.store(hashCheckpoint);
+    ChainState::nBestHeight.store(nBestHeight);
+}
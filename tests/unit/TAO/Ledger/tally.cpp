@@ -0,0 +1,206 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/tally.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/types/address.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+/* Write an account owned by a sigchain. */
+static TAO::Register::Address tally_account(const uint256_t& hashOwner)
+{
+    const TAO::Register::Address hashAccount = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+
+    TAO::Register::Object account = TAO::Register::CreateAccount(0);
+    account.hashOwner = hashOwner;
+    REQUIRE(LLD::Register->WriteState(hashAccount, account));
+
+    return hashAccount;
+}
+
+
+/* Write a trust account so the sigchain can vote. */
+static void tally_trust(const uint256_t& hashGenesis)
+{
+    TAO::Register::Object trust = TAO::Register::CreateTrust();
+    trust.hashOwner = hashGenesis;
+    REQUIRE(LLD::Register->WriteState(TAO::Register::Address(std::string("trust"), hashGenesis, TAO::Register::Address::TRUST), trust));
+}
+
+
+/* Add a credit from one account to another to a transaction. */
+static void tally_credit(TAO::Ledger::Transaction& tx, const uint256_t& hashTo, const uint256_t& hashFrom)
+{
+    tx[tx.Size()] << uint8_t(TAO::Operation::OP::CREDIT) << LLC::GetRand512() << uint32_t(0) << hashTo << hashFrom << uint64_t(1);
+}
+
+
+TEST_CASE("Vote tally tests", "[ledger]")
+{
+    using namespace TAO::Ledger;
+
+    const uint256_t hashOwner   = LLC::GetRand256();
+    const uint256_t hashAccount = tally_account(hashOwner);
+    const uint256_t hashOther   = tally_account(hashOwner);
+
+    /* Two sigchains that can vote and one without a trust account. */
+    const uint256_t hashVoter[3] = { LLC::GetRand256(), LLC::GetRand256(), LLC::GetRand256() };
+    uint256_t hashFrom[3];
+    for(uint32_t n = 0; n < 3; ++n)
+    {
+        hashFrom[n] = tally_account(hashVoter[n]);
+    }
+
+    tally_trust(hashVoter[0]);
+    tally_trust(hashVoter[1]);
+
+    uint64_t nWeight = 0;
+    REQUIRE(VoteWeight(hashVoter[0], nWeight));
+    REQUIRE(nWeight == NXS_COIN);
+    REQUIRE_FALSE(VoteWeight(hashVoter[2], nWeight));
+
+    /* The owner's sigchain, credits in the first transaction and more in the second. */
+    Transaction tx0;
+    tx0.hashGenesis = hashOwner;
+    tx0.nSequence   = 0;
+    tx0.nTimestamp  = runtime::timestamp();
+    tally_credit(tx0, hashAccount, hashFrom[0]);
+    tally_credit(tx0, hashAccount, hashFrom[1]);
+    tally_credit(tx0, hashOther,   hashFrom[1]);
+
+    Transaction tx1;
+    tx1.hashGenesis = hashOwner;
+    tx1.nSequence   = 1;
+    tx1.hashPrevTx  = tx0.GetHash();
+    tx1.nTimestamp  = tx0.nTimestamp + 1;
+    tally_credit(tx1, hashAccount, hashFrom[0]);
+    tally_credit(tx1, hashAccount, hashFrom[2]);
+
+    REQUIRE(LLD::Ledger->WriteTx(tx0.GetHash(), tx0));
+    REQUIRE(LLD::Ledger->WriteTx(tx1.GetHash(), tx1));
+    REQUIRE(LLD::Ledger->WriteLast(hashOwner, tx1.GetHash()));
+
+
+    /* Credits to an account without a tally are left alone. */
+    {
+        REQUIRE(ConnectVote(tx0[0]));
+
+        std::pair<uint64_t, uint64_t> pairTally;
+        REQUIRE_FALSE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+    }
+
+
+    /* Connected credits count each voting sigchain once. */
+    {
+        REQUIRE(LLD::Ledger->WriteTally(hashAccount, std::make_pair(uint64_t(0), uint64_t(0))));
+
+        REQUIRE(ConnectVote(tx0[0]));
+        REQUIRE(ConnectVote(tx0[1]));
+        REQUIRE(ConnectVote(tx0[2]));
+        REQUIRE(ConnectVote(tx1[0]));
+        REQUIRE(ConnectVote(tx1[1]));
+
+        std::pair<uint64_t, uint64_t> pairTally;
+        REQUIRE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+        REQUIRE(pairTally.first  == 2);
+        REQUIRE(pairTally.second == 2 * NXS_COIN);
+
+        std::pair<uint64_t, uint32_t> pairVoter;
+        REQUIRE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[0], pairVoter));
+        REQUIRE(pairVoter.first  == NXS_COIN);
+        REQUIRE(pairVoter.second == 2);
+
+        REQUIRE_FALSE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[2], pairVoter));
+        REQUIRE_FALSE(LLD::Ledger->ReadTally(hashOther, pairTally));
+    }
+
+
+    /* Disconnected credits only remove a vote once the sigchain has none left. */
+    {
+        REQUIRE(DisconnectVote(tx1[1]));
+        REQUIRE(DisconnectVote(tx1[0]));
+
+        std::pair<uint64_t, uint64_t> pairTally;
+        REQUIRE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+        REQUIRE(pairTally.first == 2);
+
+        REQUIRE(DisconnectVote(tx0[0]));
+
+        REQUIRE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+        REQUIRE(pairTally.first  == 1);
+        REQUIRE(pairTally.second == NXS_COIN);
+
+        std::pair<uint64_t, uint32_t> pairVoter;
+        REQUIRE_FALSE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[0], pairVoter));
+
+        /* Put the disconnected credits back. */
+        REQUIRE(ConnectVote(tx0[0]));
+        REQUIRE(ConnectVote(tx1[0]));
+        REQUIRE(ConnectVote(tx1[1]));
+    }
+
+
+    /* A rebuild counts the sigchain again and clears voter records that no longer count. */
+    {
+        REQUIRE(LLD::Ledger->WriteTally(hashAccount, std::make_pair(uint64_t(9), uint64_t(9))));
+        REQUIRE(LLD::Ledger->WriteVoter(hashAccount, hashVoter[0], std::make_pair(uint64_t(5), uint32_t(7))));
+        REQUIRE(LLD::Ledger->WriteVoter(hashAccount, hashVoter[2], std::make_pair(uint64_t(5), uint32_t(1))));
+
+        uint64_t nVotes = 0;
+        REQUIRE(RebuildTally(hashAccount, nVotes, nWeight));
+        REQUIRE(nVotes  == 2);
+        REQUIRE(nWeight == 2 * NXS_COIN);
+
+        std::pair<uint64_t, uint64_t> pairTally;
+        REQUIRE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+        REQUIRE(pairTally.first  == 2);
+        REQUIRE(pairTally.second == 2 * NXS_COIN);
+
+        std::pair<uint64_t, uint32_t> pairVoter;
+        REQUIRE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[0], pairVoter));
+        REQUIRE(pairVoter.first  == NXS_COIN);
+        REQUIRE(pairVoter.second == 2);
+
+        REQUIRE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[1], pairVoter));
+        REQUIRE(pairVoter.second == 1);
+
+        REQUIRE_FALSE(LLD::Ledger->ReadVoter(hashAccount, hashVoter[2], pairVoter));
+
+        /* Disconnecting after a rebuild keeps the tally in step. */
+        REQUIRE(DisconnectVote(tx1[1]));
+        REQUIRE(DisconnectVote(tx1[0]));
+        REQUIRE(DisconnectVote(tx0[1]));
+
+        REQUIRE(LLD::Ledger->ReadTally(hashAccount, pairTally));
+        REQUIRE(pairTally.first  == 1);
+        REQUIRE(pairTally.second == NXS_COIN);
+    }
+
+
+    /* A rebuild for an account that doesn't exist fails. */
+    {
+        uint64_t nVotes = 0;
+        REQUIRE_FALSE(RebuildTally(TAO::Register::Address(TAO::Register::Address::ACCOUNT), nVotes, nWeight));
+    }
+}
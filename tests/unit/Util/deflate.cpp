@@ -0,0 +1,123 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+
+#include <unit/catch2/catch.hpp>
+
+#include <Util/include/deflate.h>
+
+#include <LLP/packets/http.h>
+
+#include <string>
+
+TEST_CASE( "Deflate round trip", "[deflate]")
+{
+    std::string strData;
+    for(uint32_t n = 0; n < 2000; ++n)
+        strData += "{\"height\":" + std::to_string(n) + ",\"hash\":\"0000abcdef\"},";
+
+    /* Both formats decompress back to the original. */
+    std::string strGzip, strZlib, strCheck;
+    REQUIRE(encoding::Deflate(strData, strGzip, true));
+    REQUIRE(encoding::Deflate(strData, strZlib, false));
+    REQUIRE(strGzip.size() < strData.size());
+    REQUIRE((uint8_t)strGzip[0] == 0x1f);
+    REQUIRE((uint8_t)strGzip[1] == 0x8b);
+
+    REQUIRE(encoding::Inflate(strGzip, strCheck));
+    REQUIRE(strCheck == strData);
+
+    REQUIRE(encoding::Inflate(strZlib, strCheck));
+    REQUIRE(strCheck == strData);
+
+    /* Truncated data fails. */
+    REQUIRE(!encoding::Inflate(strGzip.substr(0, strGzip.size() / 2), strCheck));
+
+    /* Empty data. */
+    REQUIRE(encoding::Deflate("", strGzip, true));
+    REQUIRE(encoding::Inflate(strGzip, strCheck));
+    REQUIRE(strCheck.empty());
+}
+
+
+TEST_CASE( "HTTPPacket content encoding negotiation", "[deflate]")
+{
+    const std::string strContent(4096, 'a');
+
+    /* Prefers gzip. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = strContent;
+
+        REQUIRE(packet.Compress("deflate, gzip;q=0.5"));
+        REQUIRE(packet.mapHeaders["Content-Encoding"] == "gzip");
+
+        std::string strCheck;
+        REQUIRE(encoding::Inflate(packet.strContent, strCheck));
+        REQUIRE(strCheck == strContent);
+    }
+
+    /* Honors q=0. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = strContent;
+
+        REQUIRE(packet.Compress("gzip;q=0, deflate"));
+        REQUIRE(packet.mapHeaders["Content-Encoding"] == "deflate");
+    }
+
+    /* An explicit q=0 is not overridden by the wildcard, in either order. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = strContent;
+
+        REQUIRE(packet.Compress("*, gzip;q=0"));
+        REQUIRE(packet.mapHeaders["Content-Encoding"] == "deflate");
+
+        packet.strContent = strContent;
+        REQUIRE(packet.Compress("gzip;q=0, *"));
+        REQUIRE(packet.mapHeaders["Content-Encoding"] == "deflate");
+
+        packet.strContent = strContent;
+        REQUIRE(!packet.Compress("gzip;q=0, deflate;q=0, *"));
+        REQUIRE(packet.strContent == strContent);
+    }
+
+    /* A refused wildcard leaves named encodings acceptable. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = strContent;
+
+        REQUIRE(packet.Compress("deflate, *;q=0"));
+        REQUIRE(packet.mapHeaders["Content-Encoding"] == "deflate");
+    }
+
+    /* Nothing acceptable. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = strContent;
+
+        REQUIRE(!packet.Compress("identity, br"));
+        REQUIRE(packet.strContent == strContent);
+        REQUIRE(!packet.mapHeaders.count("Content-Encoding"));
+    }
+
+    /* Small content is left alone. */
+    {
+        LLP::HTTPPacket packet(200);
+        packet.strContent = "{}";
+
+        REQUIRE(!packet.Compress("gzip"));
+        REQUIRE(packet.strContent == "{}");
+    }
+}
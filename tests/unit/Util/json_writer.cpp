@@ -0,0 +1,69 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/json.h>
+#include <Util/include/json_writer.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE("Util streaming JSON writer tests", "[json]")
+{
+    /* Build a tree covering every value type. */
+    json::json tree;
+    tree["unsigned"] = uint32_t(5);
+    tree["signed"]   = int32_t(-3);
+    tree["string"]   = std::string("quote\" slash\\ newline\n control\x01");
+    tree["double"]   = 1.5;
+    tree["whole"]    = double(5);
+    tree["true"]     = true;
+    tree["null"]     = nullptr;
+    tree["empty"]    = json::json::array();
+    tree["nested"]   = json::json::array({ 1, "two", json::json::object() });
+
+    /* Stream the same structure. */
+    std::string strBuffer;
+    json::writer writer(strBuffer);
+
+    writer.BeginObject();
+    writer.Field("unsigned", uint32_t(5));
+    writer.Field("signed",   int32_t(-3));
+    writer.Field("string",   std::string("quote\" slash\\ newline\n control\x01"));
+    writer.Field("double",   1.5);
+    writer.Field("whole",    double(5));
+    writer.Field("true",     true);
+    writer.Key("null");
+    writer.Null();
+    writer.Key("empty");
+    writer.BeginArray();
+    writer.EndArray();
+    writer.Key("nested");
+    writer.BeginArray();
+    writer.Value(1);
+    writer.Value("two");
+    writer.Value(json::json::object());
+    writer.EndArray();
+    writer.EndObject();
+
+    /* The streamed output must be identical to the tree serialization. */
+    REQUIRE(strBuffer == tree.dump());
+
+    /* The streamed output must parse back into the same tree. */
+    REQUIRE(json::json::parse(strBuffer) == tree);
+
+    /* Writers append to existing buffer content. */
+    std::string strPrefix = "prefix";
+    json::writer writer2(strPrefix);
+    writer2.BeginArray();
+    writer2.EndArray();
+    REQUIRE(strPrefix == "prefix[]");
+}
@@ -0,0 +1,124 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/debug.h>
+#include <Util/include/logger.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Util asynchronous logger tests", "[logger]")
+{
+    const uint32_t nThreads  = 4;
+    const uint32_t nMessages = 64;
+
+    /* Block policy should deliver every message from every producer. */
+    {
+        debug::AsyncLogger logger;
+        logger.Start(16, true);
+        REQUIRE(logger.Running());
+
+        std::vector<std::thread> vThreads;
+        for(uint32_t t = 0; t < nThreads; ++t)
+        {
+            vThreads.push_back(std::thread([&logger, t, nMessages]
+            {
+                for(uint32_t n = 0; n < nMessages; ++n)
+                {
+                    std::string strMessage = debug::safe_printstr("logger test block ", t, ":", n);
+                    logger.Push(strMessage);
+                }
+            }));
+        }
+
+        for(auto& thread : vThreads)
+            thread.join();
+
+        logger.Stop();
+        REQUIRE_FALSE(logger.Running());
+
+        REQUIRE(logger.Dropped() == 0);
+        REQUIRE(logger.Written() == nThreads * nMessages);
+    }
+
+
+    /* Drop policy should account for every message as either written or dropped. */
+    {
+        debug::AsyncLogger logger;
+        logger.Start(4, false);
+
+        std::vector<std::thread> vThreads;
+        for(uint32_t t = 0; t < nThreads; ++t)
+        {
+            vThreads.push_back(std::thread([&logger, t, nMessages]
+            {
+                for(uint32_t n = 0; n < nMessages; ++n)
+                {
+                    std::string strMessage = debug::safe_printstr("logger test drop ", t, ":", n);
+                    logger.Push(strMessage);
+                }
+            }));
+        }
+
+        for(auto& thread : vThreads)
+            thread.join();
+
+        logger.Stop();
+
+        REQUIRE(logger.Written() + logger.Dropped() == nThreads * nMessages);
+    }
+
+
+    /* Stopping under load should write every message that Push accepted. */
+    {
+        debug::AsyncLogger logger;
+        logger.Start(8, true);
+
+        std::atomic<uint64_t> nAccepted(0);
+        std::vector<std::thread> vThreads;
+        for(uint32_t t = 0; t < nThreads; ++t)
+        {
+            vThreads.push_back(std::thread([&logger, &nAccepted, t, nMessages]
+            {
+                for(uint32_t n = 0; n < nMessages * 16; ++n)
+                {
+                    std::string strMessage = debug::safe_printstr("logger test stop ", t, ":", n);
+                    if(logger.Push(strMessage))
+                        ++nAccepted;
+                }
+            }));
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        logger.Stop();
+
+        for(auto& thread : vThreads)
+            thread.join();
+
+        REQUIRE(logger.Dropped() == 0);
+        REQUIRE(logger.Written() == nAccepted.load());
+    }
+
+
+    /* A stopped logger should refuse messages so the caller writes synchronously. */
+    {
+        debug::AsyncLogger logger;
+
+        std::string strMessage = "logger test stopped";
+        REQUIRE_FALSE(logger.Push(strMessage));
+        REQUIRE(strMessage == "logger test stopped");
+    }
+}
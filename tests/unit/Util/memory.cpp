@@ -0,0 +1,50 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/include/memory.h>
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE("Util decrypted_view tests", "[memory]")
+{
+    memory::encrypted_ptr<memory::encrypted_type<uint64_t>> ptr(new memory::encrypted_type<uint64_t>(42));
+
+    /* Memory is readable through the view and through nested proxies inside it. */
+    {
+        memory::decrypted_view<memory::encrypted_type<uint64_t>> view(ptr);
+        REQUIRE(view->DATA == 42);
+        REQUIRE(ptr->DATA == 42);
+
+        /* Writes inside the view are kept when it re-encrypts. */
+        view->DATA = 55;
+        REQUIRE((*view).DATA == 55);
+    }
+
+    /* Views nest on the same thread. */
+    {
+        memory::decrypted_view<memory::encrypted_type<uint64_t>> outer(ptr);
+        {
+            memory::decrypted_view<memory::encrypted_type<uint64_t>> inner(ptr);
+            REQUIRE(inner->DATA == 55);
+        }
+        REQUIRE(outer->DATA == 55);
+    }
+
+    /* The memory is encrypted again once all views are gone. */
+    REQUIRE(ptr->DATA == 55);
+
+    ptr.free();
+
+    /* A view of a null pointer throws on member access. */
+    memory::decrypted_view<memory::encrypted_type<uint64_t>> view(ptr);
+    REQUIRE_THROWS(view->DATA);
+}
@@ -0,0 +1,95 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <Util/include/metrics.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "metrics registry lookups", "[metrics]")
+{
+    /* The same name and labels always give the same instance. */
+    metrics::Counter& counter = metrics::GetCounter("test_lookup_total", metrics::Label("db", "ledger"));
+    REQUIRE(&counter == &metrics::GetCounter("test_lookup_total", metrics::Label("db", "ledger")));
+    REQUIRE(&counter != &metrics::GetCounter("test_lookup_total", metrics::Label("db", "local")));
+
+    counter.Add();
+    counter.Add(4);
+    REQUIRE(counter.Get() == 5);
+
+    /* Label values are escaped. */
+    REQUIRE(metrics::Label("a", "x\"y\\z") == "a=\"x\\\"y\\\\z\"");
+
+    /* Concurrent registration and updates end up on one counter. */
+    std::vector<std::thread> vThreads;
+    for(uint32_t n = 0; n < 4; ++n)
+    {
+        vThreads.push_back(std::thread([]
+        {
+            for(uint32_t i = 0; i < 1000; ++i)
+                metrics::GetCounter("test_threads_total").Add();
+        }));
+    }
+
+    for(auto& thread : vThreads)
+        thread.join();
+
+    REQUIRE(metrics::GetCounter("test_threads_total").Get() == 4000);
+}
+
+
+TEST_CASE( "metrics histogram buckets", "[metrics]")
+{
+    metrics::Histogram& histogram = metrics::GetHistogram("test_latency_seconds");
+
+    histogram.Observe(5);
+    histogram.Observe(10);
+    histogram.Observe(11);
+    histogram.Observe(900);
+    histogram.Observe(20000000);
+
+    REQUIRE(histogram.Count() == 5);
+    REQUIRE(histogram.Sum() == 20000926);
+    REQUIRE(histogram.Bucket(0) == 2);
+    REQUIRE(histogram.Bucket(1) == 1);
+    REQUIRE(histogram.Bucket(metrics::HISTOGRAM_BUCKETS - 1) == 1);
+
+    REQUIRE(histogram.Quantile(0.4) == 10);
+    REQUIRE(histogram.Quantile(0.6) == 25);
+    REQUIRE(histogram.Quantile(0.8) == 1000);
+    REQUIRE(histogram.Quantile(1.0) == 10000000);
+}
+
+
+TEST_CASE( "metrics prometheus export", "[metrics]")
+{
+    metrics::GetGauge("test_export_gauge", metrics::Label("server", "API")).Set(-3);
+    metrics::RegisterCallback("test_export_callback", "", []{ return int64_t(42); });
+    metrics::GetHistogram("test_export_seconds", metrics::Label("api", "system")).Observe(1500);
+
+    const std::string strExport = metrics::Prometheus();
+
+    REQUIRE(strExport.find("# TYPE test_export_gauge gauge\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_gauge{server=\"API\"} -3\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_callback 42\n") != std::string::npos);
+
+    REQUIRE(strExport.find("# TYPE test_export_seconds histogram\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_seconds_bucket{api=\"system\",le=\"0.001\"} 0\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_seconds_bucket{api=\"system\",le=\"0.0025\"} 1\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_seconds_bucket{api=\"system\",le=\"+Inf\"} 1\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_seconds_sum{api=\"system\"} 0.0015\n") != std::string::npos);
+    REQUIRE(strExport.find("test_export_seconds_count{api=\"system\"} 1\n") != std::string::npos);
+}
@@ -0,0 +1,82 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <Util/templates/ranked_set.h>
+
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+TEST_CASE( "ranked_set basic operations", "[ranked_set]")
+{
+    ranked_set<uint32_t> set;
+    REQUIRE(set.empty());
+    REQUIRE(set.size() == 0);
+    REQUIRE_THROWS(set.at(0));
+
+    REQUIRE(set.insert(30));
+    REQUIRE(set.insert(10));
+    REQUIRE(set.insert(20));
+    REQUIRE(!set.insert(20));
+
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.count(10) == 1);
+    REQUIRE(set.count(15) == 0);
+
+    /* Ranks follow the ordering. */
+    REQUIRE(set.at(0) == 10);
+    REQUIRE(set.at(1) == 20);
+    REQUIRE(set.at(2) == 30);
+    REQUIRE_THROWS(set.at(3));
+
+    REQUIRE(set.erase(20));
+    REQUIRE(!set.erase(20));
+    REQUIRE(set.size() == 2);
+    REQUIRE(set.at(1) == 30);
+
+    set.clear();
+    REQUIRE(set.empty());
+}
+
+
+TEST_CASE( "ranked_set matches std::set", "[ranked_set]")
+{
+    ranked_set<uint32_t, std::greater<uint32_t> > set;
+    std::set<uint32_t, std::greater<uint32_t> > setCheck;
+
+    /* Random inserts and erases. */
+    srand(42);
+    for(uint32_t n = 0; n < 20000; ++n)
+    {
+        const uint32_t nValue = rand() % 2000;
+        if(rand() % 3 == 0)
+        {
+            REQUIRE(set.erase(nValue) == (setCheck.erase(nValue) == 1));
+        }
+        else
+        {
+            REQUIRE(set.insert(nValue) == setCheck.insert(nValue).second);
+        }
+    }
+
+    /* Every rank has the same element as the sorted set. */
+    REQUIRE(set.size() == setCheck.size());
+
+    uint32_t nRank = 0;
+    for(const auto& nValue : setCheck)
+    {
+        REQUIRE(set.at(nRank++) == nValue);
+    }
+}
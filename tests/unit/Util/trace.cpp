@@ -0,0 +1,187 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <unit/catch2/catch.hpp>
+
+#include <Util/include/args.h>
+#include <Util/include/filesystem.h>
+#include <Util/include/json.h>
+#include <Util/include/trace.h>
+
+#include <fstream>
+#include <set>
+#include <thread>
+
+TEST_CASE( "trace spans", "[trace]")
+{
+    /* Nothing is recorded while disabled. */
+    trace::fEnabled = false;
+
+    uint64_t nBefore = 0;
+    trace::Dump(nBefore);
+    {
+        trace::Span span("Disabled", "test");
+    }
+
+    uint64_t nEvents = 0;
+    trace::Dump(nEvents);
+    REQUIRE(nEvents == nBefore);
+
+    /* Record nested spans on this thread and one span on another. */
+    trace::fEnabled = true;
+    {
+        trace::Span outer("Outer", "test");
+        {
+            trace::Span inner("Inner", "test");
+        }
+    }
+
+    std::thread([]
+    {
+        trace::Span span("Thread", "test");
+    }).join();
+
+    trace::fEnabled = false;
+
+    /* The dump is valid trace_event JSON. */
+    const json::json jsonTrace = json::json::parse(trace::Dump(nEvents));
+    REQUIRE(nEvents == nBefore + 3);
+    REQUIRE(jsonTrace["traceEvents"].size() == nEvents);
+
+    json::json jsonOuter, jsonInner, jsonThread;
+    for(const auto& jsonEvent : jsonTrace["traceEvents"])
+    {
+        if(jsonEvent["name"] == "Outer")
+            jsonOuter = jsonEvent;
+        else if(jsonEvent["name"] == "Inner")
+            jsonInner = jsonEvent;
+        else if(jsonEvent["name"] == "Thread")
+            jsonThread = jsonEvent;
+    }
+
+    REQUIRE(jsonOuter["ph"] == "X");
+    REQUIRE(jsonOuter["cat"] == "test");
+
+    /* The inner span is contained in the outer one. */
+    const uint64_t nOuter = jsonOuter["ts"].get<uint64_t>();
+    const uint64_t nInner = jsonInner["ts"].get<uint64_t>();
+    REQUIRE(nInner >= nOuter);
+    REQUIRE(nInner + jsonInner["dur"].get<uint64_t>() <= nOuter + jsonOuter["dur"].get<uint64_t>());
+
+    /* Each thread has its own id. */
+    REQUIRE(jsonOuter["tid"] == jsonInner["tid"]);
+    REQUIRE(jsonOuter["tid"] != jsonThread["tid"]);
+}
+
+
+TEST_CASE( "trace ring buffer", "[trace]")
+{
+    trace::fEnabled = true;
+
+    /* A new thread only keeps the most recent spans. */
+    std::thread([]
+    {
+        for(uint32_t n = 0; n < trace::DEFAULT_BUFFER + 100; ++n)
+            trace::Span span("Ring", "ring");
+    }).join();
+
+    trace::fEnabled = false;
+
+    uint64_t nEvents = 0;
+    const json::json jsonTrace = json::json::parse(trace::Dump(nEvents));
+
+    uint32_t nRing = 0;
+    for(const auto& jsonEvent : jsonTrace["traceEvents"])
+    {
+        if(jsonEvent["cat"] == "ring")
+            ++nRing;
+    }
+
+    REQUIRE(nRing == trace::DEFAULT_BUFFER);
+}
+
+
+TEST_CASE( "trace buffers are reused after a thread exits", "[trace]")
+{
+    trace::fEnabled = true;
+
+    /* Threads run one after the other share one buffer, and each span is still dumped after its thread is gone. */
+    for(uint32_t n = 0; n < 8; ++n)
+    {
+        std::thread([]
+        {
+            trace::Span span("Reuse", "reuse");
+        }).join();
+    }
+
+    trace::fEnabled = false;
+
+    uint64_t nEvents = 0;
+    const json::json jsonTrace = json::json::parse(trace::Dump(nEvents));
+
+    uint32_t nReuse = 0;
+    std::set<uint64_t> setThreads;
+    for(const auto& jsonEvent : jsonTrace["traceEvents"])
+    {
+        if(jsonEvent["cat"] == "reuse")
+        {
+            ++nReuse;
+            setThreads.insert(jsonEvent["tid"].get<uint64_t>());
+        }
+    }
+
+    REQUIRE(nReuse == 8);
+    REQUIRE(setThreads.size() == 1);
+}
+
+
+TEST_CASE( "trace dumps written by the dump thread", "[trace]")
+{
+    const std::string strPath = config::GetDataDir() + "trace-async.json";
+    filesystem::remove(strPath);
+
+    /* Nothing is queued without -traceslow. */
+    REQUIRE_FALSE(trace::WriteAsync(strPath));
+
+    config::mapArgs["-trace"]     = "1";
+    config::mapArgs["-traceslow"] = "100";
+    trace::Initialize();
+
+    REQUIRE(trace::nSlow.load() == 100);
+    {
+        trace::Span span("Async", "async");
+    }
+
+    /* Shutdown writes what was queued before it returns. */
+    REQUIRE(trace::WriteAsync(strPath));
+    trace::Shutdown();
+
+    REQUIRE_FALSE(trace::WriteAsync(strPath));
+
+    std::ifstream stream(strPath);
+    const json::json jsonTrace = json::json::parse(std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>()));
+
+    bool fFound = false;
+    for(const auto& jsonEvent : jsonTrace["traceEvents"])
+    {
+        if(jsonEvent["cat"] == "async")
+            fFound = true;
+    }
+
+    REQUIRE(fFound);
+
+    /* Restore the defaults. */
+    config::mapArgs.erase("-trace");
+    config::mapArgs.erase("-traceslow");
+    trace::Initialize();
+}